@@ -0,0 +1,354 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/send_recv.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/combine.hpp>
+#include <blacspp/traits.hpp>
+#include <blacspp/util/pack.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Latency / bandwidth micro-benchmarks of the blacspp API on a square grid
+// over MPI_COMM_WORLD (in the spirit of the OSU micro-benchmarks).
+//
+// Usage: blacspp_bench [--format=csv|json] [--output=FILE] [--types=isdcz]
+//                      [--sizes=1,8,64,...] [--lda-pad=0,...] [--nwarmup=N]
+//                      [--nrepeat=N] [--benchmarks=gesd2d,trsd2d,...]
+//
+// Benchmarks:
+//   gesd2d : ping-pong gesd2d / gerv2d between process (0,0) and its neighbour
+//   trsd2d : ping-pong trsd2d / trrv2d (upper, non-unit) between the same pair
+//   trsd2d-blacs : as trsd2d, calling the BLACS routines directly (packing of
+//            the trapezoid by BLACS rather than the blacspp kernels)
+//   pack   : local pack_trapezoid / unpack_trapezoid (upper, non-unit) round
+//            trip with the kernels of every supported instruction set (scope)
+//   gebs2d : gebs2d / gebr2d over the All, Row and Column scopes
+//   gsum2d : all-reduce gsum2d over the All, Row and Column scopes
+//   gamx2d : all-reduce gamx2d over the All, Row and Column scopes
+//
+// Every (benchmark, scope, type, M = N = size, LDA = M + pad) combination is
+// timed. Latencies are reported per operation (half a round trip for the
+// ping-pongs) as the max over the processes, bandwidth as bytes / latency.
+// Results are written on rank 0 (stdout unless --output is given).
+
+namespace {
+
+struct bench_options {
+  std::string              format     = "csv";
+  std::string              output;
+  std::string              types      = "isdcz";
+  std::vector<blacspp::blacs_int> sizes   = { 1, 8, 64, 256, 1024 };
+  std::vector<blacspp::blacs_int> pads    = { 0, 17 };
+  std::vector<std::string> benchmarks = { "gesd2d", "trsd2d", "trsd2d-blacs", "pack",
+                                          "gebs2d", "gsum2d", "gamx2d" };
+  int nwarmup = 5;
+  int nrepeat = 50;
+};
+
+struct bench_result {
+  std::string         name;
+  std::string         scope;
+  char                type;
+  blacspp::blacs_int  M, N, LDA;
+  std::size_t         bytes;
+  double              latency;
+  double              bandwidth;
+};
+
+std::vector<std::string> split_list( const std::string& str ) {
+  std::vector<std::string> items;
+  std::size_t st = 0;
+  while( st <= str.size() ) {
+    const auto en = std::min( str.find( ',', st ), str.size() );
+    if( en > st ) items.push_back( str.substr( st, en - st ) );
+    st = en + 1;
+  }
+  return items;
+}
+
+std::vector<blacspp::blacs_int> int_list( const std::string& str ) {
+  std::vector<blacspp::blacs_int> items;
+  for( const auto& s : split_list( str ) ) items.push_back( std::stoi( s ) );
+  return items;
+}
+
+bench_options parse_options( int argc, char** argv ) {
+
+  bench_options opts;
+  for( int i = 1; i < argc; ++i ) {
+
+    const std::string arg = argv[i];
+    const auto eq = arg.find( '=' );
+    const std::string key = arg.substr( 0, eq );
+    const std::string val = eq == std::string::npos ? "" : arg.substr( eq + 1 );
+
+    if     ( key == "--format"     ) opts.format     = val;
+    else if( key == "--output"     ) opts.output     = val;
+    else if( key == "--types"      ) opts.types      = val;
+    else if( key == "--sizes"      ) opts.sizes      = int_list( val );
+    else if( key == "--lda-pad"    ) opts.pads       = int_list( val );
+    else if( key == "--benchmarks" ) opts.benchmarks = split_list( val );
+    else if( key == "--nwarmup"    ) opts.nwarmup    = std::stoi( val );
+    else if( key == "--nrepeat"    ) opts.nrepeat    = std::stoi( val );
+    else throw std::runtime_error( "Unknown option: " + arg );
+
+  }
+
+  if( opts.format != "csv" and opts.format != "json" )
+    throw std::runtime_error( "Unknown format: " + opts.format );
+
+  return opts;
+
+}
+
+
+
+
+// Time nrepeat calls of f (after nwarmup untimed calls), max over the grid
+template <typename F>
+double time_op( const blacspp::Grid& grid, const bench_options& opts, F&& f ) {
+
+  MPI_Barrier( grid.comm() );
+  for( int i = 0; i < opts.nwarmup; ++i ) f();
+
+  MPI_Barrier( grid.comm() );
+  const double start = MPI_Wtime();
+  for( int i = 0; i < opts.nrepeat; ++i ) f();
+  double elapsed = (MPI_Wtime() - start) / std::max( opts.nrepeat, 1 );
+
+  MPI_Allreduce( MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, grid.comm() );
+  return elapsed;
+
+}
+
+const char* isa_name( blacspp::detail::PackISA isa ) noexcept {
+  switch( isa ) {
+    case blacspp::detail::PackISA::AVX2:   return "avx2";
+    case blacspp::detail::PackISA::AVX512: return "avx512";
+    case blacspp::detail::PackISA::NEON:   return "neon";
+    default:                               return "generic";
+  }
+}
+
+const char* scope_name( blacspp::Scope scope ) noexcept {
+  switch( scope ) {
+    case blacspp::Row:    return "row";
+    case blacspp::Column: return "column";
+    default:              return "all";
+  }
+}
+
+template <typename T>
+void bench_type( const blacspp::Grid& grid, char type, const bench_options& opts,
+                 std::vector< bench_result >& results ) {
+
+  using namespace blacspp;
+
+  // Ping-pong partner of (0,0)
+  const process_coordinate peer = grid.npc() > 1 ? process_coordinate{ 0, 1 } :
+                                                   process_coordinate{ 1, 0 };
+  const bool has_peer = grid.npr() * grid.npc() > 1;
+  const bool is_zero  = grid.ipr() == 0 and grid.ipc() == 0;
+  const bool is_peer  = grid.ipr() == peer.first and grid.ipc() == peer.second;
+
+  auto has = [&]( const char* name ) {
+    return std::find( opts.benchmarks.begin(), opts.benchmarks.end(), name ) !=
+           opts.benchmarks.end();
+  };
+
+  for( auto size : opts.sizes )
+  for( auto pad  : opts.pads  ) {
+
+    const blacs_int M = size, N = size, LDA = M + pad;
+    // Zeros remain bounded over repeated sums
+    std::vector<T> A( std::size_t(LDA) * N, T(0) );
+    const std::size_t bytes = std::size_t(M) * N * sizeof(T);
+
+    auto push = [&]( const char* name, const char* scope, std::size_t nbytes,
+                     double latency ) {
+      results.push_back( bench_result{ name, scope, type, M, N, LDA, nbytes,
+        latency, latency > 0. ? nbytes / latency : 0. } );
+    };
+
+    if( has_peer and has( "gesd2d" ) ) {
+      const double t = time_op( grid, opts, [&]() {
+        if( is_zero ) {
+          gesd2d( grid, M, N, A.data(), LDA, peer.first, peer.second );
+          gerv2d( grid, M, N, A.data(), LDA, peer.first, peer.second );
+        } else if( is_peer ) {
+          gerv2d( grid, M, N, A.data(), LDA, 0, 0 );
+          gesd2d( grid, M, N, A.data(), LDA, 0, 0 );
+        }
+      });
+      push( "gesd2d", "-", bytes, t / 2 );
+    }
+
+    if( has_peer and has( "trsd2d" ) ) {
+      const double t = time_op( grid, opts, [&]() {
+        if( is_zero ) {
+          trsd2d( grid, Upper, NonUnit, M, N, A.data(), LDA, peer.first, peer.second );
+          trrv2d( grid, Upper, NonUnit, M, N, A.data(), LDA, peer.first, peer.second );
+        } else if( is_peer ) {
+          trrv2d( grid, Upper, NonUnit, M, N, A.data(), LDA, 0, 0 );
+          trsd2d( grid, Upper, NonUnit, M, N, A.data(), LDA, 0, 0 );
+        }
+      });
+      push( "trsd2d", "-", detail::trapezoid_size( Upper, NonUnit, M, N ) * sizeof(T),
+            t / 2 );
+    }
+
+    if( has_peer and has( "trsd2d-blacs" ) ) {
+      const auto ctxt = grid.context();
+      const double t = time_op( grid, opts, [&]() {
+        if( is_zero ) {
+          blacs_traits<T>::trsd2d( ctxt, "U", "N", M, N, A.data(), LDA, peer.first, peer.second );
+          blacs_traits<T>::trrv2d( ctxt, "U", "N", M, N, A.data(), LDA, peer.first, peer.second );
+        } else if( is_peer ) {
+          blacs_traits<T>::trrv2d( ctxt, "U", "N", M, N, A.data(), LDA, 0, 0 );
+          blacs_traits<T>::trsd2d( ctxt, "U", "N", M, N, A.data(), LDA, 0, 0 );
+        }
+      });
+      push( "trsd2d-blacs", "-", detail::trapezoid_size( Upper, NonUnit, M, N ) * sizeof(T),
+            t / 2 );
+    }
+
+    if( has( "pack" ) ) {
+      const auto isa0 = detail::pack_isa();
+      const std::size_t nt = detail::trapezoid_size( Upper, NonUnit, M, N );
+      std::vector<T> packed( nt );
+      for( auto isa : { detail::PackISA::Generic, detail::PackISA::AVX2,
+                        detail::PackISA::AVX512,  detail::PackISA::NEON } ) {
+        if( not detail::pack_isa_supported( isa ) ) continue;
+        detail::set_pack_isa( isa );
+        const double t = time_op( grid, opts, [&]() {
+          detail::pack_trapezoid( packed.data(), sizeof(T), Upper, NonUnit, M, N,
+                                  A.data(), LDA );
+          detail::unpack_trapezoid( A.data(), sizeof(T), Upper, NonUnit, M, N,
+                                    packed.data(), LDA );
+        });
+        push( "pack", isa_name( isa ), 2 * nt * sizeof(T), t );
+      }
+      detail::set_pack_isa( isa0 );
+    }
+
+    for( auto scope : { All, Row, Column } ) {
+
+      if( has( "gebs2d" ) ) {
+        const auto src = detail::scope_origin( grid, scope );
+        const blacs_int RSRC = src.first, CSRC = src.second;
+        const bool is_root = grid.ipr() == RSRC and grid.ipc() == CSRC;
+        const auto top = grid.broadcast_topology( scope, bytes );
+        const double t = time_op( grid, opts, [&]() {
+          if( is_root ) gebs2d( grid, scope, top, M, N, A.data(), LDA );
+          else          gebr2d( grid, scope, top, M, N, A.data(), LDA, RSRC, CSRC );
+        });
+        push( "gebs2d", scope_name( scope ), bytes, t );
+      }
+
+      if( has( "gsum2d" ) ) {
+        const auto top = grid.combine_topology( scope, bytes );
+        const double t = time_op( grid, opts, [&]() {
+          gsum2d( grid, scope, top, M, N, A.data(), LDA );
+        });
+        push( "gsum2d", scope_name( scope ), bytes, t );
+      }
+
+      if( has( "gamx2d" ) ) {
+        const auto top = grid.combine_topology( scope, bytes );
+        const double t = time_op( grid, opts, [&]() {
+          gamx2d( grid, scope, top, M, N, A.data(), LDA );
+        });
+        push( "gamx2d", scope_name( scope ), bytes, t );
+      }
+
+    }
+
+  }
+
+}
+
+void write_results( std::FILE* out, const bench_options& opts,
+  const blacspp::Grid& grid, const std::vector< bench_result >& results ) {
+
+  if( opts.format == "csv" ) {
+
+    std::fprintf( out, "benchmark,scope,type,M,N,LDA,bytes,nprow,npcol,nrepeat,"
+                       "latency [s],bandwidth [B/s]\n" );
+    for( const auto& r : results )
+      std::fprintf( out, "%s,%s,%c,%d,%d,%d,%zu,%d,%d,%d,%.6e,%.6e\n",
+        r.name.c_str(), r.scope.c_str(), r.type, (int)r.M, (int)r.N, (int)r.LDA,
+        r.bytes, (int)grid.npr(), (int)grid.npc(), opts.nrepeat, r.latency,
+        r.bandwidth );
+
+  } else {
+
+    std::fprintf( out, "{\n  \"grid\": { \"nprow\": %d, \"npcol\": %d },\n"
+                       "  \"nwarmup\": %d,\n  \"nrepeat\": %d,\n  \"results\": [\n",
+      (int)grid.npr(), (int)grid.npc(), opts.nwarmup, opts.nrepeat );
+    for( std::size_t i = 0; i < results.size(); ++i ) {
+      const auto& r = results[i];
+      std::fprintf( out, "    { \"benchmark\": \"%s\", \"scope\": \"%s\", "
+        "\"type\": \"%c\", \"M\": %d, \"N\": %d, \"LDA\": %d, \"bytes\": %zu, "
+        "\"latency\": %.6e, \"bandwidth\": %.6e }%s\n", r.name.c_str(),
+        r.scope.c_str(), r.type, (int)r.M, (int)r.N, (int)r.LDA, r.bytes,
+        r.latency, r.bandwidth, i + 1 < results.size() ? "," : "" );
+    }
+    std::fprintf( out, "  ]\n}\n" );
+
+  }
+
+}
+
+}
+
+int main( int argc, char** argv ) {
+
+  MPI_Init( &argc, &argv );
+
+  int rank;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+
+  int ierr = 0;
+  try {
+
+    const auto opts = parse_options( argc, argv );
+    auto grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+    std::vector< bench_result > results;
+    for( auto type : opts.types )
+    switch( type ) {
+      case 'i': bench_type<blacspp::blacs_int>( grid, type, opts, results ); break;
+      case 's': bench_type<float>             ( grid, type, opts, results ); break;
+      case 'd': bench_type<double>            ( grid, type, opts, results ); break;
+      case 'c': bench_type<blacspp::scomplex> ( grid, type, opts, results ); break;
+      case 'z': bench_type<blacspp::dcomplex> ( grid, type, opts, results ); break;
+      default:
+        throw std::runtime_error( std::string("Unknown BLACS type: ") + type );
+    }
+
+    if( rank == 0 ) {
+      std::FILE* out = opts.output.empty() ? stdout :
+                       std::fopen( opts.output.c_str(), "w" );
+      if( not out ) throw std::runtime_error( "Unable to open " + opts.output );
+      write_results( out, opts, grid, results );
+      if( out != stdout ) std::fclose( out );
+    }
+
+  } catch( const std::exception& e ) {
+    if( rank == 0 ) std::fprintf( stderr, "%s\n", e.what() );
+    ierr = 1;
+  }
+
+  MPI_Finalize();
+  return ierr;
+
+}
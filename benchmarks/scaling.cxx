@@ -0,0 +1,436 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/broadcast.hpp>
+#include <blacspp/combine.hpp>
+#include <blacspp/distmatrix.hpp>
+#include <blacspp/redistribute.hpp>
+#include <blacspp/scatter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Scaling study of the communication patterns of blacspp-based codes over
+// grid shapes and process counts, with regression gating against a baseline.
+//
+// Usage: blacspp_scaling [--output=FILE] [--shapes=row,column,square,node]
+//                        [--patterns=bcast,rowsum,...] [--modes=strong,weak]
+//                        [--nprocs=1,2,4,...] [--sizes=256,1024,...] [--nb=N]
+//                        [--nwarmup=N] [--nrepeat=N] [--baseline=FILE]
+//                        [--threshold=0.1]
+//
+// Shapes (over the first nproc ranks of MPI_COMM_WORLD):
+//   row    : 1 x nproc grid
+//   column : nproc x 1 grid
+//   square : Grid::square_grid
+//   node   : Grid::node_aware_grid
+//
+// Patterns (double precision, N x N matrix in NB x NB blocks):
+//   bcast        : broadcast of a N x NB panel along the process rows from
+//                  process column 0 (gebs2d / gebr2d, Scope::Row)
+//   rowsum       : all-reduce of a N x NB panel along the process rows
+//                  (gsum2d, Scope::Row)
+//   colsum       : all-reduce of a NB x N panel along the process columns
+//                  (gsum2d, Scope::Column)
+//   redistribute : change of block size NB -> 2 NB (RedistributionPlan)
+//   scatter      : scatter of the matrix from (0,0) followed by its gather
+//
+// The process counts default to the powers of two from 2 up to the size of
+// MPI_COMM_WORLD (and the size itself), the processes beyond nproc idle.
+// Panel patterns are skipped on grids without peers in their scope (e.g.
+// bcast on the column shape). In strong scaling the matrix is N x N for every
+// process count, in weak scaling N is scaled by sqrt( nproc / nproc0 ) such
+// that the data per process is constant. Times are the max over the processes,
+// throughput is the global volume of the pattern / time. The efficiency of
+// each (pattern, shape, mode, size) curve is relative to its smallest process
+// count nproc0:
+//   strong : ( t0 * nproc0 ) / ( t * nproc )
+//   weak   : t0 / t
+//
+// Results are written as CSV on rank 0 (stdout unless --output is given),
+// such that the output of a qualified build may serve as the baseline of the
+// following runs. With --baseline, every result whose throughput falls short
+// of its baseline by more than the threshold (fraction) is reported on stderr
+// and the driver exits with status 2.
+
+namespace {
+
+struct scaling_options {
+  std::string                     output;
+  std::string                     baseline;
+  std::vector<std::string>        shapes   = { "row", "column", "square", "node" };
+  std::vector<std::string>        patterns = { "bcast", "rowsum", "colsum",
+                                               "redistribute", "scatter" };
+  std::vector<std::string>        modes    = { "strong", "weak" };
+  std::vector<blacspp::blacs_int> nprocs;
+  std::vector<blacspp::blacs_int> sizes    = { 256, 1024 };
+  blacspp::blacs_int              nb       = 64;
+  double                          threshold = 0.1;
+  int nwarmup = 2;
+  int nrepeat = 10;
+};
+
+struct scaling_result {
+  std::string        pattern;
+  std::string        shape;
+  std::string        mode;
+  blacspp::blacs_int nproc, npr, npc;
+  blacspp::blacs_int size;   ///< Requested size (key of the curve)
+  blacspp::blacs_int N;      ///< Actual matrix dimension
+  std::size_t        bytes;
+  double             time;
+  double             throughput;
+  double             efficiency;
+};
+
+std::vector<std::string> split_list( const std::string& str ) {
+  std::vector<std::string> items;
+  std::size_t st = 0;
+  while( st <= str.size() ) {
+    const auto en = std::min( str.find( ',', st ), str.size() );
+    if( en > st ) items.push_back( str.substr( st, en - st ) );
+    st = en + 1;
+  }
+  return items;
+}
+
+std::vector<blacspp::blacs_int> int_list( const std::string& str ) {
+  std::vector<blacspp::blacs_int> items;
+  for( const auto& s : split_list( str ) ) items.push_back( std::stoi( s ) );
+  return items;
+}
+
+bool contains( const std::vector<std::string>& list, const std::string& item ) {
+  return std::find( list.begin(), list.end(), item ) != list.end();
+}
+
+scaling_options parse_options( int argc, char** argv, int world_size ) {
+
+  scaling_options opts;
+  for( int i = 1; i < argc; ++i ) {
+
+    const std::string arg = argv[i];
+    const auto eq = arg.find( '=' );
+    const std::string key = arg.substr( 0, eq );
+    const std::string val = eq == std::string::npos ? "" : arg.substr( eq + 1 );
+
+    if     ( key == "--output"    ) opts.output    = val;
+    else if( key == "--baseline"  ) opts.baseline  = val;
+    else if( key == "--shapes"    ) opts.shapes    = split_list( val );
+    else if( key == "--patterns"  ) opts.patterns  = split_list( val );
+    else if( key == "--modes"     ) opts.modes     = split_list( val );
+    else if( key == "--nprocs"    ) opts.nprocs    = int_list( val );
+    else if( key == "--sizes"     ) opts.sizes     = int_list( val );
+    else if( key == "--nb"        ) opts.nb        = std::stoi( val );
+    else if( key == "--threshold" ) opts.threshold = std::stod( val );
+    else if( key == "--nwarmup"   ) opts.nwarmup   = std::stoi( val );
+    else if( key == "--nrepeat"   ) opts.nrepeat   = std::stoi( val );
+    else throw std::runtime_error( "Unknown option: " + arg );
+
+  }
+
+  for( const auto& s : opts.shapes )
+    if( not contains( { "row", "column", "square", "node" }, s ) )
+      throw std::runtime_error( "Unknown shape: " + s );
+  for( const auto& p : opts.patterns )
+    if( not contains( { "bcast", "rowsum", "colsum", "redistribute", "scatter" }, p ) )
+      throw std::runtime_error( "Unknown pattern: " + p );
+  for( const auto& m : opts.modes )
+    if( m != "strong" and m != "weak" )
+      throw std::runtime_error( "Unknown mode: " + m );
+  if( opts.nb < 1 ) throw std::runtime_error( "Invalid block size" );
+
+  if( opts.nprocs.empty() ) {
+    for( int p = 2; p < world_size; p *= 2 ) opts.nprocs.push_back( p );
+    opts.nprocs.push_back( world_size );
+  }
+  std::sort( opts.nprocs.begin(), opts.nprocs.end() );
+  opts.nprocs.erase( std::unique( opts.nprocs.begin(), opts.nprocs.end() ),
+                     opts.nprocs.end() );
+  for( auto p : opts.nprocs )
+    if( p < 1 or p > world_size )
+      throw std::runtime_error( "Invalid process count: " + std::to_string( p ) );
+
+  return opts;
+
+}
+
+// Time nrepeat calls of f (after nwarmup untimed calls), max over the grid
+template <typename F>
+double time_op( const blacspp::Grid& grid, const scaling_options& opts, F&& f ) {
+
+  MPI_Barrier( grid.comm() );
+  for( int i = 0; i < opts.nwarmup; ++i ) f();
+
+  MPI_Barrier( grid.comm() );
+  const double start = MPI_Wtime();
+  for( int i = 0; i < opts.nrepeat; ++i ) f();
+  double elapsed = (MPI_Wtime() - start) / std::max( opts.nrepeat, 1 );
+
+  MPI_Allreduce( MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, grid.comm() );
+  return elapsed;
+
+}
+
+blacspp::Grid make_grid( const std::string& shape, MPI_Comm comm, int nproc ) {
+  if     ( shape == "row"    ) return blacspp::Grid( comm, 1, nproc );
+  else if( shape == "column" ) return blacspp::Grid( comm, nproc, 1 );
+  else if( shape == "square" ) return blacspp::Grid::square_grid( comm );
+  else                         return blacspp::Grid::node_aware_grid( comm );
+}
+
+// Whether a pattern involves communication on a grid
+bool communicates( const blacspp::Grid& grid, const std::string& pattern ) {
+  if( pattern == "bcast" or pattern == "rowsum" ) return grid.npc() > 1;
+  if( pattern == "colsum" )                       return grid.npr() > 1;
+  return true;
+}
+
+// Time a pattern on a N x N matrix, returns ( volume [bytes], time [s] )
+std::pair<std::size_t, double> run_pattern( const blacspp::Grid& grid,
+  const std::string& pattern, blacspp::blacs_int N, const scaling_options& opts ) {
+
+  using namespace blacspp;
+
+  const blacs_int NB = opts.nb;
+  const std::size_t volume = std::size_t(N) * std::size_t(N) * sizeof(double);
+  const std::size_t panel  = std::size_t(N) * std::size_t(NB) * sizeof(double);
+
+  // Panels are N x NB (NB x N) and distributed over the process rows (columns)
+  // like the columns (rows) of the matrix. All processes of a row (column)
+  // agree on the size of their part, empty parts skip the transfer.
+  const blacs_int mloc = numroc( N, NB, grid.ipr(), 0, grid.npr() );
+  const blacs_int nloc = numroc( N, NB, grid.ipc(), 0, grid.npc() );
+
+  if( pattern == "bcast" ) {
+
+    const blacs_int LDA = std::max( mloc, 1 );
+    std::vector<double> A( std::size_t(LDA) * NB, 0. );
+    const double t = time_op( grid, opts, [&]() {
+      if( mloc == 0 ) return;
+      if( grid.ipc() == 0 ) gebs2d( grid, Row, mloc, NB, A.data(), LDA );
+      else gebr2d( grid, Row, mloc, NB, A.data(), LDA, grid.ipr(), 0 );
+    });
+    return { panel, t };
+
+  } else if( pattern == "rowsum" or pattern == "colsum" ) {
+
+    const bool row = pattern == "rowsum";
+    const blacs_int M = row ? mloc : NB, K = row ? NB : nloc;
+    const blacs_int LDA = std::max( M, 1 );
+    // Zeros remain bounded over repeated sums
+    std::vector<double> A( std::size_t(LDA) * K, 0. );
+    const double t = time_op( grid, opts, [&]() {
+      if( M == 0 or K == 0 ) return;
+      gsum2d( grid, row ? Row : Column, M, K, A.data(), LDA );
+    });
+    return { panel, t };
+
+  } else if( pattern == "redistribute" ) {
+
+    DistMatrix<double> A( grid, N, N, NB, NB ), B( grid, N, N, 2*NB, 2*NB );
+    RedistributionPlan<double> plan( A, B, grid.comm() );
+    const double t = time_op( grid, opts, [&]() { plan.execute( A, B ); } );
+    return { volume, t };
+
+  } else {
+
+    DistMatrix<double> A( grid, N, N, NB, NB );
+    const bool is_root = grid.ipr() == 0 and grid.ipc() == 0;
+    std::vector<double> G( is_root ? std::size_t(N) * N : 0, 0. );
+    const blacs_int LDG = std::max( N, 1 );
+    const double t = time_op( grid, opts, [&]() {
+      scatter( G.data(), LDG, A );
+      gather( A, G.data(), LDG );
+    });
+    return { 2 * volume, t };
+
+  }
+
+}
+
+void compute_efficiency( std::vector< scaling_result >& results ) {
+
+  // Reference (smallest process count) of each curve
+  using curve_key = std::tuple< std::string, std::string, std::string, blacspp::blacs_int >;
+  std::map< curve_key, const scaling_result* > ref;
+  for( const auto& r : results ) {
+    auto& p = ref[ curve_key{ r.pattern, r.shape, r.mode, r.size } ];
+    if( not p or r.nproc < p->nproc ) p = &r;
+  }
+
+  for( auto& r : results ) {
+    const auto* r0 = ref.at( curve_key{ r.pattern, r.shape, r.mode, r.size } );
+    if( r.time <= 0. )          r.efficiency = 0.;
+    else if( r.mode == "weak" ) r.efficiency = r0->time / r.time;
+    else r.efficiency = ( r0->time * r0->nproc ) / ( r.time * r.nproc );
+  }
+
+}
+
+void write_results( std::FILE* out, const std::vector< scaling_result >& results ) {
+
+  std::fprintf( out, "pattern,shape,mode,nproc,npr,npc,size,N,bytes,time [s],"
+                     "throughput [B/s],efficiency\n" );
+  for( const auto& r : results )
+    std::fprintf( out, "%s,%s,%s,%d,%d,%d,%d,%d,%zu,%.6e,%.6e,%.4f\n",
+      r.pattern.c_str(), r.shape.c_str(), r.mode.c_str(), (int)r.nproc,
+      (int)r.npr, (int)r.npc, (int)r.size, (int)r.N, r.bytes, r.time,
+      r.throughput, r.efficiency );
+
+}
+
+using result_key = std::tuple< std::string, std::string, std::string,
+                               blacspp::blacs_int, blacspp::blacs_int >;
+
+// Throughputs of a baseline (a CSV written by write_results)
+std::map< result_key, double > read_baseline( const std::string& fname ) {
+
+  std::ifstream in( fname );
+  if( not in ) throw std::runtime_error( "Unable to open " + fname );
+
+  std::string line;
+  std::getline( in, line );
+  const auto header = split_list( line );
+  auto column = [&]( const std::string& prefix ) {
+    for( std::size_t i = 0; i < header.size(); ++i )
+      if( header[i].compare( 0, prefix.size(), prefix ) == 0 ) return i;
+    throw std::runtime_error( "Invalid baseline " + fname + ": no " + prefix + " column" );
+  };
+  const auto ipat = column( "pattern" ), ishp = column( "shape" ),
+             imod = column( "mode" ),    inp  = column( "nproc" ),
+             isz  = column( "size" ),    ithr = column( "throughput" );
+
+  std::map< result_key, double > baseline;
+  while( std::getline( in, line ) ) {
+    const auto f = split_list( line );
+    if( f.size() != header.size() ) continue;
+    baseline[ result_key{ f[ipat], f[ishp], f[imod], std::stoi( f[inp] ),
+                          std::stoi( f[isz] ) } ] = std::stod( f[ithr] );
+  }
+  return baseline;
+
+}
+
+// Report the regressions against a baseline, returns their number
+int compare_baseline( std::FILE* out, const std::vector< scaling_result >& results,
+  const std::map< result_key, double >& baseline, double threshold ) {
+
+  int ncompared = 0, nregressed = 0;
+  for( const auto& r : results ) {
+
+    const auto it = baseline.find( result_key{ r.pattern, r.shape, r.mode,
+                                               r.nproc, r.size } );
+    if( it == baseline.end() ) continue;
+    ncompared++;
+
+    const double base = it->second;
+    if( r.throughput >= base * ( 1. - threshold ) ) continue;
+
+    if( nregressed++ == 0 )
+      std::fprintf( out, "%-12s %-6s %-6s %5s %6s %14s %14s %8s\n", "pattern",
+        "shape", "mode", "nproc", "size", "baseline [B/s]", "current [B/s]",
+        "change" );
+    std::fprintf( out, "%-12s %-6s %-6s %5d %6d %14.4e %14.4e %7.1f%%\n",
+      r.pattern.c_str(), r.shape.c_str(), r.mode.c_str(), (int)r.nproc,
+      (int)r.size, base, r.throughput,
+      base > 0. ? 100. * ( r.throughput - base ) / base : 0. );
+
+  }
+
+  std::fprintf( out, "%d of %zu results compared against the baseline, "
+    "%d regressed by more than %.1f%%\n", ncompared, results.size(), nregressed,
+    100. * threshold );
+  return nregressed;
+
+}
+
+}
+
+int main( int argc, char** argv ) {
+
+  MPI_Init( &argc, &argv );
+
+  int rank, world_size;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+  MPI_Comm_size( MPI_COMM_WORLD, &world_size );
+
+  int ierr = 0;
+  try {
+
+    const auto opts = parse_options( argc, argv, world_size );
+    const blacspp::blacs_int nproc0 = opts.nprocs.front();
+
+    std::vector< scaling_result > results;
+    for( auto nproc : opts.nprocs ) {
+
+      // Rank 0 participates in (and reports) every process count
+      MPI_Comm comm;
+      MPI_Comm_split( MPI_COMM_WORLD, rank < nproc ? 0 : MPI_UNDEFINED, rank, &comm );
+      if( comm == MPI_COMM_NULL ) continue;
+
+      for( const auto& shape : opts.shapes ) {
+
+        // The grid is released before its communicator
+        {
+          auto grid = make_grid( shape, comm, nproc );
+          for( const auto& mode    : opts.modes    )
+          for( const auto& pattern : opts.patterns )
+          for( auto size : opts.sizes ) {
+
+            if( not communicates( grid, pattern ) ) continue;
+
+            const blacspp::blacs_int N = mode == "weak" ?
+              blacspp::blacs_int( std::lround( size * std::sqrt( double(nproc) / nproc0 ) ) ) :
+              size;
+
+            const auto [bytes, t] = run_pattern( grid, pattern, N, opts );
+            results.push_back( scaling_result{ pattern, shape, mode, nproc,
+              grid.npr(), grid.npc(), size, N, bytes, t, t > 0. ? bytes / t : 0.,
+              0. } );
+
+          }
+        }
+
+      }
+
+      MPI_Comm_free( &comm );
+
+    }
+
+    if( rank == 0 ) {
+
+      compute_efficiency( results );
+
+      std::FILE* out = opts.output.empty() ? stdout :
+                       std::fopen( opts.output.c_str(), "w" );
+      if( not out ) throw std::runtime_error( "Unable to open " + opts.output );
+      write_results( out, results );
+      if( out != stdout ) std::fclose( out );
+
+      if( not opts.baseline.empty() and
+          compare_baseline( stderr, results, read_baseline( opts.baseline ),
+                            opts.threshold ) )
+        ierr = 2;
+
+    }
+
+  } catch( const std::exception& e ) {
+    if( rank == 0 ) std::fprintf( stderr, "%s\n", e.what() );
+    ierr = 1;
+  }
+
+  MPI_Finalize();
+  return ierr;
+
+}
@@ -0,0 +1,66 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/tune.hpp>
+#include <blacspp/util/type_conversions.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Sweep the BLACS topologies on a square grid over MPI_COMM_WORLD and write
+// the resulting topology table (see blacspp::TopologyTable).
+//
+// Usage: blacspp_tune [output file = blacspp_topologies.txt] [nrepeat] [types]
+//
+// The raw samples are printed (CSV) on rank 0. The table may be loaded with
+// blacspp::TopologyTable::load and attached with Grid::set_topology_table.
+
+int main( int argc, char** argv ) {
+
+  MPI_Init( &argc, &argv );
+
+  int rank;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+
+  const std::string fname = argc > 1 ? argv[1] : "blacspp_topologies.txt";
+
+  blacspp::tune_options opts;
+  if( argc > 2 ) opts.nrepeat = std::atoi( argv[2] );
+  if( argc > 3 ) opts.types   = argv[3];
+
+  int ierr = 0;
+  {
+    auto grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+    auto samples = blacspp::benchmark_topologies( grid, opts );
+    auto table   = blacspp::build_topology_table( samples );
+
+    if( rank == 0 ) {
+
+      std::printf( "op,scope,type,M,N,bytes,topology,latency [s],bandwidth [B/s]\n" );
+      for( const auto& s : samples )
+        std::printf( "%s,%s,%c,%d,%d,%zu,%s,%.6e,%.6e\n",
+          s.op == blacspp::Broadcast ? "broadcast" : "combine",
+          blacspp::detail::type_string( s.scope ), s.type, (int)s.M, (int)s.N,
+          s.bytes, blacspp::topology_name( s.top ), s.latency, s.bandwidth );
+
+      try {
+        table.save( fname );
+        std::printf( "Wrote %s (%d x %d grid)\n", fname.c_str(), (int)grid.npr(),
+                     (int)grid.npc() );
+      } catch( const std::exception& e ) {
+        std::fprintf( stderr, "%s\n", e.what() );
+        ierr = 1;
+      }
+
+    }
+  }
+
+  MPI_Finalize();
+  return ierr;
+
+}
@@ -0,0 +1,102 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/util/type_conversions.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Per-call overhead of translating the enum arguments of a single trbs2d
+// (Scope, Topology, Triangle, Diagonal) into BLACS strings.
+//
+// "legacy" reproduces the previous std::string based conversion for comparison.
+
+namespace legacy {
+
+  using namespace blacspp;
+
+  __attribute__((noinline)) std::string type_string( const Triangle tri ) {
+    if( tri == Upper ) return std::string( "Upper" );
+    else               return std::string( "Lower" );
+  }
+
+  __attribute__((noinline)) std::string type_string( const Diagonal diag ) {
+    if( diag == Unit ) return std::string( "U" );
+    else               return std::string( "N" );
+  }
+
+  __attribute__((noinline)) std::string type_string( const Scope scope ) {
+    if( scope == All )      return std::string( "All" );
+    else if( scope == Row ) return std::string( "Row" );
+    else                    return std::string( "Column" );
+  }
+
+  __attribute__((noinline)) std::string type_string( const Topology ) {
+    return std::string( "i-ring" );
+  }
+
+}
+
+// Stand in for the BLACS call, only inspects the leading character
+__attribute__((noinline)) int consume( const char* SCOPE, const char* TOP,
+                                       const char* UPLO,  const char* DIAG ) {
+  return SCOPE[0] + TOP[0] + UPLO[0] + DIAG[0];
+}
+
+template <typename Func>
+double time_per_call( const int ncall, Func&& f ) {
+
+  auto st = std::chrono::high_resolution_clock::now();
+  for( int i = 0; i < ncall; ++i ) f(i);
+  auto en = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<double, std::nano>( en - st ).count() / ncall;
+
+}
+
+int main( int argc, char** argv ) {
+
+  using namespace blacspp;
+  const int ncall = argc > 1 ? std::atoi( argv[1] ) : 10000000;
+
+  volatile int sink = 0;
+
+  // Vary the arguments to prevent hoisting out of the loop
+  const Scope    scopes[] = { All,   Row,   Column };
+  const Triangle tris[]   = { Upper, Lower         };
+  const Diagonal diags[]  = { Unit,  NonUnit       };
+
+  auto t_legacy = time_per_call( ncall, [&]( int i ) {
+    auto SCOPE = legacy::type_string( scopes[i%3] );
+    auto TOP   = legacy::type_string( IRing       );
+    auto UPLO  = legacy::type_string( tris[i%2]   );
+    auto DIAG  = legacy::type_string( diags[i%2]  );
+    sink += consume( SCOPE.c_str(), TOP.c_str(), UPLO.c_str(), DIAG.c_str() );
+  });
+
+  auto t_constexpr = time_per_call( ncall, [&]( int i ) {
+    const auto SCOPE = detail::type_string( scopes[i%3] );
+    const auto TOP   = detail::type_string( IRing       );
+    const auto UPLO  = detail::type_string( tris[i%2]   );
+    const auto DIAG  = detail::type_string( diags[i%2]  );
+    sink += consume( SCOPE, TOP, UPLO, DIAG );
+  });
+
+  auto t_template = time_per_call( ncall, [&]( int ) {
+    sink += consume( detail::type_string_v<Row>,   detail::type_string_v<IRing>,
+                     detail::type_string_v<Upper>, detail::type_string_v<NonUnit> );
+  });
+
+  std::printf( "%-24s %10s\n",     "conversion", "ns/call" );
+  std::printf( "%-24s %10.3f\n",   "std::string (legacy)", t_legacy    );
+  std::printf( "%-24s %10.3f\n",   "constexpr const char*", t_constexpr );
+  std::printf( "%-24s %10.3f\n",   "type_string_v<E>",      t_template  );
+
+  return sink == 0;
+
+}
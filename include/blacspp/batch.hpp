@@ -0,0 +1,240 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/util/sfinae.hpp>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace blacspp {
+
+/// Default MPI tag for batched messages
+inline constexpr int batch_tag = 2642;
+
+/**
+ *  \brief Aggregates small 2D tiles into a single message per peer.
+ *
+ *  Tiles (of any BLACS enabled type, mixed within a batch) are packed into 
+ *  a per-destination buffer upon enqueue, such that the source buffer may be
+ *  reused immediately. Recieving processes register the buffers into which the
+ *  tiles of each source are to be unpacked (in the order in which they have
+ *  been enqueued on the source). flush() exchanges one message per peer.
+ *
+ *  Every flush() on a sending process must be matched by a flush() on each of
+ *  its destinations which expects the same sequence of tiles.
+ */
+class MessageBatch {
+
+  struct recv_entry {
+    std::int32_t type;      ///< BLACS type character
+    std::int32_t kind;      ///< 0: general, otherwise encoded trapezoid
+    blacs_int    M;         ///< Number of rows
+    blacs_int    N;         ///< Number of columns
+    blacs_int    LDA;       ///< Leading dimension of the recieve buffer
+    std::size_t  elem_size; ///< Size of an element in bytes
+    void*        A;         ///< Recieve buffer
+  };
+
+  const Grid*                                  grid_; ///< Grid of the batch
+  int                                          tag_;  ///< MPI tag of the batch
+  std::map< blacs_int, std::vector<char> >       send_; ///< Packed tiles per destination rank
+  std::map< blacs_int, std::vector<recv_entry> > recv_; ///< Expected tiles per source rank
+
+  void enqueue_tile( blacs_int dest, char type, std::int32_t kind, std::size_t elem_size,
+                     blacs_int M, blacs_int N, const void* A, blacs_int LDA );
+  void expect_tile( blacs_int src, char type, std::int32_t kind, std::size_t elem_size,
+                    blacs_int M, blacs_int N, void* A, blacs_int LDA );
+
+  static std::int32_t trapezoid_kind( Triangle uplo, Diagonal diag ) noexcept {
+    return 1 + 2 * uplo + diag;
+  }
+
+public:
+
+  /**
+   *  \brief Construct an empty batch on a BLACS grid.
+   *
+   *  The grid must outlive the batch.
+   *
+   *  @param[in] grid BLACS grid which defined the communication context.
+   *  @param[in] tag  MPI tag of the batched messages
+   */
+  explicit MessageBatch( const Grid& grid, int tag = batch_tag );
+
+  /**
+   *  \brief Enqueue a general 2D tile for a destination process.
+   *
+   *  @tparam T Type of buffer to send. Must be BLACS enabled.
+   *
+   *  @param[in] M     (local) Number of rows of the buffer to send
+   *  @param[in] N     (local) Number of columns of the buffer to send
+   *  @param[in] A     (local) Pointer of buffer to send
+   *  @param[in] LDA   (local) Leading dimension of the buffer to send
+   *  @param[in] RDEST (local) Process row coordinate of destination process
+   *  @param[in] CDEST (local) Process column coordinate of desination process
+   */
+  template <typename T>
+  detail::enable_if_blacs_native_t<T>
+    enqueue( const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA,
+             const blacs_int RDEST, const blacs_int CDEST ) {
+
+    enqueue_tile( grid_->comm_rank( RDEST, CDEST ), detail::blacs_type_char_v<T>, 0,
+                  sizeof(T), M, N, A, LDA );
+
+  }
+
+  /**
+   *  \brief Enqueue a triangular (trapezoidal) 2D tile for a destination process.
+   *
+   *  The trapezoid follows the definition of trsd2d.
+   *
+   *  @tparam T Type of buffer to send. Must be BLACS enabled.
+   *
+   *  @param[in] uplo  (local) Which triangle of the buffer to send (upper/lower)
+   *  @param[in] diag  (local) Whether to imply that the diagonal of the buffer is unit.
+   *  @param[in] M     (local) Number of rows of the buffer to send
+   *  @param[in] N     (local) Number of columns of the buffer to send
+   *  @param[in] A     (local) Pointer of buffer to send
+   *  @param[in] LDA   (local) Leading dimension of the buffer to send
+   *  @param[in] RDEST (local) Process row coordinate of destination process
+   *  @param[in] CDEST (local) Process column coordinate of desination process
+   */
+  template <typename T>
+  detail::enable_if_blacs_native_t<T>
+    enqueue( const Triangle uplo, const Diagonal diag, const blacs_int M, 
+             const blacs_int N, const T* A, const blacs_int LDA,
+             const blacs_int RDEST, const blacs_int CDEST ) {
+
+    enqueue_tile( grid_->comm_rank( RDEST, CDEST ), detail::blacs_type_char_v<T>,
+                  trapezoid_kind( uplo, diag ), sizeof(T), M, N, A, LDA );
+
+  }
+
+  /**
+   *  \brief Enqueue a general 2D tile managed by a C++ container.
+   *
+   *  @tparam Container Type of container which manages the memory of the buffer.
+   *                    Must have Container::data() -> pointer member function.
+   */
+  template <class Container>
+  std::enable_if_t< detail::has_data_member_v<Container> >
+    enqueue( const blacs_int M, const blacs_int N, const Container& A, 
+             const blacs_int LDA, const blacs_int RDEST, const blacs_int CDEST ) {
+
+    enqueue( M, N, A.data(), LDA, RDEST, CDEST );
+
+  }
+
+  /**
+   *  \brief Enqueue a buffer managed by a C++ container (as a column).
+   *
+   *  @tparam Container Type of container which manages the memory of the buffer.
+   *                    Must have Container::data() -> pointer member function and
+   *                    Container::size() -> std::size_t member function.
+   */
+  template <class Container>
+  std::enable_if_t< detail::has_size_member_v<Container> >
+    enqueue( const Container& A, const blacs_int RDEST, const blacs_int CDEST ) {
+
+    enqueue( A.size(), 1, A, A.size(), RDEST, CDEST );
+
+  }
+
+  /**
+   *  \brief Register the recieve buffer of the next general 2D tile from a source process.
+   *
+   *  The buffer must not be accessed until flush() has returned.
+   *
+   *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+   *
+   *  @param[in] M     (local) Number of rows of the buffer to recieve
+   *  @param[in] N     (local) Number of columns of the buffer to recieve
+   *  @param[in] A     (local) Pointer of buffer to store recieved data
+   *  @param[in] LDA   (local) Leading dimension of the buffer to store recieved data.
+   *  @param[in] RSRC  (local) Process row coordinate of source process
+   *  @param[in] CSRC  (local) Process column coordinate of source process
+   */
+  template <typename T>
+  detail::enable_if_blacs_native_t<T>
+    expect( const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+            const blacs_int RSRC, const blacs_int CSRC ) {
+
+    expect_tile( grid_->comm_rank( RSRC, CSRC ), detail::blacs_type_char_v<T>, 0,
+                 sizeof(T), M, N, A, LDA );
+
+  }
+
+  /**
+   *  \brief Register the recieve buffer of the next triangular 2D tile from a source process.
+   *
+   *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+   */
+  template <typename T>
+  detail::enable_if_blacs_native_t<T>
+    expect( const Triangle uplo, const Diagonal diag, const blacs_int M, 
+            const blacs_int N, T* A, const blacs_int LDA,
+            const blacs_int RSRC, const blacs_int CSRC ) {
+
+    expect_tile( grid_->comm_rank( RSRC, CSRC ), detail::blacs_type_char_v<T>,
+                 trapezoid_kind( uplo, diag ), sizeof(T), M, N, A, LDA );
+
+  }
+
+  /**
+   *  \brief Register a recieve buffer managed by a C++ container.
+   *
+   *  @tparam Container Type of container which manages the memory of the buffer.
+   *                    Must have Container::data() -> pointer member function.
+   */
+  template <class Container>
+  std::enable_if_t< detail::has_data_member_v<Container> >
+    expect( const blacs_int M, const blacs_int N, Container& A, 
+            const blacs_int LDA, const blacs_int RSRC, const blacs_int CSRC ) {
+
+    expect( M, N, A.data(), LDA, RSRC, CSRC );
+
+  }
+
+  /**
+   *  \brief Register a recieve buffer managed by a C++ container (as a column).
+   *
+   *  @tparam Container Type of container which manages the memory of the buffer.
+   *                    Must have Container::data() -> pointer member function and
+   *                    Container::size() -> std::size_t member function.
+   */
+  template <class Container>
+  std::enable_if_t< detail::has_size_member_v<Container> >
+    expect( Container& A, const blacs_int RSRC, const blacs_int CSRC ) {
+
+    expect( A.size(), 1, A, A.size(), RSRC, CSRC );
+
+  }
+
+  /**
+   *  \brief Exchange all enqueued / expected tiles.
+   *
+   *  Sends one message per destination and recieves one message per source,
+   *  then unpacks the recieved tiles. Throws std::runtime_error if a recieved
+   *  tile does not match its registered buffer. Leaves the batch empty.
+   */
+  void flush();
+
+  /**
+   *  \brief Check if the batch holds no enqueued or expected tiles.
+   */
+  bool empty() const noexcept;
+
+  /**
+   *  \brief Number of bytes enqueued for a destination process.
+   */
+  std::size_t pending_bytes( const blacs_int RDEST, const blacs_int CDEST ) const;
+
+};
+
+}
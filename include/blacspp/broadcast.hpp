@@ -6,14 +6,117 @@
  */
 #pragma once
 #include <blacspp/grid.hpp>
+#include <blacspp/compression.hpp>
+#include <blacspp/datatype.hpp>
+#include <blacspp/device.hpp>
+#include <blacspp/hierarchical.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/shared_memory.hpp>
 #include <blacspp/wrappers/broadcast.hpp>
+#include <blacspp/util/pack.hpp>
 #include <blacspp/util/type_conversions.hpp>
 
+#include <vector>
+
 
 
 // XXX: DOCUMENTATION INCORRECT!!!!!!!!!!!!!!!!!!!!!!
 namespace blacspp {
 
+namespace detail {
+
+  /**
+   *  \brief Process coordinate of the origin of a broadcast scope
+   *
+   *  (0,0) for Scope::All, (ipr,0) for Scope::Row and (0,ipc) for Scope::Column.
+   *  Used as the broadcast source when one is not specified.
+   *
+   *  @param[in] grid  BLACS grid which defined the communication context.
+   *  @param[in] scope Scope of the broadcast
+   *  @returns   Process coordinate of the origin of scope
+   */
+  inline process_coordinate scope_origin( const Grid& grid, const Scope scope ) {
+    if( scope == Row )         return { grid.ipr(), 0 };
+    else if( scope == Column ) return { 0, grid.ipc() };
+    else                       return { 0, 0 };
+  }
+
+  /**
+   *  \brief Broadcast a general 2D buffer through the transports of a grid
+   *
+   *  Compresses the payload if enabled, then broadcasts through the first enabled
+   *  transport (device, hierarchical collectives for Scope::All, shared memory,
+   *  derived datatypes), falling back to BLACS. Shared by gebs2d / gebr2d and
+   *  BroadcastPlan.
+   *
+   *  @param[in]     grid    BLACS grid which defined the communication context.
+   *  @param[in]     scope   Scope of the broadcast
+   *  @param[in]     top     Communication topology of the broadcast
+   *  @param[in]     is_root Whether this process is the root (sends A)
+   *  @param[in]     M       Number of rows of the buffer
+   *  @param[in]     N       Number of columns of the buffer
+   *  @param[in/out] A       Pointer of buffer to send (root) / to store recieved data
+   *  @param[in]     LDA     Leading dimension of the buffer
+   *  @param[in]     RSRC    Process row coordinate of the root
+   *  @param[in]     CSRC    Process column coordinate of the root
+   *  @param[in]     root    Rank of the root in Grid::comm()
+   *  @param[in]     ranks   Ranks of the scope excluding the root (see scope_ranks),
+   *                         computed on demand if nullptr
+   */
+  template <typename T>
+  void broadcast_2d( const Grid& grid, const Scope scope, const Topology top,
+    const bool is_root, const blacs_int M, const blacs_int N, T* A, 
+    const blacs_int LDA, const blacs_int RSRC, const blacs_int CSRC, 
+    const blacs_int root, const std::vector<blacs_int>* ranks = nullptr ) {
+
+    if constexpr ( compressible_v<T> )
+      if( auto* cmp = compression_for<T>( grid, M, N ) ) {
+        if( is_root ) {
+          const auto& wire = cmp->compress( M, N, A, LDA );
+          const blacs_int nw = wire.size();
+          return broadcast_2d( grid, scope, top, true, nw, 1, 
+            const_cast<blacs_int*>( wire.data() ), nw, RSRC, CSRC, root, ranks );
+        }
+        auto& wire = cmp->template reserve<T>( M, N );
+        const blacs_int nw = wire.size();
+        broadcast_2d( grid, scope, top, false, nw, 1, wire.data(), nw, RSRC, CSRC,
+                      root, ranks );
+        return cmp->expand( M, N, A, LDA );
+      }
+
+    BLACSPP_PROFILE( is_root ? "gebs2d" : "gebr2d", scope, top, blacs_type_char_v<T>,
+      std::size_t(M) * std::size_t(N) * sizeof(T) );
+
+    if( const auto& dev = grid.device_transport() )
+      return dev->broadcast( scope, is_root, mpi_data_type<T>::type(), sizeof(T),
+        M, N, A, LDA, RSRC, CSRC );
+
+    if( const auto& hier = grid.hierarchical() )
+      if( scope == All and hier->fits( M, N ) )
+        return hier->broadcast( mpi_data_type<T>::type(), sizeof(T), M, N, A, LDA,
+                                root );
+
+    if( const auto& shm = grid.shared_memory() ) {
+      std::vector<blacs_int> scope_r;
+      if( not ranks ) ranks = &( scope_r = scope_ranks( grid, scope, RSRC, CSRC ) );
+      if( is_root ? shm->broadcast_send( scope, *ranks, sizeof(T), M, N, A, LDA )
+                  : shm->broadcast_recv( scope, *ranks, root, sizeof(T), M, N, A, LDA ) )
+        return;
+    }
+
+    if( const auto& dtt = grid.datatype_transport() )
+      return dtt->broadcast( scope, general_key<T>( M, N, LDA ), 
+        mpi_data_type<T>::type(), A, RSRC, CSRC );
+
+    const auto SCOPE = type_string( scope );
+    const auto TOP   = type_string( top   );
+    if( is_root ) wrappers::gebs2d( grid.context(), SCOPE, TOP, M, N, A, LDA );
+    else wrappers::gebr2d( grid.context(), SCOPE, TOP, M, N, A, LDA, RSRC, CSRC );
+
+  }
+
+}
+
 
 /**
  *  \brief General 2D broadcast send.
@@ -32,13 +135,29 @@ namespace blacspp {
  *
  */
 template <typename T>
-detail::enable_if_blacs_supported_t<T>
+detail::enable_if_blacs_native_t<T>
   gebs2d( const Grid& grid, const Scope scope, const Topology top,
           const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA ) {
 
-  auto SCOPE = detail::type_string( scope );
-  auto TOP   = detail::type_string( top   );
-  wrappers::gebs2d( grid.context(), SCOPE.c_str(), TOP.c_str(), M, N, A, LDA );
+  detail::broadcast_2d( grid, scope, top, true, M, N, const_cast<T*>(A), LDA,
+    grid.ipr(), grid.ipc(), grid.comm_rank( grid.ipr(), grid.ipc() ) );
+
+}
+
+/**
+ *  \brief General 2D broadcast send of a reinterpreted type.
+ *
+ *  Broadcasts the buffer as a buffer of its transported type (see
+ *  reinterpreted_blacs_traits).
+ */
+template <typename T>
+detail::enable_if_blacs_reinterpreted_t<T>
+  gebs2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA ) {
+
+  using E = typename blacs_traits<T>::element_type;
+  gebs2d( grid, scope, top, detail::transported_extent<T>( M ), N, 
+          reinterpret_cast<const E*>( A ), detail::transported_extent<T>( LDA ) );
 
 }
 
@@ -120,17 +239,29 @@ std::enable_if_t< detail::has_size_member_v<Container> >
  *
  */
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+detail::enable_if_blacs_native_t<T> 
   trbs2d( const Grid& grid, const Scope scope, const Topology top,
           const Triangle uplo, const Diagonal diag,
           const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA ) {
 
-  auto SCOPE = detail::type_string( scope );
-  auto TOP   = detail::type_string( top   );
-  auto UPLO  = detail::type_string( uplo  );
-  auto DIAG  = detail::type_string( diag  );
+  const auto SCOPE = detail::type_string( scope );
+  const auto TOP   = detail::type_string( top   );
+
+  BLACSPP_PROFILE( "trbs2d", scope, top, detail::blacs_type_char_v<T>,
+    detail::trapezoid_size( uplo, diag, M, N ) * sizeof(T) );
 
-  wrappers::trbs2d( grid.context(), SCOPE.c_str(), TOP.c_str(), UPLO.c_str(), DIAG.c_str(), M, N, A, LDA );
+  const auto& hier = grid.hierarchical();
+  if( const auto& dtt = grid.datatype_transport(); dtt and not ( hier and scope == All ) )
+    return dtt->broadcast( scope, detail::trapezoid_key<T>( uplo, diag, M, N, LDA ), 
+      detail::mpi_data_type<T>::type(), const_cast<T*>(A), grid.ipr(), grid.ipc() );
+
+  // Packed by blacspp and sent as a contiguous vector (bypasses the packing of BLACS)
+  detail::packed_trapezoid<T> P( uplo, diag, M, N );
+  detail::pack_trapezoid( P.data(), sizeof(T), uplo, diag, M, N, A, LDA );
+  if( hier and scope == All )
+    return hier->broadcast( detail::mpi_data_type<T>::type(), sizeof(T), P.n, 1,
+      P.data(), P.ld(), grid.comm_rank( grid.ipr(), grid.ipc() ) );
+  wrappers::gebs2d( grid.context(), SCOPE, TOP, P.n, 1, P.data(), P.ld() );
 
 }
 
@@ -194,6 +325,53 @@ std::enable_if_t< detail::has_data_member_v<Container> >
  *  @param[in]     N     (local) Number of columns of the buffer to recieve
  *  @param[in/out] A     (local) Pointer of buffer to store recieved data
  *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcasting process
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcasting process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T> 
+  gebr2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) {
+
+  detail::broadcast_2d( grid, scope, top, false, M, N, A, LDA, RSRC, CSRC,
+    grid.comm_rank( RSRC, CSRC ) );
+
+}
+
+/**
+ *  \brief General 2D broadcast recieve of a reinterpreted type.
+ *
+ *  Recieves the buffer as a buffer of its transported type (see
+ *  reinterpreted_blacs_traits).
+ */
+template <typename T>
+detail::enable_if_blacs_reinterpreted_t<T>
+  gebr2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) {
+
+  using E = typename blacs_traits<T>::element_type;
+  gebr2d( grid, scope, top, detail::transported_extent<T>( M ), N, 
+          reinterpret_cast<E*>( A ), detail::transported_extent<T>( LDA ), RSRC, CSRC );
+
+}
+
+/**
+ *  \brief General point-to-point 2D recieve.
+ *
+ *  Performs a general (rectangular) point-to-point 2D recieve on a BLACS grid.
+ *  Recieves a 2D buffer (col-major) from the origin of the scope
+ *  (see detail::scope_origin).
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to store recieved data
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
  *
  */
 template <typename T>
@@ -201,9 +379,8 @@ detail::enable_if_blacs_supported_t<T>
   gebr2d( const Grid& grid, const Scope scope, const Topology top,
           const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) {
 
-  auto SCOPE = detail::type_string( scope );
-  auto TOP   = detail::type_string( top   );
-  wrappers::gebr2d( grid.context(), SCOPE.c_str(), TOP.c_str(), M, N, A, LDA );
+  const auto src = detail::scope_origin( grid, scope );
+  gebr2d( grid, scope, top, M, N, A, LDA, src.first, src.second );
 
 }
 
@@ -224,6 +401,37 @@ detail::enable_if_blacs_supported_t<T>
  *  @param[in]     N     (local) Number of columns of the buffer to recieve
  *  @param[in/out] A     (local) Recieve buffer (managed by some container)
  *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcasting process
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcasting process
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gebr2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) {
+
+  gebr2d( grid, scope, top, M, N, A.data(), LDA, RSRC, CSRC );
+
+}
+
+/**
+ *  \brief General point-to-point 2D recieve.
+ *
+ *  Performs a general (rectangular) point-to-point 2D recieve on a BLACS grid.
+ *  Recieves a 2D buffer (col-major) from the origin of the scope
+ *  (see detail::scope_origin).
+ *
+ *  Recieve buffer managed by C++ container
+ *
+ *  @tparam Container Type of container which manages the memory of the revieve buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Recieve buffer (managed by some container)
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
  *
  */
 template <class Container>
@@ -250,6 +458,34 @@ std::enable_if_t< detail::has_data_member_v<Container> >
  *
  *  @param[in]     grid  (local) BLACS grid which defined the communication context.
  *  @param[in/out] A     (local) Recieve buffer (managed by some container)
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcasting process
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcasting process
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gebr2d( const Grid& grid, const Scope scope, const Topology top, Container& A,
+          const blacs_int RSRC, const blacs_int CSRC ) { 
+
+  gebr2d( grid, scope, top, A.size(), 1, A, A.size(), RSRC, CSRC );
+
+}
+
+/**
+ *  \brief General point-to-point 2D recieve.
+ *
+ *  Performs a general (rectangular) point-to-point 2D recieve on a BLACS grid.
+ *  Recieves a 2D buffer (col-major) from the origin of the scope
+ *  (see detail::scope_origin).
+ *
+ *  Recieve buffer managed by C++ container. Size of buffer deduced from Container::size()
+ *
+ *  @tparam Container Type of container which manages the memory of the revieve buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in/out] A     (local) Recieve buffer (managed by some container)
  *
  */
 template <class Container>
@@ -277,20 +513,64 @@ std::enable_if_t< detail::has_size_member_v<Container> >
  *  @param[in]     N     (local) Number of columns of the buffer to recieve
  *  @param[in/out] A     (local) Pointer of buffer to store recieved data
  *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcasting process
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcasting process
  *
  */
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+detail::enable_if_blacs_native_t<T> 
   trbr2d( const Grid& grid, const Scope scope, const Topology top,
           const Triangle uplo, const Diagonal diag,
-          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) { 
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) { 
+
+  const auto SCOPE = detail::type_string( scope );
+  const auto TOP   = detail::type_string( top   );
+
+  BLACSPP_PROFILE( "trbr2d", scope, top, detail::blacs_type_char_v<T>,
+    detail::trapezoid_size( uplo, diag, M, N ) * sizeof(T) );
+
+  const auto& hier = grid.hierarchical();
+  if( const auto& dtt = grid.datatype_transport(); dtt and not ( hier and scope == All ) )
+    return dtt->broadcast( scope, detail::trapezoid_key<T>( uplo, diag, M, N, LDA ), 
+      detail::mpi_data_type<T>::type(), A, RSRC, CSRC );
+
+  detail::packed_trapezoid<T> P( uplo, diag, M, N );
+  if( hier and scope == All )
+    hier->broadcast( detail::mpi_data_type<T>::type(), sizeof(T), P.n, 1,
+      P.data(), P.ld(), grid.comm_rank( RSRC, CSRC ) );
+  else
+    wrappers::gebr2d( grid.context(), SCOPE, TOP, P.n, 1, P.data(), P.ld(), RSRC, CSRC );
+  detail::unpack_trapezoid( A, sizeof(T), uplo, diag, M, N, P.data(), LDA );
+
+}
 
-  auto SCOPE = detail::type_string( scope );
-  auto TOP   = detail::type_string( top   );
-  auto UPLO  = detail::type_string( uplo  );
-  auto DIAG  = detail::type_string( diag  );
+/**
+ *  \brief Triangular point-to-point 2D recieve.
+ *
+ *  Performs a triangular (upper/lower) point-to-point 2D recieve on a BLACS grid.
+ *  Recieves the specified triangular portin of a 2D buffer (col-major) from the
+ *  origin of the scope (see detail::scope_origin).
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     UPLO  (local) Which triangle of the buffer to recieve (upper/lower)
+ *  @param[in]     DIAG  (local) Whether to imply that the diagonal of the buffer is unit.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to store recieved data
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T> 
+  trbr2d( const Grid& grid, const Scope scope, const Topology top,
+          const Triangle uplo, const Diagonal diag,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) { 
 
-  wrappers::trbr2d( grid.context(), SCOPE.c_str(), TOP.c_str(), UPLO.c_str(), DIAG.c_str(), M, N, A, LDA );
+  const auto src = detail::scope_origin( grid, scope );
+  trbr2d( grid, scope, top, uplo, diag, M, N, A, LDA, src.first, src.second );
 
 }
 
@@ -313,6 +593,40 @@ detail::enable_if_blacs_supported_t<T>
  *  @param[in]     N     (local) Number of columns of the buffer to recieve
  *  @param[in/out] A     (local) Recieve buffer (managed by some container)
  *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcasting process
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcasting process
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  trbr2d( const Grid& grid, const Scope scope, const Topology top,
+          const Triangle uplo, const Diagonal diag,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) {
+
+  trbr2d( grid, scope, top, uplo, diag, M, N, A.data(), LDA, RSRC, CSRC );
+
+}
+
+/**
+ *  \brief Triangular point-to-point 2D recieve.
+ *
+ *  Performs a triangular (upper/lower) point-to-point 2D recieve on a BLACS grid.
+ *  Recieves the specified triangular portin of a 2D buffer (col-major) from the
+ *  origin of the scope (see detail::scope_origin).
+ *
+ *  Recieve buffer managed by C++ container
+ *
+ *  @tparam Container Type of container which manages the memory of the revieve buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     UPLO  (local) Which triangle of the buffer to recieve (upper/lower)
+ *  @param[in]     DIAG  (local) Whether to imply that the diagonal of the buffer is unit.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Recieve buffer (managed by some container)
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
  *
  */
 template <class Container>
@@ -326,4 +640,226 @@ std::enable_if_t< detail::has_data_member_v<Container> >
 }
 
 
+
+
+
+
+
+
+
+// Grid default topology
+
+/**
+ *  \brief General 2D broadcast send using the default broadcast topology of the grid.
+ *  @see gebs2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, const T*, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T>
+  gebs2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gebs2d( grid, scope, grid.broadcast_topology( scope, bytes ), M, N, A, LDA );
+
+}
+
+/**
+ *  \brief General 2D broadcast send using the default broadcast topology of the grid.
+ *  @see gebs2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, const Container&, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gebs2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, const Container& A, 
+          const blacs_int LDA ) {
+
+  gebs2d( grid, scope, M, N, A.data(), LDA );
+
+}
+
+/**
+ *  \brief General 2D broadcast send using the default broadcast topology of the grid.
+ *  @see gebs2d( const Grid&, const Scope, const Topology, const Container& )
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gebs2d( const Grid& grid, const Scope scope, const Container& A ) {
+
+  gebs2d( grid, scope, A.size(), 1, A, A.size() );
+
+}
+
+/**
+ *  \brief Triangular 2D broadcast send using the default broadcast topology of the grid.
+ *  @see trbs2d( const Grid&, const Scope, const Topology, const Triangle, const Diagonal, const blacs_int, const blacs_int, const T*, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T> 
+  trbs2d( const Grid& grid, const Scope scope, 
+          const Triangle uplo, const Diagonal diag,
+          const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  trbs2d( grid, scope, grid.broadcast_topology( scope, bytes ), uplo, diag, M, N, A, LDA );
+
+}
+
+/**
+ *  \brief Triangular 2D broadcast send using the default broadcast topology of the grid.
+ *  @see trbs2d( const Grid&, const Scope, const Topology, const Triangle, const Diagonal, const blacs_int, const blacs_int, const Container&, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  trbs2d( const Grid& grid, const Scope scope,
+          const Triangle uplo, const Diagonal diag,
+          const blacs_int M, const blacs_int N, const Container& A, 
+          const blacs_int LDA ) {
+
+  trbs2d( grid, scope, uplo, diag, M, N, A.data(), LDA );
+
+}
+
+/**
+ *  \brief General 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see gebr2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T> 
+  gebr2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gebr2d( grid, scope, grid.broadcast_topology( scope, bytes ), M, N, A, LDA, RSRC, CSRC );
+
+}
+
+/**
+ *  \brief General 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see gebr2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T> 
+  gebr2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gebr2d( grid, scope, grid.broadcast_topology( scope, bytes ), M, N, A, LDA );
+
+}
+
+/**
+ *  \brief General 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see gebr2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, Container&, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gebr2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) {
+
+  gebr2d( grid, scope, M, N, A.data(), LDA, RSRC, CSRC );
+
+}
+
+/**
+ *  \brief General 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see gebr2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, Container&, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gebr2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA ) {
+
+  gebr2d( grid, scope, M, N, A.data(), LDA );
+
+}
+
+/**
+ *  \brief General 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see gebr2d( const Grid&, const Scope, const Topology, Container&, const blacs_int, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gebr2d( const Grid& grid, const Scope scope, Container& A,
+          const blacs_int RSRC, const blacs_int CSRC ) { 
+
+  gebr2d( grid, scope, A.size(), 1, A, A.size(), RSRC, CSRC );
+
+}
+
+/**
+ *  \brief General 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see gebr2d( const Grid&, const Scope, const Topology, Container& )
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gebr2d( const Grid& grid, const Scope scope, Container& A ) { 
+
+  gebr2d( grid, scope, A.size(), 1, A, A.size() );
+
+}
+
+/**
+ *  \brief Triangular 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see trbr2d( const Grid&, const Scope, const Topology, const Triangle, const Diagonal, const blacs_int, const blacs_int, T*, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T> 
+  trbr2d( const Grid& grid, const Scope scope,
+          const Triangle uplo, const Diagonal diag,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) { 
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  trbr2d( grid, scope, grid.broadcast_topology( scope, bytes ), uplo, diag, M, N, A, LDA, 
+          RSRC, CSRC );
+
+}
+
+/**
+ *  \brief Triangular 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see trbr2d( const Grid&, const Scope, const Topology, const Triangle, const Diagonal, const blacs_int, const blacs_int, T*, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T> 
+  trbr2d( const Grid& grid, const Scope scope,
+          const Triangle uplo, const Diagonal diag,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) { 
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  trbr2d( grid, scope, grid.broadcast_topology( scope, bytes ), uplo, diag, M, N, A, LDA );
+
+}
+
+/**
+ *  \brief Triangular 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see trbr2d( const Grid&, const Scope, const Topology, const Triangle, const Diagonal, const blacs_int, const blacs_int, Container&, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  trbr2d( const Grid& grid, const Scope scope,
+          const Triangle uplo, const Diagonal diag,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) {
+
+  trbr2d( grid, scope, uplo, diag, M, N, A.data(), LDA, RSRC, CSRC );
+
+}
+
+/**
+ *  \brief Triangular 2D broadcast recieve using the default broadcast topology of the grid.
+ *  @see trbr2d( const Grid&, const Scope, const Topology, const Triangle, const Diagonal, const blacs_int, const blacs_int, Container&, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  trbr2d( const Grid& grid, const Scope scope,
+          const Triangle uplo, const Diagonal diag,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA ) {
+
+  trbr2d( grid, scope, uplo, diag, M, N, A.data(), LDA );
+
+}
+
+
 }
@@ -0,0 +1,190 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Parameters of a BufferPool
+ */
+struct buffer_pool_options {
+
+  std::size_t alignment  = 64;                    ///< Alignment of buffers (power of two)
+  std::size_t high_water = std::size_t(1) << 28;  ///< Cached bytes which trigger a release (0: none)
+  bool        huge_pages = false; ///< Advise transparent huge pages for large buffers
+  bool        mpi_memory = false; ///< Allocate with MPI_Alloc_mem (may be pre-registered for RDMA)
+
+};
+
+/**
+ *  \brief Counters of a BufferPool
+ */
+struct buffer_pool_stats {
+  std::size_t hits        = 0; ///< Requests served from cached buffers
+  std::size_t misses      = 0; ///< Requests which allocated a new buffer
+  std::size_t releases    = 0; ///< Releases of cached buffers (incl. high-water)
+  std::size_t in_use      = 0; ///< Bytes currently handed out
+  std::size_t cached      = 0; ///< Bytes currently cached for reuse
+  std::size_t peak        = 0; ///< Peak of in_use + cached
+};
+
+template <typename T>
+class pooled_buffer;
+
+/**
+ *  \brief A pool of reusable communication buffers for a BLACS grid.
+ *
+ *  Buffers are rounded up to power of two size classes and returned to a per 
+ *  class free list upon deallocation, such that steady-state communication does
+ *  not repeatedly allocate, page-fault (and register) fresh memory. When the
+ *  cached bytes exceed the high-water mark, or upon release(), cached buffers
+ *  are freed along with the internal buffers of BLACS (freebuff) on the grid.
+ *
+ *  The grid must outlive the pool, buffers must be returned prior to its 
+ *  destruction. Not thread safe.
+ */
+class BufferPool {
+
+  static constexpr std::size_t nclasses = 64;
+
+  const Grid*                               grid_;
+  buffer_pool_options                       opts_;
+  std::array< std::vector<void*>, nclasses > free_; ///< Cached buffers per size class
+  buffer_pool_stats                         stats_;
+
+  std::size_t size_class( std::size_t bytes ) const noexcept;
+  void*       allocate_class( std::size_t cls );
+  void        free_buffer( void* ptr ) noexcept;
+
+public:
+
+  /**
+   *  \brief Construct an empty pool.
+   *
+   *  @param[in] grid BLACS grid whose (BLACS) buffers are managed by the pool
+   *  @param[in] opts Parameters of the pool
+   */
+  explicit BufferPool( const Grid& grid, 
+                       const buffer_pool_options& opts = buffer_pool_options() );
+
+  BufferPool( const BufferPool& ) = delete;
+  BufferPool& operator=( const BufferPool& ) = delete;
+
+  /**
+   *  \brief Destroy the pool, freeing all cached buffers.
+   */
+  ~BufferPool() noexcept;
+
+  /**
+   *  \brief Obtain a buffer of at least bytes bytes.
+   *
+   *  @param[in] bytes Requested size in bytes
+   *  @returns   Pointer to an aligned buffer (nullptr if bytes == 0)
+   */
+  void* allocate( std::size_t bytes );
+
+  /**
+   *  \brief Return a buffer obtained from allocate to the pool.
+   *
+   *  @param[in] ptr   Pointer returned by allocate
+   *  @param[in] bytes Size passed to allocate
+   */
+  void deallocate( void* ptr, std::size_t bytes ) noexcept;
+
+  /**
+   *  \brief Obtain a typed buffer of n elements (returned to the pool upon destruction).
+   *
+   *  The elements are not initialized. T must be trivially copyable.
+   */
+  template <typename T>
+  pooled_buffer<T> acquire( std::size_t n ) {
+    return pooled_buffer<T>( *this, n );
+  }
+
+  /**
+   *  \brief Free all cached buffers and the internal buffers of BLACS on the grid.
+   *
+   *  @param[in] wait Whether BLACS should wait on non-blocking operations
+   *                  which use its buffers (Cblacs_freebuff WAIT)
+   */
+  void release( bool wait = true ) noexcept;
+
+  inline const buffer_pool_stats&   stats()   const noexcept { return stats_; }
+  inline const buffer_pool_options& options() const noexcept { return opts_;  }
+
+};
+
+/**
+ *  \brief A typed buffer obtained from a BufferPool.
+ *
+ *  Models Container (data() / size()) such that it may be directly passed to 
+ *  the container interfaces of the communication routines. Movable but not 
+ *  copyable, returns its memory to the pool upon destruction.
+ *
+ *  @tparam T Type of the elements of the buffer
+ */
+template <typename T>
+class pooled_buffer {
+
+  BufferPool* pool_ = nullptr;
+  T*          data_ = nullptr;
+  std::size_t size_ = 0;
+
+public:
+
+  using value_type = T;
+
+  pooled_buffer() noexcept = default;
+
+  pooled_buffer( BufferPool& pool, std::size_t n ) :
+    pool_( &pool ), data_( static_cast<T*>( pool.allocate( n * sizeof(T) ) ) ),
+    size_( n ) { }
+
+  pooled_buffer( const pooled_buffer& ) = delete;
+  pooled_buffer& operator=( const pooled_buffer& ) = delete;
+
+  pooled_buffer( pooled_buffer&& other ) noexcept :
+    pool_( other.pool_ ), data_( std::exchange( other.data_, nullptr ) ),
+    size_( std::exchange( other.size_, 0 ) ) { }
+
+  pooled_buffer& operator=( pooled_buffer&& other ) noexcept {
+    if( this != &other ) {
+      reset();
+      pool_ = other.pool_;
+      data_ = std::exchange( other.data_, nullptr );
+      size_ = std::exchange( other.size_, 0 );
+    }
+    return *this;
+  }
+
+  ~pooled_buffer() noexcept { reset(); }
+
+  /**
+   *  \brief Return the memory to the pool and leave the buffer empty.
+   */
+  void reset() noexcept {
+    if( data_ ) pool_->deallocate( data_, size_ * sizeof(T) );
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  inline T*          data()  const noexcept { return data_; }
+  inline std::size_t size()  const noexcept { return size_; }
+  inline T*          begin() const noexcept { return data_; }
+  inline T*          end()   const noexcept { return data_ + size_; }
+
+  inline T& operator[]( std::size_t i ) const noexcept { return data_[i]; }
+
+};
+
+}
@@ -0,0 +1,1001 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/hierarchical.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/wrappers/combine.hpp>
+#include <blacspp/util/type_conversions.hpp>
+
+namespace blacspp {
+
+/**
+ *  \brief The result of a max/min combine on a single element.
+ *
+ *  @tparam T Type of the combined value. Must be BLACS enabled.
+ */
+template <typename T>
+struct located_value {
+  T                  value;      ///< Max/min value over the combine scope
+  process_coordinate coordinate; ///< Process coordinate which owned value
+};
+
+
+
+
+
+/**
+ *  \brief General 2D element-wise sum.
+ *
+ *  Performs an element-wise sum of a 2D buffer (col-major) over the processes
+ *  in the specified scope of a BLACS grid. The result overwrites A on the
+ *  destination process. If RDEST == -1, the result is stored on all 
+ *  processes in the scope.
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Pointer of buffer to combine
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gsum2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  BLACSPP_PROFILE( "gsum2d", scope, top, detail::blacs_type_char_v<T>,
+    std::size_t(M) * std::size_t(N) * sizeof(T) );
+
+  if( const auto& hier = grid.hierarchical() )
+    if( scope == All and hier->fits( M, N ) )
+      return hier->sum( detail::mpi_data_type<T>::type(), sizeof(T), M, N, A, LDA,
+        RDEST == -1 ? -1 : grid.comm_rank( RDEST, CDEST ) );
+
+  const auto SCOPE = detail::type_string( scope );
+  const auto TOP   = detail::type_string( top   );
+  wrappers::gsum2d( grid.context(), SCOPE, TOP, M, N, A, LDA, 
+                    RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum (all-reduce).
+ *
+ *  Result is stored on all processes in the scope (RDEST = -1).
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Pointer of buffer to combine
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gsum2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) {
+
+  gsum2d( grid, scope, top, M, N, A, LDA, -1, -1 );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum.
+ *
+ *  Combine buffer managed by C++ container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gsum2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gsum2d( grid, scope, top, M, N, A.data(), LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum (all-reduce).
+ *
+ *  Combine buffer managed by C++ container, result is stored on all processes
+ *  in the scope.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gsum2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA ) {
+
+  gsum2d( grid, scope, top, M, N, A.data(), LDA );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum.
+ *
+ *  Combine buffer managed by C++ container. Size of buffer deduced from 
+ *  Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gsum2d( const Grid& grid, const Scope scope, const Topology top,
+          Container& A, const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gsum2d( grid, scope, top, A.size(), 1, A, A.size(), RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum (all-reduce).
+ *
+ *  Combine buffer managed by C++ container, result is stored on all processes
+ *  in the scope. Size of buffer deduced from Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gsum2d( const Grid& grid, const Scope scope, const Topology top, Container& A ) {
+
+  gsum2d( grid, scope, top, A.size(), 1, A, A.size() );
+
+}
+
+
+
+
+
+
+/**
+ *  \brief General 2D element-wise absolute maximum.
+ *
+ *  Determines the element-wise absolute maximum of a 2D buffer (col-major) over 
+ *  the processes in the specified scope of a BLACS grid. The result overwrites 
+ *  A on the destination process. If RDEST == -1, the result is stored on all 
+ *  processes in the scope.
+ *
+ *  The process coordinates which owned each element of the result are
+ *  stored in (RA,CA) on the destination process(es).
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Pointer of buffer to combine
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *  @param[out]    RA    (local) Process row coordinates of each result element
+ *  @param[out]    CA    (local) Process column coordinates of each result element
+ *  @param[in]     LDIA  (local) Leading dimension of RA and CA
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamx2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          blacs_int* RA, blacs_int* CA, const blacs_int LDIA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  BLACSPP_PROFILE( "gamx2d", scope, top, detail::blacs_type_char_v<T>,
+    std::size_t(M) * std::size_t(N) * sizeof(T) );
+
+  const auto SCOPE = detail::type_string( scope );
+  const auto TOP   = detail::type_string( top   );
+  wrappers::gamx2d( grid.context(), SCOPE, TOP, M, N, A, LDA, 
+                    RA, CA, LDIA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum.
+ *
+ *  Process coordinates of the result are not computed (RCFLAG = -1).
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Pointer of buffer to combine
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamx2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamx2d( grid, scope, top, M, N, A, LDA, nullptr, nullptr, -1, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum (all-reduce).
+ *
+ *  Result is stored on all processes in the scope (RDEST = -1). Process
+ *  coordinates of the result are not computed.
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Pointer of buffer to combine
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamx2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) {
+
+  gamx2d( grid, scope, top, M, N, A, LDA, -1, -1 );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum.
+ *
+ *  Combine buffer managed by C++ container. Process coordinates of the
+ *  result are not computed.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gamx2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamx2d( grid, scope, top, M, N, A.data(), LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum (all-reduce).
+ *
+ *  Combine buffer managed by C++ container, result is stored on all processes
+ *  in the scope.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gamx2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA ) {
+
+  gamx2d( grid, scope, top, M, N, A.data(), LDA );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum.
+ *
+ *  Combine buffer managed by C++ container. Size of buffer deduced from 
+ *  Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gamx2d( const Grid& grid, const Scope scope, const Topology top,
+          Container& A, const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamx2d( grid, scope, top, A.size(), 1, A, A.size(), RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum (all-reduce).
+ *
+ *  Combine buffer managed by C++ container, result is stored on all processes
+ *  in the scope. Size of buffer deduced from Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gamx2d( const Grid& grid, const Scope scope, const Topology top, Container& A ) {
+
+  gamx2d( grid, scope, top, A.size(), 1, A, A.size() );
+
+}
+
+/**
+ *  \brief Scalar absolute maximum with process location.
+ *
+ *  Determines the absolute maximum of a scalar over the processes in the 
+ *  specified scope of a BLACS grid along with the process coordinate
+ *  which owned it. The result is only valid on the destination process. 
+ *  If RDEST == -1, the result is valid on all processes in the scope.
+ *
+ *  @tparam T Type of value to combine. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Processes which participate in the combine
+ *  @param[in] top   (local) Communication topology of the combine
+ *  @param[in] value (local) Value to combine
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *  @returns   Maximum value over the scope and its owning process coordinate
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, located_value<T>>
+  gamx2d_loc( const Grid& grid, const Scope scope, const Topology top,
+              const T value, const blacs_int RDEST = -1, 
+              const blacs_int CDEST = -1 ) {
+
+  located_value<T> res{ value, { -1, -1 } };
+  gamx2d( grid, scope, top, 1, 1, &res.value, 1, &res.coordinate.first,
+          &res.coordinate.second, 1, RDEST, CDEST );
+  return res;
+
+}
+
+
+
+
+
+/**
+ *  \brief General 2D element-wise absolute minimum.
+ *
+ *  Determines the element-wise absolute minimum of a 2D buffer (col-major) over 
+ *  the processes in the specified scope of a BLACS grid. The result overwrites 
+ *  A on the destination process. If RDEST == -1, the result is stored on all 
+ *  processes in the scope.
+ *
+ *  The process coordinates which owned each element of the result are
+ *  stored in (RA,CA) on the destination process(es).
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Pointer of buffer to combine
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *  @param[out]    RA    (local) Process row coordinates of each result element
+ *  @param[out]    CA    (local) Process column coordinates of each result element
+ *  @param[in]     LDIA  (local) Leading dimension of RA and CA
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamn2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          blacs_int* RA, blacs_int* CA, const blacs_int LDIA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  BLACSPP_PROFILE( "gamn2d", scope, top, detail::blacs_type_char_v<T>,
+    std::size_t(M) * std::size_t(N) * sizeof(T) );
+
+  const auto SCOPE = detail::type_string( scope );
+  const auto TOP   = detail::type_string( top   );
+  wrappers::gamn2d( grid.context(), SCOPE, TOP, M, N, A, LDA, 
+                    RA, CA, LDIA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum.
+ *
+ *  Process coordinates of the result are not computed (RCFLAG = -1).
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Pointer of buffer to combine
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamn2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamn2d( grid, scope, top, M, N, A, LDA, nullptr, nullptr, -1, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum (all-reduce).
+ *
+ *  Result is stored on all processes in the scope (RDEST = -1). Process
+ *  coordinates of the result are not computed.
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Pointer of buffer to combine
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamn2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) {
+
+  gamn2d( grid, scope, top, M, N, A, LDA, -1, -1 );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum.
+ *
+ *  Combine buffer managed by C++ container. Process coordinates of the
+ *  result are not computed.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gamn2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamn2d( grid, scope, top, M, N, A.data(), LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum (all-reduce).
+ *
+ *  Combine buffer managed by C++ container, result is stored on all processes
+ *  in the scope.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in]     M     (local) Number of rows of the buffer to combine
+ *  @param[in]     N     (local) Number of columns of the buffer to combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to combine
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gamn2d( const Grid& grid, const Scope scope, const Topology top,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA ) {
+
+  gamn2d( grid, scope, top, M, N, A.data(), LDA );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum.
+ *
+ *  Combine buffer managed by C++ container. Size of buffer deduced from 
+ *  Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *  @param[in]     RDEST (local) Process row coordinate of destination process
+ *  @param[in]     CDEST (local) Process column coordinate of desination process
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gamn2d( const Grid& grid, const Scope scope, const Topology top,
+          Container& A, const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamn2d( grid, scope, top, A.size(), 1, A, A.size(), RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum (all-reduce).
+ *
+ *  Combine buffer managed by C++ container, result is stored on all processes
+ *  in the scope. Size of buffer deduced from Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the combine
+ *  @param[in]     top   (local) Communication topology of the combine
+ *  @param[in/out] A     (local) Buffer to combine (managed by some container)
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gamn2d( const Grid& grid, const Scope scope, const Topology top, Container& A ) {
+
+  gamn2d( grid, scope, top, A.size(), 1, A, A.size() );
+
+}
+
+/**
+ *  \brief Scalar absolute minimum with process location.
+ *
+ *  Determines the absolute minimum of a scalar over the processes in the 
+ *  specified scope of a BLACS grid along with the process coordinate
+ *  which owned it. The result is only valid on the destination process. 
+ *  If RDEST == -1, the result is valid on all processes in the scope.
+ *
+ *  @tparam T Type of value to combine. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Processes which participate in the combine
+ *  @param[in] top   (local) Communication topology of the combine
+ *  @param[in] value (local) Value to combine
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *  @returns   Minimum value over the scope and its owning process coordinate
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, located_value<T>>
+  gamn2d_loc( const Grid& grid, const Scope scope, const Topology top,
+              const T value, const blacs_int RDEST = -1, 
+              const blacs_int CDEST = -1 ) {
+
+  located_value<T> res{ value, { -1, -1 } };
+  gamn2d( grid, scope, top, 1, 1, &res.value, 1, &res.coordinate.first,
+          &res.coordinate.second, 1, RDEST, CDEST );
+  return res;
+
+}
+
+
+
+
+// Grid default topology
+
+
+/**
+ *  \brief General 2D element-wise sum using the default combine topology of the grid.
+ *  @see gsum2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gsum2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gsum2d( grid, scope, grid.combine_topology( scope, bytes ), M, N, A, LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum (all-reduce) using the default combine topology of the grid.
+ *  @see gsum2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gsum2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gsum2d( grid, scope, grid.combine_topology( scope, bytes ), M, N, A, LDA );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum using the default combine topology of the grid.
+ *  @see gsum2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, Container&, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gsum2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gsum2d( grid, scope, M, N, A.data(), LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum (all-reduce) using the default combine topology of the grid.
+ *  @see gsum2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, Container&, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gsum2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA ) {
+
+  gsum2d( grid, scope, M, N, A.data(), LDA );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum using the default combine topology of the grid.
+ *  @see gsum2d( const Grid&, const Scope, const Topology, Container&, const blacs_int, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gsum2d( const Grid& grid, const Scope scope,
+          Container& A, const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gsum2d( grid, scope, A.size(), 1, A, A.size(), RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise sum (all-reduce) using the default combine topology of the grid.
+ *  @see gsum2d( const Grid&, const Scope, const Topology, Container& )
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gsum2d( const Grid& grid, const Scope scope, Container& A ) {
+
+  gsum2d( grid, scope, A.size(), 1, A, A.size() );
+
+}
+
+
+/**
+ *  \brief General 2D element-wise absolute maximum using the default combine topology of the grid.
+ *  @see gamx2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamx2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gamx2d( grid, scope, grid.combine_topology( scope, bytes ), M, N, A, LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum (all-reduce) using the default combine topology of the grid.
+ *  @see gamx2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamx2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gamx2d( grid, scope, grid.combine_topology( scope, bytes ), M, N, A, LDA );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum using the default combine topology of the grid.
+ *  @see gamx2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, Container&, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gamx2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamx2d( grid, scope, M, N, A.data(), LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum (all-reduce) using the default combine topology of the grid.
+ *  @see gamx2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, Container&, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gamx2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA ) {
+
+  gamx2d( grid, scope, M, N, A.data(), LDA );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum using the default combine topology of the grid.
+ *  @see gamx2d( const Grid&, const Scope, const Topology, Container&, const blacs_int, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gamx2d( const Grid& grid, const Scope scope,
+          Container& A, const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamx2d( grid, scope, A.size(), 1, A, A.size(), RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum (all-reduce) using the default combine topology of the grid.
+ *  @see gamx2d( const Grid&, const Scope, const Topology, Container& )
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gamx2d( const Grid& grid, const Scope scope, Container& A ) {
+
+  gamx2d( grid, scope, A.size(), 1, A, A.size() );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute maximum using the default combine topology of the grid.
+ *  @see gamx2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int, blacs_int*, blacs_int*, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamx2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          blacs_int* RA, blacs_int* CA, const blacs_int LDIA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gamx2d( grid, scope, grid.combine_topology( scope, bytes ), M, N, A, LDA, RA, CA, LDIA, 
+          RDEST, CDEST );
+
+}
+
+/**
+ *  \brief Scalar absolute maximum with process location using the default combine topology of the grid.
+ *  @see gamx2d_loc( const Grid&, const Scope, const Topology, const T, const blacs_int, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, located_value<T>>
+  gamx2d_loc( const Grid& grid, const Scope scope, const T value, 
+              const blacs_int RDEST = -1, const blacs_int CDEST = -1 ) {
+
+  return gamx2d_loc( grid, scope, grid.combine_topology( scope, sizeof(T) ), value, RDEST, CDEST );
+
+}
+
+
+/**
+ *  \brief General 2D element-wise absolute minimum using the default combine topology of the grid.
+ *  @see gamn2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamn2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gamn2d( grid, scope, grid.combine_topology( scope, bytes ), M, N, A, LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum (all-reduce) using the default combine topology of the grid.
+ *  @see gamn2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamn2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gamn2d( grid, scope, grid.combine_topology( scope, bytes ), M, N, A, LDA );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum using the default combine topology of the grid.
+ *  @see gamn2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, Container&, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gamn2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamn2d( grid, scope, M, N, A.data(), LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum (all-reduce) using the default combine topology of the grid.
+ *  @see gamn2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, Container&, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container> >
+  gamn2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, Container& A, const blacs_int LDA ) {
+
+  gamn2d( grid, scope, M, N, A.data(), LDA );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum using the default combine topology of the grid.
+ *  @see gamn2d( const Grid&, const Scope, const Topology, Container&, const blacs_int, const blacs_int )
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gamn2d( const Grid& grid, const Scope scope,
+          Container& A, const blacs_int RDEST, const blacs_int CDEST ) {
+
+  gamn2d( grid, scope, A.size(), 1, A, A.size(), RDEST, CDEST );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum (all-reduce) using the default combine topology of the grid.
+ *  @see gamn2d( const Grid&, const Scope, const Topology, Container& )
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  gamn2d( const Grid& grid, const Scope scope, Container& A ) {
+
+  gamn2d( grid, scope, A.size(), 1, A, A.size() );
+
+}
+
+/**
+ *  \brief General 2D element-wise absolute minimum using the default combine topology of the grid.
+ *  @see gamn2d( const Grid&, const Scope, const Topology, const blacs_int, const blacs_int, T*, const blacs_int, blacs_int*, blacs_int*, const blacs_int, const blacs_int, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gamn2d( const Grid& grid, const Scope scope,
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          blacs_int* RA, blacs_int* CA, const blacs_int LDIA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  gamn2d( grid, scope, grid.combine_topology( scope, bytes ), M, N, A, LDA, RA, CA, LDIA, 
+          RDEST, CDEST );
+
+}
+
+/**
+ *  \brief Scalar absolute minimum with process location using the default combine topology of the grid.
+ *  @see gamn2d_loc( const Grid&, const Scope, const Topology, const T, const blacs_int, const blacs_int )
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, located_value<T>>
+  gamn2d_loc( const Grid& grid, const Scope scope, const T value, 
+              const blacs_int RDEST = -1, const blacs_int CDEST = -1 ) {
+
+  return gamn2d_loc( grid, scope, grid.combine_topology( scope, sizeof(T) ), value, RDEST, CDEST );
+
+}
+
+}
@@ -0,0 +1,156 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace blacspp {
+
+/// Precision of compressed (double / dcomplex) payloads on the wire
+enum class WirePrecision {
+  Float,   ///< IEEE single precision (half the bytes)
+  BFloat16 ///< bfloat16, 8 exponent / 7 mantissa bits (a quarter of the bytes)
+};
+
+/// Treatment of values which are not representable in the wire precision
+enum class WireErrorPolicy {
+  Nearest, ///< Round to nearest (even), values beyond the range become +-Inf
+  Saturate ///< Round to nearest (even), finite values beyond the range are clamped to +-max
+};
+
+/**
+ *  \brief Parameters of the compressed transfer mode of a grid
+ */
+struct compression_options {
+  WirePrecision   precision = WirePrecision::Float;
+  WireErrorPolicy policy    = WireErrorPolicy::Nearest;
+  std::size_t     min_bytes = std::size_t(1) << 15; ///< Smaller payloads are sent in full precision
+};
+
+/**
+ *  \brief Counters of the compressed transfer mode of a grid
+ */
+struct compression_stats {
+  std::size_t compressed = 0; ///< Payloads sent / recieved in the wire precision
+  std::size_t bytes      = 0; ///< Bytes of these payloads in full precision
+  std::size_t wire_bytes = 0; ///< Bytes of these payloads on the wire
+};
+
+namespace detail {
+
+  /// Whether payloads of type T may be compressed (double, dcomplex)
+  template <typename T>
+  inline constexpr bool compressible_v = std::is_same_v<T, double> or
+                                         std::is_same_v<T, dcomplex>;
+
+  /**
+   *  \brief Number of 32-bit wire words of n values in the wire precision
+   */
+  std::size_t wire_words( WirePrecision precision, std::size_t n ) noexcept;
+
+  /**
+   *  \brief Convert a col-major (M,N,LDA) buffer of doubles into contiguous wire words
+   *
+   *  @param[out] dst Wire words (wire_words( precision, M*N ))
+   */
+  void compress_2d( WirePrecision precision, WireErrorPolicy policy, blacs_int M,
+                    blacs_int N, const double* A, blacs_int LDA, blacs_int* dst ) noexcept;
+
+  /**
+   *  \brief Expand contiguous wire words into a col-major (M,N,LDA) buffer of doubles
+   */
+  void expand_2d( WirePrecision precision, blacs_int M, blacs_int N,
+                  const blacs_int* src, double* A, blacs_int LDA ) noexcept;
+
+  /**
+   *  \brief Converts double / dcomplex payloads to and from a reduced wire precision
+   *
+   *  Payloads are converted into a contiguous scratch buffer of 32-bit words
+   *  (bfloat16 values are packed in pairs), which is transferred as blacs_int
+   *  such that the bit patterns are preserved by every transport. dcomplex
+   *  payloads are treated as doubles with twice the number of rows.
+   */
+  class compression_transport {
+
+    compression_options      opts_;
+    std::vector< blacs_int > wire_; ///< Scratch buffer of the wire words
+    compression_stats        stats_;
+
+  public:
+
+    explicit compression_transport( const compression_options& opts ) noexcept :
+      opts_( opts ) { }
+
+    inline const compression_options& options() const noexcept { return opts_; }
+    inline const compression_stats&   stats()   const noexcept { return stats_; }
+
+    /**
+     *  \brief Whether a payload of a given size is compressed
+     */
+    inline bool applies( std::size_t bytes ) const noexcept {
+      return bytes >= opts_.min_bytes;
+    }
+
+    /**
+     *  \brief Compress a (M,N,LDA) buffer of doubles
+     *
+     *  @returns Wire words, valid until the next operation of the transport
+     */
+    const std::vector< blacs_int >& compress( blacs_int M, blacs_int N,
+      const double* A, blacs_int LDA );
+
+    /**
+     *  \brief Reserve the wire words of a (M,N) payload of doubles for a recieve
+     */
+    std::vector< blacs_int >& reserve( blacs_int M, blacs_int N );
+
+    /**
+     *  \brief Expand the recieved wire words into a (M,N,LDA) buffer of doubles
+     */
+    void expand( blacs_int M, blacs_int N, double* A, blacs_int LDA );
+
+    inline const std::vector< blacs_int >& compress( blacs_int M, blacs_int N,
+      const dcomplex* A, blacs_int LDA ) {
+      return compress( 2*M, N, reinterpret_cast<const double*>(A), 2*LDA );
+    }
+
+    inline void expand( blacs_int M, blacs_int N, dcomplex* A, blacs_int LDA ) {
+      expand( 2*M, N, reinterpret_cast<double*>(A), 2*LDA );
+    }
+
+    /**
+     *  \brief Reserve the wire words of a (M,N) payload of type T for a recieve
+     */
+    template <typename T>
+    std::vector< blacs_int >& reserve( blacs_int M, blacs_int N ) {
+      return reserve( std::is_same_v<T, dcomplex> ? 2*M : M, N );
+    }
+
+  };
+
+  /**
+   *  \brief Compression transport of a grid for a payload of type T (nullptr if
+   *  the payload is sent in full precision)
+   */
+  template <typename T>
+  inline compression_transport* compression_for( const Grid& grid, blacs_int M,
+    blacs_int N ) noexcept {
+    if constexpr ( compressible_v<T> ) {
+      const auto& cmp = grid.compression();
+      if( cmp and not grid.device_transport() and
+          cmp->applies( std::size_t(M) * std::size_t(N) * sizeof(T) ) )
+        return cmp.get();
+    }
+    return nullptr;
+  }
+
+}
+
+}
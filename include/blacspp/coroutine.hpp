@@ -0,0 +1,380 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "blacspp/coroutine.hpp requires C++20 coroutines"
+#endif
+
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/progress.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ *  Awaitable (C++20 coroutine) and sender interfaces of the non-blocking
+ *  operations. Optional, the blacspp target itself only requires C++17.
+ *
+ *  Operations are advanced by the progress engine of their grid (see
+ *  Grid::enable_progress), which resumes the awaiting coroutine once the
+ *  operation has completed. Thousands of outstanding transfers may thus be
+ *  expressed as (lightweight) coroutines, e.g.
+ *
+ *    blacspp::Task<> recieve_tile( const blacspp::Grid& grid, double* A, ... ) {
+ *      co_await blacspp::async_gebr2d( grid, blacspp::Scope::Row, M, N, A, LDA, 0, 0 );
+ *      ...
+ *    }
+ *
+ *    blacspp::sync_wait( *grid.progress(), tasks );
+ */
+
+namespace blacspp {
+
+/// Default MPI tag of the asynchronous broadcasts
+inline constexpr int async_broadcast_tag = 2645;
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+  /// Promise state shared by all Task types
+  struct task_promise_base {
+
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr      error;
+    std::atomic<bool>       finished{false}; ///< Set once the coroutine is done
+
+    struct final_awaiter {
+      bool await_ready() const noexcept { return false; }
+      template <class Promise>
+      std::coroutine_handle<> await_suspend( std::coroutine_handle<Promise> h ) noexcept {
+        auto& p = h.promise();
+        auto  c = p.continuation;
+        p.finished.store( true, std::memory_order_release );
+        return c;
+      }
+      void await_resume() const noexcept { }
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    final_awaiter       final_suspend()   const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+
+  };
+
+  template <typename T>
+  struct task_promise : task_promise_base {
+
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value( U&& v ) { value.emplace( std::forward<U>(v) ); }
+
+    T result() {
+      if( error ) std::rethrow_exception( error );
+      return std::move( *value );
+    }
+
+  };
+
+  template <>
+  struct task_promise<void> : task_promise_base {
+
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept { }
+
+    void result() {
+      if( error ) std::rethrow_exception( error );
+    }
+
+  };
+
+  /// Progress engine of a grid, throws if none has been enabled
+  inline ProgressEngine& progress_engine( const Grid& grid ) {
+    if( not grid.progress() ) throw std::runtime_error("Progress Engine Not Enabled");
+    return *grid.progress();
+  }
+
+}
+
+/**
+ *  \brief A lazily started coroutine which may be awaited by other coroutines.
+ *
+ *  Awaiting a task starts it and resumes the awaiting coroutine once the task
+ *  has completed (yielding its value or rethrowing its exception). Top-level
+ *  tasks are run with sync_wait. Movable but not copyable.
+ *
+ *  @tparam T Type of the value of the task
+ */
+template <typename T>
+class Task {
+
+public:
+
+  using promise_type = detail::task_promise<T>;
+  using handle_type  = std::coroutine_handle<promise_type>;
+
+private:
+
+  handle_type h_;
+
+public:
+
+  explicit Task( handle_type h ) noexcept : h_( h ) { }
+
+  Task( const Task& ) = delete;
+  Task& operator=( const Task& ) = delete;
+
+  Task( Task&& other ) noexcept : h_( std::exchange( other.h_, nullptr ) ) { }
+  Task& operator=( Task&& other ) noexcept {
+    if( this != &other ) {
+      if( h_ ) h_.destroy();
+      h_ = std::exchange( other.h_, nullptr );
+    }
+    return *this;
+  }
+
+  ~Task() noexcept { if( h_ ) h_.destroy(); }
+
+  /**
+   *  \brief Start a top-level task (runs until its first suspension).
+   */
+  void start() { h_.resume(); }
+
+  /**
+   *  \brief Whether the task has completed (thread safe)
+   */
+  bool done() const noexcept {
+    return not h_ or h_.promise().finished.load( std::memory_order_acquire );
+  }
+
+  /**
+   *  \brief Value of a completed task (rethrows its exception)
+   */
+  T result() { return h_.promise().result(); }
+
+  bool await_ready() const noexcept { return false; }
+
+  std::coroutine_handle<> await_suspend( std::coroutine_handle<> c ) noexcept {
+    h_.promise().continuation = c;
+    return h_;
+  }
+
+  T await_resume() { return result(); }
+
+};
+
+namespace detail {
+
+  template <typename T>
+  Task<T> task_promise<T>::get_return_object() noexcept {
+    return Task<T>( std::coroutine_handle< task_promise<T> >::from_promise( *this ) );
+  }
+
+  inline Task<void> task_promise<void>::get_return_object() noexcept {
+    return Task<void>( std::coroutine_handle< task_promise<void> >::from_promise( *this ) );
+  }
+
+}
+
+template <class Receiver>
+class async_operation_state;
+
+/**
+ *  \brief An outstanding set of non-blocking transfers.
+ *
+ *  Awaitable: suspends the awaiting coroutine until all transfers have
+ *  completed, the coroutine is resumed by the thread which polls the progress
+ *  engine. Also a (minimal) sender in the style of std::execution: connect()
+ *  a receiver with set_value() and set_error( std::exception_ptr ) and start()
+ *  the resulting operation state.
+ */
+class AsyncOperation {
+
+  template <class Receiver>
+  friend class async_operation_state;
+
+  ProgressEngine*        engine_;
+  std::vector< Request > reqs_;
+
+public:
+
+  AsyncOperation( ProgressEngine& engine, std::vector< Request > reqs ) noexcept :
+    engine_( &engine ), reqs_( std::move(reqs) ) { }
+
+  AsyncOperation( ProgressEngine& engine, Request&& req ) : engine_( &engine ) {
+    reqs_.emplace_back( std::move(req) );
+  }
+
+  bool await_ready() { return test_all( reqs_ ); }
+
+  void await_suspend( std::coroutine_handle<> h ) {
+    engine_->submit( [this]() { return test_all( reqs_ ); }, [h]() { h.resume(); } );
+  }
+
+  void await_resume() const noexcept { }
+
+  template <class Receiver>
+  async_operation_state< std::decay_t<Receiver> > connect( Receiver&& r ) && {
+    return { std::move(*this), std::forward<Receiver>(r) };
+  }
+
+};
+
+/**
+ *  \brief Operation state of an AsyncOperation connected to a receiver.
+ *
+ *  Neither movable nor copyable, must outlive the completion of the operation.
+ */
+template <class Receiver>
+class async_operation_state {
+
+  AsyncOperation op_;
+  Receiver       rcv_;
+
+public:
+
+  async_operation_state( AsyncOperation&& op, Receiver&& r ) :
+    op_( std::move(op) ), rcv_( std::move(r) ) { }
+  async_operation_state( AsyncOperation&& op, const Receiver& r ) :
+    op_( std::move(op) ), rcv_( r ) { }
+
+  async_operation_state( const async_operation_state& ) = delete;
+  async_operation_state& operator=( const async_operation_state& ) = delete;
+
+  void start() noexcept {
+    try {
+      op_.engine_->submit( [this]() { return test_all( op_.reqs_ ); },
+                           [this]() { std::move(rcv_).set_value(); } );
+    } catch( ... ) {
+      std::move(rcv_).set_error( std::current_exception() );
+    }
+  }
+
+};
+
+
+
+
+/**
+ *  \brief Run a top-level task to completion, polling the engine.
+ *
+ *  @returns Value of the task (rethrows its exception)
+ */
+template <typename T>
+T sync_wait( ProgressEngine& engine, Task<T>&& task ) {
+  task.start();
+  while( not task.done() ) {
+    if( not engine.poll() ) std::this_thread::yield();
+  }
+  return task.result();
+}
+
+/**
+ *  \brief Run a set of top-level tasks concurrently to completion.
+ *
+ *  Tasks are started in order. Rethrows the exception of the first failed task.
+ */
+inline void sync_wait( ProgressEngine& engine, std::vector< Task<> >& tasks ) {
+  for( auto& t : tasks ) t.start();
+  for( auto& t : tasks )
+    while( not t.done() ) {
+      if( not engine.poll() ) std::this_thread::yield();
+    }
+  for( auto& t : tasks ) t.result();
+}
+
+
+
+
+/**
+ *  \brief Awaitable general 2D send (see igesd2d).
+ *
+ *  Requires a progress engine on the grid (Grid::enable_progress).
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T, AsyncOperation>
+  async_gesd2d( const Grid& grid, const blacs_int M, const blacs_int N, const T* A,
+                const blacs_int LDA, const blacs_int RDEST, const blacs_int CDEST,
+                const int TAG = nonblocking_tag ) {
+  auto& engine = detail::progress_engine( grid );
+  return AsyncOperation( engine, igesd2d( grid, M, N, A, LDA, RDEST, CDEST, TAG ) );
+}
+
+/**
+ *  \brief Awaitable general 2D recieve (see igerv2d).
+ *
+ *  Requires a progress engine on the grid (Grid::enable_progress).
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T, AsyncOperation>
+  async_gerv2d( const Grid& grid, const blacs_int M, const blacs_int N, T* A,
+                const blacs_int LDA, const blacs_int RSRC, const blacs_int CSRC,
+                const int TAG = nonblocking_tag ) {
+  auto& engine = detail::progress_engine( grid );
+  return AsyncOperation( engine, igerv2d( grid, M, N, A, LDA, RSRC, CSRC, TAG ) );
+}
+
+/**
+ *  \brief Awaitable general 2D broadcast send.
+ *
+ *  Sends directly to every other process of the scope (point-to-point, such
+ *  that outstanding broadcasts need not be issued in the same order on all
+ *  processes). Must be matched by async_gebr2d with the same tag. Requires a
+ *  progress engine on the grid.
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T, AsyncOperation>
+  async_gebs2d( const Grid& grid, const Scope scope, const blacs_int M,
+                const blacs_int N, const T* A, const blacs_int LDA,
+                const int TAG = async_broadcast_tag ) {
+
+  auto& engine = detail::progress_engine( grid );
+
+  const bool all = scope == Scope::All;
+  const blacs_int r0 = ( all or scope == Scope::Column ) ? 0 : grid.ipr();
+  const blacs_int r1 = ( all or scope == Scope::Column ) ? grid.npr() : grid.ipr() + 1;
+  const blacs_int c0 = ( all or scope == Scope::Row ) ? 0 : grid.ipc();
+  const blacs_int c1 = ( all or scope == Scope::Row ) ? grid.npc() : grid.ipc() + 1;
+
+  std::vector< Request > reqs;
+  for( blacs_int c = c0; c < c1; ++c )
+  for( blacs_int r = r0; r < r1; ++r )
+    if( r != grid.ipr() or c != grid.ipc() )
+      reqs.emplace_back( igesd2d( grid, M, N, A, LDA, r, c, TAG ) );
+
+  return AsyncOperation( engine, std::move(reqs) );
+
+}
+
+/**
+ *  \brief Awaitable general 2D broadcast recieve (matches async_gebs2d).
+ *
+ *  Requires a progress engine on the grid.
+ */
+template <typename T>
+detail::enable_if_blacs_supported_t<T, AsyncOperation>
+  async_gebr2d( const Grid& grid, const Scope scope, const blacs_int M,
+                const blacs_int N, T* A, const blacs_int LDA, const blacs_int RSRC,
+                const blacs_int CSRC, const int TAG = async_broadcast_tag ) {
+  (void)scope;
+  auto& engine = detail::progress_engine( grid );
+  return AsyncOperation( engine, igerv2d( grid, M, N, A, LDA, RSRC, CSRC, TAG ) );
+}
+
+}
@@ -0,0 +1,173 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/util/sfinae.hpp>
+#include <blacspp/util/mpi_types.hpp>
+#include <blacspp/util/scope_comms.hpp>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <tuple>
+
+namespace blacspp {
+
+/// Default number of committed datatypes retained by the datatype transport
+inline constexpr std::size_t datatype_cache_default_capacity = 64;
+
+namespace detail {
+
+/**
+ *  \brief Layout of a col-major (M,N,LDA) buffer or trapezoid
+ *
+ *  uplo / diag are -1 for general (rectangular) buffers.
+ */
+struct datatype_key {
+  char      type; ///< BLACS type character of the elements
+  blacs_int M;    ///< Number of rows
+  blacs_int N;    ///< Number of columns
+  blacs_int LDA;  ///< Leading dimension
+  int       uplo; ///< Triangle of a trapezoid (-1: general)
+  int       diag; ///< Diagonal of a trapezoid (-1: general)
+
+  inline bool operator<( const datatype_key& other ) const noexcept {
+    return std::tie( type, M, N, LDA, uplo, diag ) < 
+           std::tie( other.type, other.M, other.N, other.LDA, other.uplo, other.diag );
+  }
+};
+
+template <typename T>
+inline datatype_key general_key( const blacs_int M, const blacs_int N, 
+                                 const blacs_int LDA ) noexcept {
+  return { blacs_type_char_v<T>, M, N, LDA, -1, -1 };
+}
+
+template <typename T>
+inline datatype_key trapezoid_key( const Triangle uplo, const Diagonal diag, 
+  const blacs_int M, const blacs_int N, const blacs_int LDA ) noexcept {
+  return { blacs_type_char_v<T>, M, N, LDA, uplo, diag };
+}
+
+}
+
+/**
+ *  \brief A least-recently-used cache of committed MPI datatypes.
+ *
+ *  Maps the layout of col-major buffers (general or trapezoidal) onto committed 
+ *  MPI vector / indexed datatypes, such that repeated transfers of the same
+ *  shape do not pay for the construction and commit of their datatype. Evicted
+ *  datatypes are freed, which does not affect pending operations which use them.
+ */
+class DatatypeCache {
+
+  using entry = std::pair< detail::datatype_key, MPI_Datatype >;
+
+  std::size_t                     capacity_;
+  std::list< entry >              lru_;   ///< Entries by recency (front: most recent)
+  std::map< detail::datatype_key, 
+            std::list<entry>::iterator > index_;
+
+  std::size_t hits_   = 0;
+  std::size_t misses_ = 0;
+
+public:
+
+  /**
+   *  \brief Construct an empty cache.
+   *
+   *  @param[in] capacity Maximum number of retained datatypes (at least 1)
+   */
+  explicit DatatypeCache( std::size_t capacity = datatype_cache_default_capacity );
+
+  DatatypeCache( const DatatypeCache& ) = delete;
+  DatatypeCache& operator=( const DatatypeCache& ) = delete;
+
+  ~DatatypeCache() noexcept;
+
+  /**
+   *  \brief Obtain the committed datatype of a layout (a single element of
+   *  which describes the buffer).
+   *
+   *  @param[in] key  Layout of the buffer
+   *  @param[in] elem MPI datatype of a single element
+   *  @returns   Committed datatype owned by the cache
+   */
+  MPI_Datatype get( const detail::datatype_key& key, MPI_Datatype elem );
+
+  /**
+   *  \brief Free all retained datatypes.
+   */
+  void clear() noexcept;
+
+  inline std::size_t size()     const noexcept { return lru_.size(); }
+  inline std::size_t capacity() const noexcept { return capacity_;   }
+  inline std::size_t hits()     const noexcept { return hits_;       }
+  inline std::size_t misses()   const noexcept { return misses_;     }
+
+};
+
+namespace detail {
+
+/**
+ *  \brief Transport which transfers strided / triangular buffers in place.
+ *
+ *  Sends and recieves directly from the user buffer with cached MPI derived
+ *  datatypes (see DatatypeCache), bypassing the packing of BLACS. Broadcasts are
+ *  performed with MPI_Bcast over communicators of the process rows / columns
+ *  of the grid, and thus do not honour the BLACS topology.
+ */
+class datatype_transport {
+
+  MPI_Comm       comm_;   ///< Duplicate of Grid::comm()
+  scope_comms    scopes_; ///< Communicators of the scopes of the grid
+  DatatypeCache  cache_;
+
+public:
+
+  /**
+   *  \brief Construct the transport for a grid.
+   *
+   *  Collective over all processes of Grid::comm().
+   */
+  datatype_transport( const Grid& grid, std::size_t capacity );
+
+  datatype_transport( const datatype_transport& ) = delete;
+  datatype_transport& operator=( const datatype_transport& ) = delete;
+
+  ~datatype_transport() noexcept;
+
+  inline const DatatypeCache& cache() const noexcept { return cache_; }
+
+  /**
+   *  \brief Send a buffer to a rank of Grid::comm()
+   */
+  void send( const datatype_key& key, MPI_Datatype elem, const void* A, 
+             blacs_int dest );
+
+  /**
+   *  \brief Recieve a buffer from a rank of Grid::comm()
+   */
+  void recv( const datatype_key& key, MPI_Datatype elem, void* A, 
+             blacs_int src );
+
+  /**
+   *  \brief Broadcast a buffer over a scope of the grid
+   *
+   *  Collective over the processes of the scope.
+   *
+   *  @param[in] RSRC Process row coordinate of the root
+   *  @param[in] CSRC Process column coordinate of the root
+   */
+  void broadcast( Scope scope, const datatype_key& key, MPI_Datatype elem, 
+                  void* A, blacs_int RSRC, blacs_int CSRC );
+
+};
+
+}
+
+}
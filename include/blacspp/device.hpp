@@ -0,0 +1,123 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/util/scope_comms.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace blacspp {
+
+/// Default size (bytes) of the column blocks of the device transport
+inline constexpr std::size_t device_chunk_default_bytes = std::size_t(1) << 22;
+
+/**
+ *  \brief Counters of the device transport of a grid
+ */
+struct device_stats {
+  std::size_t direct = 0; ///< Device buffers transferred directly through (device-aware) MPI
+  std::size_t staged = 0; ///< Device buffers staged through host memory
+  std::size_t host   = 0; ///< Host buffers
+};
+
+/**
+ *  \brief Whether blacspp has been built with device (CUDA / HIP) support
+ *
+ *  See BLACSPP_ENABLE_CUDA / BLACSPP_ENABLE_HIP.
+ */
+bool device_support() noexcept;
+
+/**
+ *  \brief Whether a pointer refers to device memory
+ *
+ *  Always false if blacspp has been built without device support.
+ */
+bool is_device_pointer( const void* ptr ) noexcept;
+
+/**
+ *  \brief Whether MPI accepts device pointers (e.g. CUDA-aware MPI)
+ *
+ *  Queried from the MPI implementation if possible, may be overridden by
+ *  setting BLACSPP_DEVICE_AWARE_MPI=0/1 in the environment.
+ */
+bool device_aware_mpi() noexcept;
+
+namespace detail {
+
+/**
+ *  \brief Transport for general 2D point-to-point and broadcast operations 
+ *  on device-resident buffers
+ *
+ *  Buffers are transferred (through MPI) as a sequence of column blocks of at 
+ *  most chunk_bytes. Each process independently decides how to transfer its 
+ *  buffer: host buffers, and device buffers with device-aware MPI, are 
+ *  transferred in place, other device buffers are staged through two pinned 
+ *  host buffers such that the copy of a block overlaps the transfer of the 
+ *  previous one. Broadcasts are performed with MPI_Ibcast over the scopes of
+ *  the grid, and thus do not honour the BLACS topology.
+ */
+class device_transport {
+
+  MPI_Comm       comm_;        ///< Duplicate of Grid::comm()
+  scope_comms    scopes_;      ///< Communicators of the scopes of the grid
+  std::size_t    chunk_bytes_; ///< Target size of a column block
+  bool           aware_;       ///< Whether MPI is device-aware
+
+  std::array<void*,2> stage_ = { nullptr, nullptr }; ///< Pinned host staging buffers
+  std::size_t         stage_bytes_ = 0;              ///< Size of each staging buffer
+  device_stats        stats_;
+
+  blacs_int chunk_cols( std::size_t elem_size, blacs_int M ) const noexcept;
+  bool      staged( const void* A );
+  void      reserve_stage( std::size_t bytes );
+
+public:
+
+  /**
+   *  \brief Construct the transport for a grid.
+   *
+   *  Collective over all processes of Grid::comm(). chunk_bytes must be the
+   *  same on all processes.
+   */
+  device_transport( const Grid& grid, std::size_t chunk_bytes );
+
+  device_transport( const device_transport& ) = delete;
+  device_transport& operator=( const device_transport& ) = delete;
+
+  ~device_transport() noexcept;
+
+  inline const device_stats& stats()       const noexcept { return stats_;       }
+  inline std::size_t         chunk_bytes() const noexcept { return chunk_bytes_; }
+
+  /**
+   *  \brief Send a (host or device) buffer to a rank of Grid::comm()
+   */
+  void send( MPI_Datatype elem, std::size_t elem_size, blacs_int M, blacs_int N,
+             const void* A, blacs_int LDA, blacs_int dest );
+
+  /**
+   *  \brief Recieve a (host or device) buffer from a rank of Grid::comm()
+   */
+  void recv( MPI_Datatype elem, std::size_t elem_size, blacs_int M, blacs_int N,
+             void* A, blacs_int LDA, blacs_int src );
+
+  /**
+   *  \brief Broadcast a (host or device) buffer over a scope of the grid
+   *
+   *  Collective over the processes of the scope.
+   *
+   *  @param[in] is_root Whether this process is the root (RSRC,CSRC)
+   */
+  void broadcast( Scope scope, bool is_root, MPI_Datatype elem, 
+                  std::size_t elem_size, blacs_int M, blacs_int N, void* A, 
+                  blacs_int LDA, blacs_int RSRC, blacs_int CSRC );
+
+};
+
+}
+}
@@ -0,0 +1,361 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/util/sfinae.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace blacspp {
+
+/// Alignment (bytes) of the local storage of a DistMatrix
+inline constexpr std::size_t distmatrix_alignment = 64;
+
+/**
+ *  \brief Number of rows / columns of a block-cyclic dimension owned by a process
+ *
+ *  Equivalent to ScaLAPACK's NUMROC.
+ *
+ *  @param[in] n      Global size of the dimension
+ *  @param[in] nb     Block size of the dimension
+ *  @param[in] iproc  Process coordinate along the dimension
+ *  @param[in] isrc   Process coordinate which owns the first block
+ *  @param[in] nprocs Number of processes along the dimension
+ */
+constexpr blacs_int numroc( blacs_int n, blacs_int nb, blacs_int iproc,
+                            blacs_int isrc, blacs_int nprocs ) noexcept {
+
+  const blacs_int mydist  = ( nprocs + iproc - isrc ) % nprocs;
+  const blacs_int nblocks = n / nb;
+
+  blacs_int num = ( nblocks / nprocs ) * nb;
+  const blacs_int extra = nblocks % nprocs;
+
+  if( mydist < extra )       num += nb;
+  else if( mydist == extra ) num += n % nb;
+
+  return num;
+
+}
+
+/**
+ *  \brief Process coordinate which owns a (0-based) global index
+ *
+ *  Equivalent to ScaLAPACK's INDXG2P.
+ */
+constexpr blacs_int indxg2p( blacs_int ig, blacs_int nb, blacs_int isrc,
+                             blacs_int nprocs ) noexcept {
+  return ( isrc + ig / nb ) % nprocs;
+}
+
+/**
+ *  \brief Local (0-based) index of a (0-based) global index on its owner
+ *
+ *  Equivalent to ScaLAPACK's INDXG2L.
+ */
+constexpr blacs_int indxg2l( blacs_int ig, blacs_int nb, blacs_int nprocs ) noexcept {
+  return ( ig / ( nb * nprocs ) ) * nb + ig % nb;
+}
+
+/**
+ *  \brief Global (0-based) index of a (0-based) local index of a process
+ *
+ *  Equivalent to ScaLAPACK's INDXL2G.
+ */
+constexpr blacs_int indxl2g( blacs_int il, blacs_int nb, blacs_int iproc,
+                             blacs_int isrc, blacs_int nprocs ) noexcept {
+  return ( ( nprocs + iproc - isrc ) % nprocs ) * nb +
+         ( il / nb ) * nb * nprocs + il % nb;
+}
+
+
+
+/**
+ *  \brief Entries of a ScaLAPACK array descriptor
+ */
+enum DescriptorEntry {
+  DTYPE_ = 0, ///< Descriptor type (1: dense)
+  CTXT_  = 1, ///< BLACS context
+  M_     = 2, ///< Global number of rows
+  N_     = 3, ///< Global number of columns
+  MB_    = 4, ///< Row block size
+  NB_    = 5, ///< Column block size
+  RSRC_  = 6, ///< Process row which owns the first row
+  CSRC_  = 7, ///< Process column which owns the first column
+  LLD_   = 8  ///< Leading dimension of the local storage
+};
+
+/// A ScaLAPACK (dense) array descriptor
+using descriptor = std::array< blacs_int, 9 >;
+
+/**
+ *  \brief Location of a global matrix element in the block-cyclic distribution
+ */
+struct local_index {
+  process_coordinate owner; ///< Process coordinate which owns the element
+  blacs_int          i;     ///< Local row index on the owner
+  blacs_int          j;     ///< Local column index on the owner
+};
+
+namespace detail {
+
+/**
+ *  \brief Allocator of cache-aligned storage
+ */
+template <typename T>
+struct aligned_allocator {
+
+  using value_type = T;
+
+  aligned_allocator() noexcept = default;
+  template <typename U>
+  aligned_allocator( const aligned_allocator<U>& ) noexcept { }
+
+  T* allocate( std::size_t n ) {
+    return static_cast<T*>( ::operator new( n * sizeof(T),
+      std::align_val_t( distmatrix_alignment ) ) );
+  }
+
+  void deallocate( T* p, std::size_t ) noexcept {
+    ::operator delete( p, std::align_val_t( distmatrix_alignment ) );
+  }
+
+  template <typename U>
+  bool operator==( const aligned_allocator<U>& ) const noexcept { return true;  }
+  template <typename U>
+  bool operator!=( const aligned_allocator<U>& ) const noexcept { return false; }
+
+};
+
+/**
+ *  \brief Leading dimension of local storage with mloc rows
+ *
+ *  Rounded up to a multiple of the cache line such that every local column
+ *  starts on a cache line (at least 1, as required by ScaLAPACK).
+ */
+template <typename T>
+constexpr blacs_int padded_lda( blacs_int mloc ) noexcept {
+  constexpr blacs_int line = std::max( std::size_t(1), distmatrix_alignment / sizeof(T) );
+  return std::max( blacs_int(1), ( ( mloc + line - 1 ) / line ) * line );
+}
+
+/**
+ *  \brief The block-cyclic layout of a DistMatrix as seen by a process
+ */
+struct block_cyclic_layout {
+  blacs_int M, N, MB, NB, RSRC, CSRC; ///< Global parameters of the distribution
+  blacs_int npr, npc;                 ///< Dimensions of the grid
+  blacs_int ipr, ipc;                 ///< Coordinate of this process (-1: not in the grid)
+
+  bool operator==( const block_cyclic_layout& o ) const noexcept {
+    return std::tie( M, N, MB, NB, RSRC, CSRC, npr, npc, ipr, ipc ) ==
+           std::tie( o.M, o.N, o.MB, o.NB, o.RSRC, o.CSRC, o.npr, o.npc, o.ipr, o.ipc );
+  }
+  bool operator!=( const block_cyclic_layout& o ) const noexcept {
+    return not (*this == o);
+  }
+};
+
+}
+
+
+
+
+
+/**
+ *  \brief A dense matrix in a 2D block-cyclic distribution over a BLACS grid.
+ *
+ *  Owns the (column-major) local storage of this process, which is aligned to
+ *  distmatrix_alignment and has a padded leading dimension. Indices are 0-based.
+ *
+ *  The grid must outlive the matrix. Processes of Grid::comm() which are not
+ *  part of the grid own no elements.
+ *
+ *  @tparam T Type of the matrix elements. Must be BLACS enabled.
+ */
+template <typename T>
+class DistMatrix {
+
+  static_assert( detail::blacs_native<T>::value,
+    "DistMatrix requires a native BLACS type" );
+
+  const Grid* grid_;
+  blacs_int   m_, n_;       ///< Global dimensions
+  blacs_int   mb_, nb_;     ///< Block sizes
+  blacs_int   rsrc_, csrc_; ///< Process coordinate of the first block
+  blacs_int   mloc_, nloc_; ///< Local dimensions
+  blacs_int   lda_;         ///< Leading dimension of the local storage
+
+  std::vector< T, detail::aligned_allocator<T> > data_;
+
+public:
+
+  /**
+   *  \brief Construct a (zero initialized) distributed matrix.
+   *
+   *  @param[in] grid (local) BLACS grid over which the matrix is distributed
+   *  @param[in] M    (global) Number of rows of the matrix
+   *  @param[in] N    (global) Number of columns of the matrix
+   *  @param[in] MB   (global) Row block size
+   *  @param[in] NB   (global) Column block size
+   *  @param[in] RSRC (global) Process row which owns the first row
+   *  @param[in] CSRC (global) Process column which owns the first column
+   */
+  DistMatrix( const Grid& grid, blacs_int M, blacs_int N, blacs_int MB,
+              blacs_int NB, blacs_int RSRC = 0, blacs_int CSRC = 0 ) :
+    grid_( &grid ), m_( M ), n_( N ), mb_( MB ), nb_( NB ), rsrc_( RSRC ),
+    csrc_( CSRC ) {
+
+    if( M < 0 or N < 0 )   throw std::runtime_error("Invalid Matrix Dimensions");
+    if( MB < 1 or NB < 1 ) throw std::runtime_error("Invalid Block Size");
+    if( RSRC < 0 or RSRC >= grid.npr() or CSRC < 0 or CSRC >= grid.npc() )
+      throw std::runtime_error("Invalid Source Process");
+
+    const bool member = grid.ipr() >= 0 and grid.ipc() >= 0;
+    mloc_ = member ? numroc( M, MB, grid.ipr(), RSRC, grid.npr() ) : 0;
+    nloc_ = member ? numroc( N, NB, grid.ipc(), CSRC, grid.npc() ) : 0;
+    lda_  = detail::padded_lda<T>( mloc_ );
+
+    data_.assign( std::size_t(lda_) * nloc_, T(0) );
+
+  }
+
+  inline const Grid& grid() const noexcept { return *grid_; }
+
+  inline blacs_int m()    const noexcept { return m_;    }
+  inline blacs_int n()    const noexcept { return n_;    }
+  inline blacs_int mb()   const noexcept { return mb_;   }
+  inline blacs_int nb()   const noexcept { return nb_;   }
+  inline blacs_int rsrc() const noexcept { return rsrc_; }
+  inline blacs_int csrc() const noexcept { return csrc_; }
+
+  /// Number of rows of the local storage
+  inline blacs_int local_m() const noexcept { return mloc_; }
+  /// Number of columns of the local storage
+  inline blacs_int local_n() const noexcept { return nloc_; }
+  /// Leading dimension of the local storage
+  inline blacs_int lda()     const noexcept { return lda_;  }
+
+  inline T*       data()       noexcept { return data_.data(); }
+  inline const T* data() const noexcept { return data_.data(); }
+
+  /// Local element (il,jl) of this process
+  inline T& operator()( blacs_int il, blacs_int jl ) noexcept {
+    return data_[ il + jl * std::size_t(lda_) ];
+  }
+  inline const T& operator()( blacs_int il, blacs_int jl ) const noexcept {
+    return data_[ il + jl * std::size_t(lda_) ];
+  }
+
+  /**
+   *  \brief ScaLAPACK descriptor of the matrix
+   */
+  descriptor desc() const noexcept {
+    return { 1, grid_->context(), m_, n_, mb_, nb_, rsrc_, csrc_, lda_ };
+  }
+
+  /**
+   *  \brief Process row / column which owns a global row / column
+   */
+  inline blacs_int row_owner( blacs_int i ) const noexcept {
+    return indxg2p( i, mb_, rsrc_, grid_->npr() );
+  }
+  inline blacs_int col_owner( blacs_int j ) const noexcept {
+    return indxg2p( j, nb_, csrc_, grid_->npc() );
+  }
+
+  /**
+   *  \brief Process coordinate which owns global element (i,j)
+   */
+  inline process_coordinate owner( blacs_int i, blacs_int j ) const noexcept {
+    return { row_owner( i ), col_owner( j ) };
+  }
+
+  /**
+   *  \brief Check if global element (i,j) is owned by this process
+   */
+  inline bool is_local( blacs_int i, blacs_int j ) const noexcept {
+    return row_owner( i ) == grid_->ipr() and col_owner( j ) == grid_->ipc();
+  }
+
+  /**
+   *  \brief Local row / column index of a global row / column on its owner
+   */
+  inline blacs_int local_row( blacs_int i ) const noexcept {
+    return indxg2l( i, mb_, grid_->npr() );
+  }
+  inline blacs_int local_col( blacs_int j ) const noexcept {
+    return indxg2l( j, nb_, grid_->npc() );
+  }
+
+  /**
+   *  \brief Global row / column index of a local row / column of this process
+   */
+  inline blacs_int global_row( blacs_int il ) const noexcept {
+    return indxl2g( il, mb_, grid_->ipr(), rsrc_, grid_->npr() );
+  }
+  inline blacs_int global_col( blacs_int jl ) const noexcept {
+    return indxl2g( jl, nb_, grid_->ipc(), csrc_, grid_->npc() );
+  }
+
+  /**
+   *  \brief Owner and local indices of global element (i,j)
+   */
+  inline local_index global_to_local( blacs_int i, blacs_int j ) const noexcept {
+    return { owner( i, j ), local_row( i ), local_col( j ) };
+  }
+
+  /**
+   *  \brief Global indices of local element (il,jl) of this process
+   */
+  inline std::pair<blacs_int,blacs_int>
+    local_to_global( blacs_int il, blacs_int jl ) const noexcept {
+    return { global_row( il ), global_col( jl ) };
+  }
+
+  /**
+   *  \brief Apply a function to every local element as f( i, j, A(il,jl) )
+   *
+   *  Global indices are advanced block-wise such that no per-element index
+   *  map is evaluated.
+   */
+  template <typename F>
+  void for_each_local( F&& f ) {
+
+    for( blacs_int jb = 0; jb < nloc_; jb += nb_ ) {
+      const blacs_int jg = global_col( jb );
+      const blacs_int jn = std::min( nb_, nloc_ - jb );
+      for( blacs_int jj = 0; jj < jn; ++jj )
+      for( blacs_int ib = 0; ib < mloc_; ib += mb_ ) {
+        const blacs_int ig = global_row( ib );
+        const blacs_int in = std::min( mb_, mloc_ - ib );
+        T* col = data_.data() + ib + (jb + jj) * std::size_t(lda_);
+        for( blacs_int ii = 0; ii < in; ++ii ) f( ig + ii, jg + jj, col[ii] );
+      }
+    }
+
+  }
+
+};
+
+namespace detail {
+
+template <typename T>
+block_cyclic_layout layout_of( const DistMatrix<T>& A ) noexcept {
+  return { A.m(), A.n(), A.mb(), A.nb(), A.rsrc(), A.csrc(), A.grid().npr(),
+           A.grid().npc(), A.grid().ipr(), A.grid().ipc() };
+}
+
+}
+
+}
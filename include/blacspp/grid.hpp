@@ -6,38 +6,142 @@
  */
 #pragma once
 #include <blacspp/types.hpp>
+#include <memory>
+#include <vector>
 
 namespace blacspp {
 
+class TopologyTable;
+
+/**
+ *  \brief Placement hints for Grid::node_aware_grid
+ */
+struct node_hint {
+  Scope     locality = Row; ///< Process groups to keep within a node (Row or Column)
+  blacs_int npr      = 0;   ///< Number of process rows (0: chosen automatically)
+  blacs_int npc      = 0;   ///< Number of process columns (0: chosen automatically)
+};
+
+/**
+ *  \brief Node locality of the process groups of a BLACS grid
+ *
+ *  Fractions of the process pairs within the process groups of each scope
+ *  which share a (shared memory) node, i.e. the ratio of intra-node to total
+ *  traffic of an all-to-all exchange in that scope.
+ */
+struct grid_locality {
+  blacs_int nnodes   = 0;  ///< Number of nodes spanned by the grid
+  double    row      = 1.; ///< Intra-node fraction within process rows
+  double    column   = 1.; ///< Intra-node fraction within process columns
+  double    all      = 1.; ///< Intra-node fraction within the grid
+};
+
+/**
+ *  \brief Counters of the process-wide grid cache (see Grid::cached)
+ */
+struct grid_cache_stats {
+  std::size_t hits   = 0; ///< Grids which reused a cached BLACS context
+  std::size_t misses = 0; ///< Grids which created a BLACS context
+  std::size_t live   = 0; ///< Cached BLACS contexts which are in use
+};
+
+namespace detail {
+  class system_handle;
+  class context_handle;
+  class shm_transport;
+  class datatype_transport;
+  class device_transport;
+  class compression_transport;
+  class hierarchical_transport;
+}
+
+class ProgressEngine;
+struct progress_options;
+struct compression_options;
+
 /**
  *  \brief A class which provides a C++ wrapper for a BLACS Grid.
  *
  *  Manages the lifetime and information pertaining to a BLACS grid.
+ *
+ *  Threading model: a Grid (including its optional transports) must only be
+ *  used by one thread at a time. Distinct grids may be used concurrently from
+ *  several threads if MPI provides MPI_THREAD_MULTIPLE (see thread_multiple())
+ *  and the grids do not share an MPI communicator, e.g. the grids of a 
+ *  GridPool (see duplicate()). Concurrent BLACS calls further require a 
+ *  thread safe BLACS implementation. Process-wide blacspp state (the Profiler)
+ *  is safe for concurrent calls.
  */
 class Grid {
 
   blacs_grid_dim  grid_dim_; ///< Grid information of constructed grid
   mpi_info        mpi_info_; ///< MPI information for underlying MPI communicator
 
-  blacs_int       system_handle_; ///< BLACS representation of the MPI communicator (system handle)
-  blacs_int       context_;       ///< BLACS context representation of the BLACS grid
+  std::shared_ptr<const detail::system_handle> system_; ///< BLACS system handle (shared between grids on comm())
+  blacs_int       context_ = -1; ///< BLACS context representation of the BLACS grid
+  std::shared_ptr<const detail::context_handle> ctx_; ///< Owns context_ (shared between cached grids)
+
+  std::vector<blacs_int> pmap_; ///< Rank in comm() of each process coordinate (col-major, npr x npc)
+
+  Topology        bcast_top_ = Topology::Default; ///< Default topology for broadcasts
+  Topology        comb_top_  = Topology::Default; ///< Default topology for combines
+
+  std::shared_ptr<const TopologyTable> top_table_; ///< Tuned topologies (optional)
+
+  std::shared_ptr<detail::shm_transport> shm_; ///< Node-local transport (optional)
+  std::shared_ptr<detail::datatype_transport> dtt_; ///< Derived datatype transport (optional)
+  std::shared_ptr<detail::device_transport>   dev_; ///< Device buffer transport (optional)
+  std::shared_ptr<detail::compression_transport> cmp_; ///< Compressed transfer mode (optional)
+  std::shared_ptr<detail::hierarchical_transport> hier_; ///< Hierarchical collectives (optional)
+
+  std::shared_ptr<ProgressEngine> progress_; ///< Progress engine (optional)
+
+  mutable std::shared_ptr<const Grid> row_grid_; ///< Grid of the process row (cached by row_grid)
+  mutable std::shared_ptr<const Grid> col_grid_; ///< Grid of the process column (cached by col_grid)
   
 
   /**
-   *  \brief Construct a BLACS grid given preconstructed parameters.
+   *  \brief Construct a BLACS grid from a process map on an existing system handle.
    *
-   *  Does not actually construct a BLACS grid, assumes passed information
-   *  already represents a constructed BLACS grid.
+   *  Collective over all processes of the MPI communicator of the system handle.
+   *  Processes which do not appear in the map obtain an invalid grid which 
+   *  retains the handle and the map (such that they may participate in further
+   *  collective grid constructions).
+   *
+   *  @param[in] sys   BLACS system handle
+   *  @param[in] info  MPI information of the communicator of the system handle
+   *  @param[in] npr   Number of process rows
+   *  @param[in] npc   Number of process columns
+   *  @param[in] pmap  Rank in the communicator of each process coordinate (col-major)
+   *
+   */
+  Grid( std::shared_ptr<const detail::system_handle> sys, mpi_info info, 
+        blacs_int npr, blacs_int npc, std::vector<blacs_int> pmap );
+
+  /**
+   *  \brief Construct a BLACS grid on an existing BLACS context (local).
    *
-   *  Only used as a part of the move constructor to simplify the logic.
+   *  @param[in] ctx  BLACS context (and its system handle)
+   *  @param[in] info MPI information of the communicator of the context
+   *  @param[in] dim  Grid information of the context
+   *  @param[in] pmap Rank in the communicator of each process coordinate (col-major)
+   */
+  Grid( std::shared_ptr<const detail::context_handle> ctx, mpi_info info,
+        blacs_grid_dim dim, std::vector<blacs_int> pmap );
+
+  /**
+   *  \brief Split comm() into process rows (scope == Row) or columns (scope == Column)
    *
-   *  @param[in] dim      BLACS Grid information
-   *  @param[in] info     MPI information
-   *  @param[in] handle   BLACS system handle (must refer to already constructed BLACS handle)
-   *  @param[in] context  BLACS context (must refer to an already constructed BLACS grid)
+   *  Collective over all processes of comm().
+   */
+  Grid split( Scope scope ) const;
+
+  /**
+   *  \brief Returns the process row / column grid, splitting comm() on the first call
    *
+   *  Later calls share the context of the first (and are local).
    */
-  Grid( blacs_grid_dim dim, mpi_info info, blacs_int handle, blacs_int context );
+  Grid cached_split( Scope scope ) const;
 
 public:
 
@@ -54,17 +158,32 @@ public:
    *  Constructs a BLACS grid from an MPI communicator.
    *  npr * npc must be equal to size of MPI communicator
    *
-   *  @param[in]  c    MPI Communicator
-   *  @param[in]  npr  Number of process rows
-   *  @param[in]  npc  Number of process columns
+   *  @param[in]  c     MPI Communicator
+   *  @param[in]  npr   Number of process rows
+   *  @param[in]  npc   Number of process columns
+   *  @param[in]  order Ordering of the ranks of c on the grid
    */
-  Grid( MPI_Comm c, blacs_int npr, blacs_int npc );
+  Grid( MPI_Comm c, blacs_int npr, blacs_int npc, GridOrder order = RowMajor );
+
+  /**
+   *  \brief Construct a BLACS grid from a process map.
+   *
+   *  Constructs a BLACS grid from an MPI communicator (Cblacs_gridmap).
+   *  npr * npc must be equal to size of MPI communicator and the map
+   *  must contain each rank exactly once.
+   *
+   *  @param[in]  c     MPI Communicator
+   *  @param[in]  npr   Number of process rows
+   *  @param[in]  npc   Number of process columns
+   *  @param[in]  pmap  Rank in c of each process coordinate (col-major, npr x npc)
+   */
+  Grid( MPI_Comm c, blacs_int npr, blacs_int npc, std::vector<blacs_int> pmap );
 
   /**
    *  \brief Copy constructor.
    *
    *  Creates a clone of the passed grid with a distinct
-   *  BLACS context.
+   *  BLACS context (see clone).
    *
    *  @param[in] other BLACS grid to clone
    */
@@ -91,6 +210,8 @@ public:
   /**
    *  \brief Check if grid is valid.
    *
+   *  A grid is valid if the current process is a part of it.
+   *
    *  @returns Whether the grid is valid
    */
   bool is_valid() const ;
@@ -127,10 +248,311 @@ public:
 
   /**
    *  \brief Returns MPI communicator corresponding on which the BLACS grid has been constructed.
+   *
+   *  For grids obtained from subgrid, this is the communicator of the parent grid,
+   *  which may contain processes which are not a part of the grid.
+   *
    *  @returns MPI communicator for the BLACS grid.
    */
   inline MPI_Comm  comm()    const noexcept { return mpi_info_.comm(); }
 
+  /**
+   *  \brief Returns the communicator of the non-blocking transfers of blacspp.
+   *
+   *  A duplicate of comm() (created with the BLACS context, shared between the
+   *  grids which share the context) over which igesd2d / igerv2d, plans,
+   *  message batches, halo exchanges and scatter / gather post their messages,
+   *  such that they never match messages of the application on comm().
+   *
+   *  @returns MPI communicator, MPI_COMM_NULL if the process is not a part of
+   *           the grid.
+   */
+  MPI_Comm transfer_comm() const noexcept;
+
+  /**
+   *  \brief Whether MPI provided MPI_THREAD_MULTIPLE when this grid was created
+   */
+  inline bool thread_multiple() const { return mpi_info_.thread_multiple(); }
+
+  /**
+   *  \brief Returns the rank in comm() of a process coordinate.
+   *
+   *  @param[in] PROW Process row coordinate
+   *  @param[in] PCOL Process column coordinate
+   *  @returns   Rank of the process in comm()
+   */
+  inline blacs_int comm_rank( blacs_int PROW, blacs_int PCOL ) const noexcept {
+    return pmap_[ PROW + PCOL * grid_dim_.np_row ];
+  }
+
+  /**
+   *  \brief Returns the default topology for broadcasts on this grid.
+   *
+   *  Used by broadcast operations which do not specify a topology.
+   *
+   *  @returns Default broadcast topology
+   */
+  inline Topology broadcast_topology() const noexcept { return bcast_top_; }
+
+  /**
+   *  \brief Returns the default topology for combines on this grid.
+   *
+   *  Used by combine operations which do not specify a topology.
+   *
+   *  @returns Default combine topology
+   */
+  inline Topology combine_topology()   const noexcept { return comb_top_;  }
+
+  /**
+   *  \brief Set the default topology for broadcasts on this grid.
+   *
+   *  Must be set consistently on all processes of the grid.
+   *
+   *  @param[in] top New default broadcast topology
+   */
+  inline void set_broadcast_topology( Topology top ) noexcept { bcast_top_ = top; }
+
+  /**
+   *  \brief Set the default topology for combines on this grid.
+   *
+   *  Must be set consistently on all processes of the grid. Throws
+   *  std::runtime_error for the ring topologies (SRing, MRing), which BLACS
+   *  only supports for broadcasts.
+   *
+   *  @param[in] top New default combine topology
+   */
+  void set_combine_topology( Topology top );
+
+  /**
+   *  \brief Set a table of tuned topologies for this grid.
+   *
+   *  When set, operations which do not specify a topology select it from
+   *  the table by scope and message size, falling back to the default 
+   *  topology of the grid. Must be set consistently on all processes of the
+   *  grid. Passing nullptr removes the table.
+   *
+   *  @param[in] table Topology table (see blacspp/tune.hpp)
+   */
+  void set_topology_table( std::shared_ptr<const TopologyTable> table ) noexcept;
+
+  /**
+   *  \brief Returns the table of tuned topologies for this grid (may be nullptr).
+   *  @returns Topology table
+   */
+  inline const std::shared_ptr<const TopologyTable>& topology_table() const noexcept {
+    return top_table_;
+  }
+
+  /**
+   *  \brief Returns the topology for a broadcast of a particular size.
+   *
+   *  @param[in] scope Scope of the broadcast
+   *  @param[in] bytes Size of the broadcast message in bytes
+   *  @returns   Tuned topology if available, otherwise broadcast_topology()
+   */
+  Topology broadcast_topology( Scope scope, std::size_t bytes ) const noexcept;
+
+  /**
+   *  \brief Returns the topology for a combine of a particular size.
+   *
+   *  @param[in] scope Scope of the combine
+   *  @param[in] bytes Size of the combine message in bytes
+   *  @returns   Tuned topology if available, otherwise combine_topology()
+   */
+  Topology combine_topology( Scope scope, std::size_t bytes ) const noexcept;
+
+  /**
+   *  \brief Enable the node-local (shared memory) transport for this grid.
+   *
+   *  General point-to-point (gesd2d/gerv2d) and broadcast (gebs2d/gebr2d)
+   *  operations between processes on the same node bypass BLACS and copy
+   *  through an MPI-3 shared memory window (see blacspp/shared_memory.hpp).
+   *  Tiles which do not fit into the segment fall back to BLACS. 
+   *
+   *  Collective over all processes of comm(). Must be enabled on all processes 
+   *  which communicate over the grid. Not inherited by clones or sub-grids. 
+   *
+   *  @param[in] bytes Size of the shared memory segment of each process
+   */
+  void enable_shared_memory( std::size_t bytes );
+  void enable_shared_memory();
+
+  /**
+   *  \brief Disable the node-local transport for this grid.
+   *
+   *  Collective over all processes of comm().
+   */
+  void disable_shared_memory();
+
+  /**
+   *  \brief Returns the node-local transport of this grid (nullptr if not enabled)
+   */
+  inline const std::shared_ptr<detail::shm_transport>& shared_memory() const noexcept {
+    return shm_;
+  }
+
+  /**
+   *  \brief Enable the derived datatype transport for this grid.
+   *
+   *  General and triangular point-to-point (gesd2d/gerv2d, trsd2d/trrv2d) and
+   *  broadcast (gebs2d/gebr2d, trbs2d/trbr2d) operations bypass BLACS and 
+   *  transfer directly from / into the user buffer through cached MPI derived
+   *  datatypes (see blacspp/datatype.hpp), avoiding the packing of strided and
+   *  triangular buffers. Sends follow MPI_Send semantics, i.e. (large) sends 
+   *  may not return before the matching recieve has been posted. Broadcasts do 
+   *  not honour the requested topology. Tiles
+   *  between node-local processes still prefer the shared memory transport 
+   *  if enabled.
+   *
+   *  Collective over all processes of comm(). Must be enabled on all processes 
+   *  which communicate over the grid. Not inherited by clones or sub-grids. 
+   *
+   *  @param[in] capacity Number of datatypes retained by the cache
+   */
+  void enable_datatype_transport( std::size_t capacity );
+  void enable_datatype_transport();
+
+  /**
+   *  \brief Disable the derived datatype transport for this grid.
+   *
+   *  Collective over all processes of comm().
+   */
+  void disable_datatype_transport();
+
+  /**
+   *  \brief Returns the derived datatype transport of this grid (nullptr if not enabled)
+   */
+  inline const std::shared_ptr<detail::datatype_transport>& datatype_transport() const noexcept {
+    return dtt_;
+  }
+
+  /**
+   *  \brief Enable the device buffer transport for this grid.
+   *
+   *  General point-to-point (gesd2d/gerv2d) and broadcast (gebs2d/gebr2d) 
+   *  operations accept device-resident (CUDA / HIP) buffers, which are transferred
+   *  through device-aware MPI if available, and otherwise staged through pinned 
+   *  host memory in column blocks of chunk_bytes (see blacspp/device.hpp). Takes 
+   *  precedence over the other transports for these operations, including for 
+   *  host buffers, and thus should only be enabled on grids which communicate 
+   *  device buffers. Broadcasts do not honour the requested topology.
+   *
+   *  Collective over all processes of comm(). Must be enabled (with the same
+   *  chunk_bytes) on all processes which communicate over the grid. Not 
+   *  inherited by clones or sub-grids. 
+   *
+   *  @param[in] chunk_bytes Size of the column blocks of a transfer
+   */
+  void enable_device_transport( std::size_t chunk_bytes );
+  void enable_device_transport();
+
+  /**
+   *  \brief Disable the device buffer transport for this grid.
+   *
+   *  Collective over all processes of comm().
+   */
+  void disable_device_transport();
+
+  /**
+   *  \brief Returns the device buffer transport of this grid (nullptr if not enabled)
+   */
+  inline const std::shared_ptr<detail::device_transport>& device_transport() const noexcept {
+    return dev_;
+  }
+
+  /**
+   *  \brief Enable the compressed transfer mode for this grid.
+   *
+   *  General point-to-point (gesd2d/gerv2d) and broadcast (gebs2d/gebr2d)
+   *  operations on double / dcomplex buffers of at least opts.min_bytes are
+   *  converted to a reduced precision (float or bfloat16) before they are sent,
+   *  and expanded back into the buffer of the caller on receipt (see
+   *  blacspp/compression.hpp). The converted payload is transferred by the
+   *  other transports of the grid. Lossy, and thus only suitable for payloads
+   *  which tolerate the rounding error of the wire precision. Not applied if
+   *  the device transport is enabled.
+   *
+   *  Local, but must be enabled with the same options on all processes which
+   *  communicate over the grid. Not inherited by clones or sub-grids.
+   *
+   *  @param[in] opts Parameters of the compressed transfer mode
+   */
+  void enable_compression( const compression_options& opts );
+  void enable_compression();
+
+  /**
+   *  \brief Disable the compressed transfer mode for this grid.
+   */
+  void disable_compression();
+
+  /**
+   *  \brief Returns the compressed transfer mode of this grid (nullptr if not enabled)
+   */
+  inline const std::shared_ptr<detail::compression_transport>& compression() const noexcept {
+    return cmp_;
+  }
+
+  /**
+   *  \brief Enable hierarchical collectives for this grid.
+   *
+   *  Scope::All broadcasts (gebs2d/gebr2d, trbs2d/trbr2d) and sums (gsum2d)
+   *  bypass BLACS and proceed in two levels: among the processes of each node,
+   *  then between one leader per node (see blacspp/hierarchical.hpp). This
+   *  reduces the number of inter-node messages of these operations by the 
+   *  number of processes per node. Broadcasts and sums do not honour the
+   *  requested topology. Takes precedence over the other transports for these
+   *  operations, except for the device transport.
+   *
+   *  Collective over all processes of comm(). Must be enabled (with the same
+   *  ranks_per_node) on all processes of the grid. Not inherited by clones or
+   *  sub-grids.
+   *
+   *  @param[in] ranks_per_node Number of consecutive ranks of the grid which
+   *                            form a node (0: the shared memory nodes)
+   */
+  void enable_hierarchical_collectives( blacs_int ranks_per_node );
+  void enable_hierarchical_collectives();
+
+  /**
+   *  \brief Disable the hierarchical collectives of this grid.
+   *
+   *  Collective over all processes of the grid.
+   */
+  void disable_hierarchical_collectives();
+
+  /**
+   *  \brief Returns the hierarchical collectives of this grid (nullptr if not enabled)
+   */
+  inline const std::shared_ptr<detail::hierarchical_transport>& hierarchical() const noexcept {
+    return hier_;
+  }
+
+  /**
+   *  \brief Enable a progress engine for this grid.
+   *
+   *  Non-blocking operations on the grid may be submitted to the engine, which
+   *  advances them from poll() or a background thread (see 
+   *  blacspp/progress.hpp). Local, outstanding operations of a previous engine
+   *  are completed first. Not inherited by clones or sub-grids. The engine is
+   *  destroyed (completing its operations) before the grid is exited.
+   *
+   *  @param[in] opts Parameters of the engine
+   */
+  void enable_progress( const progress_options& opts );
+  void enable_progress();
+
+  /**
+   *  \brief Disable the progress engine of this grid (completing its operations).
+   */
+  void disable_progress();
+
+  /**
+   *  \brief Returns the progress engine of this grid (nullptr if not enabled)
+   */
+  inline const std::shared_ptr<ProgressEngine>& progress() const noexcept {
+    return progress_;
+  }
+
 
 
 
@@ -142,6 +564,72 @@ public:
 
 
 
+  /**
+   *  \brief Create a clone of this grid with a distinct BLACS context.
+   *
+   *  Reuses the BLACS system handle of this grid. Collective over all 
+   *  processes of comm().
+   *
+   *  @returns Clone of this grid
+   */
+  Grid clone() const;
+
+  /**
+   *  \brief Create a duplicate of this grid on a duplicated MPI communicator.
+   *
+   *  Unlike clone(), the duplicate owns a duplicate of comm() and its own BLACS 
+   *  system handle, such that its traffic (including blacspp's own MPI 
+   *  transfers) never matches the traffic of this grid. This allows several 
+   *  threads to communicate concurrently over duplicates of a grid. Collective
+   *  over all processes of comm().
+   *
+   *  @returns Duplicate of this grid
+   */
+  Grid duplicate() const;
+
+  /**
+   *  \brief Constuct the BLACS grid of the process row of this process.
+   *
+   *  Constructs a 1 x npc() grid for each process row. Process coordinates
+   *  within the row are retained. The first call is collective over all
+   *  processes of comm(), processes which are not a part of this grid obtain
+   *  an invalid grid. The grid is cached, later calls return grids which share
+   *  its BLACS context (without creating a new communicator or context).
+   *
+   *  @returns BLACS grid of the process row of this process
+   */
+  Grid row_grid() const;
+
+  /**
+   *  \brief Constuct the BLACS grid of the process column of this process.
+   *
+   *  Constructs a npr() x 1 grid for each process column. Process coordinates
+   *  within the column are retained. The first call is collective over all
+   *  processes of comm(), processes which are not a part of this grid obtain
+   *  an invalid grid. The grid is cached, later calls return grids which share
+   *  its BLACS context (without creating a new communicator or context).
+   *
+   *  @returns BLACS grid of the process column of this process
+   */
+  Grid col_grid() const;
+
+  /**
+   *  \brief Constuct a BLACS grid from a block of process coordinates of this grid.
+   *
+   *  Process (prow_begin, pcol_begin) of this grid becomes process (0,0) of the
+   *  sub-grid. Reuses the BLACS system handle of this grid (Cblacs_gridmap).
+   *  Collective over all processes of comm() with identical arguments, 
+   *  processes outside of the block obtain an invalid grid.
+   *
+   *  @param[in] prow_begin First process row of the sub-grid
+   *  @param[in] prow_end   One past the last process row of the sub-grid
+   *  @param[in] pcol_begin First process column of the sub-grid
+   *  @param[in] pcol_end   One past the last process column of the sub-grid
+   *  @returns   BLACS sub-grid
+   */
+  Grid subgrid( blacs_int prow_begin, blacs_int prow_end, 
+                blacs_int pcol_begin, blacs_int pcol_end ) const;
+
   /**
    *  \brief Constuct a close-to-square BLACS Grid.
    *
@@ -153,6 +641,74 @@ public:
    *  @returns        Square BLACS grid.
    */
   static Grid square_grid( const MPI_Comm& comm );
+
+  /**
+   *  \brief Obtain a BLACS grid from the process-wide grid cache.
+   *
+   *  Grids obtained for the same (communicator, npr, npc, process map) share
+   *  one reference counted BLACS context, which is created (collectively) for
+   *  the first of them and released (Cblacs_gridexit) with the last one. The
+   *  BLACS system handle of a communicator is likewise shared between all of
+   *  its cached contexts. Obtaining a grid whose context is cached is local
+   *  and issues no BLACS calls.
+   *
+   *  Grids which share a context also share its message space, i.e. they are
+   *  the same BLACS grid (unlike clones, which have distinct contexts). The
+   *  optional transports (enable_shared_memory etc.) are not shared. Grids
+   *  must be obtained and released consistently on all processes of comm, such
+   *  that they agree on whether a context is cached. Thread safe.
+   *
+   *  @param[in] comm  MPI Communicator
+   *  @param[in] npr   Number of process rows
+   *  @param[in] npc   Number of process columns
+   *  @param[in] order Ordering of the ranks of comm on the grid
+   *  @returns   BLACS grid
+   */
+  static Grid cached( const MPI_Comm& comm, blacs_int npr, blacs_int npc,
+                      GridOrder order = RowMajor );
+
+  /**
+   *  \brief Obtain a BLACS grid with a process map from the process-wide grid cache.
+   *
+   *  @param[in] comm  MPI Communicator
+   *  @param[in] npr   Number of process rows
+   *  @param[in] npc   Number of process columns
+   *  @param[in] pmap  Rank in comm of each process coordinate (col-major, npr x npc)
+   *  @returns   BLACS grid
+   */
+  static Grid cached( const MPI_Comm& comm, blacs_int npr, blacs_int npc,
+                      std::vector<blacs_int> pmap );
+
+  /**
+   *  \brief Returns the counters of the process-wide grid cache.
+   */
+  static grid_cache_stats cache_stats();
+
+  /**
+   *  \brief Construct a BLACS Grid which respects the node layout of a communicator.
+   *
+   *  Determines the shared memory nodes of the passed communicator 
+   *  (MPI_Comm_split_type) and maps the processes such that the process groups
+   *  of hint.locality (rows or columns) are contained in a node where possible.
+   *  If not specified, the grid dimensions are chosen as close to square as
+   *  possible while dividing the (smallest) node into whole process groups.
+   *  A single specified dimension must divide the size of comm.
+   *
+   *  @param[in] comm MPI Communicator from which the BLACS grid will be constructed.
+   *  @param[in] hint Placement hints
+   *  @returns        Node-aware BLACS grid.
+   */
+  static Grid node_aware_grid( const MPI_Comm& comm, 
+                               const node_hint& hint = node_hint() );
+
+  /**
+   *  \brief Report the node locality of the process groups of this grid.
+   *
+   *  Collective over all processes of comm().
+   *
+   *  @returns Intra-node fractions per scope
+   */
+  grid_locality locality() const;
 };
 
 }
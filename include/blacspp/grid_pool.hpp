@@ -0,0 +1,51 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief A pool of per-thread duplicates of a grid.
+ *
+ *  Each grid of the pool is a duplicate (see Grid::duplicate) of the prototype,
+ *  with its own MPI communicator and BLACS system handle, such that thread i may
+ *  communicate over pool[i] concurrently with the other threads (e.g. with
+ *  OpenMP, pool[ omp_get_thread_num() ]). Threads of different processes which
+ *  communicate with each other must use grids of the same index.
+ */
+class GridPool {
+
+  std::vector< Grid > grids_;
+
+public:
+
+  /**
+   *  \brief Construct a pool of duplicates of a grid.
+   *
+   *  Collective over all processes of grid.comm(). Throws std::runtime_error
+   *  if MPI does not provide MPI_THREAD_MULTIPLE.
+   *
+   *  @param[in] grid  (local) Prototype of the grids of the pool
+   *  @param[in] ngrid (global) Number of grids (typically the number of threads)
+   */
+  GridPool( const Grid& grid, std::size_t ngrid );
+
+  inline std::size_t size() const noexcept { return grids_.size(); }
+
+  inline       Grid& operator[]( std::size_t i )       noexcept { return grids_[i]; }
+  inline const Grid& operator[]( std::size_t i ) const noexcept { return grids_[i]; }
+
+  inline auto begin() noexcept { return grids_.begin(); }
+  inline auto end()   noexcept { return grids_.end();   }
+
+};
+
+}
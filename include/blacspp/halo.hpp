@@ -0,0 +1,238 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/request.hpp>
+#include <blacspp/util/sfinae.hpp>
+#include <blacspp/util/mpi_types.hpp>
+
+#include <initializer_list>
+#include <optional>
+#include <vector>
+
+namespace blacspp {
+
+/// Default MPI tag of halo exchanges (tags halo_tag ... halo_tag + 3 are used)
+inline constexpr int halo_tag = 2646;
+
+/**
+ *  \brief Nearest neighbours of a process on a BLACS grid
+ */
+enum HaloSide {
+  North, ///< Process (ipr-1, ipc)
+  South, ///< Process (ipr+1, ipc)
+  West,  ///< Process (ipr, ipc-1)
+  East   ///< Process (ipr, ipc+1)
+};
+
+/**
+ *  \brief Boundary conditions of a halo exchange
+ */
+struct halo_options {
+  bool periodic_column = false; ///< Wrap North / South around the process columns
+  bool periodic_row    = false; ///< Wrap West / East around the process rows
+  int  tag             = halo_tag;
+};
+
+/**
+ *  \brief Edge and halo of a col-major buffer which are exchanged with a neighbour
+ *
+ *  The (M,N) edge is sent to the neighbour at side, and the (M,N) halo is
+ *  recieved from it (the edge of the neighbour at the opposite side). Either
+ *  may be nullptr. Edges and halos may be strided (e.g. rows of a col-major
+ *  buffer), they are transferred in place through MPI vector datatypes.
+ *
+ *  @tparam T Element type. Must be BLACS enabled.
+ */
+template <typename T>
+struct halo_tile {
+  HaloSide  side;             ///< Neighbour which the tile is exchanged with
+  blacs_int M;                ///< Number of rows of the edge / halo
+  blacs_int N;                ///< Number of columns of the edge / halo
+  const T*  send = nullptr;   ///< Edge sent to the neighbour
+  blacs_int LDS  = 1;         ///< Leading dimension of the edge
+  T*        recv = nullptr;   ///< Halo recieved from the neighbour
+  blacs_int LDR  = 1;         ///< Leading dimension of the halo
+};
+
+namespace detail {
+
+  /**
+   *  \brief Process coordinate of the neighbour of this process at a side
+   *
+   *  @returns Neighbour, std::nullopt at a non-periodic boundary of the grid
+   */
+  std::optional<process_coordinate> halo_neighbour( const Grid& grid, HaloSide side,
+                                                    const halo_options& opts );
+
+  /// Size (bytes) of the edges of a range of tiles
+  template <typename T>
+  std::size_t halo_bytes( const halo_tile<T>* first, const halo_tile<T>* last ) noexcept {
+    std::size_t bytes = 0;
+    for( auto t = first; t != last; ++t )
+      if( t->send ) bytes += std::size_t(t->M) * std::size_t(t->N) * sizeof(T);
+    return bytes;
+  }
+
+}
+
+/**
+ *  \brief An outstanding halo exchange (see halo_exchange_begin).
+ *
+ *  Movable but not copyable, an outstanding exchange is completed upon
+ *  destruction.
+ */
+class HaloExchange {
+
+  std::vector< Request > reqs_;
+
+public:
+
+  HaloExchange() noexcept = default;
+
+  /**
+   *  \brief Post the transfers of a (type erased) tile.
+   *
+   *  @param[in] grid  BLACS grid which defines the neighbours
+   *  @param[in] opts  Boundary conditions of the exchange
+   *  @param[in] dtype MPI datatype of a single element
+   */
+  void post( const Grid& grid, const halo_options& opts, MPI_Datatype dtype,
+             HaloSide side, blacs_int M, blacs_int N, const void* send,
+             blacs_int LDS, void* recv, blacs_int LDR );
+
+  /**
+   *  \brief Block until all transfers of the exchange have completed.
+   */
+  void wait();
+
+  /**
+   *  \brief Check if all transfers of the exchange have completed without blocking.
+   */
+  bool test();
+
+  /// Number of posted transfers
+  inline std::size_t size() const noexcept { return reqs_.size(); }
+
+};
+
+/**
+ *  \brief Start a nearest neighbour (halo) exchange on a BLACS grid.
+ *
+ *  Posts the recieves and sends of all tiles at once (non-blocking), such
+ *  that no ordering of the exchanges is required to avoid deadlock. The
+ *  edges must not be modified, and the halos not accessed, until the exchange
+ *  has completed (halo_exchange_end), e.g. interior computations may proceed
+ *  in the meantime. Tiles at a non-periodic boundary of the grid are skipped.
+ *
+ *  Must be matched by an exchange with the same sequence of tiles (per side)
+ *  on the neighbours. Several tiles may be exchanged with the same side, they
+ *  are matched in order.
+ *
+ *  @tparam T Element type. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defines the neighbours
+ *  @param[in] first (local) Pointer to the first tile
+ *  @param[in] last  (local) Pointer to one past the last tile
+ *  @param[in] opts  (global) Boundary conditions of the exchange
+ *  @returns   Outstanding exchange
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, HaloExchange>
+  halo_exchange_begin( const Grid& grid, const halo_tile<T>* first,
+                       const halo_tile<T>* last,
+                       const halo_options& opts = halo_options() ) {
+
+  BLACSPP_PROFILE( "halo_exchange", -1, -1, detail::blacs_type_char_v<T>,
+    detail::halo_bytes( first, last ) );
+
+  HaloExchange ex;
+  for( auto t = first; t != last; ++t )
+    ex.post( grid, opts, detail::mpi_data_type<T>::type(), t->side, t->M, t->N,
+             t->send, t->LDS, t->recv, t->LDR );
+  return ex;
+
+}
+
+/**
+ *  \brief Start a nearest neighbour (halo) exchange on a BLACS grid.
+ *
+ *  @param[in] grid  (local) BLACS grid which defines the neighbours
+ *  @param[in] tiles (local) Tiles to exchange
+ *  @param[in] opts  (global) Boundary conditions of the exchange
+ *  @returns   Outstanding exchange
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, HaloExchange>
+  halo_exchange_begin( const Grid& grid, std::initializer_list< halo_tile<T> > tiles,
+                       const halo_options& opts = halo_options() ) {
+
+  return halo_exchange_begin( grid, tiles.begin(), tiles.end(), opts );
+
+}
+
+/**
+ *  \brief Start a nearest neighbour (halo) exchange on a BLACS grid.
+ *
+ *  @tparam Container Contiguous container of halo_tile.
+ *
+ *  @param[in] grid  (local) BLACS grid which defines the neighbours
+ *  @param[in] tiles (local) Tiles to exchange
+ *  @param[in] opts  (global) Boundary conditions of the exchange
+ *  @returns   Outstanding exchange
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container>, HaloExchange >
+  halo_exchange_begin( const Grid& grid, const Container& tiles,
+                       const halo_options& opts = halo_options() ) {
+
+  return halo_exchange_begin( grid, tiles.data(), tiles.data() + tiles.size(), opts );
+
+}
+
+/**
+ *  \brief Complete a halo exchange.
+ */
+inline void halo_exchange_end( HaloExchange& ex ) { 
+  BLACSPP_PROFILE( "halo_exchange_end", -1, -1, 0, 0 );
+  ex.wait(); 
+}
+
+/**
+ *  \brief Nearest neighbour (halo) exchange on a BLACS grid (blocking).
+ *
+ *  @param[in] grid  (local) BLACS grid which defines the neighbours
+ *  @param[in] tiles (local) Tiles to exchange
+ *  @param[in] opts  (global) Boundary conditions of the exchange
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  halo_exchange( const Grid& grid, std::initializer_list< halo_tile<T> > tiles,
+                 const halo_options& opts = halo_options() ) {
+
+  auto ex = halo_exchange_begin( grid, tiles, opts );
+  halo_exchange_end( ex );
+
+}
+
+/**
+ *  \brief Nearest neighbour (halo) exchange on a BLACS grid (blocking).
+ *
+ *  @tparam Container Contiguous container of halo_tile.
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container> >
+  halo_exchange( const Grid& grid, const Container& tiles,
+                 const halo_options& opts = halo_options() ) {
+
+  auto ex = halo_exchange_begin( grid, tiles, opts );
+  halo_exchange_end( ex );
+
+}
+
+}
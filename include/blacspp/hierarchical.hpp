@@ -0,0 +1,128 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Counters of the hierarchical collectives of a grid
+ */
+struct hierarchical_stats {
+  std::size_t broadcasts = 0; ///< Scope::All broadcasts performed hierarchically
+  std::size_t combines   = 0; ///< Scope::All sums performed hierarchically
+};
+
+namespace detail {
+
+/**
+ *  \brief Two-level (intra-node, then inter-node) collectives over a grid
+ *
+ *  The processes of the grid are partitioned into nodes, each of which has a
+ *  leader (its process of lowest rank in Grid::comm()). Collectives first
+ *  proceed among the processes of each node, then between the leaders, and
+ *  finally fan out within each node, such that only one message per node
+ *  crosses the network at each step of the inter-node exchange. The exchanges
+ *  are MPI collectives over per-node and leader communicators; (M,N,LDA) tiles
+ *  are packed into a contiguous scratch buffer if they are strided.
+ *
+ *  Sums are performed in a different order than the flat BLACS topologies,
+ *  the results are identical on all processes which recieve them.
+ */
+class hierarchical_transport {
+
+  MPI_Comm grid_comm_   = MPI_COMM_NULL; ///< Processes of the grid
+  MPI_Comm node_comm_   = MPI_COMM_NULL; ///< Processes of the grid on this node
+  MPI_Comm leader_comm_ = MPI_COMM_NULL; ///< Leaders of the nodes (MPI_COMM_NULL elsewhere)
+
+  blacs_int              nnodes_ = 0;
+  blacs_int              rank_   = 0; ///< Rank of this process in comm()
+  std::vector<blacs_int> node_;  ///< Node index of each rank of comm() (-1 if outside of the grid)
+  std::vector<blacs_int> local_; ///< Rank in its node of each rank of comm()
+
+  std::vector<char>  scratch_; ///< Contiguous copy of strided tiles
+  hierarchical_stats stats_;
+
+  void* contiguous( std::size_t elem_size, blacs_int M, blacs_int N, void* A,
+                    blacs_int LDA, bool pack );
+
+public:
+
+  /**
+   *  \brief Construct the hierarchical collectives of a grid.
+   *
+   *  Collective over all processes of Grid::comm().
+   *
+   *  @param[in] grid           BLACS grid
+   *  @param[in] ranks_per_node Number of consecutive ranks (in comm()) of the
+   *                            grid which form a node, 0: the shared memory
+   *                            nodes (MPI_Comm_split_type)
+   */
+  hierarchical_transport( const Grid& grid, blacs_int ranks_per_node );
+
+  hierarchical_transport( const hierarchical_transport& ) = delete;
+  hierarchical_transport& operator=( const hierarchical_transport& ) = delete;
+
+  /**
+   *  \brief Destroy the transport.
+   *
+   *  Collective over all processes of the grid.
+   */
+  ~hierarchical_transport() noexcept;
+
+  /// Number of nodes spanned by the grid
+  inline blacs_int nnodes() const noexcept { return nnodes_; }
+
+  /**
+   *  \brief Whether a (M,N) tile may be transferred by the hierarchical collectives
+   *
+   *  The tile is transferred as M*N elements, which must fit into an int (the
+   *  count of the MPI collectives). Larger tiles fall back to BLACS.
+   */
+  static inline bool fits( blacs_int M, blacs_int N ) noexcept {
+    return std::size_t(M) * std::size_t(N) <= std::size_t(INT_MAX);
+  }
+
+  inline const hierarchical_stats& stats() const noexcept { return stats_; }
+
+  /**
+   *  \brief Broadcast a (M,N,LDA) tile to all processes of the grid.
+   *
+   *  Collective over all processes of the grid. Throws std::runtime_error if
+   *  the tile does not fit (see fits).
+   *
+   *  @param[in]     type      MPI datatype of the elements
+   *  @param[in]     elem_size Size of an element in bytes
+   *  @param[in/out] A         Tile (sent on root, recieved elsewhere)
+   *  @param[in]     root      Rank (in comm()) of the root
+   */
+  void broadcast( MPI_Datatype type, std::size_t elem_size, blacs_int M,
+                  blacs_int N, void* A, blacs_int LDA, blacs_int root );
+
+  /**
+   *  \brief Element-wise sum of a (M,N,LDA) tile over all processes of the grid.
+   *
+   *  Collective over all processes of the grid. The result overwrites A on
+   *  the destination, the tile is left untouched elsewhere. Throws 
+   *  std::runtime_error if the tile does not fit (see fits).
+   *
+   *  @param[in]     type      MPI datatype of the elements
+   *  @param[in]     elem_size Size of an element in bytes
+   *  @param[in/out] A         Tile to sum
+   *  @param[in]     dest      Rank (in comm()) of the destination, -1: all processes
+   */
+  void sum( MPI_Datatype type, std::size_t elem_size, blacs_int M, blacs_int N,
+            void* A, blacs_int LDA, blacs_int dest );
+
+};
+
+}
+}
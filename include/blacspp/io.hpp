@@ -0,0 +1,170 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/distmatrix.hpp>
+#include <blacspp/util/mpi_types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace blacspp {
+
+/**
+ *  \brief Header of a tile file
+ *
+ *  Tile files start with a 64 byte header (magic "BLACSPPT", version, BLACS type
+ *  character, M, N, MB, NB in native byte order) followed by the MB x NB tiles
+ *  of the matrix in col-major tile order. Each tile is stored col-major with a
+ *  leading dimension equal to its number of rows (tiles of the last block
+ *  row / column may be smaller).
+ */
+struct tile_header {
+  char         type; ///< BLACS type character (i, s, d, c, z)
+  std::int64_t M;    ///< Number of rows of the matrix
+  std::int64_t N;    ///< Number of columns of the matrix
+  std::int64_t MB;   ///< Number of rows of a tile
+  std::int64_t NB;   ///< Number of columns of a tile
+};
+
+/// Size of the header of a tile file in bytes
+inline constexpr std::size_t tile_header_bytes = 64;
+
+/**
+ *  \brief Offset (bytes) of tile (bi, bj) in a tile file
+ */
+std::size_t tile_offset( const tile_header& h, std::int64_t bi, std::int64_t bj ) noexcept;
+
+/**
+ *  \brief Read the header of a tile file (local).
+ *
+ *  Throws std::runtime_error if the file cannot be read or is not a tile file.
+ */
+tile_header read_tile_header( const std::string& fname );
+
+/**
+ *  \brief A read-only memory mapping of a tile file (local).
+ *
+ *  Provides direct access to the tiles of a file, e.g. to read (or prefetch)
+ *  only the tiles which a process needs upon restart. Requires POSIX mmap,
+ *  throws std::runtime_error if unavailable.
+ */
+class MappedTileFile {
+
+  tile_header header_;
+  void*       base_  = nullptr;
+  std::size_t bytes_ = 0;
+
+public:
+
+  explicit MappedTileFile( const std::string& fname );
+
+  MappedTileFile( const MappedTileFile& ) = delete;
+  MappedTileFile& operator=( const MappedTileFile& ) = delete;
+
+  ~MappedTileFile() noexcept;
+
+  inline const tile_header& header() const noexcept { return header_; }
+
+  /// Number of rows / columns of tile (bi, bj)
+  std::int64_t tile_rows( std::int64_t bi ) const noexcept;
+  std::int64_t tile_cols( std::int64_t bj ) const noexcept;
+
+  /// Pointer to tile (bi, bj) (col-major, leading dimension tile_rows(bi))
+  const void* tile( std::int64_t bi, std::int64_t bj ) const noexcept;
+
+  /// Advise the system that tile (bi, bj) will be read soon (read-ahead)
+  void prefetch( std::int64_t bi, std::int64_t bj ) const noexcept;
+
+};
+
+namespace detail {
+
+  void write_darray( const std::string& fname, const Grid& grid,
+    const block_cyclic_layout& L, MPI_Datatype dtype, const void* A, blacs_int LDA );
+
+  void read_darray( const std::string& fname, const Grid& grid,
+    const block_cyclic_layout& L, MPI_Datatype dtype, void* A, blacs_int LDA );
+
+  void write_tiles( const std::string& fname, const Grid& grid,
+    const block_cyclic_layout& L, char type, std::size_t elem_size, const void* A,
+    blacs_int LDA );
+
+  void read_tiles( const std::string& fname, const Grid& grid,
+    const block_cyclic_layout& L, char type, std::size_t elem_size, void* A,
+    blacs_int LDA );
+
+}
+
+
+
+
+
+/**
+ *  \brief Write a distributed matrix as a raw col-major global matrix.
+ *
+ *  Collective over the processes of the grid of A (collective MPI-IO through a
+ *  darray file view). The file holds A.m() x A.n() elements in native
+ *  representation without header.
+ *
+ *  @param[in] fname (global) Name of the file
+ *  @param[in] A     (local) Distributed matrix
+ */
+template <typename T>
+void write_matrix( const std::string& fname, const DistMatrix<T>& A ) {
+  detail::write_darray( fname, A.grid(), detail::layout_of( A ),
+    detail::mpi_data_type<T>::type(), A.data(), A.lda() );
+}
+
+/**
+ *  \brief Read a distributed matrix from a raw col-major global matrix.
+ *
+ *  Collective over the processes of the grid of A. The file must hold at least
+ *  A.m() x A.n() elements.
+ *
+ *  @param[in]  fname (global) Name of the file
+ *  @param[out] A     (local) Distributed matrix
+ */
+template <typename T>
+void read_matrix( const std::string& fname, DistMatrix<T>& A ) {
+  detail::read_darray( fname, A.grid(), detail::layout_of( A ),
+    detail::mpi_data_type<T>::type(), A.data(), A.lda() );
+}
+
+/**
+ *  \brief Write a distributed matrix as a tile file (see tile_header).
+ *
+ *  Collective over the processes of the grid of A. Tiles are the MB x NB
+ *  blocks of A, such that every process writes whole tiles.
+ *
+ *  @param[in] fname (global) Name of the file
+ *  @param[in] A     (local) Distributed matrix
+ */
+template <typename T>
+void write_tiles( const std::string& fname, const DistMatrix<T>& A ) {
+  detail::write_tiles( fname, A.grid(), detail::layout_of( A ),
+    detail::blacs_type_char_v<T>, sizeof(T), A.data(), A.lda() );
+}
+
+/**
+ *  \brief Read a distributed matrix from a tile file.
+ *
+ *  Collective over the processes of the grid of A. The grid and block sizes of
+ *  A may differ from those the file has been written with; every process only
+ *  reads the parts of the tiles it owns. Throws std::runtime_error if the type
+ *  or dimensions of the file do not match A.
+ *
+ *  @param[in]  fname (global) Name of the file
+ *  @param[out] A     (local) Distributed matrix
+ */
+template <typename T>
+void read_tiles( const std::string& fname, DistMatrix<T>& A ) {
+  detail::read_tiles( fname, A.grid(), detail::layout_of( A ),
+    detail::blacs_type_char_v<T>, sizeof(T), A.data(), A.lda() );
+}
+
+}
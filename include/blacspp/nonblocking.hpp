@@ -0,0 +1,355 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/request.hpp>
+#include <blacspp/util/sfinae.hpp>
+#include <blacspp/util/mpi_types.hpp>
+
+namespace blacspp {
+
+/// Default MPI tag for non-blocking point-to-point operations
+inline constexpr int nonblocking_tag = 2641;
+
+namespace detail {
+
+  /**
+   *  \brief Translate a process coordinate to a rank in Grid::comm()
+   *
+   *  @param[in] grid  BLACS grid which defines the process coordinates
+   *  @param[in] PROW  Process row coordinate
+   *  @param[in] PCOL  Process column coordinate
+   *  @returns   Rank of the process in the MPI communicator of the grid
+   */
+  blacs_int comm_rank( const Grid& grid, const blacs_int PROW,
+                       const blacs_int PCOL );
+
+  /**
+   *  \brief Post a non-blocking send of a col-major (M,N,LDA) buffer
+   *
+   *  @param[in] comm  MPI communicator
+   *  @param[in] dtype MPI datatype of a single element
+   *  @param[in] M     Number of rows of the buffer to send
+   *  @param[in] N     Number of columns of the buffer to send
+   *  @param[in] A     Pointer of buffer to send
+   *  @param[in] LDA   Leading dimension of the buffer to send
+   *  @param[in] dest  Destination rank in comm
+   *  @param[in] tag   MPI tag
+   *  @returns   Request handle for the posted send
+   */
+  Request isend_2d( MPI_Comm comm, MPI_Datatype dtype,
+                    const blacs_int M, const blacs_int N, const void* A,
+                    const blacs_int LDA, const blacs_int dest, const int tag );
+
+  /**
+   *  \brief Post a non-blocking recieve of a col-major (M,N,LDA) buffer
+   *
+   *  @param[in] comm  MPI communicator
+   *  @param[in] dtype MPI datatype of a single element
+   *  @param[in] M     Number of rows of the buffer to recieve
+   *  @param[in] N     Number of columns of the buffer to recieve
+   *  @param[in] A     Pointer of buffer to store recieved data
+   *  @param[in] LDA   Leading dimension of the buffer to store recieved data
+   *  @param[in] src   Source rank in comm
+   *  @param[in] tag   MPI tag
+   *  @returns   Request handle for the posted recieve
+   */
+  Request irecv_2d( MPI_Comm comm, MPI_Datatype dtype,
+                    const blacs_int M, const blacs_int N, void* A,
+                    const blacs_int LDA, const blacs_int src, const int tag );
+
+  /**
+   *  \brief A committed MPI datatype which describes a col-major (M,N,LDA) buffer
+   *
+   *  Contiguous buffers (LDA == M or N == 1) are described by M*N elements of the
+   *  element type, strided buffers by a single MPI vector type (no packing).
+   *  Movable but not copyable.
+   */
+  class strided_type {
+
+    MPI_Datatype type_  = MPI_DATATYPE_NULL; ///< Datatype of the transfer
+    int          count_ = 0;                 ///< Number of type_ in the transfer
+    bool         owned_ = false;             ///< Whether type_ must be freed
+
+  public:
+
+    strided_type() noexcept = default;
+
+    /**
+     *  \brief Construct (and commit) the datatype of a (M,N,LDA) buffer
+     *
+     *  @param[in] dtype MPI datatype of a single element
+     *  @param[in] M     Number of rows of the buffer
+     *  @param[in] N     Number of columns of the buffer
+     *  @param[in] LDA   Leading dimension of the buffer
+     */
+    strided_type( MPI_Datatype dtype, const blacs_int M, const blacs_int N,
+                  const blacs_int LDA );
+
+    strided_type( const strided_type& ) = delete;
+    strided_type& operator=( const strided_type& ) = delete;
+
+    strided_type( strided_type&& other ) noexcept;
+    strided_type& operator=( strided_type&& other ) noexcept;
+
+    ~strided_type() noexcept;
+
+    inline MPI_Datatype type()  const noexcept { return type_;  }
+    inline int          count() const noexcept { return count_; }
+
+  };
+
+  /**
+   *  \brief Post a non-blocking send of a buffer described by a committed datatype
+   */
+  Request isend_2d( MPI_Comm comm, const strided_type& type, const void* A,
+                    const blacs_int dest, const int tag );
+
+  /**
+   *  \brief Post a non-blocking recieve of a buffer described by a committed datatype
+   */
+  Request irecv_2d( MPI_Comm comm, const strided_type& type, void* A,
+                    const blacs_int src, const int tag );
+
+}
+
+
+
+
+/**
+ *  \brief General non-blocking point-to-point 2D send.
+ *
+ *  Posts a general (rectangular) point-to-point 2D send on a BLACS grid.
+ *  Sends a 2D buffer (col-major) to a specified process coordinate on the BLACS
+ *  grid. The buffer must not be modified until the returned request has completed.
+ *
+ *  Must be matched by igerv2d on the destination process.
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *  @param[in] TAG   (local) MPI tag of the message
+ *  @returns   Request handle for the posted send
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, Request>
+  igesd2d( const Grid& grid,
+           const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA,
+           const blacs_int RDEST, const blacs_int CDEST,
+           const int TAG = nonblocking_tag ) {
+
+  BLACSPP_PROFILE( "igesd2d", -1, -1, detail::blacs_type_char_v<T>,
+    std::size_t(M) * std::size_t(N) * sizeof(T) );
+
+  return detail::isend_2d( grid.transfer_comm(), detail::mpi_data_type<T>::type(),
+                           M, N, A, LDA, detail::comm_rank( grid, RDEST, CDEST ), TAG );
+
+}
+
+/**
+ *  \brief General non-blocking point-to-point 2D send of a reinterpreted type.
+ *
+ *  Sends the buffer as a buffer of its transported type (see
+ *  reinterpreted_blacs_traits).
+ */
+template <typename T>
+detail::enable_if_blacs_reinterpreted_t<T, Request>
+  igesd2d( const Grid& grid,
+           const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA,
+           const blacs_int RDEST, const blacs_int CDEST,
+           const int TAG = nonblocking_tag ) {
+
+  using E = typename blacs_traits<T>::element_type;
+  return igesd2d( grid, detail::transported_extent<T>( M ), N, 
+                  reinterpret_cast<const E*>( A ), detail::transported_extent<T>( LDA ),
+                  RDEST, CDEST, TAG );
+
+}
+
+/**
+ *  \brief General non-blocking point-to-point 2D send.
+ *
+ *  Sends a buffer which is managed by a C++ container.
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Buffer to send (managed by some container)
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *  @param[in] TAG   (local) MPI tag of the message
+ *  @returns   Request handle for the posted send
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container>, Request >
+  igesd2d( const Grid& grid,
+           const blacs_int M, const blacs_int N, const Container& A,
+           const blacs_int LDA, const blacs_int RDEST, const blacs_int CDEST,
+           const int TAG = nonblocking_tag ) {
+
+  return igesd2d( grid, M, N, A.data(), LDA, RDEST, CDEST, TAG );
+
+}
+
+/**
+ *  \brief General non-blocking point-to-point 2D send.
+ *
+ *  Sends a buffer which is managed by a C++ container. Size of buffer deduced
+ *  from Container::size().
+ *
+ *  @tparam Container Type of container which manages the memory of the buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] A     (local) Buffer to send (managed by some container)
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *  @param[in] TAG   (local) MPI tag of the message
+ *  @returns   Request handle for the posted send
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container>, Request >
+  igesd2d( const Grid& grid, const Container& A,
+           const blacs_int RDEST, const blacs_int CDEST,
+           const int TAG = nonblocking_tag ) {
+
+  return igesd2d( grid, A.size(), 1, A, A.size(), RDEST, CDEST, TAG );
+
+}
+
+
+
+
+
+/**
+ *  \brief General non-blocking point-to-point 2D recieve.
+ *
+ *  Posts a general (rectangular) point-to-point 2D recieve on a BLACS grid.
+ *  Recieves a 2D buffer (col-major) from a specified source process coordinate
+ *  on the BLACS grid. The buffer must not be accessed until the returned request
+ *  has completed.
+ *
+ *  Must be matched by igesd2d on the source process.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to store recieved data
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of source process
+ *  @param[in]     CSRC  (local) Process column coordinate of source process
+ *  @param[in]     TAG   (local) MPI tag of the message
+ *  @returns       Request handle for the posted recieve
+ *
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, Request>
+  igerv2d( const Grid& grid, const blacs_int M, const blacs_int N,
+           T* A, const blacs_int LDA, const blacs_int RSRC,
+           const blacs_int CSRC, const int TAG = nonblocking_tag ) {
+
+  BLACSPP_PROFILE( "igerv2d", -1, -1, detail::blacs_type_char_v<T>,
+    std::size_t(M) * std::size_t(N) * sizeof(T) );
+
+  return detail::irecv_2d( grid.transfer_comm(), detail::mpi_data_type<T>::type(),
+                           M, N, A, LDA, detail::comm_rank( grid, RSRC, CSRC ), TAG );
+
+}
+
+/**
+ *  \brief General non-blocking point-to-point 2D recieve of a reinterpreted type.
+ *
+ *  Recieves the buffer as a buffer of its transported type (see
+ *  reinterpreted_blacs_traits).
+ */
+template <typename T>
+detail::enable_if_blacs_reinterpreted_t<T, Request>
+  igerv2d( const Grid& grid, const blacs_int M, const blacs_int N,
+           T* A, const blacs_int LDA, const blacs_int RSRC,
+           const blacs_int CSRC, const int TAG = nonblocking_tag ) {
+
+  using E = typename blacs_traits<T>::element_type;
+  return igerv2d( grid, detail::transported_extent<T>( M ), N, 
+                  reinterpret_cast<E*>( A ), detail::transported_extent<T>( LDA ),
+                  RSRC, CSRC, TAG );
+
+}
+
+/**
+ *  \brief General non-blocking point-to-point 2D recieve.
+ *
+ *  Recieve buffer managed by C++ container
+ *
+ *  @tparam Container Type of container which manages the memory of the revieve buffer.
+ *                    Must have Container::data() -> pointer member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Recieve buffer (managed by some container)
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of source process
+ *  @param[in]     CSRC  (local) Process column coordinate of source process
+ *  @param[in]     TAG   (local) MPI tag of the message
+ *  @returns       Request handle for the posted recieve
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_data_member_v<Container>, Request >
+  igerv2d( const Grid& grid, const blacs_int M, const blacs_int N,
+           Container& A, const blacs_int LDA, const blacs_int RSRC,
+           const blacs_int CSRC, const int TAG = nonblocking_tag ) {
+
+  return igerv2d( grid, M, N, A.data(), LDA, RSRC, CSRC, TAG );
+
+}
+
+/**
+ *  \brief General non-blocking point-to-point 2D recieve.
+ *
+ *  Recieve buffer managed by C++ container. Size of buffer deduced from Container::size()
+ *
+ *  @tparam Container Type of container which manages the memory of the revieve buffer.
+ *                    Must have Container::data() -> pointer member function and
+ *                    Container::size() -> std::size_t member function.
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in/out] A     (local) Recieve buffer (managed by some container)
+ *  @param[in]     RSRC  (local) Process row coordinate of source process
+ *  @param[in]     CSRC  (local) Process column coordinate of source process
+ *  @param[in]     TAG   (local) MPI tag of the message
+ *  @returns       Request handle for the posted recieve
+ *
+ */
+template <class Container>
+std::enable_if_t< detail::has_size_member_v<Container>, Request >
+  igerv2d( const Grid& grid, Container& A,
+           const blacs_int RSRC, const blacs_int CSRC,
+           const int TAG = nonblocking_tag ) {
+
+  return igerv2d( grid, A.size(), 1, A, A.size(), RSRC, CSRC, TAG );
+
+}
+
+}
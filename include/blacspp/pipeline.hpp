@@ -0,0 +1,223 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/broadcast.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace blacspp {
+
+/// Default size (bytes) of the column blocks of a pipelined broadcast
+inline constexpr std::size_t pipeline_chunk_default_bytes = std::size_t(1) << 20;
+
+/// Half-open column range [first, second) of a block
+using column_range = std::pair< blacs_int, blacs_int >;
+
+/**
+ *  \brief A pipelined general 2D broadcast.
+ *
+ *  Splits a col-major (M,N,LDA) buffer into blocks of NB columns which are 
+ *  broadcast one after another (gebs2d / gebr2d), such that processes may 
+ *  operate on the leading columns while later blocks are still in flight. With
+ *  ring or tree topologies, processes forward a block before the next one
+ *  arrives, which streams the buffer through the scope.
+ *
+ *  Every process of the scope constructs the pipeline with the same (M,N,NB)
+ *  and advances it with next() (or run()) until done(); the root sends and all
+ *  others recieve. The cursor columns_ready() reports the number of leading 
+ *  columns which have been sent / recieved.
+ *
+ *  @tparam T Type of buffer to broadcast. Must be BLACS enabled.
+ */
+template <typename T>
+class BroadcastPipeline {
+
+  const Grid* grid_;
+  Scope       scope_;
+  Topology    top_;
+  blacs_int   M_, N_, LDA_, NB_;
+  T*          A_;
+  blacs_int   RSRC_, CSRC_;
+  bool        is_root_;
+  blacs_int   ready_ = 0; ///< Number of leading columns sent / recieved
+
+public:
+
+  /**
+   *  \brief Construct a pipelined broadcast.
+   *
+   *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+   *  @param[in]     scope (local) Processes which participate in the broadcast
+   *  @param[in]     top   (local) Communication topology of the broadcast
+   *  @param[in]     M     (local) Number of rows of the buffer to broadcast
+   *  @param[in]     N     (local) Number of columns of the buffer to broadcast
+   *  @param[in/out] A     (local) Pointer of buffer to send (root) / to store
+   *                       recieved data (otherwise)
+   *  @param[in]     LDA   (local) Leading dimension of the buffer
+   *  @param[in]     RSRC  (local) Process row coordinate of the root
+   *  @param[in]     CSRC  (local) Process column coordinate of the root
+   *  @param[in]     NB    (local) Number of columns per block (0: blocks of
+   *                       pipeline_chunk_default_bytes)
+   */
+  BroadcastPipeline( const Grid& grid, const Scope scope, const Topology top,
+                     const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+                     const blacs_int RSRC, const blacs_int CSRC, 
+                     const blacs_int NB = 0 ) :
+    grid_( &grid ), scope_( scope ), top_( top ), M_( M ), N_( N ), LDA_( LDA ),
+    NB_( NB ), A_( A ), RSRC_( RSRC ), CSRC_( CSRC ),
+    is_root_( grid.ipr() == RSRC and grid.ipc() == CSRC ) {
+
+    if( NB < 0 ) throw std::runtime_error("Invalid Pipeline Block Size");
+    if( not NB_ ) 
+      NB_ = std::max( blacs_int( pipeline_chunk_default_bytes / 
+                                 std::max( M*sizeof(T), sizeof(T) ) ), 1 );
+
+  }
+
+  /**
+   *  \brief Whether this process is the root of the broadcast
+   */
+  inline bool is_root() const noexcept { return is_root_; }
+
+  /**
+   *  \brief Number of leading columns which have been sent / recieved
+   */
+  inline blacs_int columns_ready() const noexcept { return ready_; }
+
+  /**
+   *  \brief Number of columns per block
+   */
+  inline blacs_int block_size() const noexcept { return NB_; }
+
+  /**
+   *  \brief Whether all blocks have been sent / recieved
+   */
+  inline bool done() const noexcept { return ready_ >= N_; }
+
+  /**
+   *  \brief Send / recieve the next block.
+   *
+   *  @returns Column range [first, second) of the block (empty if done())
+   */
+  column_range next() {
+
+    if( done() ) return { N_, N_ };
+
+    const blacs_int j  = ready_;
+    const blacs_int nb = std::min( NB_, N_ - j );
+    T* A_j = A_ + std::size_t(j) * LDA_;
+
+    if( is_root_ ) gebs2d( *grid_, scope_, top_, M_, nb, A_j, LDA_ );
+    else           gebr2d( *grid_, scope_, top_, M_, nb, A_j, LDA_, RSRC_, CSRC_ );
+
+    ready_ = j + nb;
+    return { j, ready_ };
+
+  }
+
+  /**
+   *  \brief Send / recieve all remaining blocks.
+   *
+   *  @param[in] f Callback invoked as f( first, last ) with the column range 
+   *               of each block once it has been sent / recieved.
+   */
+  template <typename F>
+  void run( F&& f ) {
+    while( not done() ) {
+      const auto [first, last] = next();
+      f( first, last );
+    }
+  }
+
+  /**
+   *  \brief Send / recieve all remaining blocks.
+   */
+  void run() { while( not done() ) next(); }
+
+};
+
+
+
+
+/**
+ *  \brief Pipelined general 2D broadcast send.
+ *
+ *  See BroadcastPipeline. Must be matched by gebr2d_pipelined with the same
+ *  block size on all other processes of the scope.
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Processes which participate in the broadcast
+ *  @param[in] top   (local) Communication topology of the broadcast
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] A     (local) Pointer of buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] NB    (local) Number of columns per block (0: default)
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gebs2d_pipelined( const Grid& grid, const Scope scope, const Topology top,
+                    const blacs_int M, const blacs_int N, const T* A, 
+                    const blacs_int LDA, const blacs_int NB = 0 ) {
+
+  BroadcastPipeline<T>( grid, scope, top, M, N, const_cast<T*>(A), LDA, 
+                        grid.ipr(), grid.ipc(), NB ).run();
+
+}
+
+/**
+ *  \brief Pipelined general 2D broadcast recieve.
+ *
+ *  Invokes f( first, last ) once the columns [first, last) of A have been 
+ *  recieved, such that they may be operated upon while later columns are
+ *  still in flight.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *  @tparam F Type of the callback, invocable as f( blacs_int, blacs_int )
+ *
+ *  @param[in]     grid  (local) BLACS grid which defined the communication context.
+ *  @param[in]     scope (local) Processes which participate in the broadcast
+ *  @param[in]     top   (local) Communication topology of the broadcast
+ *  @param[in]     M     (local) Number of rows of the buffer to recieve
+ *  @param[in]     N     (local) Number of columns of the buffer to recieve
+ *  @param[in/out] A     (local) Pointer of buffer to store recieved data
+ *  @param[in]     LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in]     RSRC  (local) Process row coordinate of the broadcasting process
+ *  @param[in]     CSRC  (local) Process column coordinate of the broadcasting process
+ *  @param[in]     NB    (local) Number of columns per block (0: default)
+ *  @param[in]     f     (local) Per-block callback
+ */
+template <typename T, typename F>
+detail::enable_if_blacs_native_t<T>
+  gebr2d_pipelined( const Grid& grid, const Scope scope, const Topology top,
+                    const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+                    const blacs_int RSRC, const blacs_int CSRC, const blacs_int NB,
+                    F&& f ) {
+
+  BroadcastPipeline<T>( grid, scope, top, M, N, A, LDA, RSRC, CSRC, NB )
+    .run( std::forward<F>(f) );
+
+}
+
+/**
+ *  \brief Pipelined general 2D broadcast recieve (without callback).
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T>
+  gebr2d_pipelined( const Grid& grid, const Scope scope, const Topology top,
+                    const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+                    const blacs_int RSRC, const blacs_int CSRC, 
+                    const blacs_int NB = 0 ) {
+
+  BroadcastPipeline<T>( grid, scope, top, M, N, A, LDA, RSRC, CSRC, NB ).run();
+
+}
+
+}
@@ -0,0 +1,412 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/broadcast.hpp>
+#include <blacspp/hierarchical.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/wrappers/combine.hpp>
+#include <blacspp/util/type_conversions.hpp>
+
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief A recorded general 2D point-to-point send.
+ *
+ *  Captures the shape, destination and (translated) arguments of a send such
+ *  that repeated sends of the same pattern only pay for the transfer itself.
+ *  The MPI datatype of the (M,N,LDA) layout is committed once, upon construction.
+ *  execute() goes through the same transport dispatch as gesd2d (see
+ *  detail::send_2d), such that a plan may be paired with the regular calls on
+ *  the other end.
+ *
+ *  The grid must outlive the plan. Construct with plan_send.
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ */
+template <typename T>
+class SendPlan {
+
+  const Grid*          grid_;     ///< Grid of the plan
+  blacs_int            M_, N_, LDA_;
+  blacs_int            RDEST_, CDEST_;
+  blacs_int            dest_;     ///< Rank of the destination in Grid::comm()
+  int                  tag_;      ///< MPI tag of start()
+  detail::strided_type mpi_type_; ///< Committed datatype of the layout
+
+public:
+
+  SendPlan( const Grid& grid, const blacs_int M, const blacs_int N, 
+            const blacs_int LDA, const blacs_int RDEST, const blacs_int CDEST,
+            const int TAG = nonblocking_tag ) :
+    grid_( &grid ), M_( M ), N_( N ), LDA_( LDA ), RDEST_( RDEST ), 
+    CDEST_( CDEST ), dest_( grid.comm_rank( RDEST, CDEST ) ), tag_( TAG ),
+    mpi_type_( detail::mpi_data_type<T>::type(), M, N, LDA ) { }
+
+  /**
+   *  \brief Send a buffer (gesd2d).
+   *
+   *  Must be matched by gerv2d (or RecvPlan::execute) on the destination process.
+   *
+   *  @param[in] A (local) Pointer of buffer to send
+   */
+  void execute( const T* A ) const {
+    BLACSPP_PROFILE( "send_plan", -1, -1, detail::blacs_type_char_v<T>,
+      std::size_t(M_) * std::size_t(N_) * sizeof(T) );
+    detail::send_2d( *grid_, M_, N_, A, LDA_, RDEST_, CDEST_, dest_ );
+  }
+
+  /**
+   *  \brief Post a non-blocking send of a buffer (igesd2d).
+   *
+   *  Must be matched by igerv2d (or RecvPlan::start) on the destination process.
+   *
+   *  @param[in] A (local) Pointer of buffer to send
+   *  @returns   Request handle for the posted send
+   */
+  Request start( const T* A ) const {
+    return detail::isend_2d( grid_->transfer_comm(), mpi_type_, A, dest_, tag_ );
+  }
+
+};
+
+/**
+ *  \brief A recorded general 2D point-to-point recieve.
+ *
+ *  See SendPlan. Construct with plan_recv.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ */
+template <typename T>
+class RecvPlan {
+
+  const Grid*          grid_;     ///< Grid of the plan
+  blacs_int            M_, N_, LDA_;
+  blacs_int            RSRC_, CSRC_;
+  blacs_int            src_;      ///< Rank of the source in Grid::comm()
+  int                  tag_;      ///< MPI tag of start()
+  detail::strided_type mpi_type_; ///< Committed datatype of the layout
+
+public:
+
+  RecvPlan( const Grid& grid, const blacs_int M, const blacs_int N, 
+            const blacs_int LDA, const blacs_int RSRC, const blacs_int CSRC,
+            const int TAG = nonblocking_tag ) :
+    grid_( &grid ), M_( M ), N_( N ), LDA_( LDA ), RSRC_( RSRC ), 
+    CSRC_( CSRC ), src_( grid.comm_rank( RSRC, CSRC ) ), tag_( TAG ),
+    mpi_type_( detail::mpi_data_type<T>::type(), M, N, LDA ) { }
+
+  /**
+   *  \brief Recieve a buffer (gerv2d).
+   *
+   *  @param[out] A (local) Pointer of buffer to store recieved data
+   */
+  void execute( T* A ) const {
+    BLACSPP_PROFILE( "recv_plan", -1, -1, detail::blacs_type_char_v<T>,
+      std::size_t(M_) * std::size_t(N_) * sizeof(T) );
+    detail::recv_2d( *grid_, M_, N_, A, LDA_, RSRC_, CSRC_, src_ );
+  }
+
+  /**
+   *  \brief Post a non-blocking recieve of a buffer (igerv2d).
+   *
+   *  A must not be accessed until the returned request has completed.
+   *
+   *  @param[out] A (local) Pointer of buffer to store recieved data
+   *  @returns    Request handle for the posted recieve
+   */
+  Request start( T* A ) const {
+    return detail::irecv_2d( grid_->transfer_comm(), mpi_type_, A, src_, tag_ );
+  }
+
+};
+
+/**
+ *  \brief A recorded general 2D broadcast.
+ *
+ *  Captures scope, topology, shape and root of a broadcast. The topology is
+ *  resolved once (including the defaults / tuned topologies of the grid), as
+ *  are the processes of the scope. Processes of the scope execute the same plan
+ *  (or the matching gebs2d / gebr2d), the root sends and all others recieve.
+ *
+ *  The grid must outlive the plan. Construct with plan_broadcast.
+ *
+ *  @tparam T Type of buffer to broadcast. Must be BLACS enabled.
+ */
+template <typename T>
+class BroadcastPlan {
+
+  const Grid*            grid_;    ///< Grid of the plan
+  Scope                  scope_;
+  Topology               top_;
+  blacs_int              M_, N_, LDA_;
+  blacs_int              RSRC_, CSRC_;
+  bool                   is_root_; ///< Whether this process is the root
+  blacs_int              root_;    ///< Rank of the root in Grid::comm()
+  std::vector<blacs_int> ranks_;   ///< Ranks of the scope, excluding the root
+
+public:
+
+  BroadcastPlan( const Grid& grid, const Scope scope, const Topology top,
+                 const blacs_int M, const blacs_int N, const blacs_int LDA,
+                 const blacs_int RSRC, const blacs_int CSRC ) :
+    grid_( &grid ), scope_( scope ), top_( top ), M_( M ), N_( N ), LDA_( LDA ),
+    RSRC_( RSRC ), CSRC_( CSRC ), 
+    is_root_( grid.ipr() == RSRC and grid.ipc() == CSRC ),
+    root_( grid.comm_rank( RSRC, CSRC ) ), 
+    ranks_( detail::scope_ranks( grid, scope, RSRC, CSRC ) ) { }
+
+  /**
+   *  \brief Whether this process is the root of the broadcast
+   */
+  inline bool is_root() const noexcept { return is_root_; }
+
+  /**
+   *  \brief Broadcast a buffer (gebs2d on the root, gebr2d otherwise).
+   *
+   *  @param[in/out] A (local) Pointer of buffer to send (root) / to store
+   *                   recieved data (otherwise)
+   */
+  void execute( T* A ) const {
+    BLACSPP_PROFILE( "broadcast_plan", scope_, top_, detail::blacs_type_char_v<T>,
+      std::size_t(M_) * std::size_t(N_) * sizeof(T) );
+    detail::broadcast_2d( *grid_, scope_, top_, is_root_, M_, N_, A, LDA_, 
+                          RSRC_, CSRC_, root_, &ranks_ );
+  }
+
+};
+
+/**
+ *  \brief Element-wise operations of a recorded combine
+ */
+enum CombineOp {
+  Sum, ///< gsum2d
+  Max, ///< gamx2d
+  Min  ///< gamn2d
+};
+
+/**
+ *  \brief A recorded general 2D element-wise combine.
+ *
+ *  Captures operation, scope, topology, shape and destination of a combine.
+ *  Max/min plans do not report the location of the extrema.
+ *
+ *  The grid must outlive the plan. Construct with plan_combine.
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ */
+template <typename T>
+class CombinePlan {
+
+  const Grid* grid_; ///< Grid of the plan
+  CombineOp   op_;
+  Scope       scope_;
+  Topology    top_;
+  const char* SCOPE_;
+  const char* TOP_;
+  blacs_int   M_, N_, LDA_;
+  blacs_int   RDEST_, CDEST_;
+  blacs_int   dest_; ///< Rank of the destination in Grid::comm() (-1: all)
+
+public:
+
+  CombinePlan( const Grid& grid, const CombineOp op, const Scope scope, 
+               const Topology top, const blacs_int M, const blacs_int N, 
+               const blacs_int LDA, const blacs_int RDEST, const blacs_int CDEST ) :
+    grid_( &grid ), op_( op ), scope_( scope ), top_( top ),
+    SCOPE_( detail::type_string( scope ) ),
+    TOP_( detail::type_string( top ) ), M_( M ), N_( N ), LDA_( LDA ),
+    RDEST_( RDEST ), CDEST_( CDEST ), 
+    dest_( RDEST == -1 ? -1 : grid.comm_rank( RDEST, CDEST ) ) { }
+
+  /**
+   *  \brief Combine a buffer.
+   *
+   *  @param[in/out] A (local) Pointer of buffer to combine
+   */
+  void execute( T* A ) const {
+
+    BLACSPP_PROFILE( "combine_plan", scope_, top_, detail::blacs_type_char_v<T>,
+      std::size_t(M_) * std::size_t(N_) * sizeof(T) );
+
+    if( const auto& hier = grid_->hierarchical() )
+      if( op_ == Sum and scope_ == All and hier->fits( M_, N_ ) )
+        return hier->sum( detail::mpi_data_type<T>::type(), sizeof(T), M_, N_, A,
+                          LDA_, dest_ );
+
+    switch( op_ ) {
+      case Sum:
+        wrappers::gsum2d( grid_->context(), SCOPE_, TOP_, M_, N_, A, LDA_, 
+                          RDEST_, CDEST_ );
+        break;
+      case Max:
+        wrappers::gamx2d( grid_->context(), SCOPE_, TOP_, M_, N_, A, LDA_, 
+                          nullptr, nullptr, -1, RDEST_, CDEST_ );
+        break;
+      case Min:
+        wrappers::gamn2d( grid_->context(), SCOPE_, TOP_, M_, N_, A, LDA_, 
+                          nullptr, nullptr, -1, RDEST_, CDEST_ );
+        break;
+    }
+
+  }
+
+};
+
+
+
+
+/**
+ *  \brief Record a general 2D point-to-point send.
+ *
+ *  @tparam T Type of buffer to send. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] M     (local) Number of rows of the buffer to send
+ *  @param[in] N     (local) Number of columns of the buffer to send
+ *  @param[in] LDA   (local) Leading dimension of the buffer to send
+ *  @param[in] RDEST (local) Process row coordinate of destination process
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ *  @param[in] TAG   (local) MPI tag of non-blocking sends (SendPlan::start)
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, SendPlan<T>>
+  plan_send( const Grid& grid, const blacs_int M, const blacs_int N, 
+             const blacs_int LDA, const blacs_int RDEST, const blacs_int CDEST,
+             const int TAG = nonblocking_tag ) {
+
+  return SendPlan<T>( grid, M, N, LDA, RDEST, CDEST, TAG );
+
+}
+
+/**
+ *  \brief Record a general 2D point-to-point recieve.
+ *
+ *  @tparam T Type of buffer to recieve. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] M     (local) Number of rows of the buffer to recieve
+ *  @param[in] N     (local) Number of columns of the buffer to recieve
+ *  @param[in] LDA   (local) Leading dimension of the buffer to store recieved data.
+ *  @param[in] RSRC  (local) Process row coordinate of source process
+ *  @param[in] CSRC  (local) Process column coordinate of source process
+ *  @param[in] TAG   (local) MPI tag of non-blocking recieves (RecvPlan::start)
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, RecvPlan<T>>
+  plan_recv( const Grid& grid, const blacs_int M, const blacs_int N, 
+             const blacs_int LDA, const blacs_int RSRC, const blacs_int CSRC,
+             const int TAG = nonblocking_tag ) {
+
+  return RecvPlan<T>( grid, M, N, LDA, RSRC, CSRC, TAG );
+
+}
+
+/**
+ *  \brief Record a general 2D broadcast.
+ *
+ *  @tparam T Type of buffer to broadcast. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] scope (local) Processes which participate in the broadcast
+ *  @param[in] top   (local) Communication topology of the broadcast
+ *  @param[in] M     (local) Number of rows of the buffer to broadcast
+ *  @param[in] N     (local) Number of columns of the buffer to broadcast
+ *  @param[in] LDA   (local) Leading dimension of the buffer to broadcast
+ *  @param[in] RSRC  (local) Process row coordinate of the root
+ *  @param[in] CSRC  (local) Process column coordinate of the root
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, BroadcastPlan<T>>
+  plan_broadcast( const Grid& grid, const Scope scope, const Topology top,
+                  const blacs_int M, const blacs_int N, const blacs_int LDA,
+                  const blacs_int RSRC, const blacs_int CSRC ) {
+
+  return BroadcastPlan<T>( grid, scope, top, M, N, LDA, RSRC, CSRC );
+
+}
+
+/**
+ *  \brief Record a general 2D broadcast from the origin of the scope.
+ *
+ *  Root is (0,0) for Scope::All, (ipr,0) for Scope::Row and (0,ipc) for 
+ *  Scope::Column.
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, BroadcastPlan<T>>
+  plan_broadcast( const Grid& grid, const Scope scope, const Topology top,
+                  const blacs_int M, const blacs_int N, const blacs_int LDA ) {
+
+  const auto [RSRC, CSRC] = detail::scope_origin( grid, scope );
+  return plan_broadcast<T>( grid, scope, top, M, N, LDA, RSRC, CSRC );
+
+}
+
+/**
+ *  \brief Record a general 2D broadcast from the origin of the scope with the
+ *  topology of the grid.
+ *
+ *  The topology is selected once from Grid::broadcast_topology( scope, bytes ).
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, BroadcastPlan<T>>
+  plan_broadcast( const Grid& grid, const Scope scope, const blacs_int M, 
+                  const blacs_int N, const blacs_int LDA ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  return plan_broadcast<T>( grid, scope, 
+    grid.broadcast_topology( scope, bytes ), M, N, LDA );
+
+}
+
+/**
+ *  \brief Record a general 2D element-wise combine.
+ *
+ *  @tparam T Type of buffer to combine. Must be BLACS enabled.
+ *
+ *  @param[in] grid  (local) BLACS grid which defined the communication context.
+ *  @param[in] op    (local) Element-wise operation
+ *  @param[in] scope (local) Processes which participate in the combine
+ *  @param[in] top   (local) Communication topology of the combine
+ *  @param[in] M     (local) Number of rows of the buffer to combine
+ *  @param[in] N     (local) Number of columns of the buffer to combine
+ *  @param[in] LDA   (local) Leading dimension of the buffer to combine
+ *  @param[in] RDEST (local) Process row coordinate of destination process (-1: all)
+ *  @param[in] CDEST (local) Process column coordinate of desination process
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, CombinePlan<T>>
+  plan_combine( const Grid& grid, const CombineOp op, const Scope scope, 
+                const Topology top, const blacs_int M, const blacs_int N, 
+                const blacs_int LDA, const blacs_int RDEST = -1, 
+                const blacs_int CDEST = -1 ) {
+
+  return CombinePlan<T>( grid, op, scope, top, M, N, LDA, RDEST, CDEST );
+
+}
+
+/**
+ *  \brief Record a general 2D element-wise combine (all-reduce) with the 
+ *  topology of the grid.
+ *
+ *  The topology is selected once from Grid::combine_topology( scope, bytes ).
+ */
+template <typename T>
+detail::enable_if_blacs_native_t<T, CombinePlan<T>>
+  plan_combine( const Grid& grid, const CombineOp op, const Scope scope, 
+                const blacs_int M, const blacs_int N, const blacs_int LDA ) {
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+  return plan_combine<T>( grid, op, scope, 
+    grid.combine_topology( scope, bytes ), M, N, LDA );
+
+}
+
+}
@@ -0,0 +1,213 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/types.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace blacspp {
+
+/// Number of (log2, microsecond) latency buckets of a profile entry
+inline constexpr std::size_t profile_histogram_bins = 32;
+
+/**
+ *  \brief Identifies a class of profiled calls
+ *
+ *  scope / top are -1 for operations which have none (e.g. point-to-point), 
+ *  type is 0 for untyped operations (e.g. barriers).
+ */
+struct profile_key {
+  std::string name;  ///< Entry point (e.g. "gebs2d")
+  int         scope; ///< Scope of the operation (-1: none)
+  int         top;   ///< Topology of the operation (-1: none)
+  char        type;  ///< BLACS type character (0: none)
+
+  bool operator<( const profile_key& other ) const noexcept;
+};
+
+/**
+ *  \brief Accumulated statistics of a class of profiled calls
+ */
+struct profile_entry {
+  std::size_t count = 0;  ///< Number of calls
+  std::size_t bytes = 0;  ///< Total payload in bytes
+  double      total = 0.; ///< Total time in seconds
+  double      min   = 0.; ///< Shortest call in seconds
+  double      max   = 0.; ///< Longest call in seconds
+
+  /// Number of calls with latency in [2^i, 2^(i+1)) microseconds (first: < 2us)
+  std::array< std::size_t, profile_histogram_bins > histogram = {};
+};
+
+/**
+ *  \brief Whether the instrumentation of the entry points has been compiled in
+ *
+ *  See BLACSPP_ENABLE_PROFILING. If disabled, the Profiler does not record
+ *  any calls and the entry points carry no instrumentation.
+ */
+constexpr bool profiling_enabled() noexcept {
+#if defined(BLACSPP_ENABLE_PROFILING)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ *  \brief Per-process collector of the profiled blacspp calls.
+ *
+ *  Records per (entry point, scope, topology, type) counts, bytes and latency
+ *  histograms, and optionally a trace of every call which may be written in 
+ *  the Chrome trace event format (chrome://tracing, Perfetto).
+ *
+ *  Thread safe: calls from several threads are recorded under a lock, trace 
+ *  events carry the index of the recording thread.
+ */
+class Profiler {
+
+  struct trace_event {
+    const char* name;
+    double      start;
+    double      duration;
+    std::size_t bytes;
+    int         tid;
+  };
+
+  using entry_key = std::tuple< const char*, int, int, char >;
+
+  std::map< entry_key, profile_entry >   entries_; ///< Keyed by the (static) name of the entry point
+  std::vector< trace_event >             trace_;
+  std::atomic<bool>                      tracing_{false};
+  mutable std::mutex                     mutex_;        ///< Guards entries_ and trace_
+  double                                 origin_;       ///< Time origin of the trace
+  std::string                            exit_report_;  ///< Path prefix of reports on grid exit
+
+  Profiler();
+
+public:
+
+  /**
+   *  \brief Returns the profiler of this process
+   */
+  static Profiler& instance();
+
+  /**
+   *  \brief Record a call.
+   *
+   *  @param[in] name  Entry point (string with static storage duration)
+   *  @param[in] scope Scope of the operation (-1: none)
+   *  @param[in] top   Topology of the operation (-1: none)
+   *  @param[in] type  BLACS type character (0: none)
+   *  @param[in] bytes Payload in bytes
+   *  @param[in] start Start of the call (MPI_Wtime)
+   *  @param[in] end   End of the call (MPI_Wtime)
+   */
+  void record( const char* name, int scope, int top, char type, std::size_t bytes,
+               double start, double end );
+
+  /**
+   *  \brief Discard all recorded calls
+   */
+  void reset();
+
+  /**
+   *  \brief Enable / disable the recording of a trace of every call
+   */
+  inline void enable_tracing( bool enable = true ) noexcept { tracing_ = enable; }
+  inline bool tracing() const noexcept { return tracing_; }
+
+  /**
+   *  \brief Returns the accumulated statistics of this process
+   */
+  std::map< profile_key, profile_entry > entries() const;
+
+  /**
+   *  \brief Write the summary of this process.
+   */
+  void report( std::ostream& out ) const;
+
+  /**
+   *  \brief Write the summary reduced over the processes of a communicator.
+   *
+   *  Collective over comm, the summary is written on rank 0. Reports per call
+   *  class the total count / bytes and the min / avg / max time spent per 
+   *  process, which exposes load imbalance.
+   */
+  void report( std::ostream& out, MPI_Comm comm ) const;
+
+  /**
+   *  \brief Write the trace of this process in the Chrome trace event format.
+   *
+   *  @param[in] pid Process id of the events (e.g. the rank in MPI_COMM_WORLD)
+   */
+  void write_chrome_trace( std::ostream& out, int pid ) const;
+  void write_chrome_trace( const std::string& fname, int pid ) const;
+
+  /**
+   *  \brief Write the summary of this process upon destruction of each grid.
+   *
+   *  The report is written to "<prefix>.<rank>.txt" (rank in MPI_COMM_WORLD).
+   *  Defaults to the value of BLACSPP_PROFILE_REPORT in the environment (if set).
+   *  An empty prefix disables the report.
+   */
+  inline void set_exit_report( std::string prefix ) { exit_report_ = std::move(prefix); }
+
+  /**
+   *  \brief Write the exit report (if requested), called by Grid::~Grid
+   */
+  void grid_exit() const noexcept;
+
+};
+
+namespace detail {
+
+/**
+ *  \brief Times the enclosing scope and records it with the Profiler.
+ */
+class profile_region {
+
+  const char* name_;
+  int         scope_, top_;
+  char        type_;
+  std::size_t bytes_;
+  double      start_;
+
+public:
+
+  profile_region( const char* name, int scope, int top, char type, 
+                  std::size_t bytes ) noexcept;
+
+  profile_region( const profile_region& ) = delete;
+  profile_region& operator=( const profile_region& ) = delete;
+
+  ~profile_region() noexcept;
+
+};
+
+}
+}
+
+/**
+ *  \brief Instrument the enclosing scope of a blacspp entry point
+ *
+ *  Expands to nothing unless BLACSPP_ENABLE_PROFILING is defined.
+ */
+#if defined(BLACSPP_ENABLE_PROFILING)
+  #define BLACSPP_PROFILE( NAME, SCOPE, TOP, TYPE, BYTES ) \
+    ::blacspp::detail::profile_region blacspp_profile_region_( NAME, SCOPE, TOP, TYPE, BYTES )
+#else
+  #define BLACSPP_PROFILE( NAME, SCOPE, TOP, TYPE, BYTES ) ((void)0)
+#endif
@@ -0,0 +1,220 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/request.hpp>
+#include <blacspp/pipeline.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace blacspp {
+
+/// How a progress engine advances its operations
+enum class ProgressMode {
+  Polling, ///< Only within poll() (and ProgressTicket::wait()) from user code
+  Thread   ///< Additionally from a dedicated background thread
+};
+
+/**
+ *  \brief Parameters of a progress engine
+ */
+struct progress_options {
+  ProgressMode              mode           = ProgressMode::Polling;
+  std::size_t               queue_capacity = 1024; ///< Submission slots (rounded up to a power of two)
+  std::chrono::microseconds idle_sleep     = std::chrono::microseconds(50); ///< Sleep of an idle thread
+};
+
+class ProgressEngine;
+
+namespace detail {
+
+  /// Shared state of a submitted operation
+  struct progress_state {
+    std::function<bool()> step;        ///< Advances the operation, true once complete
+    std::function<void()> on_complete; ///< Invoked once complete, outside of the polling lock (optional)
+    std::atomic<bool>      done{false};
+    std::exception_ptr     error;      ///< Exception thrown by step (if any)
+  };
+
+  /**
+   *  \brief Bounded lock-free multi-producer / multi-consumer queue
+   *
+   *  Each slot carries a sequence number which tells producers and consumers
+   *  whether it is free or full for the current lap, such that push / pop only
+   *  contend on a single atomic position each.
+   */
+  class submission_queue {
+
+    struct cell {
+      std::atomic<std::size_t>          seq;
+      std::shared_ptr< progress_state > op;
+    };
+
+    std::unique_ptr< cell[] > cells_;
+    std::size_t               mask_;
+
+    alignas(64) std::atomic<std::size_t> head_{0}; ///< Next slot to push
+    alignas(64) std::atomic<std::size_t> tail_{0}; ///< Next slot to pop
+
+  public:
+
+    explicit submission_queue( std::size_t capacity );
+
+    /// Returns false if the queue is full
+    bool push( std::shared_ptr< progress_state >& op ) noexcept;
+
+    /// Returns false if the queue is empty
+    bool pop( std::shared_ptr< progress_state >& op ) noexcept;
+
+  };
+
+}
+
+/**
+ *  \brief A handle of an operation submitted to a progress engine.
+ *
+ *  Copyable. The engine must outlive its tickets.
+ */
+class ProgressTicket {
+
+  std::shared_ptr< detail::progress_state > state_;
+  ProgressEngine*                           engine_ = nullptr;
+
+public:
+
+  ProgressTicket() noexcept = default;
+  ProgressTicket( std::shared_ptr< detail::progress_state > s, ProgressEngine* e ) noexcept :
+    state_( std::move(s) ), engine_( e ) { }
+
+  /**
+   *  \brief Whether the operation has completed (true for an empty ticket)
+   */
+  bool done() const noexcept;
+
+  /**
+   *  \brief Block until the operation has completed.
+   *
+   *  Polls the engine while waiting (such that waiting also progresses the
+   *  engine in ProgressMode::Polling). Rethrows an exception of the operation.
+   */
+  void wait();
+
+};
+
+/**
+ *  \brief An engine which advances non-blocking blacspp operations.
+ *
+ *  MPI (and thus BLACS) only progress communication inside of calls, such that
+ *  a process which is busy in a long local kernel stalls its peers. Operations
+ *  submitted to the engine are advanced by poll(), which user code may call
+ *  from long kernels, and with ProgressMode::Thread also by a dedicated
+ *  background thread.
+ *
+ *  Submission goes through a lock-free queue and may be issued concurrently from
+ *  several threads. Operations are only advanced by a single thread at a time.
+ *  ProgressMode::Thread requires MPI_THREAD_MULTIPLE; operations which submit
+ *  BLACS calls (e.g. pipelines) must not use their grid concurrently from other
+ *  threads.
+ *
+ *  Outstanding operations are completed upon destruction.
+ */
+class ProgressEngine {
+
+  progress_options         opts_;
+  detail::submission_queue queue_;
+
+  std::vector< std::shared_ptr< detail::progress_state > > active_; ///< Owned by the polling thread
+
+  std::atomic<bool>        polling_{false}; ///< Whether a thread is inside poll()
+  std::atomic<std::size_t> pending_{0};     ///< Submitted operations not yet completed
+  std::atomic<bool>        stop_{false};
+  std::thread              thread_;
+
+  void run() noexcept;
+
+public:
+
+  /**
+   *  \brief Construct a progress engine.
+   *
+   *  Starts the background thread for ProgressMode::Thread. Throws
+   *  std::runtime_error if MPI has not been initialized with
+   *  MPI_THREAD_MULTIPLE in this case.
+   */
+  explicit ProgressEngine( const progress_options& opts = progress_options() );
+
+  ProgressEngine( const ProgressEngine& ) = delete;
+  ProgressEngine& operator=( const ProgressEngine& ) = delete;
+
+  ~ProgressEngine() noexcept;
+
+  inline ProgressMode mode() const noexcept { return opts_.mode; }
+
+  /**
+   *  \brief Number of submitted operations which have not yet completed
+   */
+  inline std::size_t pending() const noexcept { return pending_.load(); }
+
+  /**
+   *  \brief Submit a general operation.
+   *
+   *  Thread safe.
+   *
+   *  @param[in] step Callable which advances the operation without blocking
+   *                  (for long) and returns true once the operation is complete
+   *  @returns   Ticket of the operation
+   */
+  ProgressTicket submit( std::function<bool()> step );
+
+  /**
+   *  \brief Submit a general operation with a completion callback.
+   *
+   *  Thread safe. on_complete is invoked (by the polling thread) once step has
+   *  returned true, after the engine has released its polling lock, such that
+   *  it may submit further operations (e.g. resume a coroutine). It must not
+   *  throw.
+   */
+  ProgressTicket submit( std::function<bool()> step, std::function<void()> on_complete );
+
+  /**
+   *  \brief Submit a non-blocking MPI / blacspp request (takes ownership).
+   */
+  ProgressTicket submit( Request&& req );
+
+  /**
+   *  \brief Submit a pipelined broadcast.
+   *
+   *  Every poll advances the pipeline by a single block. The pipeline must
+   *  outlive the operation.
+   */
+  template <typename T>
+  ProgressTicket submit( BroadcastPipeline<T>& pipe ) {
+    return submit( [&pipe]() { pipe.next(); return pipe.done(); } );
+  }
+
+  /**
+   *  \brief Advance all submitted operations once.
+   *
+   *  Thread safe. Returns immediately if another thread is polling.
+   *
+   *  @returns Number of operations which have completed
+   */
+  std::size_t poll() noexcept;
+
+  /**
+   *  \brief Block until all submitted operations have completed.
+   */
+  void quiesce() noexcept;
+
+};
+
+}
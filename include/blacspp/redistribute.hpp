@@ -0,0 +1,224 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/distmatrix.hpp>
+#include <blacspp/profile.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace blacspp {
+
+/// MPI tag of the messages of a redistribution
+inline constexpr int redistribution_tag = 2643;
+
+/**
+ *  \brief Parameters of a redistribution
+ *
+ *  Both parameters must be identical on all processes of the communicator.
+ */
+struct redistribution_options {
+  std::size_t scratch_bytes = std::size_t(1) << 26; ///< Budget of the send + recieve buffers
+  std::size_t piece_bytes   = std::size_t(1) << 20; ///< Target size of a single message
+};
+
+/**
+ *  \brief Counters of the exchanges of a redistribution (per process)
+ */
+struct redistribution_stats {
+  std::size_t sends       = 0; ///< Messages sent per execution
+  std::size_t recvs       = 0; ///< Messages recieved per execution
+  std::size_t bytes_sent  = 0; ///< Bytes sent per execution
+  std::size_t local_bytes = 0; ///< Bytes copied locally (without MPI) per execution
+  std::size_t scratch     = 0; ///< Size of the scratch buffers in bytes
+};
+
+namespace detail {
+
+/**
+ *  \brief The communication schedule between two block-cyclic layouts
+ *
+ *  Built once per (source, destination) layout pair. Each dimension of the
+ *  matrix is split into segments which have a single owner in both layouts,
+ *  such that every message consists of contiguous runs of local rows within
+ *  a set of local columns on both ends. Messages are split by columns into
+ *  pieces of about piece_bytes.
+ *
+ *  Execution exchanges the pieces in a rotated order (send to rank + k,
+ *  recieve from rank - k), packing the next piece while previous ones are in
+ *  flight, with at most scratch_bytes of outstanding buffers. The exchange
+ *  with the process itself is a direct copy.
+ */
+class redistribution_schedule {
+
+public:
+
+  /// A run of consecutive local indices
+  struct run {
+    blacs_int start;
+    blacs_int len;
+  };
+
+  /// Runs of local rows / columns exchanged with each process row / column
+  using dim_runs = std::vector< std::vector<run> >;
+
+  /// A piece of a message: columns [c0, c1) of its (flattened) columns
+  struct piece {
+    int         rank;   ///< Peer in the communicator
+    blacs_int   row;    ///< Peer process row (in the layout of the peer)
+    blacs_int   col;    ///< Peer process column (in the layout of the peer)
+    blacs_int   c0, c1;
+    std::size_t bytes;
+  };
+
+private:
+
+  MPI_Comm    comm_;
+  std::size_t elem_size_;
+
+  dim_runs send_rows_, send_cols_; ///< Local runs of the source, per destination row / column
+  dim_runs recv_rows_, recv_cols_; ///< Local runs of the destination, per source row / column
+
+  std::vector< piece > send_pieces_; ///< In the order of execution
+  std::vector< piece > recv_pieces_; ///< In the order of execution
+
+  /// Local (source row, destination row, length) and (source col, destination col, length) runs
+  std::vector< std::array<blacs_int,3> > self_rows_, self_cols_;
+
+  std::size_t slot_bytes_ = 0;
+  std::size_t nslots_     = 0; ///< Slots per direction
+  std::vector< char, aligned_allocator<char> > scratch_;
+
+  redistribution_stats stats_;
+
+  void pack( const piece& p, const char* A, blacs_int LDA, char* buf ) const noexcept;
+  void unpack( const piece& p, const char* buf, char* B, blacs_int LDB ) const noexcept;
+
+public:
+
+  /**
+   *  \brief Build the schedule.
+   *
+   *  Collective over all processes of comm.
+   *
+   *  @param[in] src       Layout of the source matrix
+   *  @param[in] dst       Layout of the destination matrix
+   *  @param[in] comm      Communicator which contains the processes of both grids
+   *  @param[in] elem_size Size of the matrix elements in bytes
+   *  @param[in] opts      Parameters of the redistribution
+   */
+  redistribution_schedule( const block_cyclic_layout& src,
+    const block_cyclic_layout& dst, MPI_Comm comm, std::size_t elem_size,
+    const redistribution_options& opts );
+
+  redistribution_schedule( const redistribution_schedule& ) = delete;
+  redistribution_schedule& operator=( const redistribution_schedule& ) = delete;
+
+  ~redistribution_schedule() noexcept;
+
+  /**
+   *  \brief Redistribute a matrix.
+   *
+   *  Collective over all processes of comm.
+   *
+   *  @param[in]  A   Local storage of the source matrix
+   *  @param[in]  LDA Leading dimension of A
+   *  @param[out] B   Local storage of the destination matrix
+   *  @param[in]  LDB Leading dimension of B
+   */
+  void execute( const void* A, blacs_int LDA, void* B, blacs_int LDB );
+
+  inline const redistribution_stats& stats() const noexcept { return stats_; }
+
+};
+
+}
+
+
+
+
+
+/**
+ *  \brief A reusable redistribution between two block-cyclic layouts.
+ *
+ *  Redistributes matrices with the layouts of the matrices passed on
+ *  construction (e.g. a change of block size, or a move onto another grid).
+ *  The communicator must contain the processes of both grids, every process
+ *  of the communicator participates in construction and execution.
+ *
+ *  @tparam T Type of the matrix elements. Must be BLACS enabled.
+ */
+template <typename T>
+class RedistributionPlan {
+
+  detail::block_cyclic_layout src_, dst_;
+  std::unique_ptr< detail::redistribution_schedule > sched_;
+
+public:
+
+  /**
+   *  \brief Build the schedule of a redistribution.
+   *
+   *  Collective over all processes of comm.
+   *
+   *  @param[in] A    (local) Matrix with the source layout
+   *  @param[in] B    (local) Matrix with the destination layout
+   *  @param[in] comm (local) Communicator which contains the processes of both grids
+   *  @param[in] opts (global) Parameters of the redistribution
+   */
+  RedistributionPlan( const DistMatrix<T>& A, const DistMatrix<T>& B, MPI_Comm comm,
+    const redistribution_options& opts = redistribution_options() ) :
+    src_( detail::layout_of( A ) ), dst_( detail::layout_of( B ) ) {
+
+    if( A.m() != B.m() or A.n() != B.n() )
+      throw std::runtime_error("Redistribution Dimension Mismatch");
+
+    sched_ = std::make_unique< detail::redistribution_schedule >( src_, dst_, comm,
+      sizeof(T), opts );
+
+  }
+
+  /**
+   *  \brief Redistribute A into B.
+   *
+   *  Collective over all processes of the communicator. A and B must have the
+   *  layouts of the matrices which the plan has been built for.
+   */
+  void execute( const DistMatrix<T>& A, DistMatrix<T>& B ) {
+
+    if( detail::layout_of( A ) != src_ or detail::layout_of( B ) != dst_ )
+      throw std::runtime_error("Redistribution Layout Mismatch");
+
+    BLACSPP_PROFILE( "redistribute", -1, -1, detail::blacs_type_char_v<T>,
+      sched_->stats().bytes_sent + sched_->stats().local_bytes );
+    sched_->execute( A.data(), A.lda(), B.data(), B.lda() );
+
+  }
+
+  inline const redistribution_stats& stats() const noexcept {
+    return sched_->stats();
+  }
+
+};
+
+/**
+ *  \brief Redistribute A into B (building a single-use plan).
+ *
+ *  Collective over all processes of comm. Use RedistributionPlan to reuse the
+ *  schedule over repeated redistributions.
+ */
+template <typename T>
+void redistribute( const DistMatrix<T>& A, DistMatrix<T>& B, MPI_Comm comm,
+  const redistribution_options& opts = redistribution_options() ) {
+
+  RedistributionPlan<T>( A, B, comm, opts ).execute( A, B );
+
+}
+
+}
@@ -0,0 +1,140 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/types.hpp>
+#include <iterator>
+
+namespace blacspp {
+
+/**
+ *  \brief A class which manages the lifetime of a non-blocking operation.
+ *
+ *  Wraps an MPI request. Movable but not copyable, an active request
+ *  is completed (waited on) upon destruction.
+ */
+class Request {
+
+  MPI_Request request_; ///< Underlying MPI request handle
+
+public:
+
+  /**
+   *  \brief Construct an inactive request (MPI_REQUEST_NULL)
+   */
+  Request() noexcept;
+
+  /**
+   *  \brief Construct a request which takes ownership of an MPI request.
+   *
+   *  @param[in] r MPI request handle
+   */
+  explicit Request( MPI_Request r ) noexcept;
+
+  Request( const Request& ) = delete;
+  Request& operator=( const Request& ) = delete;
+
+  /**
+   *  \brief Move constructor
+   *
+   *  Passes ownership of the MPI request and leaves the passed
+   *  request inactive.
+   *
+   *  @param[in] other Request to move
+   */
+  Request( Request&& other ) noexcept;
+
+  /**
+   *  \brief Move assignment
+   *
+   *  Completes the currently owned operation (if active) prior
+   *  to taking ownership of the passed request.
+   *
+   *  @param[in] other Request to move
+   */
+  Request& operator=( Request&& other ) noexcept;
+
+  /**
+   *  \brief Destroy the request.
+   *
+   *  Blocks until completion if the request is still active.
+   */
+  ~Request() noexcept;
+
+  /**
+   *  \brief Block until the operation has completed.
+   *
+   *  Trivial if the request is inactive.
+   */
+  void wait();
+
+  /**
+   *  \brief Check if the operation has completed without blocking.
+   *
+   *  @returns Whether the operation has completed (true if inactive)
+   */
+  bool test();
+
+  /**
+   *  \brief Check if the request refers to an outstanding operation.
+   *  @returns Whether the request is active
+   */
+  bool is_active() const noexcept;
+
+  /**
+   *  \brief Returns the underlying MPI request handle.
+   *  @returns MPI request handle
+   */
+  inline MPI_Request& native_handle() noexcept { return request_; }
+
+};
+
+
+/**
+ *  \brief Block until all requests in a range have completed.
+ *
+ *  @param[in] first Pointer to the first request in the range
+ *  @param[in] last  Pointer to one past the last request in the range
+ */
+void wait_all( Request* first, Request* last );
+
+/**
+ *  \brief Check if all requests in a range have completed without blocking.
+ *
+ *  @param[in] first Pointer to the first request in the range
+ *  @param[in] last  Pointer to one past the last request in the range
+ *  @returns   Whether all operations in the range have completed
+ */
+bool test_all( Request* first, Request* last );
+
+/**
+ *  \brief Block until all requests in a container have completed.
+ *
+ *  @tparam Container Contiguous container of Request objects.
+ *                    Must have Container::data() and Container::size().
+ *
+ *  @param[in] reqs Requests to complete
+ */
+template <class Container>
+void wait_all( Container& reqs ) {
+  wait_all( std::data(reqs), std::data(reqs) + std::size(reqs) );
+}
+
+/**
+ *  \brief Check if all requests in a container have completed without blocking.
+ *
+ *  @tparam Container Contiguous container of Request objects.
+ *                    Must have Container::data() and Container::size().
+ *
+ *  @param[in] reqs Requests to test
+ *  @returns   Whether all operations in the container have completed
+ */
+template <class Container>
+bool test_all( Container& reqs ) {
+  return test_all( std::data(reqs), std::data(reqs) + std::size(reqs) );
+}
+
+}
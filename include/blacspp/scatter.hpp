@@ -0,0 +1,214 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/distmatrix.hpp>
+#include <blacspp/util/mpi_types.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace blacspp {
+
+/// MPI tag of the messages of scatter / gather
+inline constexpr int scatter_tag = 2644;
+
+/**
+ *  \brief Parameters of scatter / gather
+ */
+struct scatter_options {
+  /// Bound of the outstanding (packed) staging buffers on the root in bytes
+  std::size_t window_bytes = std::size_t(1) << 26;
+};
+
+namespace detail {
+
+/// A col-major panel of the global matrix (M x ncols)
+struct panel_view {
+  void*     data;
+  blacs_int ld;
+};
+
+/// Returns the panel of global columns [j0, j0 + ncols) on the root
+using panel_provider = std::function< panel_view( blacs_int j0, blacs_int ncols ) >;
+
+/// Called on the root once a panel (obtained from a panel_provider) is complete
+using panel_done = std::function< void( blacs_int j0, blacs_int ncols,
+                                        const panel_view& ) >;
+
+/**
+ *  \brief Stream the panels of a global matrix on a root into a block-cyclic layout
+ *
+ *  Panels are column blocks of the layout. The root packs the rows of each
+ *  process row into a staging buffer and posts a non-blocking send, such that
+ *  the processes of a column are served at once. At most window_bytes of
+ *  staging buffers are outstanding. Other processes recieve directly into
+ *  their local storage (no unpacking).
+ *
+ *  Collective over the processes of the grid.
+ */
+void scatter_panels( const Grid& grid, const block_cyclic_layout& layout,
+  MPI_Datatype dtype, std::size_t elem_size, const panel_provider& source,
+  void* B, blacs_int LDB, blacs_int RSRC, blacs_int CSRC,
+  const scatter_options& opts );
+
+/**
+ *  \brief Stream a block-cyclic layout into the panels of a global matrix on a root
+ *
+ *  Processes send their local column blocks directly from their local storage.
+ *  The root recieves the pieces of the upcoming panels in order into at most
+ *  window_bytes of staging buffers, and unpacks them into the panel returned
+ *  by target. done (if set) is called once a panel is complete.
+ *
+ *  Collective over the processes of the grid.
+ */
+void gather_panels( const Grid& grid, const block_cyclic_layout& layout,
+  MPI_Datatype dtype, std::size_t elem_size, const void* A, blacs_int LDA,
+  const panel_provider& target, const panel_done& done, blacs_int RDEST,
+  blacs_int CDEST, const scatter_options& opts );
+
+}
+
+
+
+
+
+/**
+ *  \brief Scatter a global matrix on a root process into a distributed matrix.
+ *
+ *  Collective over the processes of the grid of B.
+ *
+ *  @tparam T Type of the matrix elements. Must be BLACS enabled.
+ *
+ *  @param[in]  A    (root) Global col-major matrix (B.m() x B.n())
+ *  @param[in]  LDA  (root) Leading dimension of A
+ *  @param[out] B    (local) Distributed matrix
+ *  @param[in]  RSRC (global) Process row coordinate of the root
+ *  @param[in]  CSRC (global) Process column coordinate of the root
+ *  @param[in]  opts (local) Parameters of the scatter
+ */
+template <typename T>
+void scatter( const T* A, const blacs_int LDA, DistMatrix<T>& B,
+  const blacs_int RSRC = 0, const blacs_int CSRC = 0,
+  const scatter_options& opts = scatter_options() ) {
+
+  const auto& grid = B.grid();
+  if( grid.ipr() == RSRC and grid.ipc() == CSRC and LDA < std::max( B.m(), 1 ) )
+    throw std::runtime_error("Invalid Leading Dimension");
+
+  detail::scatter_panels( grid, detail::layout_of( B ), 
+    detail::mpi_data_type<T>::type(), sizeof(T), 
+    [=]( blacs_int j0, blacs_int ) { 
+      return detail::panel_view{ const_cast<T*>( A ) + j0 * std::size_t(LDA), LDA };
+    }, B.data(), B.lda(), RSRC, CSRC, opts );
+
+}
+
+/**
+ *  \brief Scatter a global matrix produced in column panels on a root process.
+ *
+ *  The global matrix is never held as a whole: the root calls 
+ *  f( j0, ncols, P, LDP ) to fill global columns [j0, j0 + ncols) of the matrix
+ *  into the panel P (B.m() x ncols, leading dimension LDP), where ncols is at
+ *  most B.nb().
+ *
+ *  Collective over the processes of the grid of B.
+ *
+ *  @param[in]  f    (root) Producer of column panels
+ *  @param[out] B    (local) Distributed matrix
+ *  @param[in]  RSRC (global) Process row coordinate of the root
+ *  @param[in]  CSRC (global) Process column coordinate of the root
+ *  @param[in]  opts (local) Parameters of the scatter
+ */
+template <typename T, typename F>
+std::enable_if_t< std::is_invocable_v<F, blacs_int, blacs_int, T*, blacs_int> >
+  scatter( F&& f, DistMatrix<T>& B, const blacs_int RSRC = 0, 
+           const blacs_int CSRC = 0, const scatter_options& opts = scatter_options() ) {
+
+  const auto& grid = B.grid();
+  const blacs_int ldp = std::max( B.m(), 1 );
+
+  std::vector<T> panel;
+  if( grid.ipr() == RSRC and grid.ipc() == CSRC ) panel.resize( ldp * B.nb() );
+
+  detail::scatter_panels( grid, detail::layout_of( B ), 
+    detail::mpi_data_type<T>::type(), sizeof(T), 
+    [&]( blacs_int j0, blacs_int ncols ) { 
+      f( j0, ncols, panel.data(), ldp );
+      return detail::panel_view{ panel.data(), ldp };
+    }, B.data(), B.lda(), RSRC, CSRC, opts );
+
+}
+
+/**
+ *  \brief Gather a distributed matrix into a global matrix on a root process.
+ *
+ *  Collective over the processes of the grid of A.
+ *
+ *  @tparam T Type of the matrix elements. Must be BLACS enabled.
+ *
+ *  @param[in]  A     (local) Distributed matrix
+ *  @param[out] B     (root) Global col-major matrix (A.m() x A.n())
+ *  @param[in]  LDB   (root) Leading dimension of B
+ *  @param[in]  RDEST (global) Process row coordinate of the root
+ *  @param[in]  CDEST (global) Process column coordinate of the root
+ *  @param[in]  opts  (local) Parameters of the gather
+ */
+template <typename T>
+void gather( const DistMatrix<T>& A, T* B, const blacs_int LDB,
+  const blacs_int RDEST = 0, const blacs_int CDEST = 0,
+  const scatter_options& opts = scatter_options() ) {
+
+  const auto& grid = A.grid();
+  if( grid.ipr() == RDEST and grid.ipc() == CDEST and LDB < std::max( A.m(), 1 ) )
+    throw std::runtime_error("Invalid Leading Dimension");
+
+  detail::gather_panels( grid, detail::layout_of( A ), 
+    detail::mpi_data_type<T>::type(), sizeof(T), A.data(), A.lda(),
+    [=]( blacs_int j0, blacs_int ) { 
+      return detail::panel_view{ B + j0 * std::size_t(LDB), LDB };
+    }, nullptr, RDEST, CDEST, opts );
+
+}
+
+/**
+ *  \brief Gather a distributed matrix in column panels on a root process.
+ *
+ *  The root calls f( j0, ncols, P, LDP ) with global columns [j0, j0 + ncols) 
+ *  of the matrix in the panel P (A.m() x ncols, leading dimension LDP), in
+ *  increasing order of j0. ncols is at most A.nb().
+ *
+ *  Collective over the processes of the grid of A.
+ *
+ *  @param[in] A     (local) Distributed matrix
+ *  @param[in] f     (root) Consumer of column panels
+ *  @param[in] RDEST (global) Process row coordinate of the root
+ *  @param[in] CDEST (global) Process column coordinate of the root
+ *  @param[in] opts  (local) Parameters of the gather
+ */
+template <typename T, typename F>
+std::enable_if_t< std::is_invocable_v<F, blacs_int, blacs_int, const T*, blacs_int> >
+  gather( const DistMatrix<T>& A, F&& f, const blacs_int RDEST = 0, 
+          const blacs_int CDEST = 0, const scatter_options& opts = scatter_options() ) {
+
+  const auto& grid = A.grid();
+  const blacs_int ldp = std::max( A.m(), 1 );
+
+  std::vector<T> panel;
+  if( grid.ipr() == RDEST and grid.ipc() == CDEST ) panel.resize( ldp * A.nb() );
+
+  detail::gather_panels( grid, detail::layout_of( A ), 
+    detail::mpi_data_type<T>::type(), sizeof(T), A.data(), A.lda(),
+    [&]( blacs_int, blacs_int ) { return detail::panel_view{ panel.data(), ldp }; },
+    [&]( blacs_int j0, blacs_int ncols, const detail::panel_view& p ) {
+      f( j0, ncols, static_cast<const T*>( p.data ), p.ld );
+    }, RDEST, CDEST, opts );
+
+}
+
+}
@@ -6,11 +6,109 @@
  */
 #pragma once
 #include <blacspp/grid.hpp>
+#include <blacspp/compression.hpp>
+#include <blacspp/datatype.hpp>
+#include <blacspp/device.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/shared_memory.hpp>
 #include <blacspp/wrappers/send_recv.hpp>
+#include <blacspp/util/pack.hpp>
 #include <blacspp/util/type_conversions.hpp>
 
 namespace blacspp {
 
+namespace detail {
+
+  /**
+   *  \brief Send a general 2D buffer through the transports of a grid
+   *
+   *  Compresses the payload if enabled, then sends through the first enabled
+   *  transport (device, shared memory, derived datatypes), falling back to
+   *  BLACS. Shared by gesd2d and SendPlan.
+   *
+   *  @param[in] grid  BLACS grid which defined the communication context.
+   *  @param[in] M     Number of rows of the buffer to send
+   *  @param[in] N     Number of columns of the buffer to send
+   *  @param[in] A     Pointer of buffer to send
+   *  @param[in] LDA   Leading dimension of the buffer to send
+   *  @param[in] RDEST Process row coordinate of destination process
+   *  @param[in] CDEST Process column coordinate of desination process
+   *  @param[in] dest  Rank of the destination process in Grid::comm()
+   */
+  template <typename T>
+  void send_2d( const Grid& grid, const blacs_int M, const blacs_int N, const T* A,
+                const blacs_int LDA, const blacs_int RDEST, const blacs_int CDEST,
+                const blacs_int dest ) {
+
+    if constexpr ( compressible_v<T> )
+      if( auto* cmp = compression_for<T>( grid, M, N ) ) {
+        const auto& wire = cmp->compress( M, N, A, LDA );
+        const blacs_int nw = wire.size();
+        return send_2d( grid, nw, 1, wire.data(), nw, RDEST, CDEST, dest );
+      }
+
+    BLACSPP_PROFILE( "gesd2d", -1, -1, blacs_type_char_v<T>,
+      std::size_t(M) * std::size_t(N) * sizeof(T) );
+
+    if( const auto& dev = grid.device_transport() )
+      return dev->send( mpi_data_type<T>::type(), sizeof(T), M, N, A, LDA, dest );
+
+    if( const auto& shm = grid.shared_memory() )
+      if( shm->send( dest, sizeof(T), M, N, A, LDA ) ) return;
+
+    if( const auto& dtt = grid.datatype_transport() )
+      return dtt->send( general_key<T>( M, N, LDA ), mpi_data_type<T>::type(), A, 
+                        dest );
+
+    wrappers::gesd2d( grid.context(), M, N, A, LDA, RDEST, CDEST );
+
+  }
+
+  /**
+   *  \brief Recieve a general 2D buffer through the transports of a grid
+   *
+   *  Matches send_2d. Shared by gerv2d and RecvPlan.
+   *
+   *  @param[in]     grid  BLACS grid which defined the communication context.
+   *  @param[in]     M     Number of rows of the buffer to recieve
+   *  @param[in]     N     Number of columns of the buffer to recieve
+   *  @param[in/out] A     Pointer of buffer to store recieved data
+   *  @param[in]     LDA   Leading dimension of the buffer to store recieved data.
+   *  @param[in]     RSRC  Process row coordinate of source process
+   *  @param[in]     CSRC  Process column coordinate of source process
+   *  @param[in]     src   Rank of the source process in Grid::comm()
+   */
+  template <typename T>
+  void recv_2d( const Grid& grid, const blacs_int M, const blacs_int N, T* A,
+                const blacs_int LDA, const blacs_int RSRC, const blacs_int CSRC,
+                const blacs_int src ) {
+
+    if constexpr ( compressible_v<T> )
+      if( auto* cmp = compression_for<T>( grid, M, N ) ) {
+        auto& wire = cmp->template reserve<T>( M, N );
+        const blacs_int nw = wire.size();
+        recv_2d( grid, nw, 1, wire.data(), nw, RSRC, CSRC, src );
+        return cmp->expand( M, N, A, LDA );
+      }
+
+    BLACSPP_PROFILE( "gerv2d", -1, -1, blacs_type_char_v<T>,
+      std::size_t(M) * std::size_t(N) * sizeof(T) );
+
+    if( const auto& dev = grid.device_transport() )
+      return dev->recv( mpi_data_type<T>::type(), sizeof(T), M, N, A, LDA, src );
+
+    if( const auto& shm = grid.shared_memory() )
+      if( shm->recv( src, sizeof(T), M, N, A, LDA ) ) return;
+
+    if( const auto& dtt = grid.datatype_transport() )
+      return dtt->recv( general_key<T>( M, N, LDA ), mpi_data_type<T>::type(), A, 
+                        src );
+
+    wrappers::gerv2d( grid.context(), M, N, A, LDA, RSRC, CSRC );
+
+  }
+
+}
 
 /**
  *  \brief General point-to-point 2D send.
@@ -31,12 +129,30 @@ namespace blacspp {
  *
  */
 template <typename T>
-detail::enable_if_blacs_supported_t<T>
+detail::enable_if_blacs_native_t<T>
+  gesd2d( const Grid& grid, 
+          const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA,
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  detail::send_2d( grid, M, N, A, LDA, RDEST, CDEST, grid.comm_rank( RDEST, CDEST ) );
+
+}
+
+/**
+ *  \brief General point-to-point 2D send of a reinterpreted type.
+ *
+ *  Sends the buffer as a buffer of its transported type (see
+ *  reinterpreted_blacs_traits).
+ */
+template <typename T>
+detail::enable_if_blacs_reinterpreted_t<T>
   gesd2d( const Grid& grid, 
           const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA,
           const blacs_int RDEST, const blacs_int CDEST ) {
 
-  wrappers::gesd2d( grid.context(), M, N, A, LDA, RDEST, CDEST );
+  using E = typename blacs_traits<T>::element_type;
+  gesd2d( grid, detail::transported_extent<T>( M ), N, reinterpret_cast<const E*>( A ),
+          detail::transported_extent<T>( LDA ), RDEST, CDEST );
 
 }
 
@@ -124,15 +240,22 @@ std::enable_if_t< detail::has_size_member_v<Container> >
  *
  */
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+detail::enable_if_blacs_native_t<T> 
   trsd2d( const Grid& grid, const Triangle uplo, const Diagonal diag, 
           const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA, 
           const blacs_int RDEST, const blacs_int CDEST ) {
 
-  auto UPLO = detail::type_string( uplo );
-  auto DIAG = detail::type_string( diag );
+  BLACSPP_PROFILE( "trsd2d", -1, -1, detail::blacs_type_char_v<T>,
+    detail::trapezoid_size( uplo, diag, M, N ) * sizeof(T) );
 
-  wrappers::trsd2d( grid.context(), UPLO.c_str(), DIAG.c_str(), M, N, A, LDA, RDEST, CDEST );
+  if( const auto& dtt = grid.datatype_transport() )
+    return dtt->send( detail::trapezoid_key<T>( uplo, diag, M, N, LDA ), 
+      detail::mpi_data_type<T>::type(), A, grid.comm_rank( RDEST, CDEST ) );
+
+  // Packed by blacspp and sent as a contiguous vector (bypasses the packing of BLACS)
+  detail::packed_trapezoid<T> P( uplo, diag, M, N );
+  detail::pack_trapezoid( P.data(), sizeof(T), uplo, diag, M, N, A, LDA );
+  wrappers::gesd2d( grid.context(), P.n, 1, P.data(), P.ld(), RDEST, CDEST );
 
 }
 
@@ -202,12 +325,30 @@ std::enable_if_t< detail::has_data_member_v<Container> >
  *
  */
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+detail::enable_if_blacs_native_t<T> 
   gerv2d( const Grid& grid, const blacs_int M, const blacs_int N,
           T* A, const blacs_int LDA, const blacs_int RSRC,
           const blacs_int CSRC ) {
 
-  wrappers::gerv2d( grid.context(), M, N, A, LDA, RSRC, CSRC );
+  detail::recv_2d( grid, M, N, A, LDA, RSRC, CSRC, grid.comm_rank( RSRC, CSRC ) );
+
+}
+
+/**
+ *  \brief General point-to-point 2D recieve of a reinterpreted type.
+ *
+ *  Recieves the buffer as a buffer of its transported type (see
+ *  reinterpreted_blacs_traits).
+ */
+template <typename T>
+detail::enable_if_blacs_reinterpreted_t<T>
+  gerv2d( const Grid& grid, const blacs_int M, const blacs_int N,
+          T* A, const blacs_int LDA, const blacs_int RSRC,
+          const blacs_int CSRC ) {
+
+  using E = typename blacs_traits<T>::element_type;
+  gerv2d( grid, detail::transported_extent<T>( M ), N, reinterpret_cast<E*>( A ),
+          detail::transported_extent<T>( LDA ), RSRC, CSRC );
 
 }
 
@@ -292,15 +433,21 @@ std::enable_if_t< detail::has_size_member_v<Container> >
  *
  */
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+detail::enable_if_blacs_native_t<T> 
   trrv2d( const Grid& grid, const Triangle uplo, const Diagonal diag, 
           const blacs_int M, const blacs_int N, T* A, const blacs_int LDA, 
           const blacs_int RSRC, const blacs_int CSRC ) {
 
-  auto UPLO = detail::type_string( uplo );
-  auto DIAG = detail::type_string( diag );
+  BLACSPP_PROFILE( "trrv2d", -1, -1, detail::blacs_type_char_v<T>,
+    detail::trapezoid_size( uplo, diag, M, N ) * sizeof(T) );
+
+  if( const auto& dtt = grid.datatype_transport() )
+    return dtt->recv( detail::trapezoid_key<T>( uplo, diag, M, N, LDA ), 
+      detail::mpi_data_type<T>::type(), A, grid.comm_rank( RSRC, CSRC ) );
 
-  wrappers::trrv2d( grid.context(), UPLO.c_str(), DIAG.c_str(), M, N, A, LDA, RSRC, CSRC );
+  detail::packed_trapezoid<T> P( uplo, diag, M, N );
+  wrappers::gerv2d( grid.context(), P.n, 1, P.data(), P.ld(), RSRC, CSRC );
+  detail::unpack_trapezoid( A, sizeof(T), uplo, diag, M, N, P.data(), LDA );
 
 }
 
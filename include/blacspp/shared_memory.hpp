@@ -0,0 +1,158 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <utility>
+#include <vector>
+
+namespace blacspp {
+
+/// Default size (bytes) of the shared memory segment of each process
+inline constexpr std::size_t shared_memory_default_bytes = std::size_t(1) << 24;
+
+/**
+ *  \brief Counters of the node-local transport of a grid
+ */
+struct shared_memory_stats {
+  std::size_t shared   = 0; ///< Messages sent / broadcast through shared memory
+  std::size_t fallback = 0; ///< Messages between node-local processes sent through BLACS
+};
+
+namespace detail {
+
+/**
+ *  \brief Node-local transport for general 2D point-to-point and broadcast operations
+ *
+ *  Each process owns a segment of an MPI-3 shared memory window (per node),
+ *  which is used as a ring buffer of outgoing tiles. A send to a process on the
+ *  same node packs the (M,N,LDA) tile into the ring of the sender and posts a
+ *  small header (MPI) which tells the recieving process where to find it. The
+ *  reciever unpacks directly from the ring of the sender into its buffer and
+ *  releases the block. Sends never wait on the reciever; if the ring has no space
+ *  for a tile the header signals a fallback onto the BLACS path, which retains
+ *  the message order between each pair of processes.
+ *
+ *  Operations involving processes on other nodes bypass the transport.
+ */
+class shm_transport {
+
+  struct header {
+    std::int64_t path;   ///< 1: shared memory, 0: BLACS
+    std::int64_t offset; ///< Offset of the block in the segment of the sender
+    std::int64_t bytes;  ///< Size of the tile in bytes
+  };
+
+  struct block_ref {
+    std::size_t offset; ///< Offset of the block in the local segment
+    std::size_t size;   ///< Size of the block (including its header)
+  };
+
+  MPI_Comm  node_comm_;   ///< Processes of comm() which share this node
+  MPI_Comm  header_comm_; ///< Duplicate of comm() for headers
+  MPI_Win   win_;         ///< Shared memory window over node_comm_
+
+  std::size_t                 capacity_; ///< Size of the local segment
+  char*                       base_;     ///< Local segment
+  std::vector< char* >        peers_;    ///< Segment of each comm() rank (nullptr if off-node)
+  std::deque< block_ref >     live_;     ///< Outstanding blocks of the local segment (in order)
+  std::size_t                 head_ = 0; ///< Next free offset of the local segment
+
+  std::list< std::pair<header,MPI_Request> > pending_; ///< Outstanding header sends
+  shared_memory_stats         stats_;
+
+  char* allocate( std::size_t bytes, int nreaders );
+  void  post_header( const header& h, int dest, int tag );
+  void  progress();
+
+public:
+
+  /**
+   *  \brief Construct the transport for the processes of an MPI communicator
+   *
+   *  Collective over all processes of comm.
+   *
+   *  @param[in] comm  MPI communicator (Grid::comm())
+   *  @param[in] bytes Size of the shared memory segment of each process
+   */
+  shm_transport( MPI_Comm comm, std::size_t bytes );
+
+  shm_transport( const shm_transport& ) = delete;
+  shm_transport& operator=( const shm_transport& ) = delete;
+
+  /**
+   *  \brief Destroy the transport.
+   *
+   *  Collective over all processes of the communicator.
+   */
+  ~shm_transport() noexcept;
+
+  /**
+   *  \brief Check if a rank of the communicator shares the node of this process
+   */
+  inline bool is_local( blacs_int rank ) const noexcept {
+    return peers_[rank] != nullptr;
+  }
+
+  inline const shared_memory_stats& stats() const noexcept { return stats_; }
+
+  /**
+   *  \brief Send a tile to a process on this node.
+   *
+   *  @returns Whether the tile has been sent (false: send through BLACS)
+   */
+  bool send( blacs_int dest, std::size_t elem_size, blacs_int M, blacs_int N,
+             const void* A, blacs_int LDA );
+
+  /**
+   *  \brief Recieve a tile from a process on this node.
+   *
+   *  @returns Whether the tile has been recieved (false: recieve through BLACS)
+   */
+  bool recv( blacs_int src, std::size_t elem_size, blacs_int M, blacs_int N,
+             void* A, blacs_int LDA );
+
+  /**
+   *  \brief Broadcast a tile to the processes of a scope on this node.
+   *
+   *  @param[in] ranks Ranks (in the communicator) of the scope, excluding the root
+   *  @returns   Whether the tile has been broadcast (false: broadcast through BLACS)
+   */
+  bool broadcast_send( Scope scope, const std::vector<blacs_int>& ranks,
+                       std::size_t elem_size, blacs_int M, blacs_int N,
+                       const void* A, blacs_int LDA );
+
+  /**
+   *  \brief Recieve a broadcast from a root on this node.
+   *
+   *  @param[in] ranks Ranks (in the communicator) of the scope, excluding the root
+   *  @param[in] root  Rank (in the communicator) of the root
+   *  @returns   Whether the tile has been recieved (false: recieve through BLACS)
+   */
+  bool broadcast_recv( Scope scope, const std::vector<blacs_int>& ranks,
+                       blacs_int root, std::size_t elem_size, blacs_int M,
+                       blacs_int N, void* A, blacs_int LDA );
+
+};
+
+/**
+ *  \brief Ranks in Grid::comm() of the processes of a scope, excluding a root
+ *
+ *  @param[in] grid  BLACS grid
+ *  @param[in] scope Scope of the operation
+ *  @param[in] RSRC  Process row coordinate of the root
+ *  @param[in] CSRC  Process column coordinate of the root
+ */
+std::vector<blacs_int> scope_ranks( const Grid& grid, Scope scope,
+                                    blacs_int RSRC, blacs_int CSRC );
+
+}
+}
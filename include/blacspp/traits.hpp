@@ -0,0 +1,192 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/types.hpp>
+#include <blacspp/util/mpi_types.hpp>
+#include <blacspp/wrappers/prototypes.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace blacspp {
+
+/**
+ *  \brief Compile-time dispatch table of a BLACS enabled type.
+ *
+ *  The primary template is empty, a type is BLACS enabled (see
+ *  detail::blacs_supported) iff blacs_traits is specialized for it.
+ *
+ *  Specializations for the native BLACS types (blacs_int, float, double,
+ *  scomplex, dcomplex) provide
+ *    - element_type Type of the elements handed to BLACS (T itself)
+ *    - native       true
+ *    - type_char    BLACS type character (i,s,d,c,z)
+ *    - mpi_type()   MPI datatype of an element
+ *    - Function pointers to the BLACS C routines (gesd2d, gerv2d, trsd2d,
+ *      trrv2d, gebs2d, gebr2d, trbs2d, trbr2d, gsum2d, gamx2d, gamn2d)
+ *
+ *  Other types may be enabled by users by deriving a specialization from
+ *  reinterpreted_blacs_traits, e.g.
+ *
+ *    template <>
+ *    struct blacspp::blacs_traits< my_half > :
+ *      blacspp::reinterpreted_blacs_traits< my_half, float > { };
+ *
+ *  @tparam T Element type
+ */
+template <typename T>
+struct blacs_traits { };
+
+/**
+ *  \brief Traits of a type which is transported as blocks of a native BLACS type.
+ *
+ *  A (M,N,LDA) buffer of T is handed to BLACS (and the MPI based transports)
+ *  as a (M',N,LDA') buffer of E, where M' and LDA' are the extents of M and
+ *  LDA in bytes divided by sizeof(E). If sizeof(T) is not a multiple of
+ *  sizeof(E) (e.g. a 2 byte half precision type transported as float), M and
+ *  LDA must describe whole numbers of E, otherwise a std::runtime_error is
+ *  thrown.
+ *
+ *  Only the general (rectangular) point-to-point and broadcast routines are
+ *  available for reinterpreted types: triangular transfers and the combine
+ *  operations are defined in terms of the elements of T.
+ *
+ *  @tparam T Trivially copyable type to transport
+ *  @tparam E Native BLACS type to transport T as
+ */
+template <typename T, typename E>
+struct reinterpreted_blacs_traits {
+
+  static_assert( std::is_trivially_copyable_v<T>,
+    "Reinterpreted BLACS types must be trivially copyable" );
+  static_assert( blacs_traits<E>::native,
+    "Reinterpreted BLACS types must be transported as a native BLACS type" );
+
+  using element_type = E;
+  static constexpr bool native = false;
+
+};
+
+namespace detail {
+
+  template <typename T>
+  struct native_blacs_traits {
+    using element_type = T;
+    static constexpr bool native = true;
+    static MPI_Datatype mpi_type() { return mpi_data_type<T>::type(); }
+  };
+
+}
+
+template <>
+struct blacs_traits< blacs_int > : detail::native_blacs_traits< blacs_int > {
+  static constexpr char type_char = 'i';
+  static constexpr auto gesd2d = &Cigesd2d;
+  static constexpr auto gerv2d = &Cigerv2d;
+  static constexpr auto trsd2d = &Citrsd2d;
+  static constexpr auto trrv2d = &Citrrv2d;
+  static constexpr auto gebs2d = &Cigebs2d;
+  static constexpr auto gebr2d = &Cigebr2d;
+  static constexpr auto trbs2d = &Citrbs2d;
+  static constexpr auto trbr2d = &Citrbr2d;
+  static constexpr auto gsum2d = &Cigsum2d;
+  static constexpr auto gamx2d = &Cigamx2d;
+  static constexpr auto gamn2d = &Cigamn2d;
+};
+
+template <>
+struct blacs_traits< float > : detail::native_blacs_traits< float > {
+  static constexpr char type_char = 's';
+  static constexpr auto gesd2d = &Csgesd2d;
+  static constexpr auto gerv2d = &Csgerv2d;
+  static constexpr auto trsd2d = &Cstrsd2d;
+  static constexpr auto trrv2d = &Cstrrv2d;
+  static constexpr auto gebs2d = &Csgebs2d;
+  static constexpr auto gebr2d = &Csgebr2d;
+  static constexpr auto trbs2d = &Cstrbs2d;
+  static constexpr auto trbr2d = &Cstrbr2d;
+  static constexpr auto gsum2d = &Csgsum2d;
+  static constexpr auto gamx2d = &Csgamx2d;
+  static constexpr auto gamn2d = &Csgamn2d;
+};
+
+template <>
+struct blacs_traits< double > : detail::native_blacs_traits< double > {
+  static constexpr char type_char = 'd';
+  static constexpr auto gesd2d = &Cdgesd2d;
+  static constexpr auto gerv2d = &Cdgerv2d;
+  static constexpr auto trsd2d = &Cdtrsd2d;
+  static constexpr auto trrv2d = &Cdtrrv2d;
+  static constexpr auto gebs2d = &Cdgebs2d;
+  static constexpr auto gebr2d = &Cdgebr2d;
+  static constexpr auto trbs2d = &Cdtrbs2d;
+  static constexpr auto trbr2d = &Cdtrbr2d;
+  static constexpr auto gsum2d = &Cdgsum2d;
+  static constexpr auto gamx2d = &Cdgamx2d;
+  static constexpr auto gamn2d = &Cdgamn2d;
+};
+
+template <>
+struct blacs_traits< scomplex > : detail::native_blacs_traits< scomplex > {
+  static constexpr char type_char = 'c';
+  static constexpr auto gesd2d = &Ccgesd2d;
+  static constexpr auto gerv2d = &Ccgerv2d;
+  static constexpr auto trsd2d = &Cctrsd2d;
+  static constexpr auto trrv2d = &Cctrrv2d;
+  static constexpr auto gebs2d = &Ccgebs2d;
+  static constexpr auto gebr2d = &Ccgebr2d;
+  static constexpr auto trbs2d = &Cctrbs2d;
+  static constexpr auto trbr2d = &Cctrbr2d;
+  static constexpr auto gsum2d = &Ccgsum2d;
+  static constexpr auto gamx2d = &Ccgamx2d;
+  static constexpr auto gamn2d = &Ccgamn2d;
+};
+
+template <>
+struct blacs_traits< dcomplex > : detail::native_blacs_traits< dcomplex > {
+  static constexpr char type_char = 'z';
+  static constexpr auto gesd2d = &Czgesd2d;
+  static constexpr auto gerv2d = &Czgerv2d;
+  static constexpr auto trsd2d = &Cztrsd2d;
+  static constexpr auto trrv2d = &Cztrrv2d;
+  static constexpr auto gebs2d = &Czgebs2d;
+  static constexpr auto gebr2d = &Czgebr2d;
+  static constexpr auto trbs2d = &Cztrbs2d;
+  static constexpr auto trbr2d = &Cztrbr2d;
+  static constexpr auto gsum2d = &Czgsum2d;
+  static constexpr auto gamx2d = &Czgamx2d;
+  static constexpr auto gamn2d = &Czgamn2d;
+};
+
+namespace detail {
+
+  /**
+   *  \brief Extent (number of rows / leading dimension) of a buffer of T in
+   *  elements of its transported type.
+   *
+   *  Identity for the native BLACS types. Throws std::runtime_error if the
+   *  extent is not a whole number of transported elements.
+   */
+  template <typename T>
+  blacs_int transported_extent( const blacs_int M ) {
+
+    using E = typename blacs_traits<T>::element_type;
+    if constexpr ( sizeof(T) % sizeof(E) == 0 )
+      return M * blacs_int( sizeof(T) / sizeof(E) );
+    else {
+      const std::size_t nbytes = std::size_t(M) * sizeof(T);
+      if( nbytes % sizeof(E) )
+        throw std::runtime_error("Extent Not A Multiple Of The Transported Type");
+      return blacs_int( nbytes / sizeof(E) );
+    }
+
+  }
+
+}
+
+}
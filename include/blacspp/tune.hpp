@@ -0,0 +1,215 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+
+#include <array>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace blacspp {
+
+/**
+ *  \brief Collective operations which may be tuned
+ */
+enum CollectiveOp {
+  Broadcast, ///< gebs2d / gebr2d (and triangular variants)
+  Combine    ///< gsum2d / gamx2d / gamn2d
+};
+
+/**
+ *  \brief Check if a topology is supported by BLACS for a collective operation
+ *
+ *  The ring topologies (SRing, MRing) are only supported for broadcasts.
+ *
+ *  @param[in] op  Collective operation
+ *  @param[in] top Topology
+ *  @returns   Whether op may be performed with top
+ */
+bool valid_for( CollectiveOp op, Topology top ) noexcept;
+
+
+/**
+ *  \brief A lookup table of the fastest topology per (operation, scope, message size)
+ *
+ *  For each (operation, scope) pair, stores a list of message size buckets sorted
+ *  by their upper bound (in bytes). A message selects the first bucket whose upper
+ *  bound is not less than its size, or the last bucket if it is larger than all
+ *  of them.
+ *
+ *  Tables are used by Grid to select topologies for operations which do not
+ *  specify one (see Grid::set_topology_table). The same table must be used on
+ *  all processes of the grid.
+ */
+class TopologyTable {
+
+public:
+
+  /**
+   *  \brief A message size bucket
+   */
+  struct entry {
+    std::size_t max_bytes; ///< Upper bound (inclusive) of the message size in bytes
+    Topology    top;       ///< Topology for messages in this bucket
+  };
+
+private:
+
+  std::array< std::vector<entry>, 6 > entries_; ///< Buckets per (operation, scope)
+
+  static std::size_t index( CollectiveOp op, Scope scope ) noexcept;
+
+public:
+
+  /**
+   *  \brief Add (or replace) a message size bucket
+   *
+   *  Throws std::runtime_error if the topology is not valid for the operation
+   *  (see valid_for).
+   *
+   *  @param[in] op        Collective operation
+   *  @param[in] scope     Scope of the operation
+   *  @param[in] max_bytes Upper bound of the message size of the bucket
+   *  @param[in] top       Topology for messages in the bucket
+   */
+  void insert( CollectiveOp op, Scope scope, std::size_t max_bytes, Topology top );
+
+  /**
+   *  \brief Lookup the topology for a message
+   *
+   *  @param[in] op    Collective operation
+   *  @param[in] scope Scope of the operation
+   *  @param[in] bytes Size of the message in bytes
+   *  @returns   Topology for the message, empty if no bucket exists for (op,scope)
+   */
+  std::optional<Topology> lookup( CollectiveOp op, Scope scope, std::size_t bytes ) const;
+
+  /**
+   *  \brief Returns the buckets for an (operation, scope) pair
+   */
+  const std::vector<entry>& entries( CollectiveOp op, Scope scope ) const;
+
+  /**
+   *  \brief Check if the table contains any buckets
+   */
+  bool empty() const noexcept;
+
+  /**
+   *  \brief Write the table in its (line-based, human readable) text format
+   *
+   *  Each line reads "<operation> <scope> <max_bytes> <topology>"
+   */
+  void save( std::ostream& out ) const;
+  void save( const std::string& fname ) const;
+
+  /**
+   *  \brief Read a table from its text format
+   *
+   *  Throws std::runtime_error on malformed input.
+   */
+  static TopologyTable load( std::istream& in );
+  static TopologyTable load( const std::string& fname );
+
+};
+
+
+
+
+/**
+ *  \brief Parameters of a topology sweep
+ */
+struct tune_options {
+
+  /// Message shapes (M,N) to sample
+  std::vector< std::pair<blacs_int,blacs_int> > shapes =
+    { {1,1}, {64,1}, {64,64}, {256,256}, {1024,512} };
+
+  /// Scopes to sample
+  std::vector< Scope > scopes = { All, Row, Column };
+
+  /// Element types to sample as BLACS type characters (i, s, d, c, z)
+  std::string types = "d";
+
+  /// Collective operations to sample
+  std::vector< CollectiveOp > ops = { Broadcast, Combine };
+
+  /// Topologies to sample (skipped for operations they are not valid for)
+  std::vector< Topology > topologies = { IRing, DRing, SRing, MRing, Hypercube,
+                                         Tree, FullyConnected, Default };
+
+  int nwarmup = 2;  ///< Untimed repetitions per sample
+  int nrepeat = 10; ///< Timed repetitions per sample
+
+};
+
+/**
+ *  \brief A single timed sample of a topology sweep
+ */
+struct tune_sample {
+  CollectiveOp op;        ///< Collective operation
+  Scope        scope;     ///< Scope of the operation
+  char         type;      ///< BLACS type character of the elements
+  blacs_int    M;         ///< Number of rows of the message
+  blacs_int    N;         ///< Number of columns of the message
+  std::size_t  bytes;     ///< Size of the message in bytes
+  Topology     top;       ///< Topology used
+  double       latency;   ///< Time per operation in seconds (max over the grid)
+  double       bandwidth; ///< bytes / latency
+};
+
+
+/**
+ *  \brief Time broadcasts / combines for every point of a topology sweep
+ *
+ *  Collective over all processes of the grid. Timings are reduced (max) over
+ *  the grid, such that all processes obtain identical samples.
+ *
+ *  @param[in] grid BLACS grid on which to time the operations
+ *  @param[in] opts Parameters of the sweep
+ *  @returns   Timed samples
+ */
+std::vector< tune_sample > benchmark_topologies( const Grid& grid,
+                                                 const tune_options& opts );
+
+/**
+ *  \brief Construct a topology table from timed samples
+ *
+ *  Selects the topology with the smallest latency per (operation, scope, bytes)
+ *  (averaged over element types of the same message size) and merges adjacent
+ *  buckets which select the same topology.
+ *
+ *  @param[in] samples Timed samples (see benchmark_topologies)
+ *  @returns   Topology table
+ */
+TopologyTable build_topology_table( const std::vector< tune_sample >& samples );
+
+/**
+ *  \brief Sweep topologies on a grid and construct a topology table
+ *
+ *  Collective over all processes of the grid.
+ *
+ *  @param[in] grid BLACS grid on which to tune
+ *  @param[in] opts Parameters of the sweep
+ *  @returns   Topology table (identical on all processes)
+ */
+TopologyTable tune( const Grid& grid, const tune_options& opts = tune_options() );
+
+/**
+ *  \brief Parse the name of a topology as written by TopologyTable::save
+ *
+ *  Throws std::runtime_error for unknown names.
+ */
+Topology topology_from_string( const std::string& name );
+
+/**
+ *  \brief Name of a topology as written by TopologyTable::save
+ */
+const char* topology_name( Topology top ) noexcept;
+
+}
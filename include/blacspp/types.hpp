@@ -43,6 +43,7 @@ namespace blacspp {
     MPI_Comm  comm_; ///< MPI Communicator which defines MPI context
     blacs_int rank_; ///< Rank of current process in specified MPI context
     blacs_int size_; ///< Size of specified MPI context
+    int       thread_level_; ///< MPI thread support level (MPI_Query_thread)
 
   public:
 
@@ -74,6 +75,18 @@ namespace blacspp {
      */
     blacs_int size() const;
 
+    /**
+     *  \brief Get the thread support level of the MPI environment
+     *  \returns the level provided by MPI_Init_thread (e.g. MPI_THREAD_MULTIPLE)
+     */
+    int thread_level() const;
+
+    /**
+     *  \brief Whether MPI has been initialized with MPI_THREAD_MULTIPLE
+     *  \returns whether several threads may issue MPI calls concurrently
+     */
+    bool thread_multiple() const;
+
   };
 
 
@@ -94,8 +107,29 @@ namespace blacspp {
     Column
   };
 
+  /**
+   *  \brief Ordering of the processes of an MPI communicator on a BLACS grid
+   */
+  enum GridOrder {
+    RowMajor,   ///< rank = prow * npc + pcol
+    ColumnMajor ///< rank = prow + pcol * npr
+  };
+
+  /**
+   *  \brief Communication topologies for BLACS broadcasts and combines
+   *
+   *  The sending and all recieving processes of a broadcast must specify
+   *  the same topology.
+   */
   enum Topology {
-    IRing
+    IRing,          ///< Increasing ring
+    DRing,          ///< Decreasing ring
+    SRing,          ///< Split ring
+    MRing,          ///< Multi-ring
+    Hypercube,      ///< Hypercube
+    Tree,           ///< General tree
+    FullyConnected, ///< Fully connected
+    Default         ///< BLACS default (typically MPI collectives)
   };
 
 }
@@ -0,0 +1,49 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/types.hpp>
+
+namespace blacspp {
+namespace detail {
+
+  /**
+   *  \brief A struct to map BLACS enabled types onto MPI datatypes.
+   *
+   *  @tparam T Type to query for the MPI datatype.
+   *
+   *  Datatype is queried by mpi_data_type<T>::type()
+   */
+  template <typename T>
+  struct mpi_data_type;
+
+  template <>
+  struct mpi_data_type< blacs_int > {
+    static MPI_Datatype type() { return MPI_INT32_T; }
+  };
+
+  template <>
+  struct mpi_data_type< float > {
+    static MPI_Datatype type() { return MPI_FLOAT; }
+  };
+
+  template <>
+  struct mpi_data_type< double > {
+    static MPI_Datatype type() { return MPI_DOUBLE; }
+  };
+
+  template <>
+  struct mpi_data_type< scomplex > {
+    static MPI_Datatype type() { return MPI_C_FLOAT_COMPLEX; }
+  };
+
+  template <>
+  struct mpi_data_type< dcomplex > {
+    static MPI_Datatype type() { return MPI_C_DOUBLE_COMPLEX; }
+  };
+
+}
+}
@@ -0,0 +1,179 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace blacspp::detail {
+
+  /**
+   *  \brief Instruction set of the pack / unpack kernels
+   *
+   *  Selected at runtime (on first use) as the widest instruction set supported
+   *  by the CPU, may be overridden by setting BLACSPP_PACK_ISA=generic, avx2,
+   *  avx512 or neon in the environment.
+   */
+  enum class PackISA {
+    Generic, ///< memcpy
+    AVX2,    ///< 256-bit loads / stores (x86-64)
+    AVX512,  ///< 512-bit loads / stores (x86-64)
+    NEON     ///< 128-bit loads / stores (AArch64)
+  };
+
+  /// Whether the kernels of an instruction set are available on this CPU
+  bool pack_isa_supported( PackISA isa ) noexcept;
+
+  /// Instruction set of the pack / unpack kernels in use
+  PackISA pack_isa() noexcept;
+
+  /**
+   *  \brief Select the instruction set of the pack / unpack kernels
+   *
+   *  Not thread safe. Throws std::runtime_error if the instruction set is not
+   *  supported.
+   */
+  void set_pack_isa( PackISA isa );
+
+  /**
+   *  \brief Size (bytes) from which packed buffers are written with non-temporal stores
+   *
+   *  Defaults to the size of the last level cache (8 MiB if unknown), may be
+   *  overridden by setting BLACSPP_PACK_STREAMING_BYTES in the environment.
+   *  Non-temporal stores bypass the cache, such that packing a tile which does
+   *  not fit into the cache anyway does not evict the working set.
+   */
+  std::size_t pack_streaming_bytes() noexcept;
+
+  /// Set the size from which packed buffers are written with non-temporal stores (not thread safe)
+  void set_pack_streaming_bytes( std::size_t bytes ) noexcept;
+
+  /**
+   *  \brief Row range [first, second) of column j of a trapezoid
+   *
+   *  Follows the trapezoid definition of the BLACS triangular routines
+   *  (trsd2d/trbs2d): for M > N the upper trapezoid contains the leading M-N rows,
+   *  for N > M the lower trapezoid contains the leading N-M columns.
+   *
+   *  @param[in] uplo Which trapezoid (upper/lower)
+   *  @param[in] diag Whether the diagonal is implied unit (and excluded)
+   *  @param[in] M    Number of rows
+   *  @param[in] N    Number of columns
+   *  @param[in] j    Column index
+   */
+  inline std::pair<blacs_int,blacs_int> 
+    trapezoid_rows( const Triangle uplo, const Diagonal diag, const blacs_int M,
+                    const blacs_int N, const blacs_int j ) noexcept {
+
+    const blacs_int unit = diag == Unit;
+    if( uplo == Upper ) {
+      const blacs_int off = std::max( M - N, 0 );
+      return { 0, std::clamp( j + off + 1 - unit, 0, M ) };
+    } else {
+      const blacs_int off = std::max( N - M, 0 );
+      return { std::clamp( j - off + unit, 0, M ), M };
+    }
+
+  }
+
+  /**
+   *  \brief Number of elements of a trapezoid
+   */
+  std::size_t trapezoid_size( const Triangle uplo, const Diagonal diag, 
+                              const blacs_int M, const blacs_int N ) noexcept;
+
+  /**
+   *  \brief Pack a col-major (M,N,LDA) buffer into contiguous storage
+   *
+   *  The pack / unpack routines copy column runs with the kernels of pack_isa().
+   *
+   *  @param[out] dst       Contiguous destination (M*N elements)
+   *  @param[in]  elem_size Size of an element in bytes
+   *  @param[in]  M         Number of rows
+   *  @param[in]  N         Number of columns
+   *  @param[in]  A         Source buffer
+   *  @param[in]  LDA       Leading dimension of the source buffer
+   */
+  void pack_2d( void* dst, const std::size_t elem_size, const blacs_int M, 
+                const blacs_int N, const void* A, const blacs_int LDA ) noexcept;
+
+  /**
+   *  \brief Unpack contiguous storage into a col-major (M,N,LDA) buffer
+   */
+  void unpack_2d( void* A, const std::size_t elem_size, const blacs_int M, 
+                  const blacs_int N, const void* src, const blacs_int LDA ) noexcept;
+
+  /**
+   *  \brief Pack a trapezoid of a col-major (M,N,LDA) buffer into contiguous storage
+   *
+   *  Destination holds trapezoid_size( uplo, diag, M, N ) elements.
+   */
+  void pack_trapezoid( void* dst, const std::size_t elem_size, const Triangle uplo,
+                       const Diagonal diag, const blacs_int M, const blacs_int N,
+                       const void* A, const blacs_int LDA ) noexcept;
+
+  /**
+   *  \brief Unpack contiguous storage into a trapezoid of a col-major (M,N,LDA) buffer
+   */
+  void unpack_trapezoid( void* A, const std::size_t elem_size, const Triangle uplo,
+                         const Diagonal diag, const blacs_int M, const blacs_int N,
+                         const void* src, const blacs_int LDA ) noexcept;
+
+  /**
+   *  \brief Uninitialized scratch storage of the calling thread
+   *
+   *  Lends a thread local buffer which grows on demand and is retained between
+   *  uses, such that repeated packing does not allocate. Buffers which are
+   *  constructed while another one is alive on the same thread allocate their
+   *  own storage. Aligned to std::max_align_t.
+   */
+  class scratch_buffer {
+
+    std::unique_ptr< std::max_align_t[] > heap_; ///< Storage of nested buffers
+    void* data_   = nullptr;
+    bool  leased_ = false; ///< Whether data_ is the storage of the thread
+
+  public:
+
+    explicit scratch_buffer( const std::size_t bytes );
+    ~scratch_buffer() noexcept;
+
+    scratch_buffer( const scratch_buffer& ) = delete;
+    scratch_buffer& operator=( const scratch_buffer& ) = delete;
+
+    inline void* data() const noexcept { return data_; }
+
+  };
+
+  /**
+   *  \brief Contiguous (uninitialized) storage of a packed trapezoid
+   *
+   *  Backed by the scratch storage of the calling thread (see scratch_buffer).
+   */
+  template <typename T>
+  struct packed_trapezoid {
+
+    blacs_int      n;       ///< Number of elements
+    scratch_buffer storage; ///< Storage of the elements
+
+    packed_trapezoid( const Triangle uplo, const Diagonal diag, const blacs_int M,
+                      const blacs_int N ) :
+      n( trapezoid_size( uplo, diag, M, N ) ), 
+      storage( std::size_t(n) * sizeof(T) ) { }
+
+    /// Pointer to the elements
+    inline T* data() const noexcept { return static_cast<T*>( storage.data() ); }
+
+    /// Leading dimension of the storage as a (n,1) buffer
+    inline blacs_int ld() const noexcept { return std::max( n, blacs_int(1) ); }
+
+  };
+
+}
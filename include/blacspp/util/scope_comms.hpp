@@ -0,0 +1,54 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/grid.hpp>
+
+namespace blacspp::detail {
+
+/**
+ *  \brief MPI communicators of the scopes of a grid
+ *
+ *  Provides communicators which contain the processes of a Scope of this
+ *  process, such that MPI collectives may be performed over the scopes of a grid.
+ *  Processes are ranked by their position in the scope (col-major for Scope::All),
+ *  see root(). Processes outside of the grid obtain MPI_COMM_NULL.
+ *  Movable but not copyable.
+ */
+class scope_comms {
+
+  MPI_Comm  grid_comm_ = MPI_COMM_NULL; ///< Processes of the grid
+  MPI_Comm  row_comm_  = MPI_COMM_NULL; ///< Process row of this process
+  MPI_Comm  col_comm_  = MPI_COMM_NULL; ///< Process column of this process
+  blacs_int npr_       = 0;
+
+public:
+
+  /**
+   *  \brief Construct the scope communicators of a grid.
+   *
+   *  Collective over all processes of Grid::comm().
+   */
+  explicit scope_comms( const Grid& grid );
+
+  scope_comms( const scope_comms& ) = delete;
+  scope_comms& operator=( const scope_comms& ) = delete;
+
+  ~scope_comms() noexcept;
+
+  /**
+   *  \brief Communicator of the processes of a scope of this process
+   */
+  MPI_Comm comm( Scope scope ) const noexcept;
+
+  /**
+   *  \brief Rank of a process coordinate in comm( scope )
+   */
+  blacs_int root( Scope scope, blacs_int PROW, blacs_int PCOL ) const noexcept;
+
+};
+
+}
@@ -6,6 +6,7 @@
  */
 #pragma once
 #include <blacspp/types.hpp>
+#include <blacspp/traits.hpp>
 #include <type_traits>
 
 namespace blacspp {
@@ -18,31 +19,60 @@ namespace detail {
    *
    *  Type is queried by blacs_supported<T>::value (true/false)
    *  
-   *  The following types are BLACS enabled:
+   *  A type is BLACS enabled iff blacs_traits<T> has been specialized. The
+   *  following (native) types are BLACS enabled by default:
    *    - blacs_int (i)
    *    - float     (s)
    *    - double    (d)
    *    - scomplex  (c)
    *    - dcomplex  (z)
    */
-  template <typename T>
+  template <typename T, typename = std::void_t<>>
   struct blacs_supported : public std::false_type { };
 
-  template<>
-  struct blacs_supported< blacs_int > : public std::true_type { };
-  template<>
-  struct blacs_supported< float >     : public std::true_type { };
-  template<>
-  struct blacs_supported< double >    : public std::true_type { };
-  template<>
-  struct blacs_supported< scomplex >  : public std::true_type { };
-  template<>
-  struct blacs_supported< dcomplex >  : public std::true_type { };
+  template <typename T>
+  struct blacs_supported< T,
+    std::void_t< typename blacs_traits<T>::element_type >
+  > : public std::true_type { };
+
+  /**
+   *  \brief A SFINAE struct to check if a type is a native BLACS type.
+   *
+   *  Native types are handed to BLACS as is, other BLACS enabled types are
+   *  reinterpreted (see reinterpreted_blacs_traits).
+   */
+  template <typename T, typename = std::void_t<>>
+  struct blacs_native : public std::false_type { };
+
+  template <typename T>
+  struct blacs_native< T, std::enable_if_t< blacs_traits<T>::native > > : 
+    public std::true_type { };
 
   template <typename T, typename U = void>
   using enable_if_blacs_supported_t = 
     typename std::enable_if< blacs_supported<T>::value, U >::type;
 
+  template <typename T, typename U = void>
+  using enable_if_blacs_native_t = 
+    typename std::enable_if< blacs_native<T>::value, U >::type;
+
+  template <typename T, typename U = void>
+  using enable_if_blacs_reinterpreted_t = typename std::enable_if< 
+    blacs_supported<T>::value and not blacs_native<T>::value, U >::type;
+
+
+  /**
+   *  \brief The BLACS type character (i,s,d,c,z) of a native BLACS type.
+   *
+   *  @tparam T Native BLACS type
+   */
+  template <typename T>
+  struct blacs_type_char : 
+    public std::integral_constant<char, blacs_traits<T>::type_char> { };
+
+  template <typename T>
+  inline constexpr char blacs_type_char_v = blacs_type_char<T>::value;
+
 
   template <typename T, typename = std::void_t<>>
   struct has_data_member : public std::false_type { };
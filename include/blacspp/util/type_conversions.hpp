@@ -6,16 +6,51 @@
  */
 #pragma once
 #include <blacspp/types.hpp>
-#include <string>
 
 namespace blacspp::detail {
 
-  extern std::string type_string( const Triangle tri );
+  /**
+   *  \brief Convert BLACS enums to the character arguments expected by BLACS
+   *
+   *  Mapped onto string literals (static storage), such that the conversion
+   *  involves no allocation and may be evaluated at compile time. BLACS only
+   *  inspects the leading character of each argument.
+   */
+  constexpr const char* type_string( const Triangle tri ) noexcept {
+    return ( tri == Upper ) ? "Upper" : "Lower";
+  }
 
-  extern std::string type_string( const Diagonal diag );
+  constexpr const char* type_string( const Diagonal diag ) noexcept {
+    return ( diag == Unit ) ? "U" : "N";
+  }
 
-  extern std::string type_string( const Scope scope );
+  constexpr const char* type_string( const Scope scope ) noexcept {
+    return ( scope == All ) ? "All" : ( scope == Row ) ? "Row" : "Column";
+  }
 
-  extern std::string type_string( const Topology top );
+  constexpr const char* type_string( const GridOrder order ) noexcept {
+    return ( order == RowMajor ) ? "Row-major" : "Column-major";
+  }
+
+  constexpr const char* type_string( const Topology top ) noexcept {
+    switch( top ) {
+      case IRing:          return "i-ring";
+      case DRing:          return "d-ring";
+      case SRing:          return "s-ring";
+      case MRing:          return "m-ring";
+      case Hypercube:      return "hypercube";
+      case Tree:           return "tree";
+      case FullyConnected: return "fully-connected";
+      default:             return " ";
+    }
+  }
+
+  /**
+   *  \brief Compile-time BLACS string for an enum value
+   *
+   *  @tparam E BLACS enum value (Triangle, Diagonal, Scope or Topology)
+   */
+  template <auto E>
+  inline constexpr const char* type_string_v = type_string( E );
 
 }
@@ -13,27 +13,56 @@ namespace wrappers {
 
 // Send
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_supported_t<T> 
   gebs2d( const blacs_int ICONTXT, const char* SCOPE, const char* TOP, 
-          const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA );
+          const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA ) {
+
+  using traits = blacs_traits<T>;
+  if constexpr ( traits::native )
+    traits::gebs2d( ICONTXT, SCOPE, TOP, M, N, A, LDA );
+  else
+    gebs2d( ICONTXT, SCOPE, TOP, detail::transported_extent<T>( M ), N, 
+            reinterpret_cast<const typename traits::element_type*>( A ),
+            detail::transported_extent<T>( LDA ) );
+
+}
 
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_native_t<T> 
   trbs2d( const blacs_int ICONTXT, const char* SCOPE, const char* TOP,
           const char* UPLO, const char* DIAG, const blacs_int M, const blacs_int N, 
-          const T* A, const blacs_int LDA ); 
+          const T* A, const blacs_int LDA ) {
+
+  blacs_traits<T>::trbs2d( ICONTXT, SCOPE, TOP, UPLO, DIAG, M, N, A, LDA );
+
+}
 
 // Recv
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_supported_t<T> 
   gebr2d( const blacs_int ICONTXT, const char* SCOPE, const char* TOP,
-          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA );
+          const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
+          const blacs_int RSRC, const blacs_int CSRC ) {
+
+  using traits = blacs_traits<T>;
+  if constexpr ( traits::native )
+    traits::gebr2d( ICONTXT, SCOPE, TOP, M, N, A, LDA, RSRC, CSRC );
+  else
+    gebr2d( ICONTXT, SCOPE, TOP, detail::transported_extent<T>( M ), N, 
+            reinterpret_cast<typename traits::element_type*>( A ),
+            detail::transported_extent<T>( LDA ), RSRC, CSRC );
+
+}
 
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_native_t<T> 
   trbr2d( const blacs_int ICONTXT, const char* SCOPE, const char* TOP,
           const char* UPLO, const char* DIAG, const blacs_int M, const blacs_int N, 
-          T* A, const blacs_int LDA ); 
+          T* A, const blacs_int LDA, const blacs_int RSRC, const blacs_int CSRC ) {
+
+  blacs_traits<T>::trbr2d( ICONTXT, SCOPE, TOP, UPLO, DIAG, M, N, A, LDA, RSRC, CSRC );
+
+}
 
 }
 }
@@ -13,26 +13,40 @@ namespace wrappers {
 
 // Element-wise sum
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_native_t<T> 
   gsum2d( const blacs_int ICONTXT, const char* SCOPE, const char* TOP, 
           const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
-          const blacs_int RDEST, const blacs_int CDEST );
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  blacs_traits<T>::gsum2d( ICONTXT, SCOPE, TOP, M, N, A, LDA, RDEST, CDEST );
+
+}
 
 // Element-wise max
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_native_t<T> 
   gamx2d( const blacs_int ICONTXT, const char* SCOPE, const char* TOP, 
           const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
           blacs_int* RA, blacs_int* CA, const blacs_int RCFLAG, 
-          const blacs_int RDEST, const blacs_int CDEST );
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  blacs_traits<T>::gamx2d( ICONTXT, SCOPE, TOP, M, N, A, LDA, RA, CA, RCFLAG,
+                           RDEST, CDEST );
+
+}
 
 // Element-wise min
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_native_t<T> 
   gamn2d( const blacs_int ICONTXT, const char* SCOPE, const char* TOP, 
           const blacs_int M, const blacs_int N, T* A, const blacs_int LDA,
           blacs_int* RA, blacs_int* CA, const blacs_int RCFLAG, 
-          const blacs_int RDEST, const blacs_int CDEST );
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  blacs_traits<T>::gamn2d( ICONTXT, SCOPE, TOP, M, N, A, LDA, RA, CA, RCFLAG,
+                           RDEST, CDEST );
+
+}
 
 }
 }
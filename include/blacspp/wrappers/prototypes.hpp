@@ -0,0 +1,265 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#pragma once
+#include <blacspp/types.hpp>
+
+// Prototypes of the BLACS C interface
+extern "C" {
+
+// Point-to-point send
+void Cigesd2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const blacspp::blacs_int* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Csgesd2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const float* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Cdgesd2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const double* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Ccgesd2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const blacspp::scomplex* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Czgesd2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const blacspp::dcomplex* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+
+void Citrsd2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const blacspp::blacs_int* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Cstrsd2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const float* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Cdtrsd2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const double* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Cctrsd2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const blacspp::scomplex* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Cztrsd2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const blacspp::dcomplex* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+
+// Point-to-point recieve
+void Cigerv2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, blacspp::blacs_int* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+void Csgerv2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, float* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+void Cdgerv2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, double* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+void Ccgerv2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, blacspp::scomplex* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+void Czgerv2d( const blacspp::blacs_int ICONTXT, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, blacspp::dcomplex* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+
+void Citrrv2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::blacs_int* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+void Cstrrv2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, float* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+void Cdtrrv2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, double* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+void Cctrrv2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::scomplex* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+void Cztrrv2d( const blacspp::blacs_int ICONTXT, const char* UPLO, const char* DIAG,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::dcomplex* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+
+
+// Broadcast send
+void Cigebs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const blacspp::blacs_int* A, const blacspp::blacs_int LDA );
+void Csgebs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const float* A, const blacspp::blacs_int LDA );
+void Cdgebs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const double* A, const blacspp::blacs_int LDA );
+void Ccgebs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const blacspp::scomplex* A, const blacspp::blacs_int LDA );
+void Czgebs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               const blacspp::dcomplex* A, const blacspp::blacs_int LDA );
+
+void Citrbs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const blacspp::blacs_int* A,
+               const blacspp::blacs_int LDA );
+void Cstrbs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const float* A,
+               const blacspp::blacs_int LDA );
+void Cdtrbs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const double* A,
+               const blacspp::blacs_int LDA );
+void Cctrbs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const blacspp::scomplex* A,
+               const blacspp::blacs_int LDA );
+void Cztrbs2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, const blacspp::dcomplex* A,
+               const blacspp::blacs_int LDA );
+
+// Broadcast recieve
+void Cigebr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::blacs_int* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+void Csgebr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, float* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+void Cdgebr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, double* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+void Ccgebr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::scomplex* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+void Czgebr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::dcomplex* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+
+void Citrbr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, blacspp::blacs_int* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+void Cstrbr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, float* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+void Cdtrbr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, double* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RSRC, const blacspp::blacs_int CSRC );
+void Cctrbr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, blacspp::scomplex* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+void Cztrbr2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const char* UPLO, const char* DIAG, const blacspp::blacs_int M,
+               const blacspp::blacs_int N, blacspp::dcomplex* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RSRC,
+               const blacspp::blacs_int CSRC );
+
+
+// Element-wise sum
+void Cigsum2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::blacs_int* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Csgsum2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, float* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Cdgsum2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, double* A,
+               const blacspp::blacs_int LDA, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Ccgsum2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::scomplex* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Czgsum2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::dcomplex* A, const blacspp::blacs_int LDA,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+
+// Element-wise max
+void Cigamx2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::blacs_int* A, const blacspp::blacs_int LDA,
+               blacspp::blacs_int* RA, blacspp::blacs_int* CA,
+               const blacspp::blacs_int RCFLAG, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Csgamx2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, float* A,
+               const blacspp::blacs_int LDA, blacspp::blacs_int* RA,
+               blacspp::blacs_int* CA, const blacspp::blacs_int RCFLAG,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Cdgamx2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, double* A,
+               const blacspp::blacs_int LDA, blacspp::blacs_int* RA,
+               blacspp::blacs_int* CA, const blacspp::blacs_int RCFLAG,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Ccgamx2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::scomplex* A, const blacspp::blacs_int LDA,
+               blacspp::blacs_int* RA, blacspp::blacs_int* CA,
+               const blacspp::blacs_int RCFLAG, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Czgamx2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::dcomplex* A, const blacspp::blacs_int LDA,
+               blacspp::blacs_int* RA, blacspp::blacs_int* CA,
+               const blacspp::blacs_int RCFLAG, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+
+// Element-wise min
+void Cigamn2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::blacs_int* A, const blacspp::blacs_int LDA,
+               blacspp::blacs_int* RA, blacspp::blacs_int* CA,
+               const blacspp::blacs_int RCFLAG, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Csgamn2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, float* A,
+               const blacspp::blacs_int LDA, blacspp::blacs_int* RA,
+               blacspp::blacs_int* CA, const blacspp::blacs_int RCFLAG,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Cdgamn2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N, double* A,
+               const blacspp::blacs_int LDA, blacspp::blacs_int* RA,
+               blacspp::blacs_int* CA, const blacspp::blacs_int RCFLAG,
+               const blacspp::blacs_int RDEST, const blacspp::blacs_int CDEST );
+void Ccgamn2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::scomplex* A, const blacspp::blacs_int LDA,
+               blacspp::blacs_int* RA, blacspp::blacs_int* CA,
+               const blacspp::blacs_int RCFLAG, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+void Czgamn2d( const blacspp::blacs_int ICONTXT, const char* SCOPE, const char* TOP,
+               const blacspp::blacs_int M, const blacspp::blacs_int N,
+               blacspp::dcomplex* A, const blacspp::blacs_int LDA,
+               blacspp::blacs_int* RA, blacspp::blacs_int* CA,
+               const blacspp::blacs_int RCFLAG, const blacspp::blacs_int RDEST,
+               const blacspp::blacs_int CDEST );
+
+}
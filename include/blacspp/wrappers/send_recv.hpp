@@ -13,29 +13,57 @@ namespace wrappers {
 
 // Send
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_supported_t<T> 
   gesd2d( const blacs_int ICONTXT, const blacs_int M, const blacs_int N,
           const T* A, const blacs_int LDA, const blacs_int RDEST,
-          const blacs_int CDEST );
+          const blacs_int CDEST ) {
+
+  using traits = blacs_traits<T>;
+  if constexpr ( traits::native )
+    traits::gesd2d( ICONTXT, M, N, A, LDA, RDEST, CDEST );
+  else
+    gesd2d( ICONTXT, detail::transported_extent<T>( M ), N, 
+            reinterpret_cast<const typename traits::element_type*>( A ),
+            detail::transported_extent<T>( LDA ), RDEST, CDEST );
+
+}
 
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_native_t<T> 
   trsd2d( const blacs_int ICONTXT, const char* UPLO, const char* DIAG, 
           const blacs_int M, const blacs_int N, const T* A, const blacs_int LDA, 
-          const blacs_int RDEST, const blacs_int CDEST );
+          const blacs_int RDEST, const blacs_int CDEST ) {
+
+  blacs_traits<T>::trsd2d( ICONTXT, UPLO, DIAG, M, N, A, LDA, RDEST, CDEST );
+
+}
 
 // Recv
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_supported_t<T> 
   gerv2d( const blacs_int ICONTXT, const blacs_int M, const blacs_int N,
           T* A, const blacs_int LDA, const blacs_int RSRC,
-          const blacs_int CSRC );
+          const blacs_int CSRC ) {
+
+  using traits = blacs_traits<T>;
+  if constexpr ( traits::native )
+    traits::gerv2d( ICONTXT, M, N, A, LDA, RSRC, CSRC );
+  else
+    gerv2d( ICONTXT, detail::transported_extent<T>( M ), N, 
+            reinterpret_cast<typename traits::element_type*>( A ),
+            detail::transported_extent<T>( LDA ), RSRC, CSRC );
+
+}
 
 template <typename T>
-detail::enable_if_blacs_supported_t<T> 
+inline detail::enable_if_blacs_native_t<T> 
   trrv2d( const blacs_int ICONTXT, const char* UPLO, const char* DIAG, 
           const blacs_int M, const blacs_int N, T* A, const blacs_int LDA, 
-          const blacs_int RSRC, const blacs_int CSRC );
+          const blacs_int RSRC, const blacs_int CSRC ) {
+
+  blacs_traits<T>::trrv2d( ICONTXT, UPLO, DIAG, M, N, A, LDA, RSRC, CSRC );
+
+}
 
 }
 }
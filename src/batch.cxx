@@ -0,0 +1,151 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/batch.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/util/pack.hpp>
+
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+namespace blacspp {
+
+namespace {
+
+  /// Header of a tile in a batched message
+  struct record {
+    std::int32_t type;
+    std::int32_t kind;
+    std::int32_t M;
+    std::int32_t N;
+  };
+
+  constexpr std::size_t record_align = 16;
+  static_assert( sizeof(record) % record_align == 0 );
+
+  inline std::size_t round_up( std::size_t n ) {
+    return ( (n + record_align - 1) / record_align ) * record_align;
+  }
+
+  inline std::size_t tile_elements( std::int32_t kind, blacs_int M, blacs_int N ) {
+    if( not kind ) return std::size_t(M) * N;
+    return detail::trapezoid_size( Triangle( (kind-1) / 2 ), Diagonal( (kind-1) % 2 ),
+                                   M, N );
+  }
+
+}
+
+MessageBatch::MessageBatch( const Grid& grid, int tag ) : grid_( &grid ), tag_( tag ) { }
+
+void MessageBatch::enqueue_tile( blacs_int dest, char type, std::int32_t kind, 
+  std::size_t elem_size, blacs_int M, blacs_int N, const void* A, blacs_int LDA ) {
+
+  if( M < 0 or N < 0 or LDA < M ) 
+    throw std::runtime_error("Invalid (M,N,LDA) For Batched Tile");
+
+  auto& buf = send_[dest];
+  const std::size_t bytes = tile_elements( kind, M, N ) * elem_size;
+  const std::size_t pos   = buf.size();
+  buf.resize( pos + sizeof(record) + round_up( bytes ) );
+
+  const record rec{ type, kind, M, N };
+  std::memcpy( buf.data() + pos, &rec, sizeof(record) );
+
+  char* data = buf.data() + pos + sizeof(record);
+  if( kind ) 
+    detail::pack_trapezoid( data, elem_size, Triangle( (kind-1) / 2 ), 
+                            Diagonal( (kind-1) % 2 ), M, N, A, LDA );
+  else
+    detail::pack_2d( data, elem_size, M, N, A, LDA );
+
+}
+
+void MessageBatch::expect_tile( blacs_int src, char type, std::int32_t kind, 
+  std::size_t elem_size, blacs_int M, blacs_int N, void* A, blacs_int LDA ) {
+
+  if( M < 0 or N < 0 or LDA < M ) 
+    throw std::runtime_error("Invalid (M,N,LDA) For Batched Tile");
+
+  recv_[src].push_back( { type, kind, M, N, LDA, elem_size, A } );
+
+}
+
+void MessageBatch::flush() {
+
+  BLACSPP_PROFILE( "batch_flush", -1, -1, 0, std::accumulate( send_.begin(), 
+    send_.end(), std::size_t(0), []( std::size_t b, const auto& s ) {
+      return b + s.second.size(); 
+    } ) );
+
+  const auto comm = grid_->transfer_comm();
+
+  std::map< blacs_int, std::vector<char> > recv_bufs;
+  std::vector< Request > reqs;
+  reqs.reserve( send_.size() + recv_.size() );
+
+  for( const auto& [src, tiles] : recv_ ) {
+
+    std::size_t bytes = 0;
+    for( const auto& t : tiles )
+      bytes += sizeof(record) + round_up( tile_elements( t.kind, t.M, t.N ) * t.elem_size );
+
+    auto& buf = recv_bufs[src];
+    buf.resize( bytes );
+    reqs.emplace_back( detail::irecv_2d( comm, MPI_BYTE, bytes, 1, buf.data(), bytes,
+                                         src, tag_ ) );
+
+  }
+
+  for( const auto& [dest, buf] : send_ )
+    reqs.emplace_back( detail::isend_2d( comm, MPI_BYTE, buf.size(), 1, buf.data(),
+                                         buf.size(), dest, tag_ ) );
+
+  wait_all( reqs );
+  send_.clear();
+
+  auto tiles_by_src = std::move( recv_ );
+  recv_.clear();
+
+  for( const auto& [src, tiles] : tiles_by_src ) {
+
+    const char* pos = recv_bufs[src].data();
+    for( const auto& t : tiles ) {
+
+      record rec;
+      std::memcpy( &rec, pos, sizeof(record) );
+      if( rec.type != t.type or rec.kind != t.kind or rec.M != t.M or rec.N != t.N )
+        throw std::runtime_error("Batched Tile Does Not Match Recieve Buffer");
+      pos += sizeof(record);
+
+      if( t.kind )
+        detail::unpack_trapezoid( t.A, t.elem_size, Triangle( (t.kind-1) / 2 ),
+                                  Diagonal( (t.kind-1) % 2 ), t.M, t.N, pos, t.LDA );
+      else
+        detail::unpack_2d( t.A, t.elem_size, t.M, t.N, pos, t.LDA );
+
+      pos += round_up( tile_elements( t.kind, t.M, t.N ) * t.elem_size );
+
+    }
+
+  }
+
+}
+
+bool MessageBatch::empty() const noexcept {
+  return send_.empty() and recv_.empty();
+}
+
+std::size_t MessageBatch::pending_bytes( const blacs_int RDEST, 
+                                         const blacs_int CDEST ) const {
+
+  auto it = send_.find( grid_->comm_rank( RDEST, CDEST ) );
+  return it == send_.end() ? 0 : it->second.size();
+
+}
+
+}
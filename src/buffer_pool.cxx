@@ -0,0 +1,135 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/buffer_pool.hpp>
+#include <blacspp/wrappers/support.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
+namespace blacspp {
+
+namespace {
+
+  constexpr std::size_t min_class       = 8;  // 256 bytes
+  constexpr std::size_t huge_page_bytes = std::size_t(1) << 21;
+
+}
+
+BufferPool::BufferPool( const Grid& grid, const buffer_pool_options& opts ) :
+  grid_( &grid ), opts_( opts ) {
+
+  if( opts_.alignment == 0 or (opts_.alignment & (opts_.alignment - 1)) )
+    throw std::runtime_error("Buffer Pool Alignment Must Be A Power Of Two");
+
+}
+
+BufferPool::~BufferPool() noexcept {
+
+  for( std::size_t cls = 0; cls < nclasses; ++cls )
+    for( auto* ptr : free_[cls] ) free_buffer( ptr );
+
+}
+
+std::size_t BufferPool::size_class( std::size_t bytes ) const noexcept {
+
+  std::size_t cls = min_class;
+  while( (std::size_t(1) << cls) < std::max( bytes, opts_.alignment ) ) ++cls;
+  return cls;
+
+}
+
+void* BufferPool::allocate_class( std::size_t cls ) {
+
+  const std::size_t bytes = std::size_t(1) << cls;
+
+  void* ptr = nullptr;
+  if( opts_.mpi_memory ) {
+    if( MPI_Alloc_mem( bytes, MPI_INFO_NULL, &ptr ) != MPI_SUCCESS ) ptr = nullptr;
+  } else {
+    const bool huge = opts_.huge_pages and bytes >= huge_page_bytes;
+    ptr = std::aligned_alloc( huge ? huge_page_bytes : opts_.alignment, bytes );
+#if defined(MADV_HUGEPAGE)
+    if( ptr and huge ) madvise( ptr, bytes, MADV_HUGEPAGE );
+#endif
+  }
+
+  if( not ptr ) throw std::bad_alloc();
+  return ptr;
+
+}
+
+void BufferPool::free_buffer( void* ptr ) noexcept {
+
+  if( opts_.mpi_memory ) MPI_Free_mem( ptr );
+  else                   std::free( ptr );
+
+}
+
+void* BufferPool::allocate( std::size_t bytes ) {
+
+  if( not bytes ) return nullptr;
+
+  const auto cls = size_class( bytes );
+  const std::size_t cls_bytes = std::size_t(1) << cls;
+
+  void* ptr;
+  auto& bucket = free_[cls];
+  if( not bucket.empty() ) {
+    ptr = bucket.back();
+    bucket.pop_back();
+    stats_.cached -= cls_bytes;
+    stats_.hits++;
+  } else {
+    ptr = allocate_class( cls );
+    stats_.misses++;
+  }
+
+  stats_.in_use += cls_bytes;
+  stats_.peak    = std::max( stats_.peak, stats_.in_use + stats_.cached );
+  return ptr;
+
+}
+
+void BufferPool::deallocate( void* ptr, std::size_t bytes ) noexcept {
+
+  if( not ptr ) return;
+
+  const auto cls = size_class( bytes );
+  const std::size_t cls_bytes = std::size_t(1) << cls;
+
+  stats_.in_use -= cls_bytes;
+  try {
+    free_[cls].push_back( ptr );
+    stats_.cached += cls_bytes;
+  } catch( ... ) {
+    free_buffer( ptr );
+  }
+
+  if( opts_.high_water and stats_.cached > opts_.high_water ) release( false );
+
+}
+
+void BufferPool::release( bool wait ) noexcept {
+
+  for( std::size_t cls = 0; cls < nclasses; ++cls ) {
+    for( auto* ptr : free_[cls] ) free_buffer( ptr );
+    free_[cls].clear();
+  }
+  stats_.cached = 0;
+  stats_.releases++;
+
+  if( grid_->is_valid() ) wrappers::freebuff( grid_->context(), wait );
+
+}
+
+}
@@ -0,0 +1,164 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/compression.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace blacspp::detail {
+
+namespace {
+
+  /// Values converted per step (staged on the stack)
+  constexpr blacs_int chunk = 512;
+
+  // The kernels below are branch free, such that they are vectorized by the
+  // compiler (conversions, compares and blends)
+
+  void to_float( const double* x, float* f, const blacs_int n,
+                 const bool saturate ) noexcept {
+
+    constexpr double fmax = std::numeric_limits<float>::max();
+    constexpr double inf  = std::numeric_limits<double>::infinity();
+    if( saturate )
+      for( blacs_int i = 0; i < n; ++i ) {
+        const double a = std::abs( x[i] );
+        f[i] = float( ( a > fmax and a != inf ) ? std::copysign( fmax, x[i] ) : x[i] );
+      }
+    else
+      for( blacs_int i = 0; i < n; ++i ) f[i] = float( x[i] );
+
+  }
+
+  void to_bfloat16( const float* f, std::uint16_t* h, const blacs_int n,
+                    const bool saturate ) noexcept {
+
+    for( blacs_int i = 0; i < n; ++i ) {
+
+      std::uint32_t u;
+      std::memcpy( &u, f + i, sizeof(u) );
+
+      // Round to nearest even, quiet NaNs
+      const std::uint32_t mag = u & 0x7fffffffu;
+      std::uint16_t r = std::uint16_t( ( u + 0x7fffu + ( ( u >> 16 ) & 1u ) ) >> 16 );
+      r = mag > 0x7f800000u ? std::uint16_t( ( u >> 16 ) | 0x40u ) : r;
+
+      // Finite values which rounded to Inf
+      if( saturate )
+        r = ( ( r & 0x7fffu ) == 0x7f80u and mag < 0x7f800000u ) ?
+          std::uint16_t( ( r & 0x8000u ) | 0x7f7fu ) : r;
+
+      h[i] = r;
+
+    }
+
+  }
+
+  void from_bfloat16( const std::uint16_t* h, double* x, const blacs_int n ) noexcept {
+    for( blacs_int i = 0; i < n; ++i ) {
+      const std::uint32_t u = std::uint32_t( h[i] ) << 16;
+      float f;
+      std::memcpy( &f, &u, sizeof(f) );
+      x[i] = f;
+    }
+  }
+
+}
+
+std::size_t wire_words( WirePrecision precision, std::size_t n ) noexcept {
+  return precision == WirePrecision::Float ? n : ( n + 1 ) / 2;
+}
+
+void compress_2d( WirePrecision precision, WireErrorPolicy policy, blacs_int M,
+                  blacs_int N, const double* A, blacs_int LDA, blacs_int* dst ) noexcept {
+
+  const bool saturate = policy == WireErrorPolicy::Saturate;
+  auto* d = reinterpret_cast<char*>( dst );
+
+  float         f[ chunk ];
+  std::uint16_t h[ chunk ];
+  for( blacs_int j = 0; j < N; ++j )
+  for( blacs_int i = 0; i < M; i += chunk ) {
+
+    const blacs_int n = std::min( chunk, M - i );
+    to_float( A + i + std::size_t(j) * LDA, f, n, saturate );
+
+    if( precision == WirePrecision::Float ) {
+      std::memcpy( d, f, n * sizeof(float) );
+      d += n * sizeof(float);
+    } else {
+      to_bfloat16( f, h, n, saturate );
+      std::memcpy( d, h, n * sizeof(std::uint16_t) );
+      d += n * sizeof(std::uint16_t);
+    }
+
+  }
+
+}
+
+void expand_2d( WirePrecision precision, blacs_int M, blacs_int N,
+                const blacs_int* src, double* A, blacs_int LDA ) noexcept {
+
+  const auto* s = reinterpret_cast<const char*>( src );
+
+  float         f[ chunk ];
+  std::uint16_t h[ chunk ];
+  for( blacs_int j = 0; j < N; ++j )
+  for( blacs_int i = 0; i < M; i += chunk ) {
+
+    const blacs_int n = std::min( chunk, M - i );
+    double* x = A + i + std::size_t(j) * LDA;
+
+    if( precision == WirePrecision::Float ) {
+      std::memcpy( f, s, n * sizeof(float) );
+      for( blacs_int k = 0; k < n; ++k ) x[k] = f[k];
+      s += n * sizeof(float);
+    } else {
+      std::memcpy( h, s, n * sizeof(std::uint16_t) );
+      from_bfloat16( h, x, n );
+      s += n * sizeof(std::uint16_t);
+    }
+
+  }
+
+}
+
+
+
+
+const std::vector< blacs_int >& compression_transport::compress( blacs_int M,
+  blacs_int N, const double* A, blacs_int LDA ) {
+
+  auto& wire = reserve( M, N );
+  if( not wire.empty() ) wire.back() = 0; // Padding of an odd number of bfloat16
+  compress_2d( opts_.precision, opts_.policy, M, N, A, LDA, wire.data() );
+  return wire;
+
+}
+
+std::vector< blacs_int >& compression_transport::reserve( blacs_int M, blacs_int N ) {
+
+  const std::size_t n = std::size_t(M) * std::size_t(N);
+  wire_.resize( wire_words( opts_.precision, n ) );
+
+  stats_.compressed++;
+  stats_.bytes      += n * sizeof(double);
+  stats_.wire_bytes += wire_.size() * sizeof(blacs_int);
+
+  return wire_;
+
+}
+
+void compression_transport::expand( blacs_int M, blacs_int N, double* A,
+  blacs_int LDA ) {
+  expand_2d( opts_.precision, M, N, wire_.data(), A, LDA );
+}
+
+}
@@ -0,0 +1,131 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/datatype.hpp>
+#include <blacspp/util/pack.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace blacspp {
+
+namespace {
+
+  constexpr int p2p_tag = 1;
+
+  MPI_Datatype make_datatype( const detail::datatype_key& key, MPI_Datatype elem ) {
+
+    if( key.M < 0 or key.N < 0 or key.LDA < std::max( key.M, 1 ) ) 
+      throw std::runtime_error("Invalid (M,N,LDA) For Derived Datatype");
+
+    MPI_Datatype type;
+    if( key.uplo < 0 ) {
+
+      MPI_Type_vector( key.N, key.M, key.LDA, elem, &type );
+
+    } else {
+
+      std::vector<int> lengths( key.N ), displs( key.N );
+      for( blacs_int j = 0; j < key.N; ++j ) {
+        const auto [first, last] = detail::trapezoid_rows( Triangle(key.uplo), 
+          Diagonal(key.diag), key.M, key.N, j );
+        lengths[j] = std::max( last - first, 0 );
+        displs[j]  = j * key.LDA + first;
+      }
+      MPI_Type_indexed( key.N, lengths.data(), displs.data(), elem, &type );
+
+    }
+
+    MPI_Type_commit( &type );
+    return type;
+
+  }
+
+}
+
+DatatypeCache::DatatypeCache( std::size_t capacity ) : 
+  capacity_( std::max( capacity, std::size_t(1) ) ) { }
+
+DatatypeCache::~DatatypeCache() noexcept { clear(); }
+
+MPI_Datatype DatatypeCache::get( const detail::datatype_key& key, MPI_Datatype elem ) {
+
+  auto it = index_.find( key );
+  if( it != index_.end() ) {
+    hits_++;
+    lru_.splice( lru_.begin(), lru_, it->second );
+    return it->second->second;
+  }
+
+  misses_++;
+  if( lru_.size() == capacity_ ) {
+    MPI_Type_free( &lru_.back().second );
+    index_.erase( lru_.back().first );
+    lru_.pop_back();
+  }
+
+  lru_.emplace_front( key, make_datatype( key, elem ) );
+  index_.emplace( key, lru_.begin() );
+  return lru_.front().second;
+
+}
+
+void DatatypeCache::clear() noexcept {
+
+  for( auto& e : lru_ ) MPI_Type_free( &e.second );
+  lru_.clear();
+  index_.clear();
+
+}
+
+
+
+
+namespace detail {
+
+datatype_transport::datatype_transport( const Grid& grid, std::size_t capacity ) :
+  scopes_( grid ), cache_( capacity ) {
+
+  MPI_Comm_dup( grid.comm(), &comm_ );
+
+}
+
+datatype_transport::~datatype_transport() noexcept {
+
+  cache_.clear();
+  MPI_Comm_free( &comm_ );
+
+}
+
+void datatype_transport::send( const datatype_key& key, MPI_Datatype elem, 
+  const void* A, blacs_int dest ) {
+
+  if( key.M == 0 or key.N == 0 ) return;
+  MPI_Send( A, 1, cache_.get( key, elem ), dest, p2p_tag, comm_ );
+
+}
+
+void datatype_transport::recv( const datatype_key& key, MPI_Datatype elem, 
+  void* A, blacs_int src ) {
+
+  if( key.M == 0 or key.N == 0 ) return;
+  MPI_Recv( A, 1, cache_.get( key, elem ), src, p2p_tag, comm_, MPI_STATUS_IGNORE );
+
+}
+
+void datatype_transport::broadcast( Scope scope, const datatype_key& key, 
+  MPI_Datatype elem, void* A, blacs_int RSRC, blacs_int CSRC ) {
+
+  if( key.M == 0 or key.N == 0 ) return;
+
+  MPI_Bcast( A, 1, cache_.get( key, elem ), scopes_.root( scope, RSRC, CSRC ),
+             scopes_.comm( scope ) );
+
+}
+
+}
+}
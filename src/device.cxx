@@ -0,0 +1,315 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/device.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/util/pack.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(BLACSPP_HAS_CUDA)
+#include <cuda_runtime.h>
+#elif defined(BLACSPP_HAS_HIP)
+#include <hip/hip_runtime.h>
+#endif
+
+#if __has_include(<mpi-ext.h>)
+#include <mpi-ext.h>
+#endif
+
+namespace blacspp {
+
+namespace {
+
+  constexpr int p2p_tag = 1;
+
+  /// Copy a (M,N,LDA) block of device memory into contiguous host memory
+  void copy_to_host( void* dst, const void* A, std::size_t elem_size, blacs_int M,
+                     blacs_int N, blacs_int LDA ) {
+#if defined(BLACSPP_HAS_CUDA)
+    cudaMemcpy2D( dst, M*elem_size, A, LDA*elem_size, M*elem_size, N,
+                  cudaMemcpyDeviceToHost );
+#elif defined(BLACSPP_HAS_HIP)
+    hipMemcpy2D( dst, M*elem_size, A, LDA*elem_size, M*elem_size, N,
+                 hipMemcpyDeviceToHost );
+#else
+    detail::pack_2d( dst, elem_size, M, N, A, LDA );
+#endif
+  }
+
+  /// Copy contiguous host memory into a (M,N,LDA) block of device memory
+  void copy_to_device( void* A, const void* src, std::size_t elem_size, blacs_int M,
+                       blacs_int N, blacs_int LDA ) {
+#if defined(BLACSPP_HAS_CUDA)
+    cudaMemcpy2D( A, LDA*elem_size, src, M*elem_size, M*elem_size, N,
+                  cudaMemcpyHostToDevice );
+#elif defined(BLACSPP_HAS_HIP)
+    hipMemcpy2D( A, LDA*elem_size, src, M*elem_size, M*elem_size, N,
+                 hipMemcpyHostToDevice );
+#else
+    detail::unpack_2d( A, elem_size, M, N, src, LDA );
+#endif
+  }
+
+  void* allocate_pinned( std::size_t bytes ) {
+    void* ptr = nullptr;
+#if defined(BLACSPP_HAS_CUDA)
+    if( cudaMallocHost( &ptr, bytes ) != cudaSuccess ) ptr = nullptr;
+#elif defined(BLACSPP_HAS_HIP)
+    if( hipHostMalloc( &ptr, bytes ) != hipSuccess ) ptr = nullptr;
+#else
+    ptr = std::malloc( bytes );
+#endif
+    if( not ptr ) throw std::bad_alloc();
+    return ptr;
+  }
+
+  void free_pinned( void* ptr ) noexcept {
+    if( not ptr ) return;
+#if defined(BLACSPP_HAS_CUDA)
+    cudaFreeHost( ptr );
+#elif defined(BLACSPP_HAS_HIP)
+    hipHostFree( ptr );
+#else
+    std::free( ptr );
+#endif
+  }
+
+  inline const char* offset( const void* A, std::size_t bytes ) {
+    return static_cast<const char*>( A ) + bytes;
+  }
+  inline char* offset( void* A, std::size_t bytes ) {
+    return static_cast<char*>( A ) + bytes;
+  }
+
+}
+
+bool device_support() noexcept {
+#if defined(BLACSPP_HAS_CUDA) || defined(BLACSPP_HAS_HIP)
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool is_device_pointer( const void* ptr ) noexcept {
+
+  if( not ptr ) return false;
+#if defined(BLACSPP_HAS_CUDA)
+  cudaPointerAttributes attr;
+  if( cudaPointerGetAttributes( &attr, ptr ) != cudaSuccess ) {
+    cudaGetLastError(); // Clear the error of unregistered host pointers
+    return false;
+  }
+  return attr.type == cudaMemoryTypeDevice;
+#elif defined(BLACSPP_HAS_HIP)
+  hipPointerAttribute_t attr;
+  if( hipPointerGetAttributes( &attr, ptr ) != hipSuccess ) {
+    hipGetLastError();
+    return false;
+  }
+  return attr.memoryType == hipMemoryTypeDevice;
+#else
+  return false;
+#endif
+
+}
+
+bool device_aware_mpi() noexcept {
+
+  if( const char* env = std::getenv( "BLACSPP_DEVICE_AWARE_MPI" ) )
+    return std::string( env ) != "0";
+
+#if defined(BLACSPP_HAS_CUDA) && defined(MPIX_CUDA_AWARE_SUPPORT) && MPIX_CUDA_AWARE_SUPPORT
+  return MPIX_Query_cuda_support();
+#elif defined(BLACSPP_HAS_HIP) && defined(MPIX_ROCM_AWARE_SUPPORT) && MPIX_ROCM_AWARE_SUPPORT
+  return MPIX_Query_rocm_support();
+#else
+  return false;
+#endif
+
+}
+
+
+
+
+namespace detail {
+
+device_transport::device_transport( const Grid& grid, std::size_t chunk_bytes ) :
+  scopes_( grid ), chunk_bytes_( std::max( chunk_bytes, std::size_t(1) ) ), 
+  aware_( device_aware_mpi() ) {
+
+  MPI_Comm_dup( grid.comm(), &comm_ );
+
+}
+
+device_transport::~device_transport() noexcept {
+
+  for( auto* s : stage_ ) free_pinned( s );
+  MPI_Comm_free( &comm_ );
+
+}
+
+blacs_int device_transport::chunk_cols( std::size_t elem_size, blacs_int M ) const noexcept {
+  return std::max( blacs_int( chunk_bytes_ / std::max( M*elem_size, std::size_t(1) ) ), 1 );
+}
+
+bool device_transport::staged( const void* A ) {
+
+  const bool device = is_device_pointer( A );
+  if( not device )  stats_.host++;
+  else if( aware_ ) stats_.direct++;
+  else              stats_.staged++;
+  return device and not aware_;
+
+}
+
+void device_transport::reserve_stage( std::size_t bytes ) {
+
+  if( bytes <= stage_bytes_ ) return;
+  for( auto& s : stage_ ) { free_pinned( s ); s = nullptr; }
+  for( auto& s : stage_ ) s = allocate_pinned( bytes );
+  stage_bytes_ = bytes;
+
+}
+
+void device_transport::send( MPI_Datatype elem, std::size_t elem_size, 
+  blacs_int M, blacs_int N, const void* A, blacs_int LDA, blacs_int dest ) {
+
+  if( M == 0 or N == 0 ) return;
+
+  const blacs_int nc = chunk_cols( elem_size, M );
+  const bool stage   = staged( A );
+
+  std::vector< Request > reqs( stage ? 2 : (N + nc - 1) / nc );
+  if( stage ) reserve_stage( std::size_t(M) * nc * elem_size );
+
+  for( blacs_int j = 0, k = 0; j < N; j += nc, ++k ) {
+
+    const blacs_int ncols = std::min( nc, N - j );
+    const void*     A_j   = offset( A, std::size_t(j) * LDA * elem_size );
+
+    if( stage ) {
+      // Overlap the copy of this block with the send of the previous one
+      auto& r = reqs[ k % 2 ];
+      r.wait();
+      copy_to_host( stage_[k % 2], A_j, elem_size, M, ncols, LDA );
+      r = isend_2d( comm_, elem, M, ncols, stage_[k % 2], M, dest, p2p_tag );
+    } else {
+      reqs[k] = isend_2d( comm_, elem, M, ncols, A_j, LDA, dest, p2p_tag );
+    }
+
+  }
+
+  wait_all( reqs );
+
+}
+
+void device_transport::recv( MPI_Datatype elem, std::size_t elem_size, 
+  blacs_int M, blacs_int N, void* A, blacs_int LDA, blacs_int src ) {
+
+  if( M == 0 or N == 0 ) return;
+
+  const blacs_int nc      = chunk_cols( elem_size, M );
+  const blacs_int nchunks = (N + nc - 1) / nc;
+  const bool      stage   = staged( A );
+
+  if( not stage ) {
+    std::vector< Request > reqs;
+    reqs.reserve( nchunks );
+    for( blacs_int j = 0; j < N; j += nc )
+      reqs.emplace_back( irecv_2d( comm_, elem, M, std::min( nc, N - j ), 
+        offset( A, std::size_t(j) * LDA * elem_size ), LDA, src, p2p_tag ) );
+    wait_all( reqs );
+    return;
+  }
+
+  reserve_stage( std::size_t(M) * nc * elem_size );
+
+  Request reqs[2];
+  reqs[0] = irecv_2d( comm_, elem, M, std::min( nc, N ), stage_[0], M, src, p2p_tag );
+  for( blacs_int j = 0, k = 0; j < N; j += nc, ++k ) {
+
+    // Overlap the recieve of the next block with the copy of this one
+    if( k + 1 < nchunks ) {
+      const blacs_int j_next = j + nc;
+      reqs[(k+1) % 2] = irecv_2d( comm_, elem, M, std::min( nc, N - j_next ), 
+        stage_[(k+1) % 2], M, src, p2p_tag );
+    }
+
+    reqs[k % 2].wait();
+    copy_to_device( offset( A, std::size_t(j) * LDA * elem_size ), stage_[k % 2], 
+                    elem_size, M, std::min( nc, N - j ), LDA );
+
+  }
+
+}
+
+void device_transport::broadcast( Scope scope, bool is_root, MPI_Datatype elem, 
+  std::size_t elem_size, blacs_int M, blacs_int N, void* A, blacs_int LDA, 
+  blacs_int RSRC, blacs_int CSRC ) {
+
+  if( M == 0 or N == 0 ) return;
+
+  const auto      comm    = scopes_.comm( scope );
+  const auto      root    = scopes_.root( scope, RSRC, CSRC );
+  const blacs_int nc      = chunk_cols( elem_size, M );
+  const blacs_int nchunks = (N + nc - 1) / nc;
+  const bool      stage   = staged( A );
+
+  auto ibcast = [&]( void* buf, blacs_int ncols, blacs_int ld ) {
+    strided_type type( elem, M, ncols, ld );
+    MPI_Request r;
+    MPI_Ibcast( buf, type.count(), type.type(), root, comm, &r );
+    return Request( r );
+  };
+
+  if( not stage ) {
+    std::vector< Request > reqs;
+    reqs.reserve( nchunks );
+    for( blacs_int j = 0; j < N; j += nc )
+      reqs.emplace_back( ibcast( offset( A, std::size_t(j) * LDA * elem_size ), 
+        std::min( nc, N - j ), LDA ) );
+    wait_all( reqs );
+    return;
+  }
+
+  reserve_stage( std::size_t(M) * nc * elem_size );
+
+  Request reqs[2];
+  if( is_root ) {
+
+    for( blacs_int j = 0, k = 0; j < N; j += nc, ++k ) {
+      const blacs_int ncols = std::min( nc, N - j );
+      reqs[k % 2].wait();
+      copy_to_host( stage_[k % 2], offset( A, std::size_t(j) * LDA * elem_size ), 
+                    elem_size, M, ncols, LDA );
+      reqs[k % 2] = ibcast( stage_[k % 2], ncols, M );
+    }
+    wait_all( reqs, reqs + 2 );
+
+  } else {
+
+    reqs[0] = ibcast( stage_[0], std::min( nc, N ), M );
+    for( blacs_int j = 0, k = 0; j < N; j += nc, ++k ) {
+      if( k + 1 < nchunks )
+        reqs[(k+1) % 2] = ibcast( stage_[(k+1) % 2], std::min( nc, N - j - nc ), M );
+      reqs[k % 2].wait();
+      copy_to_device( offset( A, std::size_t(j) * LDA * elem_size ), stage_[k % 2], 
+                      elem_size, M, std::min( nc, N - j ), LDA );
+    }
+
+  }
+
+}
+
+}
+}
@@ -5,85 +5,690 @@
  *  All rights reserved
  */
 #include <blacspp/grid.hpp>
+#include <blacspp/tune.hpp>
+#include <blacspp/compression.hpp>
+#include <blacspp/datatype.hpp>
+#include <blacspp/device.hpp>
+#include <blacspp/hierarchical.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/progress.hpp>
+#include <blacspp/shared_memory.hpp>
 #include <blacspp/wrappers/support.hpp>
 #include <blacspp/util/type_conversions.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <tuple>
 
 namespace blacspp {
 
+namespace detail {
+
+  /**
+   *  \brief Owns a BLACS system handle (and optionally its MPI communicator)
+   */
+  class system_handle {
+
+    MPI_Comm  comm_;
+    bool      owns_comm_;
+    blacs_int handle_;
+
+  public:
+
+    system_handle( MPI_Comm c, bool owns_comm ) : 
+      comm_(c), owns_comm_(owns_comm), handle_( wrappers::blacs_from_sys(c) ) { }
+
+    system_handle( const system_handle& ) = delete;
+    system_handle& operator=( const system_handle& ) = delete;
+
+    ~system_handle() noexcept {
+      wrappers::free_sys_handle( handle_ );
+      if( owns_comm_ ) MPI_Comm_free( &comm_ );
+    }
+
+    inline blacs_int handle() const noexcept { return handle_; }
+
+  };
+
+  /**
+   *  \brief Owns a BLACS context (and retains its system handle)
+   *
+   *  Also owns the duplicate of the communicator of the grid over which the
+   *  non-blocking transfers of blacspp are posted (see Grid::transfer_comm).
+   */
+  class context_handle {
+
+    std::shared_ptr<const system_handle> system_;
+    blacs_int context_;
+    MPI_Comm  transfer_comm_;
+
+  public:
+
+    context_handle( std::shared_ptr<const system_handle> sys, blacs_int c,
+                    MPI_Comm transfer_comm ) noexcept :
+      system_( std::move(sys) ), context_( c ), transfer_comm_( transfer_comm ) { }
+
+    context_handle( const context_handle& ) = delete;
+    context_handle& operator=( const context_handle& ) = delete;
+
+    ~context_handle() noexcept {
+      BLACSPP_PROFILE( "grid_exit", -1, -1, 0, 0 );
+      wrappers::grid_exit( context_ );
+      MPI_Comm_free( &transfer_comm_ );
+    }
+
+    inline blacs_int context()       const noexcept { return context_;       }
+    inline MPI_Comm  transfer_comm() const noexcept { return transfer_comm_; }
+    inline const std::shared_ptr<const system_handle>& system() const noexcept {
+      return system_;
+    }
+
+  };
+
+}
+
+namespace {
+
+  /**
+   *  \brief Process-wide cache of BLACS contexts (see Grid::cached)
+   *
+   *  Holds weak references only, such that contexts are released with the last
+   *  grid which uses them. Expired entries are pruned on lookup.
+   */
+  struct grid_cache {
+
+    using key = std::tuple< MPI_Comm, blacs_int, blacs_int, std::vector<blacs_int> >;
+
+    struct entry {
+      std::weak_ptr<const detail::context_handle> context;
+      blacs_grid_dim                              dim;
+    };
+
+    std::mutex                 mutex;
+    std::map< key, entry >     contexts;
+    std::map< MPI_Comm, std::weak_ptr<const detail::system_handle> > systems;
+    grid_cache_stats           stats;
+
+    static grid_cache& instance() {
+      static grid_cache cache;
+      return cache;
+    }
+
+    void prune() {
+      for( auto it = contexts.begin(); it != contexts.end(); )
+        it = it->second.context.expired() ? contexts.erase( it ) : std::next( it );
+      for( auto it = systems.begin(); it != systems.end(); )
+        it = it->second.expired() ? systems.erase( it ) : std::next( it );
+    }
+
+  };
+
+  // Throws if pmap is not a permutation of the nproc ranks of a communicator
+  void check_process_map( const std::vector<blacs_int>& pmap, blacs_int nproc ) {
+
+    std::vector<bool> mapped( nproc, false );
+    if( pmap.size() != mapped.size() ) 
+      throw std::runtime_error("Invalid Process Map");
+    for( auto r : pmap ) {
+      if( r < 0 or r >= nproc or mapped[r] )
+        throw std::runtime_error("Invalid Process Map");
+      mapped[r] = true;
+    }
+
+  }
+
+  // Rank (in comm) of each process coordinate (col-major) of a grid of an ordering
+  std::vector<blacs_int> ordered_map( blacs_int npr, blacs_int npc, GridOrder order ) {
+    std::vector<blacs_int> pmap( npr * npc );
+    for( blacs_int j = 0; j < npc; ++j )
+    for( blacs_int i = 0; i < npr; ++i )
+      pmap[ i + j*npr ] = (order == RowMajor) ? i * npc + j : i + j * npr;
+    return pmap;
+  }
+
+  // Rank (in comm) of the leader of the shared memory node of each rank of comm
+  std::vector<blacs_int> node_leaders( MPI_Comm comm ) {
+
+    int rank, size;
+    MPI_Comm_rank( comm, &rank );
+    MPI_Comm_size( comm, &size );
+
+    MPI_Comm node;
+    MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node );
+
+    blacs_int leader;
+    MPI_Allreduce( &rank, &leader, 1, MPI_INT, MPI_MIN, node );
+    MPI_Comm_free( &node );
+
+    std::vector<blacs_int> leaders( size );
+    MPI_Allgather( &leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, comm );
+    return leaders;
+
+  }
+
+  // Duplicate of comm which carries the non-blocking transfers of a context
+  MPI_Comm transfer_dup( MPI_Comm comm ) {
+    MPI_Comm dup;
+    MPI_Comm_dup( comm, &dup );
+    return dup;
+  }
+
+  // Closest to square factorization of nproc
+  std::pair<blacs_int,blacs_int> square_dims( blacs_int nproc ) {
+ 
+    blacs_int npr = std::sqrt( nproc );
+    blacs_int npc = nproc / npr; 
+
+    while( npr * npc != nproc ) {
+      npr--;
+      npc = nproc / npr;
+    }
+
+    return { npr, npc };
+
+  }
+
+  // Number of process pairs and pairs which share a node for a group of processes
+  std::pair<double,double> group_pairs( const std::map<blacs_int,blacs_int>& counts ) {
+    double n = 0., intra = 0.;
+    for( const auto& c : counts ) {
+      n     += c.second;
+      intra += 0.5 * c.second * (c.second - 1);
+    }
+    return { 0.5 * n * (n - 1), intra };
+  }
+
+}
+
 bool Grid::is_valid() const {
-  return mpi_info_.comm() != MPI_COMM_NULL;
+  return mpi_info_.comm() != MPI_COMM_NULL and context_ >= 0;
 }
 
+MPI_Comm Grid::transfer_comm() const noexcept {
+  return ctx_ ? ctx_->transfer_comm() : MPI_COMM_NULL;
+}
 
 void Grid::barrier( Scope scope ) const noexcept {
-  auto SCOPE = detail::type_string( scope );
-  wrappers::barrier( context(), SCOPE.c_str() );
+  BLACSPP_PROFILE( "barrier", scope, -1, 0, 0 );
+  const auto SCOPE = detail::type_string( scope );
+  wrappers::barrier( context(), SCOPE );
+}
+
+
+void Grid::set_combine_topology( Topology top ) {
+  if( not valid_for( Combine, top ) )
+    throw std::runtime_error("Ring Topologies Are Not Valid For Combines");
+  comb_top_ = top;
+}
+
+void Grid::set_topology_table( std::shared_ptr<const TopologyTable> table ) noexcept {
+  top_table_ = std::move( table );
+}
+
+Topology Grid::broadcast_topology( Scope scope, std::size_t bytes ) const noexcept {
+  if( top_table_ ) 
+    return top_table_->lookup( Broadcast, scope, bytes ).value_or( bcast_top_ );
+  return bcast_top_;
+}
+
+Topology Grid::combine_topology( Scope scope, std::size_t bytes ) const noexcept {
+  if( top_table_ ) 
+    return top_table_->lookup( Combine, scope, bytes ).value_or( comb_top_ );
+  return comb_top_;
+}
+
+void Grid::enable_shared_memory( std::size_t bytes ) {
+  if( mpi_info_.comm() == MPI_COMM_NULL ) return;
+  shm_.reset();
+  shm_ = std::make_shared<detail::shm_transport>( mpi_info_.comm(), bytes );
+}
+
+void Grid::enable_shared_memory() {
+  enable_shared_memory( shared_memory_default_bytes );
+}
+
+void Grid::disable_shared_memory() { shm_.reset(); }
+
+void Grid::enable_datatype_transport( std::size_t capacity ) {
+  if( mpi_info_.comm() == MPI_COMM_NULL ) return;
+  dtt_.reset();
+  dtt_ = std::make_shared<detail::datatype_transport>( *this, capacity );
+}
+
+void Grid::enable_datatype_transport() {
+  enable_datatype_transport( datatype_cache_default_capacity );
+}
+
+void Grid::disable_datatype_transport() { dtt_.reset(); }
+
+void Grid::enable_device_transport( std::size_t chunk_bytes ) {
+  if( mpi_info_.comm() == MPI_COMM_NULL ) return;
+  dev_.reset();
+  dev_ = std::make_shared<detail::device_transport>( *this, chunk_bytes );
+}
+
+void Grid::enable_device_transport() {
+  enable_device_transport( device_chunk_default_bytes );
+}
+
+void Grid::disable_device_transport() { dev_.reset(); }
+
+void Grid::enable_compression( const compression_options& opts ) {
+  cmp_ = std::make_shared<detail::compression_transport>( opts );
+}
+
+void Grid::enable_compression() { enable_compression( compression_options() ); }
+
+void Grid::disable_compression() { cmp_.reset(); }
+
+void Grid::enable_hierarchical_collectives( blacs_int ranks_per_node ) {
+  if( mpi_info_.comm() == MPI_COMM_NULL ) return;
+  hier_.reset();
+  hier_ = std::make_shared<detail::hierarchical_transport>( *this, ranks_per_node );
+}
+
+void Grid::enable_hierarchical_collectives() { enable_hierarchical_collectives( 0 ); }
+
+void Grid::disable_hierarchical_collectives() { hier_.reset(); }
+
+void Grid::enable_progress( const progress_options& opts ) {
+  progress_.reset();
+  progress_ = std::make_shared<ProgressEngine>( opts );
 }
 
+void Grid::enable_progress() { enable_progress( progress_options() ); }
 
+void Grid::disable_progress() { progress_.reset(); }
 
 Grid::Grid() : Grid( MPI_COMM_NULL, 0, 0 ){ }
 
-Grid::Grid( MPI_Comm c, blacs_int npr, blacs_int npc ) : mpi_info_( c ) {
+Grid::Grid( MPI_Comm c, blacs_int npr, blacs_int npc, GridOrder order ) : 
+  mpi_info_( c ) {
 
-  if( is_valid() ) {
+  if( mpi_info_.comm() != MPI_COMM_NULL ) {
 
     if( npr * npc != mpi_info_.size() )
       throw std::runtime_error("NPC * NPR != NPROCS");
 
     // Create system handle
-    system_handle_ = wrappers::blacs_from_sys( c );
+    system_ = std::make_shared<detail::system_handle>( c, false );
     
     // Greate blacs grid
-    context_ = wrappers::grid_init( system_handle_, "row-major", npr, npc );
+    BLACSPP_PROFILE( "grid_init", -1, -1, 0, 0 );
+    context_ = wrappers::grid_init( system_->handle(), detail::type_string( order ),
+                                    npr, npc );
+
+    ctx_ = std::make_shared<const detail::context_handle>( system_, context_,
+                                                           transfer_dup( c ) );
 
     // Grab the grid info
     grid_dim_ = wrappers::grid_info( context_ );
+    pmap_     = ordered_map( npr, npc, order );
+
+  }
+
+}
+
+Grid::Grid( MPI_Comm c, blacs_int npr, blacs_int npc, std::vector<blacs_int> pmap ) :
+  mpi_info_( c ), pmap_( std::move(pmap) ) {
+
+  if( mpi_info_.comm() != MPI_COMM_NULL ) {
+
+    if( npr * npc != mpi_info_.size() )
+      throw std::runtime_error("NPC * NPR != NPROCS");
+
+    check_process_map( pmap_, mpi_info_.size() );
+
+    BLACSPP_PROFILE( "grid_init", -1, -1, 0, 0 );
+    system_   = std::make_shared<detail::system_handle>( c, false );
+    context_  = wrappers::grid_map( system_->handle(), pmap_.data(), npr, npr, npc );
+    ctx_      = std::make_shared<const detail::context_handle>( system_, context_,
+                                                                transfer_dup( c ) );
+    grid_dim_ = wrappers::grid_info( context_ );
+
+  }
+
+}
 
+Grid::Grid( std::shared_ptr<const detail::system_handle> sys, mpi_info info, 
+  blacs_int npr, blacs_int npc, std::vector<blacs_int> pmap ) :
+  mpi_info_(info), system_(std::move(sys)), pmap_(std::move(pmap)) {
+
+  BLACSPP_PROFILE( "grid_init", -1, -1, 0, 0 );
+  context_ = wrappers::grid_map( system_->handle(), pmap_.data(), npr, npr, npc );
+
+  // Collective over comm, processes outside of the grid release their duplicate
+  MPI_Comm transfer_comm = transfer_dup( mpi_info_.comm() );
+  if( context_ >= 0 ) {
+    ctx_      = std::make_shared<const detail::context_handle>( system_, context_,
+                                                                transfer_comm );
+    grid_dim_ = wrappers::grid_info( context_ );
+  } else {
+    MPI_Comm_free( &transfer_comm );
+    grid_dim_ = { npr, npc, -1, -1 };
   }
 
 }
 
-Grid::Grid( blacs_grid_dim dim, mpi_info mpi, blacs_int handle, blacs_int context ) :
-  grid_dim_(dim), mpi_info_(mpi), system_handle_(handle), context_(context){ }
+Grid::Grid( std::shared_ptr<const detail::context_handle> ctx, mpi_info info,
+  blacs_grid_dim dim, std::vector<blacs_int> pmap ) :
+  grid_dim_(dim), mpi_info_(info), system_(ctx->system()), pmap_(std::move(pmap)) {
 
-Grid::Grid( const Grid& other ) :
-  Grid( other.mpi_info_.comm(), other.grid_dim_.np_row, other.grid_dim_.np_col ){ }
+  context_ = ctx->context();
+  ctx_     = std::move( ctx );
+
+}
+
+Grid::Grid( const Grid& other ) : Grid( other.clone() ) { }
 
 Grid::Grid( Grid&& other ) noexcept :
-  Grid( other.grid_dim_, other.mpi_info_, other.system_handle_, other.context_ ) {
+  grid_dim_( other.grid_dim_ ), mpi_info_( other.mpi_info_ ), 
+  system_( std::move(other.system_) ), context_( other.context_ ),
+  ctx_( std::move(other.ctx_) ), pmap_( std::move(other.pmap_) ) {
+
+  bcast_top_ = other.bcast_top_;
+  comb_top_  = other.comb_top_;
+  top_table_ = other.top_table_;
+  shm_       = std::move( other.shm_ );
+  dtt_       = std::move( other.dtt_ );
+  dev_       = std::move( other.dev_ );
+  cmp_       = std::move( other.cmp_ );
+  hier_      = std::move( other.hier_ );
+  progress_  = std::move( other.progress_ );
+  row_grid_  = std::move( other.row_grid_ );
+  col_grid_  = std::move( other.col_grid_ );
 
   other.mpi_info_ = mpi_info( MPI_COMM_NULL );
+  other.context_  = -1;
 
 }
 
 
 Grid::~Grid() noexcept {
 
-  if( is_valid() ) {
-    wrappers::grid_exit( context_ );
-    wrappers::free_sys_handle( system_handle_ );
+  progress_.reset();
+
+  if( context_ >= 0 ) {
+    ctx_.reset(); // Exits the context with its last grid
+    if constexpr ( profiling_enabled() ) Profiler::instance().grid_exit();
   }
 
 }
+Grid Grid::clone() const {
+
+  if( not system_ ) return Grid();
+
+  Grid g( system_, mpi_info_, npr(), npc(), pmap_ );
+  g.bcast_top_ = bcast_top_;
+  g.comb_top_  = comb_top_;
+  g.top_table_ = top_table_;
+  return g;
+
+}
+
+Grid Grid::duplicate() const {
+
+  if( not system_ ) return Grid();
+
+  MPI_Comm dup;
+  MPI_Comm_dup( mpi_info_.comm(), &dup );
+
+  Grid g( std::make_shared<detail::system_handle>( dup, true ), mpi_info( dup ),
+          npr(), npc(), pmap_ );
+  g.bcast_top_ = bcast_top_;
+  g.comb_top_  = comb_top_;
+  g.top_table_ = top_table_;
+  return g;
+
+}
+
+Grid Grid::split( Scope scope ) const {
+
+  if( mpi_info_.comm() == MPI_COMM_NULL ) return Grid();
+
+  const bool by_row = scope == Row;
+  const blacs_int color = is_valid() ? (by_row ? ipr() : ipc()) : MPI_UNDEFINED;
+  const blacs_int key   = is_valid() ? (by_row ? ipc() : ipr()) : 0;
+
+  // A single split of comm() is far cheaper than a Cblacs_gridmap (collective
+  // over the full system handle) per process row / column
+  MPI_Comm c;
+  MPI_Comm_split( mpi_info_.comm(), color, key, &c );
+  if( c == MPI_COMM_NULL ) return Grid();
+
+  const blacs_int npr_sub = by_row ? 1     : npr();
+  const blacs_int npc_sub = by_row ? npc() : 1;
+
+  // Ranks in c are ordered by the coordinate along the row / column
+  std::vector<blacs_int> pmap( npr_sub * npc_sub );
+  for( size_t i = 0; i < pmap.size(); ++i ) pmap[i] = i;
+
+  Grid g( std::make_shared<detail::system_handle>( c, true ), mpi_info( c ),
+          npr_sub, npc_sub, std::move( pmap ) );
+  g.bcast_top_ = bcast_top_;
+  g.comb_top_  = comb_top_;
+  g.top_table_ = top_table_;
+  return g;
+
+}
+
+Grid Grid::cached_split( Scope scope ) const {
+
+  auto& cache = scope == Row ? row_grid_ : col_grid_;
+  if( not cache ) cache = std::make_shared<const Grid>( split( scope ) );
+  if( not cache->ctx_ ) return Grid();
+
+  Grid g( cache->ctx_, cache->mpi_info_, cache->grid_dim_, cache->pmap_ );
+  g.bcast_top_ = bcast_top_;
+  g.comb_top_  = comb_top_;
+  g.top_table_ = top_table_;
+  return g;
+
+}
+
+Grid Grid::row_grid() const { return cached_split( Row );    }
+Grid Grid::col_grid() const { return cached_split( Column ); }
+
+Grid Grid::subgrid( blacs_int prow_begin, blacs_int prow_end, 
+                    blacs_int pcol_begin, blacs_int pcol_end ) const {
+
+  if( not system_ ) return Grid();
+
+  if( prow_begin < 0 or prow_end > npr() or prow_begin >= prow_end or
+      pcol_begin < 0 or pcol_end > npc() or pcol_begin >= pcol_end )
+    throw std::runtime_error("Invalid Sub-Grid Extent");
+
+  const blacs_int npr_sub = prow_end - prow_begin;
+  const blacs_int npc_sub = pcol_end - pcol_begin;
+
+  std::vector<blacs_int> pmap( npr_sub * npc_sub );
+  for( blacs_int j = 0; j < npc_sub; ++j )
+  for( blacs_int i = 0; i < npr_sub; ++i )
+    pmap[ i + j*npr_sub ] = comm_rank( prow_begin + i, pcol_begin + j );
+
+  Grid g( system_, mpi_info_, npr_sub, npc_sub, std::move( pmap ) );
+  g.bcast_top_ = bcast_top_;
+  g.comb_top_  = comb_top_;
+  g.top_table_ = top_table_;
+  return g;
+
+}
 
 
 
 Grid Grid::square_grid( const MPI_Comm& comm ) {
 
   mpi_info info(comm);
- 
-  blacs_int npr = std::sqrt( info.size() );
-  blacs_int npc = info.size() / npr; 
 
-  while( npr * npc != info.size() ) {
-    npr--;
-    npc = info.size() / npr;
+  auto [npr, npc] = square_dims( info.size() );
+  return Grid( comm, npr, npc );
+
+}
+
+
+Grid Grid::cached( const MPI_Comm& comm, blacs_int npr, blacs_int npc,
+  GridOrder order ) {
+
+  return cached( comm, npr, npc, ordered_map( npr, npc, order ) );
+
+}
+
+Grid Grid::cached( const MPI_Comm& comm, blacs_int npr, blacs_int npc,
+  std::vector<blacs_int> pmap ) {
+
+  if( comm == MPI_COMM_NULL ) return Grid();
+
+  mpi_info info( comm );
+  if( npr * npc != info.size() )
+    throw std::runtime_error("NPC * NPR != NPROCS");
+  check_process_map( pmap, info.size() );
+
+  auto& cache = grid_cache::instance();
+  grid_cache::key key{ comm, npr, npc, pmap };
+  std::shared_ptr<const detail::system_handle> sys;
+  {
+    std::lock_guard<std::mutex> lock( cache.mutex );
+    cache.prune();
+
+    auto it = cache.contexts.find( key );
+    if( it != cache.contexts.end() )
+      if( auto ctx = it->second.context.lock() ) {
+        cache.stats.hits++;
+        return Grid( std::move(ctx), info, it->second.dim, std::move(pmap) );
+      }
+
+    auto& weak_sys = cache.systems[ comm ];
+    sys = weak_sys.lock();
+    if( not sys ) {
+      sys      = std::make_shared<const detail::system_handle>( comm, false );
+      weak_sys = sys;
+    }
   }
 
-  return Grid( comm, npr, npc );
+  // The lock is not held over the (collective) context creation, such that
+  // threads which create grids over distinct communicators cannot deadlock
+  Grid g( std::move(sys), info, npr, npc, std::move(pmap) );
+
+  std::lock_guard<std::mutex> lock( cache.mutex );
+  cache.stats.misses++;
+  cache.contexts[ std::move(key) ] = { g.ctx_, g.grid_dim_ };
+  return g;
+
+}
+
+grid_cache_stats Grid::cache_stats() {
+
+  auto& cache = grid_cache::instance();
+  std::lock_guard<std::mutex> lock( cache.mutex );
+  cache.prune();
+
+  auto stats = cache.stats;
+  stats.live = cache.contexts.size();
+  return stats;
+
+}
+
+Grid Grid::node_aware_grid( const MPI_Comm& comm, const node_hint& hint ) {
+
+  mpi_info info(comm);
+  if( comm == MPI_COMM_NULL ) return Grid();
+
+  if( hint.locality == All ) 
+    throw std::runtime_error("Node Locality Must Be Row or Column");
+
+  const blacs_int nproc   = info.size();
+  if( ( hint.npr > 0 and hint.npc <= 0 and nproc % hint.npr ) or
+      ( hint.npc > 0 and hint.npr <= 0 and nproc % hint.npc ) )
+    throw std::runtime_error("Grid Dimension Does Not Divide NPROCS");
+
+  const auto      leaders = node_leaders( comm );
+
+  // Order ranks by node, retaining their order within the node
+  std::vector<blacs_int> ranks( nproc );
+  std::iota( ranks.begin(), ranks.end(), 0 );
+  std::stable_sort( ranks.begin(), ranks.end(), 
+    [&]( blacs_int a, blacs_int b ){ return leaders[a] < leaders[b]; } );
+
+  std::map<blacs_int,blacs_int> node_size;
+  for( auto l : leaders ) node_size[l]++;
+  blacs_int min_node = nproc;
+  for( const auto& n : node_size ) min_node = std::min( min_node, n.second );
+
+  blacs_int npr = hint.npr, npc = hint.npc;
+  if( npr > 0 and npc <= 0 ) npc = nproc / npr;
+  if( npc > 0 and npr <= 0 ) npr = nproc / npc;
+
+  if( npr <= 0 or npc <= 0 ) {
+
+    // Closest to square such that the node local groups (rows or columns)
+    // tile the nodes: group divides the node or the node divides the group
+    blacs_int best = 0;
+    for( blacs_int r = 1; r <= nproc; ++r ) {
+      if( nproc % r ) continue;
+      const blacs_int c = nproc / r;
+      const blacs_int g = (hint.locality == Row) ? c : r;
+      if( min_node % g and g % min_node ) continue;
+      if( not best or std::abs(r - c) < std::abs(best - nproc/best) ) best = r;
+    }
+
+    if( best ) { npr = best; npc = nproc / best; }
+    else std::tie( npr, npc ) = square_dims( nproc );
+
+  }
+
+  if( npr * npc != nproc )
+    throw std::runtime_error("NPC * NPR != NPROCS");
+
+  // Consecutive (node ordered) ranks along the node local groups
+  std::vector<blacs_int> pmap( nproc );
+  for( blacs_int j = 0; j < npc; ++j )
+  for( blacs_int i = 0; i < npr; ++i )
+    pmap[ i + j*npr ] = (hint.locality == Row) ? ranks[ i*npc + j ] : 
+                                                 ranks[ i + j*npr ];
+
+  return Grid( comm, npr, npc, std::move(pmap) );
+
+}
+
+grid_locality Grid::locality() const {
+
+  grid_locality loc;
+  if( mpi_info_.comm() == MPI_COMM_NULL ) return loc;
+
+  const auto leaders = node_leaders( mpi_info_.comm() );
+  const auto node    = [&]( blacs_int i, blacs_int j ) { 
+    return leaders[ comm_rank(i,j) ]; 
+  };
+
+  std::map<blacs_int,blacs_int> all_counts;
+  double row_pairs = 0., row_intra = 0., col_pairs = 0., col_intra = 0.;
+
+  for( blacs_int i = 0; i < npr(); ++i ) {
+    std::map<blacs_int,blacs_int> counts;
+    for( blacs_int j = 0; j < npc(); ++j ) { counts[node(i,j)]++; all_counts[node(i,j)]++; }
+    auto [p, intra] = group_pairs( counts );
+    row_pairs += p; row_intra += intra;
+  }
+
+  for( blacs_int j = 0; j < npc(); ++j ) {
+    std::map<blacs_int,blacs_int> counts;
+    for( blacs_int i = 0; i < npr(); ++i ) counts[node(i,j)]++;
+    auto [p, intra] = group_pairs( counts );
+    col_pairs += p; col_intra += intra;
+  }
+
+  auto [all_pairs, all_intra] = group_pairs( all_counts );
+
+  loc.nnodes = all_counts.size();
+  if( row_pairs > 0. ) loc.row    = row_intra / row_pairs;
+  if( col_pairs > 0. ) loc.column = col_intra / col_pairs;
+  if( all_pairs > 0. ) loc.all    = all_intra / all_pairs;
+
+  return loc;
 
 }
 
@@ -0,0 +1,23 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/grid_pool.hpp>
+
+#include <stdexcept>
+
+namespace blacspp {
+
+GridPool::GridPool( const Grid& grid, std::size_t ngrid ) {
+
+  if( not grid.thread_multiple() )
+    throw std::runtime_error("GridPool Requires MPI_THREAD_MULTIPLE");
+
+  grids_.reserve( ngrid );
+  for( std::size_t i = 0; i < ngrid; ++i ) grids_.emplace_back( grid.duplicate() );
+
+}
+
+}
@@ -0,0 +1,71 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/halo.hpp>
+#include <blacspp/nonblocking.hpp>
+
+namespace blacspp {
+
+namespace detail {
+
+  std::optional<process_coordinate> halo_neighbour( const Grid& grid, HaloSide side,
+                                                    const halo_options& opts ) {
+
+    const bool vertical = side == North or side == South;
+    const bool periodic = vertical ? opts.periodic_column : opts.periodic_row;
+    const blacs_int np  = vertical ? grid.npr() : grid.npc();
+    const blacs_int ip  = ( vertical ? grid.ipr() : grid.ipc() ) +
+                          ( side == North or side == West ? -1 : 1 );
+
+    if( ( ip < 0 or ip >= np ) and not periodic ) return std::nullopt;
+    const blacs_int wrapped = ( ip + np ) % np;
+
+    if( vertical ) return process_coordinate{ wrapped, grid.ipc() };
+    else           return process_coordinate{ grid.ipr(), wrapped };
+
+  }
+
+}
+
+namespace {
+
+  inline HaloSide opposite( HaloSide side ) noexcept {
+    switch( side ) {
+      case North: return South;
+      case South: return North;
+      case West:  return East;
+      default:    return West;
+    }
+  }
+
+}
+
+void HaloExchange::post( const Grid& grid, const halo_options& opts,
+  MPI_Datatype dtype, HaloSide side, blacs_int M, blacs_int N, const void* send,
+  blacs_int LDS, void* recv, blacs_int LDR ) {
+
+  const auto nb = detail::halo_neighbour( grid, side, opts );
+  if( not nb ) return;
+
+  const blacs_int rank = grid.comm_rank( nb->first, nb->second );
+
+  // Messages are tagged by their direction of travel, such that the exchanges
+  // with both neighbours along a dimension are distinct if they coincide
+  // (e.g. periodic grids with two processes along the dimension)
+  if( recv )
+    reqs_.emplace_back( detail::irecv_2d( grid.transfer_comm(), dtype, M, N, recv, LDR,
+                                          rank, opts.tag + opposite( side ) ) );
+  if( send )
+    reqs_.emplace_back( detail::isend_2d( grid.transfer_comm(), dtype, M, N, send, LDS,
+                                          rank, opts.tag + side ) );
+
+}
+
+void HaloExchange::wait() { wait_all( reqs_ ); }
+
+bool HaloExchange::test() { return test_all( reqs_ ); }
+
+}
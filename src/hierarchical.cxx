@@ -0,0 +1,162 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/hierarchical.hpp>
+#include <blacspp/util/pack.hpp>
+
+#include <stdexcept>
+
+namespace blacspp {
+namespace detail {
+
+namespace {
+
+  constexpr int reduce_tag = 1;
+
+}
+
+hierarchical_transport::hierarchical_transport( const Grid& grid,
+  blacs_int ranks_per_node ) {
+
+  const MPI_Comm comm = grid.comm();
+
+  int size;
+  MPI_Comm_rank( comm, &rank_ );
+  MPI_Comm_size( comm, &size );
+
+  // Processes of comm() which are not a part of the grid do not participate
+  const bool member = grid.is_valid();
+  MPI_Comm_split( comm, member ? 0 : MPI_UNDEFINED, rank_, &grid_comm_ );
+
+  blacs_int ids[2] = { -1, -1 }; // Node index, rank in the node
+  if( member ) {
+
+    int grid_rank;
+    MPI_Comm_rank( grid_comm_, &grid_rank );
+
+    if( ranks_per_node > 0 )
+      MPI_Comm_split( grid_comm_, grid_rank / ranks_per_node, grid_rank, &node_comm_ );
+    else
+      MPI_Comm_split_type( grid_comm_, MPI_COMM_TYPE_SHARED, grid_rank, MPI_INFO_NULL,
+                           &node_comm_ );
+
+    MPI_Comm_rank( node_comm_, ids + 1 );
+    MPI_Comm_split( grid_comm_, ids[1] == 0 ? 0 : MPI_UNDEFINED, grid_rank,
+                    &leader_comm_ );
+
+    // Leaders are ranked by their node index
+    if( leader_comm_ != MPI_COMM_NULL ) {
+      MPI_Comm_rank( leader_comm_, ids );
+      MPI_Comm_size( leader_comm_, &nnodes_ );
+    }
+    MPI_Bcast( ids,     1, MPI_INT, 0, node_comm_ );
+    MPI_Bcast( &nnodes_, 1, MPI_INT, 0, node_comm_ );
+
+  }
+
+  std::vector<blacs_int> all_ids( 2 * size );
+  MPI_Allgather( ids, 2, MPI_INT, all_ids.data(), 2, MPI_INT, comm );
+
+  node_.resize( size );
+  local_.resize( size );
+  for( int i = 0; i < size; ++i ) {
+    node_[i]  = all_ids[ 2*i ];
+    local_[i] = all_ids[ 2*i + 1 ];
+  }
+
+}
+
+hierarchical_transport::~hierarchical_transport() noexcept {
+
+  if( leader_comm_ != MPI_COMM_NULL ) MPI_Comm_free( &leader_comm_ );
+  if( node_comm_   != MPI_COMM_NULL ) MPI_Comm_free( &node_comm_   );
+  if( grid_comm_   != MPI_COMM_NULL ) MPI_Comm_free( &grid_comm_   );
+
+}
+
+void* hierarchical_transport::contiguous( std::size_t elem_size, blacs_int M,
+  blacs_int N, void* A, blacs_int LDA, bool pack ) {
+
+  scratch_.resize( std::size_t(M) * std::size_t(N) * elem_size );
+  if( pack ) pack_2d( scratch_.data(), elem_size, M, N, A, LDA );
+  return scratch_.data();
+
+}
+
+void hierarchical_transport::broadcast( MPI_Datatype type, std::size_t elem_size,
+  blacs_int M, blacs_int N, void* A, blacs_int LDA, blacs_int root ) {
+
+  if( grid_comm_ == MPI_COMM_NULL ) return;
+  if( not fits( M, N ) )
+    throw std::runtime_error("Tile Too Large For Hierarchical Collectives");
+
+  const int       count     = M * N;
+  const blacs_int my_node   = node_[ rank_ ];
+  const blacs_int root_node = node_[ root ], root_local = local_[ root ];
+  const bool      is_root   = rank_ == root;
+
+  const bool in_place = M == LDA or N == 1;
+  void* buf = in_place ? A : contiguous( elem_size, M, N, A, LDA, is_root );
+
+  // Within the node of the root, between the leaders, then within the other nodes
+  if( my_node == root_node ) MPI_Bcast( buf, count, type, root_local, node_comm_ );
+  if( leader_comm_ != MPI_COMM_NULL and nnodes_ > 1 )
+    MPI_Bcast( buf, count, type, root_node, leader_comm_ );
+  if( my_node != root_node ) MPI_Bcast( buf, count, type, 0, node_comm_ );
+
+  if( not in_place and not is_root ) unpack_2d( A, elem_size, M, N, buf, LDA );
+  stats_.broadcasts++;
+
+}
+
+void hierarchical_transport::sum( MPI_Datatype type, std::size_t elem_size,
+  blacs_int M, blacs_int N, void* A, blacs_int LDA, blacs_int dest ) {
+
+  if( grid_comm_ == MPI_COMM_NULL ) return;
+  if( not fits( M, N ) )
+    throw std::runtime_error("Tile Too Large For Hierarchical Collectives");
+
+  const int       count    = M * N;
+  const blacs_int my_node  = node_[ rank_ ], my_local = local_[ rank_ ];
+  const bool      leader   = leader_comm_ != MPI_COMM_NULL and nnodes_ > 1;
+
+  // The tile of the caller is only overwritten with the result
+  void* buf = contiguous( elem_size, M, N, A, LDA, true );
+
+  // Onto the leader of each node
+  MPI_Reduce( my_local == 0 ? MPI_IN_PLACE : buf, buf, count, type, MPI_SUM, 0,
+              node_comm_ );
+
+  if( dest < 0 ) {
+
+    if( leader ) MPI_Allreduce( MPI_IN_PLACE, buf, count, type, MPI_SUM, leader_comm_ );
+    MPI_Bcast( buf, count, type, 0, node_comm_ );
+    unpack_2d( A, elem_size, M, N, buf, LDA );
+
+  } else {
+
+    const blacs_int dest_node = node_[ dest ], dest_local = local_[ dest ];
+    if( leader )
+      MPI_Reduce( my_node == dest_node ? MPI_IN_PLACE : buf, buf, count, type,
+                  MPI_SUM, dest_node, leader_comm_ );
+
+    // Forward from the leader of the destination node
+    if( my_node == dest_node and dest_local != 0 ) {
+      if( my_local == 0 )
+        MPI_Send( buf, count, type, dest_local, reduce_tag, node_comm_ );
+      else if( my_local == dest_local )
+        MPI_Recv( buf, count, type, 0, reduce_tag, node_comm_, MPI_STATUS_IGNORE );
+    }
+    if( rank_ == dest ) unpack_2d( A, elem_size, M, N, buf, LDA );
+
+  }
+
+  stats_.combines++;
+
+}
+
+}
+}
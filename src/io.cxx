@@ -0,0 +1,430 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/io.hpp>
+#include <blacspp/nonblocking.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define BLACSPP_HAS_MMAP
+#endif
+
+namespace blacspp {
+
+namespace {
+
+  constexpr char          tile_magic[8] = { 'B','L','A','C','S','P','P','T' };
+  constexpr std::uint32_t tile_version  = 1;
+
+  std::size_t type_size( char type ) {
+    switch( type ) {
+      case 'i': return sizeof( blacs_int );
+      case 's': return sizeof( float );
+      case 'd': return sizeof( double );
+      case 'c': return sizeof( scomplex );
+      case 'z': return sizeof( dcomplex );
+    }
+    throw std::runtime_error("Invalid Matrix File Type");
+  }
+
+  void encode_header( const tile_header& h, char* buf ) noexcept {
+    std::memset( buf, 0, tile_header_bytes );
+    std::memcpy( buf,      tile_magic,    8 );
+    std::memcpy( buf + 8,  &tile_version, 4 );
+    buf[12] = h.type;
+    std::memcpy( buf + 16, &h.M,  8 );
+    std::memcpy( buf + 24, &h.N,  8 );
+    std::memcpy( buf + 32, &h.MB, 8 );
+    std::memcpy( buf + 40, &h.NB, 8 );
+  }
+
+  /// Decode a header, returns false if buf does not hold a valid header
+  bool decode_header( const char* buf, tile_header& h ) noexcept {
+    std::uint32_t version;
+    std::memcpy( &version, buf + 8, 4 );
+    if( std::memcmp( buf, tile_magic, 8 ) or version != tile_version ) return false;
+    h.type = buf[12];
+    std::memcpy( &h.M,  buf + 16, 8 );
+    std::memcpy( &h.N,  buf + 24, 8 );
+    std::memcpy( &h.MB, buf + 32, 8 );
+    std::memcpy( &h.NB, buf + 40, 8 );
+    return std::strchr( "isdcz", h.type ) and h.type and h.M >= 0 and h.N >= 0 and
+           h.MB > 0 and h.NB > 0;
+  }
+
+  std::size_t file_bytes( const tile_header& h ) {
+    return tile_header_bytes + std::size_t(h.M) * h.N * type_size( h.type );
+  }
+
+  /**
+   *  \brief The processes of a grid in a communicator
+   *
+   *  MPI-IO is collective over the members of the grid only (grid.comm() may
+   *  contain processes outside of the grid).
+   */
+  class io_comm {
+
+    MPI_Comm comm_ = MPI_COMM_NULL;
+
+  public:
+
+    explicit io_comm( const Grid& grid ) {
+      const bool member = grid.ipr() >= 0 and grid.ipc() >= 0;
+      MPI_Comm_split( grid.comm(), member ? 0 : MPI_UNDEFINED, 0, &comm_ );
+    }
+
+    io_comm( const io_comm& ) = delete;
+    io_comm& operator=( const io_comm& ) = delete;
+
+    ~io_comm() noexcept {
+      if( comm_ != MPI_COMM_NULL ) MPI_Comm_free( &comm_ );
+    }
+
+    inline MPI_Comm comm()   const noexcept { return comm_; }
+    inline bool     member() const noexcept { return comm_ != MPI_COMM_NULL; }
+
+  };
+
+  /// A collectively opened MPI file (closed on destruction)
+  class io_file {
+
+    MPI_File fh_ = MPI_FILE_NULL;
+
+  public:
+
+    io_file( MPI_Comm comm, const std::string& fname, int amode ) {
+      if( MPI_File_open( comm, fname.c_str(), amode, MPI_INFO_NULL, &fh_ ) != MPI_SUCCESS )
+        throw std::runtime_error("Unable To Open Matrix File");
+    }
+
+    io_file( const io_file& ) = delete;
+    io_file& operator=( const io_file& ) = delete;
+
+    ~io_file() noexcept {
+      if( fh_ != MPI_FILE_NULL ) MPI_File_close( &fh_ );
+    }
+
+    inline MPI_File handle() const noexcept { return fh_; }
+
+  };
+
+  /// A committed MPI datatype (freed on destruction)
+  struct owned_type {
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+    owned_type() = default;
+    owned_type( const owned_type& ) = delete;
+    owned_type& operator=( const owned_type& ) = delete;
+    ~owned_type() noexcept {
+      if( type != MPI_DATATYPE_NULL ) MPI_Type_free( &type );
+    }
+  };
+
+  /// The darray file type of the local part of a block-cyclic matrix
+  void darray_type( const detail::block_cyclic_layout& L, MPI_Datatype dtype,
+    owned_type& t ) {
+
+    // darray places block 0 on process 0 and numbers the processes row-major
+    const int rank = ( (L.ipr - L.RSRC + L.npr) % L.npr ) * L.npc +
+                       (L.ipc - L.CSRC + L.npc) % L.npc;
+
+    const int gsizes[2]   = { int(L.M),  int(L.N)  };
+    const int distribs[2] = { MPI_DISTRIBUTE_CYCLIC, MPI_DISTRIBUTE_CYCLIC };
+    const int dargs[2]    = { int(L.MB), int(L.NB) };
+    const int psizes[2]   = { int(L.npr), int(L.npc) };
+
+    MPI_Type_create_darray( L.npr * L.npc, rank, 2, gsizes, distribs, dargs, psizes,
+                            MPI_ORDER_FORTRAN, dtype, &t.type );
+    MPI_Type_commit( &t.type );
+
+  }
+
+  /// A contiguous run of bytes shared by the file and the local storage
+  struct io_run {
+    MPI_Aint file, mem;
+    int      len;
+  };
+
+  /**
+   *  \brief Runs between the tiles of a file and the local storage of a matrix
+   *
+   *  Sorted by (and merged in) file offset, as required by MPI file views.
+   */
+  std::vector< io_run > tile_runs( const tile_header& h,
+    const detail::block_cyclic_layout& L, std::size_t es, blacs_int LDA ) {
+
+    std::vector< io_run > runs;
+
+    const blacs_int mblocks = ( L.M + L.MB - 1 ) / L.MB;
+    const blacs_int nloc    = numroc( L.N, L.NB, L.ipc, L.CSRC, L.npc );
+    const blacs_int b0      = ( L.ipr - L.RSRC + L.npr ) % L.npr;
+
+    for( blacs_int jl = 0; jl < nloc; ++jl ) {
+
+      const std::int64_t j  = indxl2g( jl, L.NB, L.ipc, L.CSRC, L.npc );
+      const std::int64_t bj = j / h.NB, cj = j % h.NB;
+
+      for( blacs_int b = b0; b < mblocks; b += L.npr ) {
+        const blacs_int g0 = b * L.MB, l0 = ( b / L.npr ) * L.MB;
+        const blacs_int g1 = std::min( L.M, g0 + L.MB );
+        for( blacs_int g = g0; g < g1; ) {
+          const std::int64_t bi = g / h.MB, ri = g % h.MB;
+          const std::int64_t tr = std::min( h.MB, h.M - bi * h.MB );
+          const blacs_int    len = std::min( std::int64_t( g1 - g ), h.MB - ri );
+          runs.push_back( {
+            MPI_Aint( tile_offset( h, bi, bj ) + ( cj * tr + ri ) * es ),
+            MPI_Aint( ( std::size_t(jl) * LDA + l0 + ( g - g0 ) ) * es ),
+            int( len * es ) } );
+          g += len;
+        }
+      }
+
+    }
+
+    std::sort( runs.begin(), runs.end(),
+      []( const io_run& a, const io_run& b ) { return a.file < b.file; } );
+
+    std::vector< io_run > merged;
+    for( const auto& r : runs ) {
+      if( not merged.empty() and merged.back().file + merged.back().len == r.file and
+          merged.back().mem + merged.back().len == r.mem )
+        merged.back().len += r.len;
+      else merged.push_back( r );
+    }
+    return merged;
+
+  }
+
+  /// File and memory types of a set of runs
+  void run_types( const std::vector< io_run >& runs, owned_type& ftype,
+    owned_type& mtype ) {
+
+    std::vector< int >      lens;
+    std::vector< MPI_Aint > fdisp, mdisp;
+    for( const auto& r : runs ) {
+      lens.push_back( r.len );
+      fdisp.push_back( r.file );
+      mdisp.push_back( r.mem );
+    }
+
+    MPI_Type_create_hindexed( runs.size(), lens.data(), fdisp.data(), MPI_BYTE, &ftype.type );
+    MPI_Type_create_hindexed( runs.size(), lens.data(), mdisp.data(), MPI_BYTE, &mtype.type );
+    MPI_Type_commit( &ftype.type );
+    MPI_Type_commit( &mtype.type );
+
+  }
+
+}
+
+std::size_t tile_offset( const tile_header& h, std::int64_t bi, std::int64_t bj ) noexcept {
+  const std::size_t es  = type_size( h.type );
+  const std::int64_t nw = std::min( h.NB, h.N - bj * h.NB );
+  return tile_header_bytes + es * std::size_t( bj * h.NB * h.M + bi * h.MB * nw );
+}
+
+tile_header read_tile_header( const std::string& fname ) {
+
+  std::ifstream file( fname, std::ios::binary );
+  if( not file ) throw std::runtime_error("Unable To Open Matrix File");
+
+  char buf[ tile_header_bytes ];
+  tile_header h;
+  if( not file.read( buf, tile_header_bytes ) or not decode_header( buf, h ) )
+    throw std::runtime_error("Invalid Matrix File");
+
+  return h;
+
+}
+
+MappedTileFile::MappedTileFile( const std::string& fname ) :
+  header_( read_tile_header( fname ) ) {
+
+#ifdef BLACSPP_HAS_MMAP
+
+  const int fd = ::open( fname.c_str(), O_RDONLY );
+  if( fd < 0 ) throw std::runtime_error("Unable To Open Matrix File");
+
+  struct stat st;
+  if( ::fstat( fd, &st ) or std::size_t( st.st_size ) < file_bytes( header_ ) ) {
+    ::close( fd );
+    throw std::runtime_error("Invalid Matrix File");
+  }
+
+  bytes_ = st.st_size;
+  base_  = ::mmap( nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0 );
+  ::close( fd );
+
+  if( base_ == MAP_FAILED ) {
+    base_ = nullptr;
+    throw std::runtime_error("Unable To Map Matrix File");
+  }
+
+#else
+
+  throw std::runtime_error("Memory Mapped Files Not Supported");
+
+#endif
+
+}
+
+MappedTileFile::~MappedTileFile() noexcept {
+#ifdef BLACSPP_HAS_MMAP
+  if( base_ ) ::munmap( base_, bytes_ );
+#endif
+}
+
+std::int64_t MappedTileFile::tile_rows( std::int64_t bi ) const noexcept {
+  return std::min( header_.MB, header_.M - bi * header_.MB );
+}
+
+std::int64_t MappedTileFile::tile_cols( std::int64_t bj ) const noexcept {
+  return std::min( header_.NB, header_.N - bj * header_.NB );
+}
+
+const void* MappedTileFile::tile( std::int64_t bi, std::int64_t bj ) const noexcept {
+  return static_cast<const char*>( base_ ) + tile_offset( header_, bi, bj );
+}
+
+void MappedTileFile::prefetch( std::int64_t bi, std::int64_t bj ) const noexcept {
+#ifdef BLACSPP_HAS_MMAP
+  const std::size_t page  = ::sysconf( _SC_PAGESIZE );
+  const std::size_t first = tile_offset( header_, bi, bj );
+  const std::size_t last  = first + tile_rows( bi ) * tile_cols( bj ) *
+                                    type_size( header_.type );
+  const std::size_t start = first / page * page;
+  ::madvise( static_cast<char*>( base_ ) + start, last - start, MADV_WILLNEED );
+#else
+  (void)bi; (void)bj;
+#endif
+}
+
+
+
+
+
+namespace detail {
+
+void write_darray( const std::string& fname, const Grid& grid,
+  const block_cyclic_layout& L, MPI_Datatype dtype, const void* A, blacs_int LDA ) {
+
+  io_comm comm( grid );
+  if( not comm.member() ) return;
+
+  int es;
+  MPI_Type_size( dtype, &es );
+
+  io_file file( comm.comm(), fname, MPI_MODE_CREATE | MPI_MODE_WRONLY );
+  MPI_File_set_size( file.handle(), MPI_Offset( L.M ) * L.N * es );
+  if( L.M == 0 or L.N == 0 ) return;
+
+  owned_type ftype;
+  darray_type( L, dtype, ftype );
+  MPI_File_set_view( file.handle(), 0, dtype, ftype.type, "native", MPI_INFO_NULL );
+
+  const blacs_int mloc = numroc( L.M, L.MB, L.ipr, L.RSRC, L.npr );
+  const blacs_int nloc = numroc( L.N, L.NB, L.ipc, L.CSRC, L.npc );
+  if( mloc and nloc ) {
+    strided_type mtype( dtype, mloc, nloc, LDA );
+    MPI_File_write_all( file.handle(), A, mtype.count(), mtype.type(), MPI_STATUS_IGNORE );
+  } else
+    MPI_File_write_all( file.handle(), A, 0, dtype, MPI_STATUS_IGNORE );
+
+}
+
+void read_darray( const std::string& fname, const Grid& grid,
+  const block_cyclic_layout& L, MPI_Datatype dtype, void* A, blacs_int LDA ) {
+
+  io_comm comm( grid );
+  if( not comm.member() ) return;
+
+  io_file file( comm.comm(), fname, MPI_MODE_RDONLY );
+  if( L.M == 0 or L.N == 0 ) return;
+
+  owned_type ftype;
+  darray_type( L, dtype, ftype );
+  MPI_File_set_view( file.handle(), 0, dtype, ftype.type, "native", MPI_INFO_NULL );
+
+  const blacs_int mloc = numroc( L.M, L.MB, L.ipr, L.RSRC, L.npr );
+  const blacs_int nloc = numroc( L.N, L.NB, L.ipc, L.CSRC, L.npc );
+  if( mloc and nloc ) {
+    strided_type mtype( dtype, mloc, nloc, LDA );
+    MPI_File_read_all( file.handle(), A, mtype.count(), mtype.type(), MPI_STATUS_IGNORE );
+  } else
+    MPI_File_read_all( file.handle(), A, 0, dtype, MPI_STATUS_IGNORE );
+
+}
+
+void write_tiles( const std::string& fname, const Grid& grid,
+  const block_cyclic_layout& L, char type, std::size_t elem_size, const void* A,
+  blacs_int LDA ) {
+
+  io_comm comm( grid );
+  if( not comm.member() ) return;
+
+  const tile_header h{ type, L.M, L.N, L.MB, L.NB };
+
+  io_file file( comm.comm(), fname, MPI_MODE_CREATE | MPI_MODE_WRONLY );
+  MPI_File_set_size( file.handle(), file_bytes( h ) );
+
+  int rank;
+  MPI_Comm_rank( comm.comm(), &rank );
+  if( rank == 0 ) {
+    char buf[ tile_header_bytes ];
+    encode_header( h, buf );
+    MPI_File_write_at( file.handle(), 0, buf, tile_header_bytes, MPI_BYTE,
+                       MPI_STATUS_IGNORE );
+  }
+
+  owned_type ftype, mtype;
+  run_types( tile_runs( h, L, elem_size, LDA ), ftype, mtype );
+  MPI_File_set_view( file.handle(), 0, MPI_BYTE, ftype.type, "native", MPI_INFO_NULL );
+  MPI_File_write_all( file.handle(), A, 1, mtype.type, MPI_STATUS_IGNORE );
+
+}
+
+void read_tiles( const std::string& fname, const Grid& grid,
+  const block_cyclic_layout& L, char type, std::size_t elem_size, void* A,
+  blacs_int LDA ) {
+
+  io_comm comm( grid );
+  if( not comm.member() ) return;
+
+  io_file file( comm.comm(), fname, MPI_MODE_RDONLY );
+
+  // The header is read once and shared, such that all processes agree on errors
+  char buf[ tile_header_bytes ] = {};
+  int rank;
+  MPI_Comm_rank( comm.comm(), &rank );
+  if( rank == 0 )
+    MPI_File_read_at( file.handle(), 0, buf, tile_header_bytes, MPI_BYTE,
+                      MPI_STATUS_IGNORE );
+  MPI_Bcast( buf, tile_header_bytes, MPI_BYTE, 0, comm.comm() );
+
+  tile_header h;
+  if( not decode_header( buf, h ) )
+    throw std::runtime_error("Invalid Matrix File");
+  if( h.type != type )
+    throw std::runtime_error("Matrix File Type Mismatch");
+  if( h.M != L.M or h.N != L.N )
+    throw std::runtime_error("Matrix File Dimension Mismatch");
+
+  owned_type ftype, mtype;
+  run_types( tile_runs( h, L, elem_size, LDA ), ftype, mtype );
+  MPI_File_set_view( file.handle(), 0, MPI_BYTE, ftype.type, "native", MPI_INFO_NULL );
+  MPI_File_read_all( file.handle(), A, 1, mtype.type, MPI_STATUS_IGNORE );
+
+}
+
+}
+}
@@ -18,6 +18,8 @@ mpi_info::mpi_info( MPI_Comm c ) : comm_(c) {
     throw std::runtime_error("MPI Environment Not Initialized!");
   }
 
+  MPI_Query_thread( &thread_level_ );
+
   if( c == MPI_COMM_NULL ) {
 
     rank_ = -1;
@@ -34,6 +36,8 @@ mpi_info::mpi_info( MPI_Comm c ) : comm_(c) {
 MPI_Comm  mpi_info::comm() const { return comm_; };
 blacs_int mpi_info::rank() const { return rank_; };
 blacs_int mpi_info::size() const { return size_; };
+int       mpi_info::thread_level() const { return thread_level_; };
+bool      mpi_info::thread_multiple() const { return thread_level_ >= MPI_THREAD_MULTIPLE; };
 
 
 }
@@ -0,0 +1,109 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/nonblocking.hpp>
+
+#include <climits>
+#include <stdexcept>
+#include <utility>
+
+namespace blacspp::detail {
+
+  blacs_int comm_rank( const Grid& grid, const blacs_int PROW, 
+                       const blacs_int PCOL ) {
+
+    // The BLACS process number need not be the rank in Grid::comm()
+    // (e.g. for sub-grids), use the process map of the grid
+    return grid.comm_rank( PROW, PCOL );
+
+  }
+
+
+  strided_type::strided_type( MPI_Datatype dtype, const blacs_int M, 
+    const blacs_int N, const blacs_int LDA ) {
+
+    if( M < 0 or N < 0 or LDA < M ) 
+      throw std::runtime_error("Invalid (M,N,LDA) For Non-Blocking Transfer");
+
+    if( M == 0 or N == 0 ) return;
+
+    // Contiguous buffers are sent as M*N elements as long as the count fits
+    // into an int, otherwise (and for strided buffers) as a vector of columns
+    const std::size_t count = std::size_t(M) * std::size_t(N);
+    if( ( LDA == M or N == 1 ) and count <= std::size_t(INT_MAX) ) {
+      type_  = dtype;
+      count_ = static_cast<int>( count );
+    } else {
+      MPI_Type_vector( N, M, LDA, dtype, &type_ );
+      MPI_Type_commit( &type_ );
+      count_ = 1;
+      owned_ = true;
+    }
+
+  }
+
+  strided_type::strided_type( strided_type&& other ) noexcept :
+    type_( other.type_ ), count_( other.count_ ), owned_( other.owned_ ) {
+    other.owned_ = false;
+  }
+
+  strided_type& strided_type::operator=( strided_type&& other ) noexcept {
+
+    if( this != &other ) {
+      if( owned_ ) MPI_Type_free( &type_ );
+      type_  = other.type_;
+      count_ = other.count_;
+      owned_ = std::exchange( other.owned_, false );
+    }
+    return *this;
+
+  }
+
+  strided_type::~strided_type() noexcept {
+    // Freeing the type does not affect pending operations which use it
+    if( owned_ ) MPI_Type_free( &type_ );
+  }
+
+
+
+
+  Request isend_2d( MPI_Comm comm, const strided_type& type, const void* A,
+                    const blacs_int dest, const int tag ) {
+
+    MPI_Request req = MPI_REQUEST_NULL;
+    if( type.count() ) 
+      MPI_Isend( A, type.count(), type.type(), dest, tag, comm, &req );
+    return Request( req );
+
+  }
+
+  Request irecv_2d( MPI_Comm comm, const strided_type& type, void* A,
+                    const blacs_int src, const int tag ) {
+
+    MPI_Request req = MPI_REQUEST_NULL;
+    if( type.count() ) 
+      MPI_Irecv( A, type.count(), type.type(), src, tag, comm, &req );
+    return Request( req );
+
+  }
+
+  Request isend_2d( MPI_Comm comm, MPI_Datatype dtype,
+                    const blacs_int M, const blacs_int N, const void* A,
+                    const blacs_int LDA, const blacs_int dest, const int tag ) {
+
+    return isend_2d( comm, strided_type( dtype, M, N, LDA ), A, dest, tag );
+
+  }
+
+  Request irecv_2d( MPI_Comm comm, MPI_Datatype dtype,
+                    const blacs_int M, const blacs_int N, void* A,
+                    const blacs_int LDA, const blacs_int src, const int tag ) {
+
+    return irecv_2d( comm, strided_type( dtype, M, N, LDA ), A, src, tag );
+
+  }
+
+}
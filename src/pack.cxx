@@ -0,0 +1,360 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/util/pack.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__x86_64__) && ( defined(__GNUC__) || defined(__clang__) )
+#define BLACSPP_PACK_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define BLACSPP_PACK_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace blacspp::detail {
+
+namespace {
+
+  /// Copies a contiguous run of bytes, with non-temporal stores if stream
+  using copy_fn = void (*)( char* d, const char* s, std::size_t n, bool stream ) noexcept;
+
+  /// Runs shorter than this are copied with memcpy (call overhead dominates)
+  constexpr std::size_t short_run = 256;
+
+  void copy_generic( char* d, const char* s, std::size_t n, bool ) noexcept {
+    std::memcpy( d, s, n );
+  }
+
+#ifdef BLACSPP_PACK_X86
+
+  __attribute__((target("avx2")))
+  void copy_avx2( char* d, const char* s, std::size_t n, bool stream ) noexcept {
+
+    if( n < short_run ) { std::memcpy( d, s, n ); return; }
+
+    if( stream ) {
+
+      // Non-temporal stores require an aligned destination
+      const std::size_t head = ( 32 - ( reinterpret_cast<std::uintptr_t>(d) & 31 ) ) & 31;
+      std::memcpy( d, s, head );
+      d += head; s += head; n -= head;
+
+      for( ; n >= 128; n -= 128, d += 128, s += 128 ) {
+        const __m256i a = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s      ) );
+        const __m256i b = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 32 ) );
+        const __m256i c = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 64 ) );
+        const __m256i e = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 96 ) );
+        _mm256_stream_si256( reinterpret_cast<__m256i*>( d      ), a );
+        _mm256_stream_si256( reinterpret_cast<__m256i*>( d + 32 ), b );
+        _mm256_stream_si256( reinterpret_cast<__m256i*>( d + 64 ), c );
+        _mm256_stream_si256( reinterpret_cast<__m256i*>( d + 96 ), e );
+      }
+      for( ; n >= 32; n -= 32, d += 32, s += 32 )
+        _mm256_stream_si256( reinterpret_cast<__m256i*>( d ),
+          _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s ) ) );
+      _mm_sfence();
+
+    } else {
+
+      for( ; n >= 128; n -= 128, d += 128, s += 128 ) {
+        const __m256i a = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s      ) );
+        const __m256i b = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 32 ) );
+        const __m256i c = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 64 ) );
+        const __m256i e = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s + 96 ) );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( d      ), a );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( d + 32 ), b );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( d + 64 ), c );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( d + 96 ), e );
+      }
+      for( ; n >= 32; n -= 32, d += 32, s += 32 )
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>( d ),
+          _mm256_loadu_si256( reinterpret_cast<const __m256i*>( s ) ) );
+
+    }
+
+    std::memcpy( d, s, n );
+
+  }
+
+  __attribute__((target("avx512f")))
+  void copy_avx512( char* d, const char* s, std::size_t n, bool stream ) noexcept {
+
+    if( n < short_run ) { std::memcpy( d, s, n ); return; }
+
+    if( stream ) {
+
+      const std::size_t head = ( 64 - ( reinterpret_cast<std::uintptr_t>(d) & 63 ) ) & 63;
+      std::memcpy( d, s, head );
+      d += head; s += head; n -= head;
+
+      for( ; n >= 256; n -= 256, d += 256, s += 256 ) {
+        const __m512i a = _mm512_loadu_si512( s       );
+        const __m512i b = _mm512_loadu_si512( s +  64 );
+        const __m512i c = _mm512_loadu_si512( s + 128 );
+        const __m512i e = _mm512_loadu_si512( s + 192 );
+        _mm512_stream_si512( reinterpret_cast<__m512i*>( d       ), a );
+        _mm512_stream_si512( reinterpret_cast<__m512i*>( d +  64 ), b );
+        _mm512_stream_si512( reinterpret_cast<__m512i*>( d + 128 ), c );
+        _mm512_stream_si512( reinterpret_cast<__m512i*>( d + 192 ), e );
+      }
+      for( ; n >= 64; n -= 64, d += 64, s += 64 )
+        _mm512_stream_si512( reinterpret_cast<__m512i*>( d ), _mm512_loadu_si512( s ) );
+      _mm_sfence();
+
+    } else {
+
+      for( ; n >= 256; n -= 256, d += 256, s += 256 ) {
+        const __m512i a = _mm512_loadu_si512( s       );
+        const __m512i b = _mm512_loadu_si512( s +  64 );
+        const __m512i c = _mm512_loadu_si512( s + 128 );
+        const __m512i e = _mm512_loadu_si512( s + 192 );
+        _mm512_storeu_si512( d,       a );
+        _mm512_storeu_si512( d +  64, b );
+        _mm512_storeu_si512( d + 128, c );
+        _mm512_storeu_si512( d + 192, e );
+      }
+      for( ; n >= 64; n -= 64, d += 64, s += 64 )
+        _mm512_storeu_si512( d, _mm512_loadu_si512( s ) );
+
+    }
+
+    std::memcpy( d, s, n );
+
+  }
+
+#endif
+
+#ifdef BLACSPP_PACK_NEON
+
+  // NEON has no (portable) non-temporal stores
+  void copy_neon( char* d, const char* s, std::size_t n, bool ) noexcept {
+
+    if( n < short_run ) { std::memcpy( d, s, n ); return; }
+
+    auto*       ud = reinterpret_cast<std::uint8_t*>( d );
+    const auto* us = reinterpret_cast<const std::uint8_t*>( s );
+    for( ; n >= 64; n -= 64, ud += 64, us += 64 ) {
+      const uint8x16x4_t v = vld1q_u8_x4( us );
+      vst1q_u8_x4( ud, v );
+    }
+    for( ; n >= 16; n -= 16, ud += 16, us += 16 ) vst1q_u8( ud, vld1q_u8( us ) );
+    std::memcpy( ud, us, n );
+
+  }
+
+#endif
+
+  copy_fn kernel_of( PackISA isa ) noexcept {
+    switch( isa ) {
+#ifdef BLACSPP_PACK_X86
+      case PackISA::AVX2:   return copy_avx2;
+      case PackISA::AVX512: return copy_avx512;
+#endif
+#ifdef BLACSPP_PACK_NEON
+      case PackISA::NEON:   return copy_neon;
+#endif
+      default:              return copy_generic;
+    }
+  }
+
+  PackISA default_isa() noexcept {
+
+    if( const char* env = std::getenv( "BLACSPP_PACK_ISA" ) ) {
+      const std::string name( env );
+      const char* names[] = { "generic", "avx2", "avx512", "neon" };
+      for( auto isa : { PackISA::Generic, PackISA::AVX2, PackISA::AVX512, PackISA::NEON } )
+        if( name == names[ int(isa) ] and pack_isa_supported( isa ) ) return isa;
+    }
+
+    for( auto isa : { PackISA::AVX512, PackISA::AVX2, PackISA::NEON } )
+      if( pack_isa_supported( isa ) ) return isa;
+    return PackISA::Generic;
+
+  }
+
+  std::size_t default_streaming_bytes() noexcept {
+
+    if( const char* env = std::getenv( "BLACSPP_PACK_STREAMING_BYTES" ) )
+      return std::strtoull( env, nullptr, 10 );
+
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    const long llc = sysconf( _SC_LEVEL3_CACHE_SIZE );
+    if( llc > 0 ) return llc;
+#endif
+    return std::size_t(1) << 23;
+
+  }
+
+  struct pack_kernels {
+    PackISA     isa       = default_isa();
+    copy_fn     copy      = kernel_of( isa );
+    std::size_t streaming = default_streaming_bytes();
+  };
+
+  pack_kernels& kernels() noexcept {
+    static pack_kernels k;
+    return k;
+  }
+
+}
+
+bool pack_isa_supported( PackISA isa ) noexcept {
+  switch( isa ) {
+    case PackISA::Generic: return true;
+#ifdef BLACSPP_PACK_X86
+    case PackISA::AVX2:    __builtin_cpu_init(); return __builtin_cpu_supports( "avx2" );
+    case PackISA::AVX512:  __builtin_cpu_init(); return __builtin_cpu_supports( "avx512f" );
+#endif
+#ifdef BLACSPP_PACK_NEON
+    case PackISA::NEON:    return true;
+#endif
+    default:               return false;
+  }
+}
+
+PackISA pack_isa() noexcept { return kernels().isa; }
+
+void set_pack_isa( PackISA isa ) {
+  if( not pack_isa_supported( isa ) )
+    throw std::runtime_error("Pack ISA Not Supported");
+  kernels().isa  = isa;
+  kernels().copy = kernel_of( isa );
+}
+
+std::size_t pack_streaming_bytes() noexcept { return kernels().streaming; }
+
+void set_pack_streaming_bytes( std::size_t bytes ) noexcept {
+  kernels().streaming = bytes;
+}
+
+std::size_t trapezoid_size( const Triangle uplo, const Diagonal diag, 
+                            const blacs_int M, const blacs_int N ) noexcept {
+
+  std::size_t n = 0;
+  for( blacs_int j = 0; j < N; ++j ) {
+    auto [st, en] = trapezoid_rows( uplo, diag, M, N, j );
+    n += en - st;
+  }
+  return n;
+
+}
+
+namespace {
+
+  /// Scratch storage of a thread, reused by consecutive scratch_buffers
+  struct thread_scratch {
+    std::vector< std::max_align_t > storage;
+    bool                            leased = false;
+  };
+
+  thread_scratch& local_scratch() noexcept {
+    thread_local thread_scratch scratch;
+    return scratch;
+  }
+
+}
+
+scratch_buffer::scratch_buffer( const std::size_t bytes ) {
+
+  const std::size_t n = 
+    ( bytes + sizeof(std::max_align_t) - 1 ) / sizeof(std::max_align_t);
+
+  // Nested buffers on the same thread obtain their own storage
+  auto& scratch = local_scratch();
+  if( scratch.leased ) {
+    heap_.reset( new std::max_align_t[ std::max( n, std::size_t(1) ) ] );
+    data_ = heap_.get();
+    return;
+  }
+
+  if( scratch.storage.size() < n ) scratch.storage.resize( n );
+  scratch.leased = true;
+  leased_        = true;
+  data_          = scratch.storage.data();
+
+}
+
+scratch_buffer::~scratch_buffer() noexcept {
+  if( leased_ ) local_scratch().leased = false;
+}
+
+void pack_2d( void* dst, const std::size_t elem_size, const blacs_int M, 
+              const blacs_int N, const void* A, const blacs_int LDA ) noexcept {
+
+  auto*       d = static_cast<char*>( dst );
+  const auto* s = static_cast<const char*>( A );
+
+  const auto& k = kernels();
+  const std::size_t col = M * elem_size;
+  const bool stream = col * N >= k.streaming;
+  if( LDA == M or N == 1 ) k.copy( d, s, col * N, stream );
+  else for( blacs_int j = 0; j < N; ++j )
+    k.copy( d + j*col, s + std::size_t(j) * LDA * elem_size, col, stream );
+
+}
+
+void unpack_2d( void* A, const std::size_t elem_size, const blacs_int M, 
+                const blacs_int N, const void* src, const blacs_int LDA ) noexcept {
+
+  auto*       d = static_cast<char*>( A );
+  const auto* s = static_cast<const char*>( src );
+
+  const auto& k = kernels();
+  const std::size_t col = M * elem_size;
+  const bool stream = col * N >= k.streaming;
+  if( LDA == M or N == 1 ) k.copy( d, s, col * N, stream );
+  else for( blacs_int j = 0; j < N; ++j )
+    k.copy( d + std::size_t(j) * LDA * elem_size, s + j*col, col, stream );
+
+}
+
+void pack_trapezoid( void* dst, const std::size_t elem_size, const Triangle uplo,
+                     const Diagonal diag, const blacs_int M, const blacs_int N,
+                     const void* A, const blacs_int LDA ) noexcept {
+
+  auto*       d = static_cast<char*>( dst );
+  const auto* s = static_cast<const char*>( A );
+
+  const auto& k = kernels();
+  const bool stream = trapezoid_size( uplo, diag, M, N ) * elem_size >= k.streaming;
+  for( blacs_int j = 0; j < N; ++j ) {
+    auto [st, en] = trapezoid_rows( uplo, diag, M, N, j );
+    const std::size_t len = (en - st) * elem_size;
+    k.copy( d, s + (st + std::size_t(j) * LDA) * elem_size, len, stream );
+    d += len;
+  }
+
+}
+
+void unpack_trapezoid( void* A, const std::size_t elem_size, const Triangle uplo,
+                       const Diagonal diag, const blacs_int M, const blacs_int N,
+                       const void* src, const blacs_int LDA ) noexcept {
+
+  auto*       d = static_cast<char*>( A );
+  const auto* s = static_cast<const char*>( src );
+
+  const auto& k = kernels();
+  const bool stream = trapezoid_size( uplo, diag, M, N ) * elem_size >= k.streaming;
+  for( blacs_int j = 0; j < N; ++j ) {
+    auto [st, en] = trapezoid_rows( uplo, diag, M, N, j );
+    const std::size_t len = (en - st) * elem_size;
+    k.copy( d + (st + std::size_t(j) * LDA) * elem_size, s, len, stream );
+    s += len;
+  }
+
+}
+
+}
@@ -0,0 +1,268 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/profile.hpp>
+#include <blacspp/tune.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace blacspp {
+
+namespace {
+
+  const char* scope_label( int scope ) noexcept {
+    switch( scope ) {
+      case All:    return "all";
+      case Row:    return "row";
+      case Column: return "column";
+      default:     return "-";
+    }
+  }
+
+  const char* top_label( int top ) noexcept {
+    return top < 0 ? "-" : topology_name( Topology( top ) );
+  }
+
+  std::size_t histogram_bin( double seconds ) noexcept {
+    const double us = seconds * 1e6;
+    if( us < 2. ) return 0;
+    return std::min( std::size_t( std::log2( us ) ), profile_histogram_bins - 1 );
+  }
+
+  void merge( profile_entry& e, const profile_entry& other ) noexcept {
+    e.min    = e.count ? std::min( e.min, other.min ) : other.min;
+    e.max    = std::max( e.max, other.max );
+    e.count += other.count;
+    e.bytes += other.bytes;
+    e.total += other.total;
+    for( std::size_t i = 0; i < profile_histogram_bins; ++i )
+      e.histogram[i] += other.histogram[i];
+  }
+
+  std::string key_label( const profile_key& k ) {
+    char buf[128];
+    std::snprintf( buf, sizeof(buf), "%-10s %-7s %-15s %c", k.name.c_str(),
+      scope_label( k.scope ), top_label( k.top ), k.type ? k.type : '-' );
+    return buf;
+  }
+
+  /// Index of the calling thread (in order of the first recorded call)
+  int thread_index() noexcept {
+    static std::atomic<int> next{0};
+    thread_local const int index = next++;
+    return index;
+  }
+
+}
+
+bool profile_key::operator<( const profile_key& other ) const noexcept {
+  return std::tie( name, scope, top, type ) < 
+         std::tie( other.name, other.scope, other.top, other.type );
+}
+
+Profiler::Profiler() : origin_( MPI_Wtime() ) {
+  if( const char* env = std::getenv( "BLACSPP_PROFILE_REPORT" ) ) exit_report_ = env;
+}
+
+Profiler& Profiler::instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+void Profiler::record( const char* name, int scope, int top, char type, 
+  std::size_t bytes, double start, double end ) {
+
+  const double dt = end - start;
+
+  std::lock_guard<std::mutex> lock( mutex_ );
+  auto& e = entries_[ entry_key{ name, scope, top, type } ];
+  e.min = e.count ? std::min( e.min, dt ) : dt;
+  e.max = std::max( e.max, dt );
+  e.count++;
+  e.bytes += bytes;
+  e.total += dt;
+  e.histogram[ histogram_bin( dt ) ]++;
+
+  if( tracing_ ) trace_.push_back( { name, start, dt, bytes, thread_index() } );
+
+}
+
+void Profiler::reset() {
+  std::lock_guard<std::mutex> lock( mutex_ );
+  entries_.clear();
+  trace_.clear();
+  origin_ = MPI_Wtime();
+}
+
+std::map< profile_key, profile_entry > Profiler::entries() const {
+
+  std::map< profile_key, profile_entry > entries;
+  std::lock_guard<std::mutex> lock( mutex_ );
+  for( const auto& [k, e] : entries_ ) {
+    const auto [name, scope, top, type] = k;
+    merge( entries[ profile_key{ name, scope, top, type } ], e );
+  }
+  return entries;
+
+}
+
+void Profiler::report( std::ostream& out ) const {
+
+  char buf[256];
+  out << "# name      scope   topology        type      count          bytes"
+         "     total(s)       min(s)       max(s)\n";
+  for( const auto& [k, e] : entries() ) {
+    std::snprintf( buf, sizeof(buf), "%s %10zu %14zu %12.6e %12.6e %12.6e\n",
+      key_label( k ).c_str(), e.count, e.bytes, e.total, e.min, e.max );
+    out << buf;
+  }
+
+}
+
+void Profiler::report( std::ostream& out, MPI_Comm comm ) const {
+
+  int rank, size;
+  MPI_Comm_rank( comm, &rank );
+  MPI_Comm_size( comm, &size );
+
+  // Serialize the entries of this process
+  std::ostringstream ss;
+  ss.precision( 17 );
+  for( const auto& [k, e] : entries() ) {
+    ss << k.name << " " << k.scope << " " << k.top << " " << int(k.type) << " " 
+       << e.count << " " << e.bytes << " " << e.total << " " << e.min << " " 
+       << e.max;
+    for( auto h : e.histogram ) ss << " " << h;
+    ss << "\n";
+  }
+  const std::string local = ss.str();
+
+  int nlocal = local.size();
+  std::vector<int> counts( size ), displs( size );
+  MPI_Gather( &nlocal, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm );
+
+  std::string all;
+  if( rank == 0 ) {
+    for( int i = 1; i < size; ++i ) displs[i] = displs[i-1] + counts[i-1];
+    all.resize( displs.back() + counts.back() );
+  }
+  MPI_Gatherv( local.data(), nlocal, MPI_CHAR, all.data(), counts.data(),
+               displs.data(), MPI_CHAR, 0, comm );
+
+  if( rank ) return;
+
+  // Merge, tracking the time spent per process
+  struct reduced {
+    profile_entry entry;
+    double        t_min = 0., t_max = 0.;
+    int           nproc = 0;
+  };
+  std::map< profile_key, reduced > merged;
+
+  std::istringstream in( all );
+  std::string line;
+  while( std::getline( in, line ) ) {
+    std::istringstream ls( line );
+    profile_key   k;
+    profile_entry e;
+    int type;
+    ls >> k.name >> k.scope >> k.top >> type >> e.count >> e.bytes >> e.total 
+       >> e.min >> e.max;
+    for( auto& h : e.histogram ) ls >> h;
+    k.type = type;
+
+    auto& r = merged[k];
+    r.t_min = r.nproc ? std::min( r.t_min, e.total ) : e.total;
+    r.t_max = std::max( r.t_max, e.total );
+    r.nproc++;
+    merge( r.entry, e );
+  }
+
+  char buf[256];
+  std::snprintf( buf, sizeof(buf), "# blacspp profile reduced over %d processes\n", size );
+  out << buf;
+  out << "# name      scope   topology        type      count          bytes"
+         "  proc_min(s)  proc_avg(s)  proc_max(s)\n";
+  for( const auto& [k, r] : merged ) {
+    // Processes without calls of this class spent no time in it
+    const double t_min = r.nproc < size ? 0. : r.t_min;
+    std::snprintf( buf, sizeof(buf), "%s %10zu %14zu %12.6e %12.6e %12.6e\n",
+      key_label( k ).c_str(), r.entry.count, r.entry.bytes, t_min, 
+      r.entry.total / size, r.t_max );
+    out << buf;
+  }
+
+}
+
+void Profiler::write_chrome_trace( std::ostream& out, int pid ) const {
+
+  std::vector< trace_event > trace;
+  {
+    std::lock_guard<std::mutex> lock( mutex_ );
+    trace = trace_;
+  }
+
+  char buf[256];
+  out << "{\"traceEvents\":[\n";
+  for( std::size_t i = 0; i < trace.size(); ++i ) {
+    const auto& ev = trace[i];
+    std::snprintf( buf, sizeof(buf), 
+      "%s{\"name\":\"%s\",\"cat\":\"blacspp\",\"ph\":\"X\",\"ts\":%.3f,"
+      "\"dur\":%.3f,\"pid\":%d,\"tid\":%d,\"args\":{\"bytes\":%zu}}",
+      i ? ",\n" : "", ev.name, (ev.start - origin_) * 1e6, ev.duration * 1e6, 
+      pid, ev.tid, ev.bytes );
+    out << buf;
+  }
+  out << "\n]}\n";
+
+}
+
+void Profiler::write_chrome_trace( const std::string& fname, int pid ) const {
+
+  std::ofstream out( fname );
+  if( not out ) throw std::runtime_error( "Unable to open " + fname );
+  write_chrome_trace( out, pid );
+
+}
+
+void Profiler::grid_exit() const noexcept {
+
+  if( exit_report_.empty() or entries().empty() ) return;
+
+  int rank = 0, finalized = 0;
+  MPI_Finalized( &finalized );
+  if( not finalized ) MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+
+  std::ofstream out( exit_report_ + "." + std::to_string( rank ) + ".txt" );
+  if( out ) report( out );
+
+}
+
+
+
+
+namespace detail {
+
+profile_region::profile_region( const char* name, int scope, int top, char type,
+  std::size_t bytes ) noexcept : name_( name ), scope_( scope ), top_( top ), 
+  type_( type ), bytes_( bytes ), start_( MPI_Wtime() ) { }
+
+profile_region::~profile_region() noexcept {
+  try {
+    Profiler::instance().record( name_, scope_, top_, type_, bytes_, start_, 
+                                 MPI_Wtime() );
+  } catch( ... ) { }
+}
+
+}
+}
@@ -0,0 +1,191 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/progress.hpp>
+
+#include <stdexcept>
+
+namespace blacspp {
+
+namespace detail {
+
+submission_queue::submission_queue( std::size_t capacity ) {
+
+  std::size_t n = 2;
+  while( n < capacity ) n <<= 1;
+
+  cells_ = std::make_unique< cell[] >( n );
+  mask_  = n - 1;
+  for( std::size_t i = 0; i < n; ++i )
+    cells_[i].seq.store( i, std::memory_order_relaxed );
+
+}
+
+bool submission_queue::push( std::shared_ptr< progress_state >& op ) noexcept {
+
+  std::size_t pos = head_.load( std::memory_order_relaxed );
+  while( true ) {
+    cell& c = cells_[ pos & mask_ ];
+    const std::size_t seq = c.seq.load( std::memory_order_acquire );
+    const auto diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+    if( diff == 0 ) {
+      if( head_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+        c.op = std::move( op );
+        c.seq.store( pos + 1, std::memory_order_release );
+        return true;
+      }
+    } else if( diff < 0 ) return false; // Full
+    else pos = head_.load( std::memory_order_relaxed );
+  }
+
+}
+
+bool submission_queue::pop( std::shared_ptr< progress_state >& op ) noexcept {
+
+  std::size_t pos = tail_.load( std::memory_order_relaxed );
+  while( true ) {
+    cell& c = cells_[ pos & mask_ ];
+    const std::size_t seq = c.seq.load( std::memory_order_acquire );
+    const auto diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos + 1);
+    if( diff == 0 ) {
+      if( tail_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+        op = std::move( c.op );
+        c.seq.store( pos + mask_ + 1, std::memory_order_release );
+        return true;
+      }
+    } else if( diff < 0 ) return false; // Empty
+    else pos = tail_.load( std::memory_order_relaxed );
+  }
+
+}
+
+}
+
+
+
+
+bool ProgressTicket::done() const noexcept {
+  return not state_ or state_->done.load( std::memory_order_acquire );
+}
+
+void ProgressTicket::wait() {
+
+  while( not done() ) {
+    if( not engine_->poll() ) std::this_thread::yield();
+  }
+  if( state_ and state_->error ) std::rethrow_exception( state_->error );
+
+}
+
+
+
+
+ProgressEngine::ProgressEngine( const progress_options& opts ) :
+  opts_( opts ), queue_( opts.queue_capacity ) {
+
+  if( opts_.mode == ProgressMode::Thread ) {
+
+    int level;
+    MPI_Query_thread( &level );
+    if( level < MPI_THREAD_MULTIPLE )
+      throw std::runtime_error("Progress Thread Requires MPI_THREAD_MULTIPLE");
+
+    thread_ = std::thread( [this]() { run(); } );
+
+  }
+
+}
+
+ProgressEngine::~ProgressEngine() noexcept {
+
+  stop_.store( true );
+  if( thread_.joinable() ) thread_.join();
+  quiesce();
+
+}
+
+void ProgressEngine::run() noexcept {
+
+  while( not stop_.load( std::memory_order_relaxed ) ) {
+    poll();
+    if( not pending() ) std::this_thread::sleep_for( opts_.idle_sleep );
+  }
+
+}
+
+ProgressTicket ProgressEngine::submit( std::function<bool()> step ) {
+  return submit( std::move(step), nullptr );
+}
+
+ProgressTicket ProgressEngine::submit( std::function<bool()> step,
+  std::function<void()> on_complete ) {
+
+  auto state         = std::make_shared< detail::progress_state >();
+  state->step        = std::move( step );
+  state->on_complete = std::move( on_complete );
+  ProgressTicket ticket( state, this );
+
+  pending_.fetch_add( 1 );
+  while( not queue_.push( state ) ) {
+    // Full: drain the queue (or wait for the polling thread to do so)
+    if( not poll() ) std::this_thread::yield();
+  }
+
+  return ticket;
+
+}
+
+ProgressTicket ProgressEngine::submit( Request&& req ) {
+  auto r = std::make_shared< Request >( std::move(req) );
+  return submit( [r]() { return r->test(); } );
+}
+
+std::size_t ProgressEngine::poll() noexcept {
+
+  if( polling_.exchange( true, std::memory_order_acquire ) ) return 0;
+
+  std::shared_ptr< detail::progress_state > op;
+  while( queue_.pop( op ) ) active_.emplace_back( std::move(op) );
+
+  // Advance in submission order, compacting the remaining operations
+  std::vector< std::shared_ptr< detail::progress_state > > completed;
+  std::size_t nactive = 0;
+  for( std::size_t i = 0; i < active_.size(); ++i ) {
+
+    auto& s = *active_[i];
+    bool complete;
+    try { complete = s.step(); }
+    catch( ... ) { s.error = std::current_exception(); complete = true; }
+
+    if( complete ) {
+      s.step = nullptr;
+      completed.emplace_back( std::move( active_[i] ) );
+    } else if( nactive != i ) active_[nactive++] = std::move( active_[i] );
+    else nactive++;
+
+  }
+  active_.resize( nactive );
+
+  polling_.store( false, std::memory_order_release );
+
+  for( auto& s : completed ) {
+    auto on_complete = std::move( s->on_complete );
+    s->done.store( true, std::memory_order_release );
+    pending_.fetch_sub( 1 );
+    if( on_complete ) on_complete();
+  }
+
+  return completed.size();
+
+}
+
+void ProgressEngine::quiesce() noexcept {
+  while( pending() ) {
+    if( not poll() ) std::this_thread::yield();
+  }
+}
+
+}
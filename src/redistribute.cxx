@@ -0,0 +1,312 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/redistribute.hpp>
+#include <blacspp/util/mpi_types.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace blacspp {
+namespace detail {
+
+namespace {
+
+  /// A segment of a dimension with a single owner in both layouts
+  struct segment {
+    blacs_int g, len; ///< Global start / length
+    blacs_int p, q;   ///< Owner in the source / destination layout
+  };
+
+  std::vector< segment > dim_segments( blacs_int n, blacs_int nbs, blacs_int srcs,
+    blacs_int nps, blacs_int nbd, blacs_int srcd, blacs_int npd ) {
+
+    std::vector< segment > segs;
+    for( blacs_int g = 0; g < n; ) {
+      const blacs_int len = std::min( { nbs - g % nbs, nbd - g % nbd, n - g } );
+      segs.push_back( { g, len, indxg2p( g, nbs, srcs, nps ),
+                                indxg2p( g, nbd, srcd, npd ) } );
+      g += len;
+    }
+    return segs;
+
+  }
+
+  void append( std::vector< redistribution_schedule::run >& runs, blacs_int start,
+               blacs_int len ) {
+    if( not runs.empty() and runs.back().start + runs.back().len == start )
+      runs.back().len += len;
+    else runs.push_back( { start, len } );
+  }
+
+  blacs_int total( const std::vector< redistribution_schedule::run >& runs ) noexcept {
+    blacs_int n = 0;
+    for( const auto& r : runs ) n += r.len;
+    return n;
+  }
+
+  /// Walk two run lists (of the same total length) in lock step
+  template <typename F>
+  void walk( const std::vector< redistribution_schedule::run >& a,
+             const std::vector< redistribution_schedule::run >& b, F&& f ) {
+
+    std::size_t i = 0, j = 0;
+    blacs_int   oa = 0, ob = 0;
+    while( i < a.size() and j < b.size() ) {
+      const blacs_int len = std::min( a[i].len - oa, b[j].len - ob );
+      f( a[i].start + oa, b[j].start + ob, len );
+      oa += len; ob += len;
+      if( oa == a[i].len ) { ++i; oa = 0; }
+      if( ob == b[j].len ) { ++j; ob = 0; }
+    }
+
+  }
+
+  /// Call f( local column ) for the flattened columns [c0, c1) of a run list
+  template <typename F>
+  void for_columns( const std::vector< redistribution_schedule::run >& runs,
+                    blacs_int c0, blacs_int c1, F&& f ) {
+
+    blacs_int c = 0;
+    for( const auto& r : runs ) {
+      if( c + r.len <= c0 ) { c += r.len; continue; }
+      for( blacs_int k = std::max( c0 - c, 0 ); k < r.len and c + k < c1; ++k )
+        f( r.start + k );
+      c += r.len;
+      if( c >= c1 ) break;
+    }
+
+  }
+
+}
+
+redistribution_schedule::redistribution_schedule( const block_cyclic_layout& src,
+  const block_cyclic_layout& dst, MPI_Comm comm, std::size_t elem_size,
+  const redistribution_options& opts ) : elem_size_( elem_size ) {
+
+  MPI_Comm_dup( comm, &comm_ );
+
+  int rank, size;
+  MPI_Comm_rank( comm_, &rank );
+  MPI_Comm_size( comm_, &size );
+
+  // Locate the processes of both grids in the communicator
+  std::vector<blacs_int> coords( 4 * size );
+  blacs_int my_coords[4] = { src.ipr, src.ipc, dst.ipr, dst.ipc };
+  MPI_Allgather( my_coords, 4, detail::mpi_data_type<blacs_int>::type(), coords.data(),
+                 4, detail::mpi_data_type<blacs_int>::type(), comm_ );
+
+  const bool in_src = src.ipr >= 0 and src.ipc >= 0;
+  const bool in_dst = dst.ipr >= 0 and dst.ipc >= 0;
+
+  // Runs per process row / column of the peer layout
+  send_rows_.resize( dst.npr ); send_cols_.resize( dst.npc );
+  recv_rows_.resize( src.npr ); recv_cols_.resize( src.npc );
+
+  const auto rsegs = dim_segments( src.M, src.MB, src.RSRC, src.npr, dst.MB,
+    dst.RSRC, dst.npr );
+  const auto csegs = dim_segments( src.N, src.NB, src.CSRC, src.npc, dst.NB,
+    dst.CSRC, dst.npc );
+
+  for( const auto& s : rsegs ) {
+    if( in_src and s.p == src.ipr )
+      append( send_rows_[s.q], indxg2l( s.g, src.MB, src.npr ), s.len );
+    if( in_dst and s.q == dst.ipr )
+      append( recv_rows_[s.p], indxg2l( s.g, dst.MB, dst.npr ), s.len );
+  }
+  for( const auto& s : csegs ) {
+    if( in_src and s.p == src.ipc )
+      append( send_cols_[s.q], indxg2l( s.g, src.NB, src.npc ), s.len );
+    if( in_dst and s.q == dst.ipc )
+      append( recv_cols_[s.p], indxg2l( s.g, dst.NB, dst.npc ), s.len );
+  }
+
+  // Split the messages into pieces, in the rotated order of execution
+  auto split = [&]( std::vector<piece>& pieces, int peer, blacs_int pr, blacs_int pc,
+                    const std::vector<run>& rows, const std::vector<run>& cols ) {
+    const blacs_int R = total( rows ), C = total( cols );
+    if( R == 0 or C == 0 ) return;
+    const std::size_t col_bytes = R * elem_size_;
+    const blacs_int   ncol = std::max( std::size_t(1), opts.piece_bytes / col_bytes );
+    for( blacs_int c0 = 0; c0 < C; c0 += ncol ) {
+      const blacs_int c1 = std::min( C, c0 + ncol );
+      pieces.push_back( { peer, pr, pc, c0, c1, (c1 - c0) * col_bytes } );
+      slot_bytes_ = std::max( slot_bytes_, pieces.back().bytes );
+    }
+  };
+
+  for( int k = 1; k < size; ++k ) {
+
+    const int d = (rank + k) % size;
+    const blacs_int dr = coords[4*d + 2], dc = coords[4*d + 3];
+    if( in_src and dr >= 0 and dc >= 0 )
+      split( send_pieces_, d, dr, dc, send_rows_[dr], send_cols_[dc] );
+
+    const int s = (rank - k + size) % size;
+    const blacs_int sr = coords[4*s], sc = coords[4*s + 1];
+    if( in_dst and sr >= 0 and sc >= 0 )
+      split( recv_pieces_, s, sr, sc, recv_rows_[sr], recv_cols_[sc] );
+
+  }
+
+  // The part of the matrix which remains on this process
+  if( in_src and in_dst ) {
+    walk( send_rows_[dst.ipr], recv_rows_[src.ipr], [&]( auto a, auto b, auto len ) {
+      self_rows_.push_back( { a, b, len } );
+    });
+    walk( send_cols_[dst.ipc], recv_cols_[src.ipc], [&]( auto a, auto b, auto len ) {
+      self_cols_.push_back( { a, b, len } );
+    });
+  }
+
+  // Scratch slots (at least one per direction)
+  if( slot_bytes_ ) {
+    nslots_ = std::max( std::size_t(1), opts.scratch_bytes / (2 * slot_bytes_) );
+    nslots_ = std::min( nslots_, std::max( send_pieces_.size(), recv_pieces_.size() ) );
+    scratch_.resize( 2 * nslots_ * slot_bytes_ );
+  }
+
+  stats_.sends   = send_pieces_.size();
+  stats_.recvs   = recv_pieces_.size();
+  stats_.scratch = scratch_.size();
+  for( const auto& p : send_pieces_ ) stats_.bytes_sent += p.bytes;
+  for( const auto& r : self_rows_ )
+  for( const auto& c : self_cols_ ) stats_.local_bytes += r[2] * c[2] * elem_size_;
+
+}
+
+redistribution_schedule::~redistribution_schedule() noexcept {
+  MPI_Comm_free( &comm_ );
+}
+
+
+
+
+void redistribution_schedule::pack( const piece& p, const char* A, blacs_int LDA,
+  char* buf ) const noexcept {
+
+  const auto& rows = send_rows_[p.row];
+  for_columns( send_cols_[p.col], p.c0, p.c1, [&]( blacs_int j ) {
+    const char* col = A + std::size_t(j) * LDA * elem_size_;
+    for( const auto& r : rows ) {
+      const std::size_t n = r.len * elem_size_;
+      std::memcpy( buf, col + r.start * elem_size_, n );
+      buf += n;
+    }
+  });
+
+}
+
+void redistribution_schedule::unpack( const piece& p, const char* buf, char* B,
+  blacs_int LDB ) const noexcept {
+
+  const auto& rows = recv_rows_[p.row];
+  for_columns( recv_cols_[p.col], p.c0, p.c1, [&]( blacs_int j ) {
+    char* col = B + std::size_t(j) * LDB * elem_size_;
+    for( const auto& r : rows ) {
+      const std::size_t n = r.len * elem_size_;
+      std::memcpy( col + r.start * elem_size_, buf, n );
+      buf += n;
+    }
+  });
+
+}
+
+void redistribution_schedule::execute( const void* A_, blacs_int LDA, void* B_,
+  blacs_int LDB ) {
+
+  const char* A = static_cast<const char*>( A_ );
+  char*       B = static_cast<char*>( B_ );
+
+  // Slots [0, nslots) send, [nslots, 2*nslots) recieve
+  std::vector< std::size_t > free_send, free_recv;
+  for( std::size_t i = 0; i < nslots_; ++i ) {
+    free_send.push_back( i );
+    free_recv.push_back( nslots_ + i );
+  }
+  auto slot = [&]( std::size_t i ) { return scratch_.data() + i * slot_bytes_; };
+
+  struct pending {
+    std::size_t  slot;
+    const piece* p; ///< nullptr for sends
+  };
+  std::vector< MPI_Request > reqs;
+  std::vector< pending >     info;
+
+  std::size_t si = 0, ri = 0;
+  bool self_done = false;
+
+  auto complete = [&]( int n, const int* idx ) {
+    for( int k = 0; k < n; ++k ) {
+      auto& inf = info[ idx[k] ];
+      if( inf.p ) {
+        unpack( *inf.p, slot( inf.slot ), B, LDB );
+        free_recv.push_back( inf.slot );
+      } else free_send.push_back( inf.slot );
+    }
+    // Compact the completed requests
+    std::size_t j = 0;
+    for( std::size_t i = 0; i < reqs.size(); ++i )
+      if( reqs[i] != MPI_REQUEST_NULL ) { reqs[j] = reqs[i]; info[j] = info[i]; ++j; }
+    reqs.resize( j ); info.resize( j );
+  };
+
+  std::vector<int> idx;
+  while( true ) {
+
+    // Recieves are posted in order as buffers become free
+    while( ri < recv_pieces_.size() and not free_recv.empty() ) {
+      const auto& p = recv_pieces_[ri++];
+      const auto  s = free_recv.back(); free_recv.pop_back();
+      reqs.emplace_back();
+      info.push_back( { s, &p } );
+      MPI_Irecv( slot( s ), p.bytes, MPI_BYTE, p.rank, redistribution_tag, comm_,
+                 &reqs.back() );
+    }
+
+    if( si < send_pieces_.size() and not free_send.empty() ) {
+
+      // Pack while previous pieces are in flight
+      const auto& p = send_pieces_[si++];
+      const auto  s = free_send.back(); free_send.pop_back();
+      pack( p, A, LDA, slot( s ) );
+      reqs.emplace_back();
+      info.push_back( { s, nullptr } );
+      MPI_Isend( slot( s ), p.bytes, MPI_BYTE, p.rank, redistribution_tag, comm_,
+                 &reqs.back() );
+
+      int n;
+      idx.resize( reqs.size() );
+      MPI_Testsome( reqs.size(), reqs.data(), &n, idx.data(), MPI_STATUSES_IGNORE );
+      if( n != MPI_UNDEFINED ) complete( n, idx.data() );
+
+    } else if( not self_done ) {
+
+      for( const auto& c : self_cols_ )
+      for( blacs_int k = 0; k < c[2]; ++k ) {
+        const char* acol = A + std::size_t(c[0] + k) * LDA * elem_size_;
+        char*       bcol = B + std::size_t(c[1] + k) * LDB * elem_size_;
+        for( const auto& r : self_rows_ )
+          std::memcpy( bcol + r[1] * elem_size_, acol + r[0] * elem_size_,
+                       r[2] * elem_size_ );
+      }
+      self_done = true;
+
+    } else if( not reqs.empty() ) {
+
+      int n;
+      idx.resize( reqs.size() );
+      MPI_Waitsome( reqs.size(), reqs.data(), &n, idx.data(), MPI_STATUSES_IGNORE );
+      if( n != MPI_UNDEFINED ) complete( n, idx.data() );
+
+    } else break;
+
+  }
+
+}
+
+}
+}
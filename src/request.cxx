@@ -0,0 +1,85 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/request.hpp>
+
+#include <vector>
+
+namespace blacspp {
+
+Request::Request() noexcept : request_( MPI_REQUEST_NULL ) { }
+
+Request::Request( MPI_Request r ) noexcept : request_( r ) { }
+
+Request::Request( Request&& other ) noexcept : request_( other.request_ ) {
+  other.request_ = MPI_REQUEST_NULL;
+}
+
+Request& Request::operator=( Request&& other ) noexcept {
+
+  if( this != &other ) {
+    wait();
+    request_       = other.request_;
+    other.request_ = MPI_REQUEST_NULL;
+  }
+  return *this;
+
+}
+
+Request::~Request() noexcept { wait(); }
+
+void Request::wait() {
+  if( is_active() ) MPI_Wait( &request_, MPI_STATUS_IGNORE );
+}
+
+bool Request::test() {
+
+  if( not is_active() ) return true;
+
+  int flag;
+  MPI_Test( &request_, &flag, MPI_STATUS_IGNORE );
+  return flag;
+
+}
+
+bool Request::is_active() const noexcept {
+  return request_ != MPI_REQUEST_NULL;
+}
+
+
+
+
+void wait_all( Request* first, Request* last ) {
+
+  std::vector< MPI_Request > reqs;
+  reqs.reserve( std::distance( first, last ) );
+  for( auto it = first; it != last; ++it ) reqs.emplace_back( it->native_handle() );
+
+  MPI_Waitall( reqs.size(), reqs.data(), MPI_STATUSES_IGNORE );
+
+  // MPI_Waitall resets completed handles to MPI_REQUEST_NULL
+  for( auto it = first; it != last; ++it ) 
+    it->native_handle() = reqs[ std::distance( first, it ) ];
+
+}
+
+bool test_all( Request* first, Request* last ) {
+
+  std::vector< MPI_Request > reqs;
+  reqs.reserve( std::distance( first, last ) );
+  for( auto it = first; it != last; ++it ) reqs.emplace_back( it->native_handle() );
+
+  int flag;
+  MPI_Testall( reqs.size(), reqs.data(), &flag, MPI_STATUSES_IGNORE );
+
+  for( auto it = first; it != last; ++it ) 
+    it->native_handle() = reqs[ std::distance( first, it ) ];
+
+  return flag;
+
+}
+
+}
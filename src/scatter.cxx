@@ -0,0 +1,236 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/scatter.hpp>
+#include <blacspp/buffer_pool.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/profile.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace blacspp {
+namespace detail {
+
+namespace {
+
+  /// Call f( global row, local row, length ) for the row blocks of process row p
+  template <typename F>
+  void for_row_blocks( const block_cyclic_layout& L, blacs_int p, F&& f ) {
+    const blacs_int nblocks = ( L.M + L.MB - 1 ) / L.MB;
+    for( blacs_int b = ( p - L.RSRC + L.npr ) % L.npr; b < nblocks; b += L.npr ) {
+      const blacs_int g0 = b * L.MB;
+      f( g0, ( b / L.npr ) * L.MB, std::min( L.MB, L.M - g0 ) );
+    }
+  }
+
+  /// Copy the rows of process row p between a panel and its local (packed) form
+  template <bool ToPanel>
+  void copy_rows( const block_cyclic_layout& L, blacs_int p, std::size_t es,
+    blacs_int ncols, char* panel, blacs_int ldp, char* local, blacs_int ldl ) {
+
+    for( blacs_int c = 0; c < ncols; ++c ) {
+      char* pcol = panel + std::size_t(c) * ldp * es;
+      char* lcol = local + std::size_t(c) * ldl * es;
+      for_row_blocks( L, p, [&]( blacs_int g0, blacs_int l0, blacs_int len ) {
+        if constexpr ( ToPanel ) std::memcpy( pcol + g0 * es, lcol + l0 * es, len * es );
+        else                     std::memcpy( lcol + l0 * es, pcol + g0 * es, len * es );
+      });
+    }
+
+  }
+
+  /// A staging buffer of the root in flight
+  struct staged {
+    Request     req;
+    void*       buf;
+    std::size_t bytes;
+  };
+
+}
+
+void scatter_panels( const Grid& grid, const block_cyclic_layout& L,
+  MPI_Datatype dtype, std::size_t es, const panel_provider& source,
+  void* B_, blacs_int LDB, blacs_int RSRC, blacs_int CSRC,
+  const scatter_options& opts ) {
+
+  if( L.ipr < 0 or L.ipc < 0 ) return;
+
+  char* B = static_cast<char*>( B_ );
+  const MPI_Comm  comm  = grid.transfer_comm();
+  const blacs_int root  = grid.comm_rank( RSRC, CSRC );
+  const blacs_int mloc  = numroc( L.M, L.MB, L.ipr, L.RSRC, L.npr );
+  const blacs_int nloc  = numroc( L.N, L.NB, L.ipc, L.CSRC, L.npc );
+
+  // The root transfers the global matrix, all others their local blocks
+  const bool is_root = L.ipr == RSRC and L.ipc == CSRC;
+  BLACSPP_PROFILE( "scatter", -1, -1, 0, is_root ? std::size_t(L.M) * L.N * es :
+                                               std::size_t(mloc) * nloc * es );
+
+  if( not is_root ) {
+
+    // Recieve the local column blocks in place
+    std::vector< Request > reqs;
+    if( mloc )
+    for( blacs_int jl = 0; jl < nloc; jl += L.NB )
+      reqs.emplace_back( irecv_2d( comm, dtype, mloc, std::min( L.NB, nloc - jl ),
+        B + jl * std::size_t(LDB) * es, LDB, root, scatter_tag ) );
+    wait_all( reqs );
+    return;
+
+  }
+
+  BufferPool pool( grid );
+  std::deque< staged > inflight;
+  std::size_t outstanding = 0;
+
+  auto retire = [&]() {
+    auto& s = inflight.front();
+    s.req.wait();
+    pool.deallocate( s.buf, s.bytes );
+    outstanding -= s.bytes;
+    inflight.pop_front();
+  };
+
+  for( blacs_int j0 = 0; j0 < L.N; j0 += L.NB ) {
+
+    const blacs_int ncols = std::min( L.NB, L.N - j0 );
+    const blacs_int pc    = indxg2p( j0, L.NB, L.CSRC, L.npc );
+    const auto      panel = source( j0, ncols );
+    char*           pdata = static_cast<char*>( panel.data );
+
+    for( blacs_int p = 0; p < L.npr; ++p ) {
+
+      const blacs_int mp = numroc( L.M, L.MB, p, L.RSRC, L.npr );
+      if( mp == 0 ) continue;
+
+      if( p == L.ipr and pc == L.ipc ) {
+        const blacs_int jl = indxg2l( j0, L.NB, L.npc );
+        copy_rows<false>( L, p, es, ncols, pdata, panel.ld,
+                          B + jl * std::size_t(LDB) * es, LDB );
+        continue;
+      }
+
+      const std::size_t bytes = std::size_t(mp) * ncols * es;
+      while( not inflight.empty() and outstanding + bytes > opts.window_bytes )
+        retire();
+
+      void* buf = pool.allocate( bytes );
+      copy_rows<false>( L, p, es, ncols, pdata, panel.ld, static_cast<char*>( buf ), mp );
+
+      inflight.push_back( { isend_2d( comm, dtype, mp, ncols, buf, mp,
+        grid.comm_rank( p, pc ), scatter_tag ), buf, bytes } );
+      outstanding += bytes;
+
+    }
+
+  }
+
+  while( not inflight.empty() ) retire();
+
+}
+
+void gather_panels( const Grid& grid, const block_cyclic_layout& L,
+  MPI_Datatype dtype, std::size_t es, const void* A_, blacs_int LDA,
+  const panel_provider& target, const panel_done& done, blacs_int RDEST,
+  blacs_int CDEST, const scatter_options& opts ) {
+
+  if( L.ipr < 0 or L.ipc < 0 ) return;
+
+  const char* A = static_cast<const char*>( A_ );
+  const MPI_Comm  comm  = grid.transfer_comm();
+  const blacs_int root  = grid.comm_rank( RDEST, CDEST );
+  const blacs_int mloc  = numroc( L.M, L.MB, L.ipr, L.RSRC, L.npr );
+  const blacs_int nloc  = numroc( L.N, L.NB, L.ipc, L.CSRC, L.npc );
+
+  // The root transfers the global matrix, all others their local blocks
+  const bool is_root = L.ipr == RDEST and L.ipc == CDEST;
+  BLACSPP_PROFILE( "gather", -1, -1, 0, is_root ? std::size_t(L.M) * L.N * es :
+                                               std::size_t(mloc) * nloc * es );
+
+  if( not is_root ) {
+
+    // Send the local column blocks in place
+    std::vector< Request > reqs;
+    if( mloc )
+    for( blacs_int jl = 0; jl < nloc; jl += L.NB )
+      reqs.emplace_back( isend_2d( comm, dtype, mloc, std::min( L.NB, nloc - jl ),
+        A + jl * std::size_t(LDA) * es, LDA, root, scatter_tag ) );
+    wait_all( reqs );
+    return;
+
+  }
+
+  if( L.M == 0 ) return;
+
+  // Pieces in the order in which they are unpacked
+  struct piece {
+    blacs_int   j0, ncols, p, pc, mp;
+    bool        first, last; ///< First / last piece of its panel
+    std::size_t bytes;       ///< 0 for the local piece
+    Request     req;
+    void*       buf = nullptr;
+  };
+
+  std::vector< piece > pieces;
+  for( blacs_int j0 = 0; j0 < L.N; j0 += L.NB ) {
+    const blacs_int ncols = std::min( L.NB, L.N - j0 );
+    const blacs_int pc    = indxg2p( j0, L.NB, L.CSRC, L.npc );
+    const std::size_t st  = pieces.size();
+    for( blacs_int p = 0; p < L.npr; ++p ) {
+      const blacs_int mp = numroc( L.M, L.MB, p, L.RSRC, L.npr );
+      if( mp == 0 ) continue;
+      const bool local = p == L.ipr and pc == L.ipc;
+      pieces.push_back( { j0, ncols, p, pc, mp, false, false,
+        local ? 0 : std::size_t(mp) * ncols * es, Request() } );
+    }
+    pieces[st].first = true;
+    pieces.back().last = true;
+  }
+
+  BufferPool pool( grid );
+  std::size_t outstanding = 0, posted = 0;
+  panel_view panel{ nullptr, 0 };
+
+  for( std::size_t i = 0; i < pieces.size(); ++i ) {
+
+    // Recieves of the upcoming pieces are posted within the window
+    while( posted < pieces.size() and
+           ( posted == i or outstanding + pieces[posted].bytes <= opts.window_bytes ) ) {
+      auto& q = pieces[posted++];
+      if( not q.bytes ) continue;
+      q.buf = pool.allocate( q.bytes );
+      q.req = irecv_2d( comm, dtype, q.mp, q.ncols, q.buf, q.mp,
+                        grid.comm_rank( q.p, q.pc ), scatter_tag );
+      outstanding += q.bytes;
+    }
+
+    auto& q = pieces[i];
+    if( q.first ) panel = target( q.j0, q.ncols );
+    char* pdata = static_cast<char*>( panel.data );
+
+    if( q.bytes ) {
+      q.req.wait();
+      copy_rows<true>( L, q.p, es, q.ncols, pdata, panel.ld,
+                       static_cast<char*>( q.buf ), q.mp );
+      pool.deallocate( q.buf, q.bytes );
+      outstanding -= q.bytes;
+    } else {
+      const blacs_int jl = indxg2l( q.j0, L.NB, L.npc );
+      copy_rows<true>( L, q.p, es, q.ncols, pdata, panel.ld,
+        const_cast<char*>( A ) + jl * std::size_t(LDA) * es, LDA );
+    }
+
+    if( q.last and done ) done( q.j0, q.ncols, panel );
+
+  }
+
+}
+
+}
+}
@@ -0,0 +1,47 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/util/scope_comms.hpp>
+
+namespace blacspp::detail {
+
+scope_comms::scope_comms( const Grid& grid ) : npr_( grid.npr() ) {
+
+  const auto comm      = grid.comm();
+  const bool is_member = grid.ipr() >= 0;
+
+  MPI_Comm_split( comm, is_member ? 0 : MPI_UNDEFINED, 
+                  grid.ipr() + grid.ipc() * grid.npr(), &grid_comm_ );
+  MPI_Comm_split( comm, is_member ? grid.ipr() : MPI_UNDEFINED, grid.ipc(), &row_comm_ );
+  MPI_Comm_split( comm, is_member ? grid.ipc() : MPI_UNDEFINED, grid.ipr(), &col_comm_ );
+
+}
+
+scope_comms::~scope_comms() noexcept {
+
+  if( grid_comm_ != MPI_COMM_NULL ) MPI_Comm_free( &grid_comm_ );
+  if( row_comm_  != MPI_COMM_NULL ) MPI_Comm_free( &row_comm_  );
+  if( col_comm_  != MPI_COMM_NULL ) MPI_Comm_free( &col_comm_  );
+
+}
+
+MPI_Comm scope_comms::comm( Scope scope ) const noexcept {
+  switch( scope ) {
+    case Row:    return row_comm_;
+    case Column: return col_comm_;
+    default:     return grid_comm_;
+  }
+}
+
+blacs_int scope_comms::root( Scope scope, blacs_int PROW, blacs_int PCOL ) const noexcept {
+  switch( scope ) {
+    case Row:    return PCOL;
+    case Column: return PROW;
+    default:     return PROW + PCOL * npr_;
+  }
+}
+
+}
@@ -0,0 +1,268 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/shared_memory.hpp>
+#include <blacspp/util/pack.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+namespace blacspp {
+namespace detail {
+
+namespace {
+
+  constexpr int p2p_tag   = 1;
+  constexpr int bcast_tag = 2; // + Scope
+
+  constexpr std::size_t block_align = 64;
+
+  /// Header of a block in the ring of the sender
+  struct alignas(block_align) block_header {
+    std::atomic<std::int64_t> readers; ///< Number of processes yet to read the block
+  };
+
+  static_assert( std::atomic<std::int64_t>::is_always_lock_free,
+    "Shared memory transport requires lock-free 64-bit atomics" );
+
+  inline std::size_t round_up( std::size_t n ) {
+    return ( (n + block_align - 1) / block_align ) * block_align;
+  }
+
+}
+
+shm_transport::shm_transport( MPI_Comm comm, std::size_t bytes ) :
+  capacity_( round_up( bytes ) ) {
+
+  int rank, size;
+  MPI_Comm_rank( comm, &rank );
+  MPI_Comm_size( comm, &size );
+
+  MPI_Comm_dup( comm, &header_comm_ );
+  MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm_ );
+
+  MPI_Win_allocate_shared( capacity_, 1, MPI_INFO_NULL, node_comm_, &base_, &win_ );
+  MPI_Win_lock_all( MPI_MODE_NOCHECK, win_ );
+
+  // Locate the segments of the processes on this node
+  int node_size;
+  MPI_Comm_size( node_comm_, &node_size );
+
+  std::vector<int> node_ranks( node_size );
+  MPI_Allgather( &rank, 1, MPI_INT, node_ranks.data(), 1, MPI_INT, node_comm_ );
+
+  peers_.assign( size, nullptr );
+  for( int i = 0; i < node_size; ++i ) {
+    MPI_Aint seg_size; int disp; void* ptr;
+    MPI_Win_shared_query( win_, i, &seg_size, &disp, &ptr );
+    peers_[ node_ranks[i] ] = static_cast<char*>( ptr );
+  }
+
+}
+
+shm_transport::~shm_transport() noexcept {
+
+  for( auto& p : pending_ ) MPI_Wait( &p.second, MPI_STATUS_IGNORE );
+
+  // Peers may still be reading from the local segment
+  MPI_Barrier( node_comm_ );
+
+  MPI_Win_unlock_all( win_ );
+  MPI_Win_free( &win_ );
+  MPI_Comm_free( &node_comm_ );
+  MPI_Comm_free( &header_comm_ );
+
+}
+
+
+
+
+void shm_transport::progress() {
+
+  for( auto it = pending_.begin(); it != pending_.end(); ) {
+    int flag;
+    MPI_Test( &it->second, &flag, MPI_STATUS_IGNORE );
+    if( flag ) it = pending_.erase( it );
+    else       ++it;
+  }
+
+}
+
+void shm_transport::post_header( const header& h, int dest, int tag ) {
+
+  // Headers are posted non-blocking such that sends never wait on the reciever
+  pending_.emplace_back( h, MPI_REQUEST_NULL );
+  auto& p = pending_.back();
+  MPI_Isend( &p.first, 3, MPI_INT64_T, dest, tag, header_comm_, &p.second );
+
+}
+
+char* shm_transport::allocate( std::size_t bytes, int nreaders ) {
+
+  progress();
+
+  // Release completely read blocks (in order)
+  while( not live_.empty() ) {
+    auto* blk = reinterpret_cast<block_header*>( base_ + live_.front().offset );
+    if( blk->readers.load( std::memory_order_acquire ) ) break;
+    blk->~block_header();
+    live_.pop_front();
+  }
+  if( live_.empty() ) head_ = 0;
+
+  const std::size_t size = sizeof(block_header) + round_up( bytes );
+
+  std::size_t offset;
+  if( live_.empty() ) {
+    if( size > capacity_ ) return nullptr;
+    offset = 0;
+  } else {
+    const std::size_t tail = live_.front().offset;
+    if( head_ > tail ) {
+      if( head_ + size <= capacity_ ) offset = head_;
+      else if( size < tail )          offset = 0;
+      else return nullptr;
+    } else {
+      if( head_ + size < tail ) offset = head_;
+      else return nullptr;
+    }
+  }
+
+  auto* blk = new ( base_ + offset ) block_header;
+  blk->readers.store( nreaders, std::memory_order_relaxed );
+
+  live_.push_back( { offset, size } );
+  head_ = offset + size;
+
+  return base_ + offset;
+
+}
+
+
+
+
+bool shm_transport::send( blacs_int dest, std::size_t elem_size, blacs_int M,
+  blacs_int N, const void* A, blacs_int LDA ) {
+
+  if( not is_local( dest ) ) return false;
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * elem_size;
+  char* blk = allocate( bytes, 1 );
+
+  header h{ 0, 0, std::int64_t(bytes) };
+  if( blk ) {
+    pack_2d( blk + sizeof(block_header), elem_size, M, N, A, LDA );
+    h.path   = 1;
+    h.offset = blk - base_;
+    stats_.shared++;
+  } else stats_.fallback++;
+
+  MPI_Win_sync( win_ );
+  post_header( h, dest, p2p_tag );
+
+  return h.path;
+
+}
+
+bool shm_transport::recv( blacs_int src, std::size_t elem_size, blacs_int M,
+  blacs_int N, void* A, blacs_int LDA ) {
+
+  if( not is_local( src ) ) return false;
+
+  header h;
+  MPI_Recv( &h, 3, MPI_INT64_T, src, p2p_tag, header_comm_, MPI_STATUS_IGNORE );
+  if( not h.path ) return false;
+
+  if( std::size_t(h.bytes) != std::size_t(M) * std::size_t(N) * elem_size )
+    throw std::runtime_error("Shared Memory Message Size Mismatch");
+
+  MPI_Win_sync( win_ );
+
+  char* blk = peers_[src] + h.offset;
+  unpack_2d( A, elem_size, M, N, blk + sizeof(block_header), LDA );
+  reinterpret_cast<block_header*>( blk )->readers.fetch_sub( 1,
+    std::memory_order_release );
+
+  return true;
+
+}
+
+bool shm_transport::broadcast_send( Scope scope, const std::vector<blacs_int>& ranks,
+  std::size_t elem_size, blacs_int M, blacs_int N, const void* A, blacs_int LDA ) {
+
+  for( auto r : ranks ) if( not is_local( r ) ) return false;
+  if( ranks.empty() ) return true;
+
+  const std::size_t bytes = std::size_t(M) * std::size_t(N) * elem_size;
+  char* blk = allocate( bytes, ranks.size() );
+
+  header h{ 0, 0, std::int64_t(bytes) };
+  if( blk ) {
+    pack_2d( blk + sizeof(block_header), elem_size, M, N, A, LDA );
+    h.path   = 1;
+    h.offset = blk - base_;
+    stats_.shared++;
+  } else stats_.fallback++;
+
+  MPI_Win_sync( win_ );
+  for( auto r : ranks ) post_header( h, r, bcast_tag + scope );
+
+  return h.path;
+
+}
+
+bool shm_transport::broadcast_recv( Scope scope, const std::vector<blacs_int>& ranks,
+  blacs_int root, std::size_t elem_size, blacs_int M, blacs_int N, void* A,
+  blacs_int LDA ) {
+
+  if( not is_local( root ) ) return false;
+  for( auto r : ranks ) if( not is_local( r ) ) return false;
+
+  header h;
+  MPI_Recv( &h, 3, MPI_INT64_T, root, bcast_tag + scope, header_comm_,
+            MPI_STATUS_IGNORE );
+  if( not h.path ) return false;
+
+  if( std::size_t(h.bytes) != std::size_t(M) * std::size_t(N) * elem_size )
+    throw std::runtime_error("Shared Memory Message Size Mismatch");
+
+  MPI_Win_sync( win_ );
+
+  char* blk = peers_[root] + h.offset;
+  unpack_2d( A, elem_size, M, N, blk + sizeof(block_header), LDA );
+  reinterpret_cast<block_header*>( blk )->readers.fetch_sub( 1,
+    std::memory_order_release );
+
+  return true;
+
+}
+
+
+
+
+std::vector<blacs_int> scope_ranks( const Grid& grid, Scope scope,
+                                    blacs_int RSRC, blacs_int CSRC ) {
+
+  std::vector<blacs_int> ranks;
+
+  const blacs_int i_st = (scope == Row)    ? RSRC : 0;
+  const blacs_int i_en = (scope == Row)    ? RSRC + 1 : grid.npr();
+  const blacs_int j_st = (scope == Column) ? CSRC : 0;
+  const blacs_int j_en = (scope == Column) ? CSRC + 1 : grid.npc();
+
+  ranks.reserve( (i_en - i_st) * (j_en - j_st) );
+  for( blacs_int j = j_st; j < j_en; ++j )
+  for( blacs_int i = i_st; i < i_en; ++i )
+    if( i != RSRC or j != CSRC ) ranks.push_back( grid.comm_rank( i, j ) );
+
+  return ranks;
+
+}
+
+}
+}
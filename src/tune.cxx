@@ -0,0 +1,289 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <blacspp/tune.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/combine.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace blacspp {
+
+namespace {
+
+const char* op_name( CollectiveOp op ) noexcept {
+  return op == Broadcast ? "broadcast" : "combine";
+}
+
+const char* scope_name( Scope scope ) noexcept {
+  switch( scope ) {
+    case Row:    return "row";
+    case Column: return "column";
+    default:     return "all";
+  }
+}
+
+CollectiveOp op_from_string( const std::string& name ) {
+  if( name == "broadcast" ) return Broadcast;
+  if( name == "combine"   ) return Combine;
+  throw std::runtime_error( "Unknown collective operation: " + name );
+}
+
+Scope scope_from_string( const std::string& name ) {
+  if( name == "all"    ) return All;
+  if( name == "row"    ) return Row;
+  if( name == "column" ) return Column;
+  throw std::runtime_error( "Unknown scope: " + name );
+}
+
+}
+
+std::size_t TopologyTable::index( CollectiveOp op, Scope scope ) noexcept {
+  return 3 * static_cast<std::size_t>(op) + static_cast<std::size_t>(scope);
+}
+
+bool valid_for( CollectiveOp op, Topology top ) noexcept {
+  return op != Combine or ( top != SRing and top != MRing );
+}
+
+void TopologyTable::insert( CollectiveOp op, Scope scope, std::size_t max_bytes,
+                            Topology top ) {
+
+  if( not valid_for( op, top ) )
+    throw std::runtime_error( std::string("Invalid Topology For Combine: ") +
+                              topology_name( top ) );
+
+  auto& bkts = entries_[ index( op, scope ) ];
+  auto it = std::lower_bound( bkts.begin(), bkts.end(), max_bytes,
+    []( const entry& e, std::size_t b ){ return e.max_bytes < b; } );
+
+  if( it != bkts.end() and it->max_bytes == max_bytes ) it->top = top;
+  else bkts.insert( it, entry{ max_bytes, top } );
+
+}
+
+std::optional<Topology> TopologyTable::lookup( CollectiveOp op, Scope scope,
+                                               std::size_t bytes ) const {
+
+  const auto& bkts = entries_[ index( op, scope ) ];
+  if( bkts.empty() ) return std::nullopt;
+
+  auto it = std::lower_bound( bkts.begin(), bkts.end(), bytes,
+    []( const entry& e, std::size_t b ){ return e.max_bytes < b; } );
+
+  return it == bkts.end() ? bkts.back().top : it->top;
+
+}
+
+const std::vector<TopologyTable::entry>&
+  TopologyTable::entries( CollectiveOp op, Scope scope ) const {
+  return entries_[ index( op, scope ) ];
+}
+
+bool TopologyTable::empty() const noexcept {
+  return std::all_of( entries_.begin(), entries_.end(),
+    []( const auto& b ){ return b.empty(); } );
+}
+
+void TopologyTable::save( std::ostream& out ) const {
+
+  for( auto op : { Broadcast, Combine } )
+  for( auto scope : { All, Row, Column } )
+  for( const auto& e : entries( op, scope ) )
+    out << op_name(op) << " " << scope_name(scope) << " " << e.max_bytes << " "
+        << topology_name( e.top ) << "\n";
+
+}
+
+void TopologyTable::save( const std::string& fname ) const {
+
+  std::ofstream out( fname );
+  if( not out ) throw std::runtime_error( "Unable to open " + fname );
+  save( out );
+
+}
+
+TopologyTable TopologyTable::load( std::istream& in ) {
+
+  TopologyTable table;
+
+  std::string line;
+  while( std::getline( in, line ) ) {
+
+    if( line.empty() or line[0] == '#' ) continue;
+
+    std::istringstream ss( line );
+    std::string op, scope, top;
+    std::size_t max_bytes;
+    if( not (ss >> op >> scope >> max_bytes >> top) )
+      throw std::runtime_error( "Malformed topology table entry: " + line );
+
+    table.insert( op_from_string(op), scope_from_string(scope), max_bytes,
+                  topology_from_string(top) );
+
+  }
+
+  return table;
+
+}
+
+TopologyTable TopologyTable::load( const std::string& fname ) {
+
+  std::ifstream in( fname );
+  if( not in ) throw std::runtime_error( "Unable to open " + fname );
+  return load( in );
+
+}
+
+
+
+
+
+const char* topology_name( Topology top ) noexcept {
+  return top == Default ? "default" : detail::type_string( top );
+}
+
+Topology topology_from_string( const std::string& name ) {
+
+  for( auto top : { IRing, DRing, SRing, MRing, Hypercube, Tree,
+                    FullyConnected, Default } )
+    if( name == topology_name( top ) ) return top;
+
+  throw std::runtime_error( "Unknown topology: " + name );
+
+}
+
+
+
+
+
+namespace {
+
+template <typename T>
+double time_collective( const Grid& grid, CollectiveOp op, Scope scope,
+  Topology top, blacs_int M, blacs_int N, int nwarmup, int nrepeat ) {
+
+  std::vector<T> buffer( std::size_t(M) * std::size_t(N), T(1) );
+  const auto [RSRC, CSRC] = detail::scope_origin( grid, scope );
+  const bool is_root = grid.ipr() == RSRC and grid.ipc() == CSRC;
+
+  auto run = [&]() {
+    if( op == Combine )
+      gsum2d( grid, scope, top, M, N, buffer.data(), M );
+    else if( is_root )
+      gebs2d( grid, scope, top, M, N, buffer.data(), M );
+    else
+      gebr2d( grid, scope, top, M, N, buffer.data(), M, RSRC, CSRC );
+  };
+
+  MPI_Barrier( grid.comm() );
+  for( int i = 0; i < nwarmup; ++i ) run();
+
+  MPI_Barrier( grid.comm() );
+  const double start = MPI_Wtime();
+  for( int i = 0; i < nrepeat; ++i ) run();
+  double elapsed = (MPI_Wtime() - start) / std::max( nrepeat, 1 );
+
+  // Every process must obtain the same table
+  MPI_Allreduce( MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, grid.comm() );
+  return elapsed;
+
+}
+
+template <typename T>
+void sample_type( const Grid& grid, char type, const tune_options& opts,
+                  std::vector< tune_sample >& samples ) {
+
+  for( auto op    : opts.ops        )
+  for( auto scope : opts.scopes     )
+  for( auto [M,N] : opts.shapes     )
+  for( auto top   : opts.topologies )
+  if( valid_for( op, top ) ) {
+
+    const double latency = time_collective<T>( grid, op, scope, top, M, N,
+      opts.nwarmup, opts.nrepeat );
+    const std::size_t bytes = std::size_t(M) * std::size_t(N) * sizeof(T);
+
+    samples.push_back( tune_sample{ op, scope, type, M, N, bytes, top, latency,
+      latency > 0. ? bytes / latency : 0. } );
+
+  }
+
+}
+
+}
+
+std::vector< tune_sample > benchmark_topologies( const Grid& grid,
+                                                 const tune_options& opts ) {
+
+  std::vector< tune_sample > samples;
+
+  for( auto type : opts.types )
+  switch( type ) {
+    case 'i': sample_type<blacs_int>( grid, type, opts, samples ); break;
+    case 's': sample_type<float>    ( grid, type, opts, samples ); break;
+    case 'd': sample_type<double>   ( grid, type, opts, samples ); break;
+    case 'c': sample_type<scomplex> ( grid, type, opts, samples ); break;
+    case 'z': sample_type<dcomplex> ( grid, type, opts, samples ); break;
+    default:
+      throw std::runtime_error( std::string("Unknown BLACS type: ") + type );
+  }
+
+  return samples;
+
+}
+
+TopologyTable build_topology_table( const std::vector< tune_sample >& samples ) {
+
+  // (op, scope, bytes) -> topology -> (total latency, count)
+  using key_type = std::tuple< CollectiveOp, Scope, std::size_t >;
+  std::map< key_type, std::map< Topology, std::pair<double,int> > > timings;
+
+  for( const auto& s : samples ) {
+    auto& t = timings[ key_type{ s.op, s.scope, s.bytes } ][ s.top ];
+    t.first  += s.latency;
+    t.second += 1;
+  }
+
+  // Buckets are visited in increasing size per (op, scope): widen the
+  // previous bucket if it selected the same topology
+  std::map< std::pair<CollectiveOp,Scope>, std::vector<TopologyTable::entry> > bkts;
+  for( const auto& [key, tops] : timings ) {
+
+    const auto [op, scope, bytes] = key;
+
+    auto best = std::min_element( tops.begin(), tops.end(),
+      []( const auto& a, const auto& b ) {
+        return a.second.first / a.second.second < b.second.first / b.second.second;
+      } )->first;
+
+    auto& b = bkts[ { op, scope } ];
+    if( not b.empty() and b.back().top == best ) b.back().max_bytes = bytes;
+    else b.push_back( { bytes, best } );
+
+  }
+
+  TopologyTable table;
+  for( const auto& [key, b] : bkts )
+  for( const auto& e : b )
+    table.insert( key.first, key.second, e.max_bytes, e.top );
+
+  return table;
+
+}
+
+TopologyTable tune( const Grid& grid, const tune_options& opts ) {
+  return build_topology_table( benchmark_topologies( grid, opts ) );
+}
+
+}
@@ -0,0 +1,141 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/batch.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Batched Send-Recv", "[batch]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  if( not grid.is_valid() or grid.npr() * grid.npc() < 2 ) return;
+
+  const blacspp::blacs_int M(3), N(2), LDA(5), ntiles(4);
+
+  // Every process sends ntiles strided tiles to its successor in the grid
+  const auto me   = blacspp::coordinate_rank( grid, grid.ipr(), grid.ipc() );
+  const auto np   = grid.npr() * grid.npc();
+  const auto next = blacspp::rank_coordinate( grid, (me + 1)      % np );
+  const auto prev = blacspp::rank_coordinate( grid, (me + np - 1) % np );
+
+  blacspp::MessageBatch batch( grid );
+  CHECK( batch.empty() );
+
+  std::vector< std::vector<TestType> > send( ntiles ), recv( ntiles );
+  for( blacspp::blacs_int t = 0; t < ntiles; ++t ) {
+    send[t].assign( LDA*N, TestType(-1) );
+    for( blacspp::blacs_int j = 0; j < N; ++j )
+    for( blacspp::blacs_int i = 0; i < M; ++i )
+      send[t][i + j*LDA] = TestType( me*100 + t*10 + i + j*M );
+    recv[t].assign( LDA*N, TestType(-2) );
+
+    batch.enqueue( M, N, send[t], LDA, next.first, next.second );
+    batch.expect ( M, N, recv[t], LDA, prev.first, prev.second );
+  }
+
+  // Tiles are packed on enqueue
+  for( auto& s : send ) std::fill( s.begin(), s.end(), TestType(0) );
+  CHECK( batch.pending_bytes( next.first, next.second ) > 0 );
+
+  batch.flush();
+  CHECK( batch.empty() );
+
+  const auto src = blacspp::coordinate_rank( grid, prev.first, prev.second );
+  for( blacspp::blacs_int t = 0; t < ntiles; ++t )
+  for( blacspp::blacs_int j = 0; j < N; ++j )
+  for( blacspp::blacs_int i = 0; i < LDA; ++i )
+    if( i < M ) CHECK( recv[t][i + j*LDA] == TestType( src*100 + t*10 + i + j*M ) );
+    else        CHECK( recv[t][i + j*LDA] == TestType(-2) );
+
+}
+
+
+TEST_CASE( "Batched Send-Recv Mixed Types", "[batch]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  if( not grid.is_valid() or grid.npr() * grid.npc() < 2 ) return;
+
+  const auto me   = blacspp::coordinate_rank( grid, grid.ipr(), grid.ipc() );
+  const auto np   = grid.npr() * grid.npc();
+  const auto next = blacspp::rank_coordinate( grid, (me + 1)      % np );
+  const auto prev = blacspp::rank_coordinate( grid, (me + np - 1) % np );
+  const auto src  = blacspp::coordinate_rank( grid, prev.first, prev.second );
+
+  blacspp::MessageBatch batch( grid );
+
+  std::vector< blacspp::blacs_int > i_send( 3, me ),           i_recv( 3 );
+  std::vector< double >             d_send( 4, me + 0.5 ),     d_recv( 4 );
+  std::vector< blacspp::dcomplex >  z_send( 2, { 1.*me, 2. } ), z_recv( 2 );
+
+  batch.enqueue( i_send, next.first, next.second );
+  batch.enqueue( d_send, next.first, next.second );
+  batch.enqueue( z_send, next.first, next.second );
+
+  batch.expect( i_recv, prev.first, prev.second );
+  batch.expect( d_recv, prev.first, prev.second );
+  batch.expect( z_recv, prev.first, prev.second );
+
+  batch.flush();
+
+  for( auto x : i_recv ) CHECK( x == src );
+  for( auto x : d_recv ) CHECK( x == src + 0.5 );
+  for( auto x : z_recv ) CHECK( x == blacspp::dcomplex( 1.*src, 2. ) );
+
+  SECTION( "Mismatched Recieve Buffer" ) {
+
+    batch.enqueue( d_send, next.first, next.second );
+    batch.expect ( z_recv, prev.first, prev.second );
+    CHECK_THROWS_AS( batch.flush(), std::runtime_error );
+
+  }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Batched Triangular Send-Recv", "[batch]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  if( not grid.is_valid() or grid.npr() * grid.npc() < 2 ) return;
+
+  const blacspp::blacs_int M(4), N(4);
+
+  const auto me   = blacspp::coordinate_rank( grid, grid.ipr(), grid.ipc() );
+  const auto np   = grid.npr() * grid.npc();
+  const auto next = blacspp::rank_coordinate( grid, (me + 1)      % np );
+  const auto prev = blacspp::rank_coordinate( grid, (me + np - 1) % np );
+
+  std::vector< TestType > send( M*N, TestType(1) ), upper( M*N, TestType(0) ), 
+                          lower( M*N, TestType(0) );
+
+  blacspp::MessageBatch batch( grid );
+  batch.enqueue( blacspp::Triangle::Upper, blacspp::Diagonal::NonUnit, M, N, 
+                 send.data(), M, next.first, next.second );
+  batch.enqueue( blacspp::Triangle::Lower, blacspp::Diagonal::Unit, M, N, 
+                 send.data(), M, next.first, next.second );
+
+  batch.expect( blacspp::Triangle::Upper, blacspp::Diagonal::NonUnit, M, N, 
+                upper.data(), M, prev.first, prev.second );
+  batch.expect( blacspp::Triangle::Lower, blacspp::Diagonal::Unit, M, N, 
+                lower.data(), M, prev.first, prev.second );
+
+  batch.flush();
+
+  for( blacspp::blacs_int j = 0; j < N; ++j )
+  for( blacspp::blacs_int i = 0; i < M; ++i ) {
+    CHECK( upper[i + j*M] == TestType( i <= j ? 1 : 0 ) );
+    CHECK( lower[i + j*M] == TestType( i >  j ? 1 : 0 ) );
+  }
+
+}
@@ -229,3 +229,71 @@ BLACSPP_TEMPLATE_TEST_CASE( "Triangular 2D Broadcast", "[broadcast]" ) {
   for( auto x : data_send ) CHECK( x == TestType(mpi.rank()) );
 
 }
+
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "2D Broadcast Topologies", "[broadcast]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(4), N(4);
+
+  std::vector< TestType > data_send( M*N, TestType(mpi.rank()) );
+  std::vector< TestType > data_recv( M*N, TestType(-1) );
+
+  // Broadcast from the last process in the grid
+  const auto rsrc = grid.npr() - 1;
+  const auto csrc = grid.npc() - 1;
+  const auto src_rank = blacspp::coordinate_rank( grid, rsrc, csrc );
+
+  std::array< blacspp::Topology, 8 > tops = {
+    blacspp::Topology::IRing,     blacspp::Topology::DRing,
+    blacspp::Topology::SRing,     blacspp::Topology::MRing,
+    blacspp::Topology::Hypercube, blacspp::Topology::Tree,
+    blacspp::Topology::FullyConnected, blacspp::Topology::Default
+  };
+
+  SECTION( "Explicit Topology" ) {
+
+    for( auto top : tops ) {
+
+      if( grid.ipr() == rsrc and grid.ipc() == csrc ) {
+        blacspp::gebs2d( grid, blacspp::Scope::All, top, M, N, data_send.data(), M );
+        for( auto x : data_recv ) CHECK( x == TestType(-1) );
+      } else {
+        blacspp::gebr2d( grid, blacspp::Scope::All, top, M, N, data_recv.data(), M, rsrc, csrc );
+        for( auto x : data_recv ) CHECK( x == TestType(src_rank) );
+      }
+
+      std::fill( data_recv.begin(), data_recv.end(), TestType(-1) );
+
+    }
+
+  }
+
+  SECTION( "Grid Default Topology" ) {
+
+    CHECK( grid.broadcast_topology() == blacspp::Topology::Default );
+
+    for( auto top : tops ) {
+
+      grid.set_broadcast_topology( top );
+      CHECK( grid.broadcast_topology() == top );
+
+      if( grid.ipr() == rsrc and grid.ipc() == csrc ) {
+        blacspp::gebs2d( grid, blacspp::Scope::All, data_send );
+        for( auto x : data_recv ) CHECK( x == TestType(-1) );
+      } else {
+        blacspp::gebr2d( grid, blacspp::Scope::All, data_recv, rsrc, csrc );
+        for( auto x : data_recv ) CHECK( x == TestType(src_rank) );
+      }
+
+      std::fill( data_recv.begin(), data_recv.end(), TestType(-1) );
+
+    }
+
+  }
+
+}
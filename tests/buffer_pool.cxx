@@ -0,0 +1,119 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/buffer_pool.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/information.hpp>
+#include <cstdint>
+#include <vector>
+
+
+TEST_CASE( "Buffer Pool", "[buffer_pool]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  SECTION( "Reuse" ) {
+
+    blacspp::BufferPool pool( grid );
+
+    void* a = pool.allocate( 1000 );
+    CHECK( reinterpret_cast<std::uintptr_t>(a) % 64 == 0 );
+    CHECK( pool.stats().in_use == 1024 );
+    pool.deallocate( a, 1000 );
+    CHECK( pool.stats().in_use == 0    );
+    CHECK( pool.stats().cached == 1024 );
+
+    // Same size class
+    void* b = pool.allocate( 600 );
+    CHECK( b == a );
+    CHECK( pool.stats().hits   == 1 );
+    CHECK( pool.stats().misses == 1 );
+
+    // Different size class
+    void* c = pool.allocate( 2000 );
+    CHECK( c != a );
+    CHECK( pool.stats().misses == 2 );
+    CHECK( pool.stats().peak   == 1024 + 2048 );
+
+    pool.deallocate( b, 600 );
+    pool.deallocate( c, 2000 );
+
+    pool.release();
+    CHECK( pool.stats().cached   == 0 );
+    CHECK( pool.stats().releases == 1 );
+
+    CHECK( pool.allocate( 0 ) == nullptr );
+
+  }
+
+  SECTION( "High Water" ) {
+
+    blacspp::buffer_pool_options opts;
+    opts.high_water = 4096;
+    opts.alignment  = 256;
+    blacspp::BufferPool pool( grid, opts );
+
+    {
+      auto x = pool.acquire<double>( 256 ); // 2048 B
+      auto y = pool.acquire<double>( 512 ); // 4096 B
+      CHECK( reinterpret_cast<std::uintptr_t>(x.data()) % 256 == 0 );
+    }
+    CHECK( pool.stats().releases == 1 );
+    CHECK( pool.stats().cached   == 0 );
+
+  }
+
+  SECTION( "MPI Memory" ) {
+
+    blacspp::buffer_pool_options opts;
+    opts.mpi_memory = true;
+    blacspp::BufferPool pool( grid, opts );
+
+    auto x = pool.acquire<float>( 100 );
+    CHECK( x.data() != nullptr );
+    CHECK( x.size() == 100 );
+
+  }
+
+  SECTION( "Invalid Alignment" ) {
+
+    blacspp::buffer_pool_options opts;
+    opts.alignment = 48;
+    CHECK_THROWS_AS( blacspp::BufferPool( grid, opts ), std::runtime_error );
+
+  }
+
+}
+
+
+TEST_CASE( "Buffer Pool Send-Recv", "[buffer_pool]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  blacspp::BufferPool pool( grid );
+
+  const int rank_col = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+
+  for( int it = 0; it < 3; ++it ) {
+
+    auto buf = pool.acquire<double>( 16 );
+    if( grid.ipc() == 0 ) {
+      std::fill( buf.begin(), buf.end(), double( mpi.rank() + it ) );
+      for( int i = 1; i < grid.npc(); ++i )
+        blacspp::gesd2d( grid, buf, grid.ipr(), i );
+    } else {
+      blacspp::gerv2d( grid, buf, grid.ipr(), 0 );
+      for( auto x : buf ) CHECK( x == double( rank_col + it ) );
+    }
+
+  }
+
+  CHECK( pool.stats().misses == 1 );
+  CHECK( pool.stats().hits   == 2 );
+
+}
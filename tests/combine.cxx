@@ -0,0 +1,131 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/combine.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "General 2D Sum", "[combine]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(4), N(4);
+
+  std::vector< TestType > data( M*N, TestType(mpi.rank()) );
+
+  const TestType all_sum = TestType( mpi.size() * (mpi.size()-1) / 2 );
+
+  TestType row_sum = TestType(0);
+  for( auto j = 0; j < grid.npc(); ++j )
+    row_sum += TestType( blacspp::coordinate_rank( grid, grid.ipr(), j ) );
+
+  SECTION( "Pointer Interface" ) {
+
+    SECTION( "All" ) {
+      blacspp::gsum2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data.data(), M );
+      for( auto x : data ) CHECK( x == all_sum );
+    }
+
+    SECTION( "Row" ) {
+      blacspp::gsum2d( grid, blacspp::Scope::Row, blacspp::Topology::IRing, M, N, data.data(), M );
+      for( auto x : data ) CHECK( x == row_sum );
+    }
+
+    SECTION( "Destination" ) {
+      blacspp::gsum2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data.data(), M, 0, 0 );
+      if( grid.ipr() == 0 and grid.ipc() == 0 )
+        for( auto x : data ) CHECK( x == all_sum );
+    }
+
+  }
+
+  SECTION( "Container Interface" ) {
+
+    blacspp::gsum2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data, M );
+    for( auto x : data ) CHECK( x == all_sum );
+
+  }
+
+  SECTION( "Abbreviated Container Interface" ) {
+
+    blacspp::gsum2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, data );
+    for( auto x : data ) CHECK( x == all_sum );
+
+  }
+
+  SECTION( "Grid Default Topology" ) {
+
+    grid.set_combine_topology( blacspp::Topology::Hypercube );
+    CHECK( grid.combine_topology() == blacspp::Topology::Hypercube );
+
+    blacspp::gsum2d( grid, blacspp::Scope::All, data );
+    for( auto x : data ) CHECK( x == all_sum );
+
+  }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "General 2D Max/Min", "[combine]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(2), N(2);
+
+  std::vector< TestType > data( M*N, TestType(mpi.rank()) );
+
+  auto max_coord = blacspp::rank_coordinate( grid, mpi.size()-1 );
+
+  SECTION( "Pointer Interface" ) {
+
+    std::vector< blacspp::blacs_int > RA( M*N, -1 ), CA( M*N, -1 );
+    blacspp::gamx2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N,
+      data.data(), M, RA.data(), CA.data(), M, -1, -1 );
+
+    for( auto x : data ) CHECK( x == TestType(mpi.size()-1) );
+    for( auto x : RA   ) CHECK( x == max_coord.first        );
+    for( auto x : CA   ) CHECK( x == max_coord.second       );
+
+  }
+
+  SECTION( "Container Interface" ) {
+
+    SECTION( "Max" ) {
+      blacspp::gamx2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, M, N, data, M );
+      for( auto x : data ) CHECK( x == TestType(mpi.size()-1) );
+    }
+
+    SECTION( "Min" ) {
+      blacspp::gamn2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, data );
+      for( auto x : data ) CHECK( x == TestType(0) );
+    }
+
+  }
+
+  SECTION( "Located Scalar" ) {
+
+    auto mx = blacspp::gamx2d_loc( grid, blacspp::Scope::All, blacspp::Topology::IRing,
+      TestType(mpi.rank()) );
+    CHECK( mx.value == TestType(mpi.size()-1) );
+    CHECK( mx.coordinate == max_coord );
+
+    auto mn = blacspp::gamn2d_loc( grid, blacspp::Scope::Row, blacspp::Topology::IRing,
+      TestType(mpi.rank()) );
+    CHECK( mn.value == TestType( blacspp::coordinate_rank( grid, grid.ipr(), 0 ) ) );
+    CHECK( mn.coordinate == blacspp::process_coordinate( grid.ipr(), 0 ) );
+
+  }
+
+}
@@ -0,0 +1,144 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/compression.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/information.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+TEST_CASE( "Compression Kernels", "[compression]" ) {
+
+  using namespace blacspp;
+
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const std::vector<double> x = { 1., -2.5, 1./3., 1e-3, 1e300, -1e300, inf, nan, 0. };
+  const blacs_int n = x.size();
+
+  CHECK( detail::wire_words( WirePrecision::Float,    n ) == 9 );
+  CHECK( detail::wire_words( WirePrecision::BFloat16, n ) == 5 );
+
+  for( auto precision : { WirePrecision::Float, WirePrecision::BFloat16 } )
+  for( auto policy : { WireErrorPolicy::Nearest, WireErrorPolicy::Saturate } ) {
+
+    // As a (3,3) buffer with padding
+    const blacs_int LDA = 4;
+    std::vector<double> A( LDA*3, -7. ), B( LDA*3, -7. );
+    for( blacs_int j = 0; j < 3; ++j )
+    for( blacs_int i = 0; i < 3; ++i ) A[ i + j*LDA ] = x[ i + j*3 ];
+
+    std::vector<blacs_int> wire( detail::wire_words( precision, n ) );
+    detail::compress_2d( precision, policy, 3, 3, A.data(), LDA, wire.data() );
+    detail::expand_2d( precision, 3, 3, wire.data(), B.data(), LDA );
+
+    const double eps  = precision == WirePrecision::Float ? 6e-8 : 4e-3;
+    const double wmax = precision == WirePrecision::Float ?
+      double( std::numeric_limits<float>::max() ) : 3.3895313892515355e38;
+
+    for( blacs_int j = 0; j < 3; ++j )
+    for( blacs_int i = 0; i < 3; ++i ) {
+      const double a = A[ i + j*LDA ], b = B[ i + j*LDA ];
+      if( std::isnan(a) ) CHECK( std::isnan(b) );
+      else if( std::isinf(a) ) CHECK( b == a );
+      else if( std::abs(a) > wmax ) {
+        if( policy == WireErrorPolicy::Saturate ) CHECK( b == std::copysign( wmax, a ) );
+        else CHECK( b == std::copysign( inf, a ) );
+      }
+      else CHECK( std::abs( b - a ) <= eps * std::abs(a) );
+    }
+    CHECK( B[3] == -7. ); // Padding untouched
+
+  }
+
+}
+
+TEST_CASE( "Compressed Transfers", "[compression]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(5), N(3), LDA(7);
+  const int root = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+
+  // Exactly representable in bfloat16
+  auto value = []( int rank, blacspp::blacs_int i ) { return 0.25 * ( rank * 8 + i ); };
+
+  for( auto precision : { blacspp::WirePrecision::Float, blacspp::WirePrecision::BFloat16 } ) {
+
+    blacspp::compression_options opts;
+    opts.precision = precision;
+    opts.min_bytes = 0;
+    grid.enable_compression( opts );
+    REQUIRE( grid.compression() );
+
+    // Point-to-point from the first process column
+    std::vector< double > A( LDA*N, -1. );
+    if( grid.ipc() == 0 )
+      for( blacspp::blacs_int j = 0; j < N; ++j )
+      for( blacspp::blacs_int i = 0; i < M; ++i ) A[ i + j*LDA ] = value( mpi.rank(), i + j*M );
+
+    if( grid.ipc() == 0 )
+      for( int c = 1; c < grid.npc(); ++c )
+        blacspp::gesd2d( grid, M, N, A.data(), LDA, grid.ipr(), c );
+    else
+      blacspp::gerv2d( grid, M, N, A.data(), LDA, grid.ipr(), 0 );
+
+    for( blacspp::blacs_int j = 0; j < N;   ++j )
+    for( blacspp::blacs_int i = 0; i < LDA; ++i )
+      CHECK( A[ i + j*LDA ] == ( i < M ? value( root, i + j*M ) : -1. ) );
+
+    // Complex broadcast over the process rows
+    std::vector< blacspp::dcomplex > Z( LDA*N, blacspp::dcomplex( -1., -1. ) );
+    if( grid.ipc() == 0 )
+      for( blacspp::blacs_int j = 0; j < N; ++j )
+      for( blacspp::blacs_int i = 0; i < M; ++i )
+        Z[ i + j*LDA ] = blacspp::dcomplex( value( mpi.rank(), i ), -value( mpi.rank(), j ) );
+
+    if( grid.ipc() == 0 )
+      blacspp::gebs2d( grid, blacspp::Scope::Row, M, N, Z.data(), LDA );
+    else
+      blacspp::gebr2d( grid, blacspp::Scope::Row, M, N, Z.data(), LDA, grid.ipr(), 0 );
+
+    for( blacspp::blacs_int j = 0; j < N;   ++j )
+    for( blacspp::blacs_int i = 0; i < LDA; ++i )
+      CHECK( Z[ i + j*LDA ] == ( i < M ?
+        blacspp::dcomplex( value( root, i ), -value( root, j ) ) :
+        blacspp::dcomplex( -1., -1. ) ) );
+
+    const auto& stats = grid.compression()->stats();
+    if( grid.npc() > 1 ) {
+      CHECK( stats.compressed >= 2 );
+      const std::size_t ratio = precision == blacspp::WirePrecision::Float ? 2 : 4;
+      CHECK( stats.wire_bytes * ratio <= stats.bytes + ratio * sizeof(blacspp::blacs_int) * stats.compressed );
+    }
+
+  }
+
+  SECTION( "Below Threshold" ) {
+
+    // Small payloads are sent in full precision
+    blacspp::compression_options opts;
+    grid.enable_compression( opts );
+
+    double x = grid.ipc() == 0 ? 1. / 3. : -1.;
+    if( grid.ipc() == 0 )
+      blacspp::gebs2d( grid, blacspp::Scope::Row, 1, 1, &x, 1 );
+    else
+      blacspp::gebr2d( grid, blacspp::Scope::Row, 1, 1, &x, 1, grid.ipr(), 0 );
+    CHECK( x == 1. / 3. );
+    CHECK( grid.compression()->stats().compressed == 0 );
+
+    grid.disable_compression();
+    CHECK( not grid.compression() );
+
+  }
+
+}
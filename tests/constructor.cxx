@@ -6,6 +6,8 @@
  */
 #include <catch2/catch.hpp>
 #include <blacspp/grid.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
 
 
 TEST_CASE( "Default Constructor", "[constructor]" ) {
@@ -49,6 +51,31 @@ TEST_CASE( "Copy Constructor", "[constructor]" ) {
 
 }
 
+TEST_CASE( "Default Topologies", "[constructor]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  CHECK( grid.broadcast_topology() == blacspp::Topology::Default );
+  CHECK( grid.combine_topology()   == blacspp::Topology::Default );
+
+  grid.set_broadcast_topology( blacspp::Topology::Hypercube );
+  grid.set_combine_topology(   blacspp::Topology::Tree      );
+
+  blacspp::Grid grid2( grid );
+  CHECK( grid2.broadcast_topology() == blacspp::Topology::Hypercube );
+  CHECK( grid2.combine_topology()   == blacspp::Topology::Tree      );
+
+  blacspp::Grid grid3( std::move(grid2) );
+  CHECK( grid3.broadcast_topology() == blacspp::Topology::Hypercube );
+  CHECK( grid3.combine_topology()   == blacspp::Topology::Tree      );
+
+  // BLACS only supports the ring topologies for broadcasts
+  CHECK_THROWS( grid3.set_combine_topology( blacspp::Topology::SRing ) );
+  CHECK_THROWS( grid3.set_combine_topology( blacspp::Topology::MRing ) );
+  CHECK( grid3.combine_topology() == blacspp::Topology::Tree );
+
+}
+
 TEST_CASE( "Move Constructor", "[constructor]" ) {
 
   blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
@@ -73,3 +100,271 @@ TEST_CASE( "Move Constructor", "[constructor]" ) {
   CHECK( context == grid2.context() );
 
 }
+
+TEST_CASE( "Clone", "[constructor]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  grid.set_broadcast_topology( blacspp::Topology::Tree );
+
+  blacspp::Grid grid2 = grid.clone();
+
+  REQUIRE( grid2.is_valid() );
+  CHECK( grid.npr()  == grid2.npr()  );
+  CHECK( grid.npc()  == grid2.npc()  );
+  CHECK( grid.ipr()  == grid2.ipr()  );
+  CHECK( grid.ipc()  == grid2.ipc()  );
+  CHECK( grid.comm() == grid2.comm() );
+  CHECK( grid.context() != grid2.context() );
+  CHECK( grid2.broadcast_topology() == blacspp::Topology::Tree );
+
+  blacspp::Grid invalid;
+  CHECK( not invalid.clone().is_valid() );
+
+}
+
+TEST_CASE( "Sub-Grids", "[constructor]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  SECTION( "Row Grid" ) {
+
+    auto row = grid.row_grid();
+    REQUIRE( row.is_valid() );
+    CHECK( row.npr() == 1          );
+    CHECK( row.npc() == grid.npc() );
+    CHECK( row.ipr() == 0          );
+    CHECK( row.ipc() == grid.ipc() );
+
+    int size; MPI_Comm_size( row.comm(), &size );
+    CHECK( size == grid.npc() );
+
+    int rank; MPI_Comm_rank( row.comm(), &rank );
+    CHECK( row.comm_rank( 0, row.ipc() ) == rank );
+
+  }
+
+  SECTION( "Cached Row / Column Grids" ) {
+
+    blacspp::blacs_int row_ctx, col_ctx;
+    MPI_Comm           row_comm;
+
+    {
+      // Repeated calls share the communicator and context of the first
+      auto row  = grid.row_grid();
+      auto row2 = grid.row_grid();
+      REQUIRE( row2.is_valid() );
+      CHECK( row2.context() == row.context() );
+      CHECK( row2.comm()    == row.comm()    );
+      CHECK( row2.ipc()     == grid.ipc()    );
+      row_ctx  = row.context();
+      row_comm = row.comm();
+
+      auto col  = grid.col_grid();
+      auto col2 = grid.col_grid();
+      REQUIRE( col2.is_valid() );
+      CHECK( col2.context() == col.context() );
+      CHECK( col2.comm()    == col.comm()    );
+      CHECK( col2.ipr()     == grid.ipr()    );
+      col_ctx = col.context();
+    }
+
+    // The cache outlives the returned grids
+    auto row = grid.row_grid();
+    CHECK( row.context() == row_ctx  );
+    CHECK( row.comm()    == row_comm );
+    CHECK( grid.col_grid().context() == col_ctx );
+
+    // Topology settings of the parent are applied at every call
+    grid.set_broadcast_topology( blacspp::Topology::Tree );
+    CHECK( grid.row_grid().broadcast_topology() == blacspp::Topology::Tree );
+
+    // Clones do not inherit the cache
+    auto clone = grid.clone();
+    CHECK( clone.row_grid().context() != row.context() );
+
+  }
+
+  SECTION( "Column Grid" ) {
+
+    auto col = grid.col_grid();
+    REQUIRE( col.is_valid() );
+    CHECK( col.npr() == grid.npr() );
+    CHECK( col.npc() == 1          );
+    CHECK( col.ipr() == grid.ipr() );
+    CHECK( col.ipc() == 0          );
+
+    // Clones of sub-grids only involve the processes of the sub-grid
+    auto clone = col.clone();
+    CHECK( clone.is_valid() );
+    CHECK( clone.context() != col.context() );
+
+  }
+
+  SECTION( "Block" ) {
+
+    auto sub = grid.subgrid( 0, 1, 0, grid.npc() );
+    CHECK( sub.npr() == 1          );
+    CHECK( sub.npc() == grid.npc() );
+    CHECK( sub.comm() == grid.comm() );
+
+    if( grid.ipr() == 0 ) {
+      REQUIRE( sub.is_valid() );
+      CHECK( sub.ipr() == 0 );
+      CHECK( sub.ipc() == grid.ipc() );
+    } else CHECK( not sub.is_valid() );
+
+    for( auto j = 0; j < sub.npc(); ++j )
+      CHECK( sub.comm_rank( 0, j ) == grid.comm_rank( 0, j ) );
+
+    // Nested construction (non-members participate) 
+    auto nested = sub.subgrid( 0, 1, 0, 1 );
+    CHECK( nested.is_valid() == (mpi.rank() == grid.comm_rank(0,0)) );
+
+    auto copy( sub );
+    CHECK( copy.is_valid() == sub.is_valid() );
+
+    CHECK_THROWS( grid.subgrid( 0, grid.npr()+1, 0, 1 ) );
+    CHECK_THROWS( grid.subgrid( 1, 1, 0, 1 ) );
+
+  }
+
+}
+
+TEST_CASE( "Grid Ordering", "[constructor]" ) {
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+  const blacspp::blacs_int npr = mpi.size() % 2 ? 1 : 2;
+  const blacspp::blacs_int npc = mpi.size() / npr;
+
+  SECTION( "Column Major" ) {
+
+    blacspp::Grid grid( MPI_COMM_WORLD, npr, npc, blacspp::ColumnMajor );
+    REQUIRE( grid.is_valid() );
+    CHECK( grid.ipr() == mpi.rank() % npr );
+    CHECK( grid.ipc() == mpi.rank() / npr );
+    CHECK( grid.comm_rank( grid.ipr(), grid.ipc() ) == mpi.rank() );
+
+  }
+
+  SECTION( "Process Map" ) {
+
+    // Reverse rank order
+    std::vector< blacspp::blacs_int > pmap( mpi.size() );
+    for( auto i = 0; i < mpi.size(); ++i ) pmap[i] = mpi.size() - i - 1;
+
+    blacspp::Grid grid( MPI_COMM_WORLD, npr, npc, pmap );
+    REQUIRE( grid.is_valid() );
+
+    const auto idx = mpi.size() - mpi.rank() - 1;
+    CHECK( grid.ipr() == idx % npr );
+    CHECK( grid.ipc() == idx / npr );
+    CHECK( grid.comm_rank( grid.ipr(), grid.ipc() ) == mpi.rank() );
+
+    pmap[0] = pmap[1];
+    CHECK_THROWS( blacspp::Grid( MPI_COMM_WORLD, npr, npc, pmap ) );
+
+  }
+
+}
+
+TEST_CASE( "Node Aware Grid", "[constructor]" ) {
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  for( auto locality : { blacspp::Row, blacspp::Column } ) {
+
+    blacspp::node_hint hint;
+    hint.locality = locality;
+
+    auto grid = blacspp::Grid::node_aware_grid( MPI_COMM_WORLD, hint );
+    REQUIRE( grid.is_valid() );
+    CHECK( grid.npr() * grid.npc() == mpi.size() );
+    CHECK( grid.comm_rank( grid.ipr(), grid.ipc() ) == mpi.rank() );
+
+    // Groups of the requested scope never span more nodes than the grid
+    auto loc = grid.locality();
+    CHECK( loc.nnodes >= 1 );
+    if( locality == blacspp::Row ) CHECK( loc.row    >= loc.all );
+    else                           CHECK( loc.column >= loc.all );
+
+  }
+
+  blacspp::node_hint hint;
+  hint.npr = 1;
+  auto grid = blacspp::Grid::node_aware_grid( MPI_COMM_WORLD, hint );
+  CHECK( grid.npr() == 1 );
+  CHECK( grid.npc() == mpi.size() );
+
+  // Explicit dimensions are never replaced by automatic ones
+  hint.npr = mpi.size() + 1;
+  CHECK_THROWS( blacspp::Grid::node_aware_grid( MPI_COMM_WORLD, hint ) );
+  hint.npr = 0;
+  hint.npc = mpi.size() + 1;
+  CHECK_THROWS( blacspp::Grid::node_aware_grid( MPI_COMM_WORLD, hint ) );
+  hint.npc = 0;
+
+  hint.locality = blacspp::All;
+  CHECK_THROWS( blacspp::Grid::node_aware_grid( MPI_COMM_WORLD, hint ) );
+
+}
+
+TEST_CASE( "Grid Cache", "[constructor]" ) {
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+  const blacspp::blacs_int np = mpi.size();
+
+  const auto stats0 = blacspp::Grid::cache_stats();
+  {
+
+    auto g1 = blacspp::Grid::cached( MPI_COMM_WORLD, 1, np );
+    auto g2 = blacspp::Grid::cached( MPI_COMM_WORLD, 1, np );
+    REQUIRE( g1.is_valid() );
+    REQUIRE( g2.is_valid() );
+
+    // Shared context, distinct grid objects
+    CHECK( g1.context() == g2.context() );
+    CHECK( g2.ipc() == mpi.rank() );
+
+    // Distinct shapes and clones obtain distinct contexts
+    auto g3 = blacspp::Grid::cached( MPI_COMM_WORLD, np, 1 );
+    auto g5 = g1.clone();
+    if( np > 1 ) CHECK( g3.context() != g1.context() );
+    CHECK( g5.context() != g1.context() );
+    CHECK( g3.ipr() == mpi.rank() );
+
+    // Orderings which yield the same process map share the context
+    auto g4 = blacspp::Grid::cached( MPI_COMM_WORLD, 1, np, blacspp::ColumnMajor );
+    CHECK( g4.context() == g1.context() );
+
+    // Equivalent process map of g1 (row-major 1 x np)
+    std::vector<blacspp::blacs_int> pmap( np );
+    for( blacspp::blacs_int i = 0; i < np; ++i ) pmap[i] = i;
+    auto g6 = blacspp::Grid::cached( MPI_COMM_WORLD, 1, np, pmap );
+    CHECK( g6.context() == g1.context() );
+
+    const auto stats = blacspp::Grid::cache_stats();
+    CHECK( stats.misses - stats0.misses == ( np > 1 ? 2 : 1 ) );
+    CHECK( stats.hits   - stats0.hits   == ( np > 1 ? 3 : 4 ) );
+    CHECK( stats.live   - stats0.live   == stats.misses - stats0.misses );
+
+    // Moved-from grids release their reference
+    {
+      auto g7( std::move( g2 ) );
+      CHECK( g7.context() == g1.context() );
+    }
+    CHECK( g1.is_valid() );
+
+    // Collective communication over the shared context
+    blacspp::blacs_int x = 1;
+    MPI_Allreduce( MPI_IN_PLACE, &x, 1, MPI_INT, MPI_SUM, g1.comm() );
+    CHECK( x == np );
+
+    CHECK_THROWS( blacspp::Grid::cached( MPI_COMM_WORLD, np, 2 ) );
+
+  }
+
+  // Released with the last grid
+  CHECK( blacspp::Grid::cache_stats().live == stats0.live );
+
+}
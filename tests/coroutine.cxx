@@ -0,0 +1,133 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/coroutine.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+
+namespace {
+
+  blacspp::Task<int> answer() { co_return 42; }
+
+  blacspp::Task<int> twice() {
+    const int a = co_await answer();
+    co_return 2 * a;
+  }
+
+  blacspp::Task<> fail() {
+    throw std::runtime_error("Task");
+    co_return;
+  }
+
+  // Exchange tile k along the process rows
+  blacspp::Task<> exchange( const blacspp::Grid& grid, int k, const double* send,
+    double* recv, blacspp::blacs_int M ) {
+
+    const auto right = ( grid.ipc() + 1 ) % grid.npc();
+    const auto left  = ( grid.ipc() + grid.npc() - 1 ) % grid.npc();
+
+    auto r = blacspp::async_gerv2d( grid, M, 1, recv, M, grid.ipr(), left, k );
+    co_await blacspp::async_gesd2d( grid, M, 1, send, M, grid.ipr(), right, k );
+    co_await r;
+
+  }
+
+  blacspp::Task<> broadcast( const blacspp::Grid& grid, int k, double* A,
+    blacspp::blacs_int M ) {
+    if( grid.ipc() == 0 )
+      co_await blacspp::async_gebs2d( grid, blacspp::Scope::Row, M, 1, A, M, k );
+    else
+      co_await blacspp::async_gebr2d( grid, blacspp::Scope::Row, M, 1, A, M,
+                                      grid.ipr(), 0, k );
+  }
+
+  struct flag_receiver {
+    bool* value;
+    bool* error;
+    void set_value() && noexcept { *value = true; }
+    void set_error( std::exception_ptr ) && noexcept { *error = true; }
+  };
+
+}
+
+
+TEST_CASE( "Coroutines", "[coroutine]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  SECTION( "No Engine" ) {
+    double x = 0.;
+    CHECK_THROWS( blacspp::async_gesd2d( grid, 1, 1, &x, 1, 0, 0 ) );
+  }
+
+  grid.enable_progress();
+  auto& engine = *grid.progress();
+
+  SECTION( "Task" ) {
+    CHECK( blacspp::sync_wait( engine, twice() ) == 84 );
+    CHECK_THROWS( blacspp::sync_wait( engine, fail() ) );
+  }
+
+  // With a progress thread, coroutines are resumed by the thread
+  std::vector< blacspp::ProgressMode > modes = { blacspp::ProgressMode::Polling };
+  if( grid.thread_multiple() ) modes.push_back( blacspp::ProgressMode::Thread );
+
+  SECTION( "Tiles" )
+  for( auto mode : modes ) {
+
+    blacspp::progress_options opts;
+    opts.mode = mode;
+    grid.enable_progress( opts );
+    auto& engine = *grid.progress();
+
+    // Many outstanding transfers as coroutines
+    const int ntile = 200;
+    const blacspp::blacs_int M(4);
+    const int src = blacspp::coordinate_rank( grid, grid.ipr(),
+      ( grid.ipc() + grid.npc() - 1 ) % grid.npc() );
+
+    std::vector<double> send( ntile * M ), recv( ntile * M, -1. ), bcast( ntile * M, -1. );
+    for( int i = 0; i < ntile * M; ++i ) send[i] = mpi.rank() * 10000 + i;
+    if( grid.ipc() == 0 ) bcast = send;
+
+    std::vector< blacspp::Task<> > tasks;
+    for( int k = 0; k < ntile; ++k ) {
+      tasks.emplace_back( exchange( grid, k, send.data() + k*M, recv.data() + k*M, M ) );
+      tasks.emplace_back( broadcast( grid, k, bcast.data() + k*M, M ) );
+    }
+    blacspp::sync_wait( engine, tasks );
+    CHECK( engine.pending() == 0 );
+
+    const int root = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+    for( int i = 0; i < ntile * M; ++i ) {
+      CHECK( recv[i]  == src  * 10000 + i );
+      CHECK( bcast[i] == root * 10000 + i );
+    }
+
+  }
+
+  SECTION( "Sender" ) {
+
+    double x = mpi.rank(), y = -1.;
+    bool recv_done = false, send_done = false, error = false;
+
+    auto rop = blacspp::async_gerv2d( grid, 1, 1, &y, 1, grid.ipr(), grid.ipc() )
+      .connect( flag_receiver{ &recv_done, &error } );
+    auto sop = blacspp::async_gesd2d( grid, 1, 1, &x, 1, grid.ipr(), grid.ipc() )
+      .connect( flag_receiver{ &send_done, &error } );
+    rop.start();
+    sop.start();
+
+    while( not ( recv_done and send_done ) ) engine.poll();
+    CHECK( not error );
+    CHECK( y == mpi.rank() );
+
+  }
+
+}
@@ -0,0 +1,156 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+TEST_CASE( "Datatype Cache", "[datatype]" ) {
+
+  blacspp::DatatypeCache cache( 2 );
+  CHECK( cache.capacity() == 2 );
+
+  const auto a = blacspp::detail::general_key<double>( 3, 4, 5 );
+  const auto b = blacspp::detail::trapezoid_key<double>( blacspp::Triangle::Upper,
+    blacspp::Diagonal::Unit, 3, 4, 5 );
+  const auto c = blacspp::detail::general_key<float>( 3, 4, 5 );
+
+  auto ta = cache.get( a, MPI_DOUBLE );
+  cache.get( b, MPI_DOUBLE );
+  CHECK( cache.get( a, MPI_DOUBLE ) == ta );
+  CHECK( cache.size()   == 2 );
+  CHECK( cache.hits()   == 1 );
+  CHECK( cache.misses() == 2 );
+
+  // b is the least recently used
+  cache.get( c, MPI_FLOAT );
+  CHECK( cache.size() == 2 );
+  cache.get( a, MPI_DOUBLE );
+  CHECK( cache.hits() == 2 );
+  cache.get( b, MPI_DOUBLE );
+  CHECK( cache.misses() == 4 );
+
+  int size;
+  MPI_Type_size( cache.get( b, MPI_DOUBLE ), &size );
+  CHECK( size == 6 * sizeof(double) ); // 0 + 1 + 2 + 3 elements
+
+  cache.clear();
+  CHECK( cache.size() == 0 );
+
+  CHECK_THROWS_AS( cache.get( blacspp::detail::general_key<double>( 3, 4, 2 ), 
+    MPI_DOUBLE ), std::runtime_error );
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Datatype Transport Send-Recv", "[datatype]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  grid.enable_datatype_transport();
+  REQUIRE( grid.datatype_transport() );
+
+  const blacspp::blacs_int M(4), N(4), LDA(6);
+
+  std::vector< TestType > data( LDA*N, TestType(-1) );
+  const int rank_col = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+
+  SECTION( "General" ) {
+
+    for( int it = 0; it < 2; ++it ) {
+      if( grid.ipc() == 0 ) {
+        std::fill( data.begin(), data.end(), TestType( mpi.rank() ) );
+        for( int i = 1; i < grid.npc(); ++i )
+          blacspp::gesd2d( grid, M, N, data.data(), LDA, grid.ipr(), i );
+      } else {
+        blacspp::gerv2d( grid, M, N, data.data(), LDA, grid.ipr(), 0 );
+        for( blacspp::blacs_int j = 0; j < N;   ++j )
+        for( blacspp::blacs_int i = 0; i < LDA; ++i )
+          CHECK( data[i + j*LDA] == TestType( i < M ? rank_col : -1 ) );
+      }
+    }
+
+    if( grid.ipc() != 0 ) {
+      CHECK( grid.datatype_transport()->cache().misses() == 1 );
+      CHECK( grid.datatype_transport()->cache().hits()   == 1 );
+    }
+
+  }
+
+  SECTION( "Triangular" ) {
+
+    if( grid.ipc() == 0 ) {
+      std::fill( data.begin(), data.end(), TestType( mpi.rank() ) );
+      for( int i = 1; i < grid.npc(); ++i )
+        blacspp::trsd2d( grid, blacspp::Triangle::Lower, blacspp::Diagonal::NonUnit,
+          M, N, data.data(), LDA, grid.ipr(), i );
+    } else {
+      blacspp::trrv2d( grid, blacspp::Triangle::Lower, blacspp::Diagonal::NonUnit,
+        M, N, data.data(), LDA, grid.ipr(), 0 );
+      for( blacspp::blacs_int j = 0; j < N;   ++j )
+      for( blacspp::blacs_int i = 0; i < LDA; ++i )
+        CHECK( data[i + j*LDA] == TestType( (i < M and i >= j) ? rank_col : -1 ) );
+    }
+
+  }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Datatype Transport Broadcast", "[datatype]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  grid.enable_datatype_transport( 4 );
+
+  const blacspp::blacs_int M(3), N(3), LDA(4);
+  std::vector< TestType > data( LDA*N, TestType(-1) );
+
+  SECTION( "Row" ) {
+
+    const int root = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+    if( grid.ipc() == 0 ) {
+      std::fill( data.begin(), data.end(), TestType( mpi.rank() ) );
+      blacspp::gebs2d( grid, blacspp::Scope::Row, blacspp::Topology::Default, 
+        M, N, data.data(), LDA );
+    } else {
+      blacspp::gebr2d( grid, blacspp::Scope::Row, blacspp::Topology::Default, 
+        M, N, data.data(), LDA, grid.ipr(), 0 );
+      for( blacspp::blacs_int j = 0; j < N;   ++j )
+      for( blacspp::blacs_int i = 0; i < LDA; ++i )
+        CHECK( data[i + j*LDA] == TestType( i < M ? root : -1 ) );
+    }
+
+  }
+
+  SECTION( "All Triangular" ) {
+
+    const auto RSRC = grid.npr() - 1, CSRC = grid.npc() - 1;
+    const int root = blacspp::coordinate_rank( grid, RSRC, CSRC );
+    if( grid.ipr() == RSRC and grid.ipc() == CSRC ) {
+      std::fill( data.begin(), data.end(), TestType( mpi.rank() ) );
+      blacspp::trbs2d( grid, blacspp::Scope::All, blacspp::Topology::Default, 
+        blacspp::Triangle::Upper, blacspp::Diagonal::Unit, M, N, data.data(), LDA );
+    } else {
+      blacspp::trbr2d( grid, blacspp::Scope::All, blacspp::Topology::Default, 
+        blacspp::Triangle::Upper, blacspp::Diagonal::Unit, M, N, data.data(), LDA,
+        RSRC, CSRC );
+      for( blacspp::blacs_int j = 0; j < N;   ++j )
+      for( blacspp::blacs_int i = 0; i < LDA; ++i )
+        CHECK( data[i + j*LDA] == TestType( (i < M and i < j) ? root : -1 ) );
+    }
+
+  }
+
+}
@@ -0,0 +1,90 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+TEST_CASE( "Device Pointer Detection", "[device]" ) {
+
+  std::vector<double> host( 10 );
+  CHECK( not blacspp::is_device_pointer( host.data() ) );
+  CHECK( not blacspp::is_device_pointer( nullptr ) );
+
+  if( not blacspp::device_support() ) CHECK( not blacspp::device_aware_mpi() );
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Device Transport", "[device]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  // Two columns per block
+  const blacspp::blacs_int M(3), N(5), LDA(4);
+  grid.enable_device_transport( 2 * M * sizeof(TestType) );
+  REQUIRE( grid.device_transport() );
+
+  std::vector< TestType > data( LDA*N, TestType(-1) );
+  auto fill = [&]() {
+    for( blacspp::blacs_int j = 0; j < N; ++j )
+    for( blacspp::blacs_int i = 0; i < M; ++i )
+      data[i + j*LDA] = TestType( mpi.rank() * 100 + i + j*M );
+  };
+  auto check = [&]( int src ) {
+    for( blacspp::blacs_int j = 0; j < N;   ++j )
+    for( blacspp::blacs_int i = 0; i < LDA; ++i )
+      CHECK( data[i + j*LDA] == TestType( i < M ? src * 100 + i + j*M : -1 ) );
+  };
+
+  SECTION( "Send-Recv" ) {
+
+    if( grid.ipc() == 0 ) {
+      fill();
+      for( int i = 1; i < grid.npc(); ++i )
+        blacspp::gesd2d( grid, M, N, data.data(), LDA, grid.ipr(), i );
+    } else {
+      blacspp::gerv2d( grid, M, N, data.data(), LDA, grid.ipr(), 0 );
+      check( blacspp::coordinate_rank( grid, grid.ipr(), 0 ) );
+      CHECK( grid.device_transport()->stats().host == 1 );
+    }
+
+  }
+
+  SECTION( "Broadcast" ) {
+
+    const auto RSRC = grid.npr() - 1, CSRC = grid.npc() - 1;
+    if( grid.ipr() == RSRC and grid.ipc() == CSRC ) {
+      fill();
+      blacspp::gebs2d( grid, blacspp::Scope::All, blacspp::Topology::Default, 
+        M, N, data.data(), LDA );
+    } else {
+      blacspp::gebr2d( grid, blacspp::Scope::All, blacspp::Topology::Default, 
+        M, N, data.data(), LDA, RSRC, CSRC );
+      check( blacspp::coordinate_rank( grid, RSRC, CSRC ) );
+    }
+
+    std::fill( data.begin(), data.end(), TestType(-1) );
+    if( grid.ipc() == 0 ) {
+      fill();
+      blacspp::gebs2d( grid, blacspp::Scope::Row, blacspp::Topology::Default, 
+        M, N, data.data(), LDA );
+    } else {
+      blacspp::gebr2d( grid, blacspp::Scope::Row, blacspp::Topology::Default, 
+        M, N, data.data(), LDA, grid.ipr(), 0 );
+      check( blacspp::coordinate_rank( grid, grid.ipr(), 0 ) );
+    }
+
+  }
+
+}
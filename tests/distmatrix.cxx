@@ -0,0 +1,122 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/distmatrix.hpp>
+#include <blacspp/combine.hpp>
+#include <cstdint>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+TEST_CASE( "Block-Cyclic Index Maps", "[distmatrix]" ) {
+
+  // 10 elements, blocks of 3, 2 processes, first block on process 1
+  //   global : 0 1 2 | 3 4 5 | 6 7 8 | 9
+  //   owner  : 1 1 1 | 0 0 0 | 1 1 1 | 0
+  static_assert( blacspp::numroc( 10, 3, 0, 1, 2 ) == 4 );
+  static_assert( blacspp::numroc( 10, 3, 1, 1, 2 ) == 6 );
+  static_assert( blacspp::indxg2p( 4, 3, 1, 2 ) == 0 );
+  static_assert( blacspp::indxg2l( 7, 3, 2 ) == 4 );
+  static_assert( blacspp::indxl2g( 3, 3, 0, 1, 2 ) == 9 );
+
+  for( blacspp::blacs_int nprocs : { 1, 2, 3, 5 } )
+  for( blacspp::blacs_int nb     : { 1, 2, 4 } )
+  for( blacspp::blacs_int isrc = 0; isrc < nprocs; ++isrc ) {
+
+    const blacspp::blacs_int n = 23;
+    std::vector< blacspp::blacs_int > count( nprocs, 0 );
+    for( blacspp::blacs_int ig = 0; ig < n; ++ig ) {
+      const auto p  = blacspp::indxg2p( ig, nb, isrc, nprocs );
+      const auto il = blacspp::indxg2l( ig, nb, nprocs );
+      CHECK( il == count[p] );
+      CHECK( blacspp::indxl2g( il, nb, p, isrc, nprocs ) == ig );
+      count[p]++;
+    }
+
+    for( blacspp::blacs_int p = 0; p < nprocs; ++p )
+      CHECK( blacspp::numroc( n, nb, p, isrc, nprocs ) == count[p] );
+
+  }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Distributed Matrix", "[distmatrix]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(13), N(9), MB(2), NB(3);
+  blacspp::DistMatrix< TestType > A( grid, M, N, MB, NB, 0, grid.npc() - 1 );
+
+  SECTION( "Local Storage" ) {
+
+    CHECK( A.local_m() == blacspp::numroc( M, MB, grid.ipr(), 0, grid.npr() ) );
+    CHECK( A.local_n() == blacspp::numroc( N, NB, grid.ipc(), grid.npc()-1, grid.npc() ) );
+    CHECK( A.lda() >= std::max( A.local_m(), 1 ) );
+    CHECK( (A.lda() * sizeof(TestType)) % blacspp::distmatrix_alignment == 0 );
+    if( A.local_n() )
+      CHECK( reinterpret_cast<std::uintptr_t>( A.data() ) % 
+             blacspp::distmatrix_alignment == 0 );
+
+    // Local sizes cover the matrix
+    blacspp::blacs_int nelem = A.local_m() * A.local_n();
+    blacspp::gsum2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, 1, 1, 
+                     &nelem, 1 );
+    CHECK( nelem == M * N );
+
+  }
+
+  SECTION( "Descriptor" ) {
+
+    const auto desc = A.desc();
+    CHECK( desc[blacspp::DTYPE_] == 1 );
+    CHECK( desc[blacspp::CTXT_]  == grid.context() );
+    CHECK( desc[blacspp::M_]     == M );
+    CHECK( desc[blacspp::N_]     == N );
+    CHECK( desc[blacspp::MB_]    == MB );
+    CHECK( desc[blacspp::NB_]    == NB );
+    CHECK( desc[blacspp::RSRC_]  == 0 );
+    CHECK( desc[blacspp::CSRC_]  == grid.npc() - 1 );
+    CHECK( desc[blacspp::LLD_]   == A.lda() );
+
+  }
+
+  SECTION( "Index Maps" ) {
+
+    for( blacspp::blacs_int jl = 0; jl < A.local_n(); ++jl )
+    for( blacspp::blacs_int il = 0; il < A.local_m(); ++il ) {
+      const auto [i, j] = A.local_to_global( il, jl );
+      CHECK( A.is_local( i, j ) );
+      const auto loc = A.global_to_local( i, j );
+      CHECK( loc.owner == blacspp::process_coordinate( grid.ipr(), grid.ipc() ) );
+      CHECK( loc.i == il );
+      CHECK( loc.j == jl );
+    }
+
+  }
+
+  SECTION( "Local Iteration" ) {
+
+    A.for_each_local( [&]( auto i, auto j, TestType& x ) { x = TestType( i + j*M ); } );
+
+    for( blacspp::blacs_int jl = 0; jl < A.local_n(); ++jl )
+    for( blacspp::blacs_int il = 0; il < A.local_m(); ++il ) {
+      const auto [i, j] = A.local_to_global( il, jl );
+      CHECK( A(il,jl) == TestType( i + j*M ) );
+    }
+
+  }
+
+  SECTION( "Invalid Arguments" ) {
+    CHECK_THROWS( blacspp::DistMatrix< TestType >( grid, -1, N, MB, NB ) );
+    CHECK_THROWS( blacspp::DistMatrix< TestType >( grid, M, N, 0, NB ) );
+    CHECK_THROWS( blacspp::DistMatrix< TestType >( grid, M, N, MB, NB, grid.npr() ) );
+  }
+
+}
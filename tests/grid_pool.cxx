@@ -0,0 +1,109 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/grid_pool.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/information.hpp>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE( "Grid Pool", "[grid_pool]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  int level;
+  MPI_Query_thread( &level );
+  CHECK( mpi.thread_level() == level );
+  CHECK( grid.thread_multiple() == (level >= MPI_THREAD_MULTIPLE) );
+
+  SECTION( "Duplicate" ) {
+
+    blacspp::Grid dup = grid.duplicate();
+    CHECK( dup.is_valid() );
+    CHECK( dup.npr() == grid.npr() );
+    CHECK( dup.npc() == grid.npc() );
+    CHECK( dup.ipr() == grid.ipr() );
+    CHECK( dup.ipc() == grid.ipc() );
+    CHECK( dup.context() != grid.context() );
+
+    int cmp;
+    MPI_Comm_compare( dup.comm(), grid.comm(), &cmp );
+    CHECK( cmp == MPI_CONGRUENT );
+
+  }
+
+  SECTION( "Concurrent" ) {
+
+    const std::size_t nthreads = 4;
+    if( not grid.thread_multiple() ) {
+      CHECK_THROWS( blacspp::GridPool( grid, nthreads ) );
+      return;
+    }
+
+    blacspp::GridPool pool( grid, nthreads );
+    REQUIRE( pool.size() == nthreads );
+
+    // Every thread exchanges along the process rows over its own grid, with
+    // identical tags, such that only the communicators separate the messages
+    const blacspp::blacs_int M(7), N(3);
+    const auto right = ( grid.ipc() + 1 ) % grid.npc();
+    const auto left  = ( grid.ipc() + grid.npc() - 1 ) % grid.npc();
+    const int  src   = blacspp::coordinate_rank( grid, grid.ipr(), left );
+
+    std::vector< std::vector<double> > recv( nthreads,
+      std::vector<double>( M*N, -1. ) );
+
+    std::vector< std::thread > threads;
+    for( std::size_t t = 0; t < nthreads; ++t )
+      threads.emplace_back( [&, t]() {
+        const auto& g = pool[t];
+        std::vector<double> send( M*N );
+        for( blacspp::blacs_int i = 0; i < M*N; ++i )
+          send[i] = 1000. * t + 100. * mpi.rank() + i;
+        for( int rep = 0; rep < 10; ++rep ) {
+          auto r = blacspp::igerv2d( g, M, N, recv[t].data(), M, g.ipr(), left );
+          auto s = blacspp::igesd2d( g, M, N, send.data(), M, g.ipr(), right );
+          r.wait(); s.wait();
+        }
+      });
+    for( auto& th : threads ) th.join();
+
+    for( std::size_t t = 0; t < nthreads; ++t )
+    for( blacspp::blacs_int i = 0; i < M*N; ++i )
+      CHECK( recv[t][i] == 1000. * t + 100. * src + i );
+
+  }
+
+}
+
+TEST_CASE( "Concurrent Profiling", "[grid_pool]" ) {
+
+  auto& prof = blacspp::Profiler::instance();
+  prof.reset();
+  prof.enable_tracing();
+
+  const int nthreads = 4, ncalls = 1000;
+  std::vector< std::thread > threads;
+  for( int t = 0; t < nthreads; ++t )
+    threads.emplace_back( [&]() {
+      for( int i = 0; i < ncalls; ++i ) prof.record( "thread", -1, -1, 0, 8, 0., 1e-6 );
+    });
+  for( auto& th : threads ) th.join();
+
+  std::size_t count = 0, bytes = 0;
+  for( const auto& [k, e] : prof.entries() )
+    if( k.name == "thread" ) { count += e.count; bytes += e.bytes; }
+  CHECK( count == std::size_t( nthreads * ncalls ) );
+  CHECK( bytes == std::size_t( 8 * nthreads * ncalls ) );
+
+  prof.enable_tracing( false );
+  prof.reset();
+
+}
@@ -0,0 +1,114 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/halo.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+
+TEST_CASE( "Halo Neighbours", "[halo]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::halo_options open, periodic;
+  periodic.periodic_column = periodic.periodic_row = true;
+
+  const auto n = blacspp::detail::halo_neighbour( grid, blacspp::North, open );
+  const auto e = blacspp::detail::halo_neighbour( grid, blacspp::East,  periodic );
+
+  CHECK( bool(n) == ( grid.ipr() > 0 ) );
+  if( n ) CHECK( *n == blacspp::process_coordinate{ grid.ipr() - 1, grid.ipc() } );
+
+  REQUIRE( e );
+  CHECK( *e == blacspp::process_coordinate{ grid.ipr(), ( grid.ipc() + 1 ) % grid.npc() } );
+
+}
+
+TEST_CASE( "Halo Exchange", "[halo]" ) {
+
+  using blacspp::blacs_int;
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  // Local (m,n) block with a ring of halo cells
+  const blacs_int m(4), n(3), ld( m + 2 );
+  auto at = []( std::vector<double>& A, blacs_int i, blacs_int j ) -> double& {
+    return A[ i + j*( m + 2 ) ];
+  };
+  auto value = []( const blacspp::Grid& g, blacspp::process_coordinate p,
+                   blacs_int i, blacs_int j ) {
+    return blacspp::coordinate_rank( g, p ) * 1000. + i * 10. + j;
+  };
+
+  for( bool periodic : { false, true } ) {
+
+    blacspp::halo_options opts;
+    opts.periodic_column = opts.periodic_row = periodic;
+
+    std::vector<double> A( ld * ( n + 2 ), -1. );
+    const blacspp::process_coordinate me{ grid.ipr(), grid.ipc() };
+    for( blacs_int j = 1; j <= n; ++j )
+    for( blacs_int i = 1; i <= m; ++i ) at( A, i, j ) = value( grid, me, i, j );
+
+    double* a = A.data();
+    std::vector< blacspp::halo_tile<double> > tiles = {
+      // Rows (strided)
+      { blacspp::North, 1, n, a + 1 + ld,       ld, a + 0 + ld,       ld },
+      { blacspp::South, 1, n, a + m + ld,       ld, a + m + 1 + ld,   ld },
+      // Columns (contiguous)
+      { blacspp::West,  m, 1, a + 1 + ld,       ld, a + 1,            ld },
+      { blacspp::East,  m, 1, a + 1 + n*ld,     ld, a + 1 + (n+1)*ld, ld }
+    };
+
+    // Split form, overlapped with an (interior) computation
+    auto ex = blacspp::halo_exchange_begin( grid, tiles, opts );
+    double interior = 0.;
+    for( blacs_int j = 2; j < n; ++j )
+    for( blacs_int i = 2; i < m; ++i ) interior += at( A, i, j );
+    blacspp::halo_exchange_end( ex );
+    CHECK( ex.test() );
+
+    const auto north = blacspp::detail::halo_neighbour( grid, blacspp::North, opts );
+    const auto south = blacspp::detail::halo_neighbour( grid, blacspp::South, opts );
+    const auto west  = blacspp::detail::halo_neighbour( grid, blacspp::West,  opts );
+    const auto east  = blacspp::detail::halo_neighbour( grid, blacspp::East,  opts );
+
+    for( blacs_int j = 1; j <= n; ++j ) {
+      CHECK( at( A, 0,     j ) == ( north ? value( grid, *north, m, j ) : -1. ) );
+      CHECK( at( A, m + 1, j ) == ( south ? value( grid, *south, 1, j ) : -1. ) );
+    }
+    for( blacs_int i = 1; i <= m; ++i ) {
+      CHECK( at( A, i, 0     ) == ( west ? value( grid, *west, i, n ) : -1. ) );
+      CHECK( at( A, i, n + 1 ) == ( east ? value( grid, *east, i, 1 ) : -1. ) );
+    }
+
+    // Corners are not exchanged, the interior is untouched
+    CHECK( at( A, 0, 0 ) == -1. );
+    CHECK( at( A, m + 1, n + 1 ) == -1. );
+    for( blacs_int j = 1; j <= n; ++j )
+    for( blacs_int i = 1; i <= m; ++i ) CHECK( at( A, i, j ) == value( grid, me, i, j ) );
+    (void)interior;
+
+  }
+
+  SECTION( "Blocking" ) {
+
+    // Periodic ring of single values along the process rows
+    blacspp::halo_options opts;
+    opts.periodic_row = true;
+
+    blacs_int x = grid.ipc(), w = -1, e = -1;
+    blacspp::halo_exchange( grid, {
+      blacspp::halo_tile<blacs_int>{ blacspp::West, 1, 1, &x, 1, &w, 1 },
+      blacspp::halo_tile<blacs_int>{ blacspp::East, 1, 1, &x, 1, &e, 1 } }, opts );
+
+    CHECK( w == ( grid.ipc() + grid.npc() - 1 ) % grid.npc() );
+    CHECK( e == ( grid.ipc() + 1 ) % grid.npc() );
+
+  }
+
+}
@@ -0,0 +1,130 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/hierarchical.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/combine.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+
+TEST_CASE( "Hierarchical Collectives", "[hierarchical]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(5), N(3), LDA(7);
+  const blacspp::blacs_int nproc = grid.npr() * grid.npc();
+
+  // 0: shared memory nodes, otherwise emulated nodes (including uneven ones)
+  for( blacspp::blacs_int ranks_per_node : { 0, 1, 2, 3 } ) {
+
+    grid.enable_hierarchical_collectives( ranks_per_node );
+    const auto& hier = grid.hierarchical();
+    REQUIRE( hier );
+
+    // Tiles of more than INT_MAX elements fall back to BLACS
+    CHECK(     hier->fits( M, N ) );
+    CHECK(     hier->fits( 1 << 15, 1 << 15 ) );
+    CHECK( not hier->fits( 1 << 16, 1 << 16 ) );
+    if( ranks_per_node > 0 )
+      CHECK( hier->nnodes() == ( mpi.size() + ranks_per_node - 1 ) / ranks_per_node );
+
+    // Broadcast from every process
+    for( blacspp::blacs_int pr = 0; pr < grid.npr(); ++pr )
+    for( blacspp::blacs_int pc = 0; pc < grid.npc(); ++pc ) {
+
+      const bool is_root = grid.ipr() == pr and grid.ipc() == pc;
+      const int  root    = blacspp::coordinate_rank( grid, pr, pc );
+
+      std::vector< double > A( LDA*N, -1. );
+      if( is_root )
+        for( blacspp::blacs_int j = 0; j < N; ++j )
+        for( blacspp::blacs_int i = 0; i < M; ++i ) A[ i + j*LDA ] = root * 100 + i + j*M;
+
+      if( is_root ) blacspp::gebs2d( grid, blacspp::Scope::All, M, N, A.data(), LDA );
+      else          blacspp::gebr2d( grid, blacspp::Scope::All, M, N, A.data(), LDA, pr, pc );
+
+      for( blacspp::blacs_int j = 0; j < N;   ++j )
+      for( blacspp::blacs_int i = 0; i < LDA; ++i )
+        CHECK( A[ i + j*LDA ] == ( i < M ? root * 100 + i + j*M : -1. ) );
+
+      // Triangular
+      std::vector< float > U( LDA*N, -1.f );
+      if( is_root ) for( blacspp::blacs_int i = 0; i < LDA*N; ++i ) U[i] = i;
+
+      if( is_root )
+        blacspp::trbs2d( grid, blacspp::Scope::All, blacspp::Upper, blacspp::NonUnit,
+                         M, N, U.data(), LDA );
+      else
+        blacspp::trbr2d( grid, blacspp::Scope::All, blacspp::Upper, blacspp::NonUnit,
+                         M, N, U.data(), LDA, pr, pc );
+
+      for( blacspp::blacs_int j = 0; j < N; ++j ) {
+        const auto [st,en] = blacspp::detail::trapezoid_rows( blacspp::Upper,
+          blacspp::NonUnit, M, N, j );
+        for( blacspp::blacs_int i = 0; i < LDA; ++i )
+          CHECK( U[ i + j*LDA ] == ( is_root or ( i >= st and i < en ) ? i + j*LDA : -1.f ) );
+      }
+
+    }
+
+    // All-reduce
+    std::vector< blacspp::blacs_int > S( LDA*N, -1 );
+    for( blacspp::blacs_int j = 0; j < N; ++j )
+    for( blacspp::blacs_int i = 0; i < M; ++i ) S[ i + j*LDA ] = mpi.rank() + i + j*M;
+
+    blacspp::gsum2d( grid, blacspp::Scope::All, M, N, S.data(), LDA );
+
+    const blacspp::blacs_int rsum = nproc * ( nproc - 1 ) / 2;
+    for( blacspp::blacs_int j = 0; j < N;   ++j )
+    for( blacspp::blacs_int i = 0; i < LDA; ++i )
+      CHECK( S[ i + j*LDA ] == ( i < M ? rsum + nproc * ( i + j*M ) : -1 ) );
+
+    // Reduce onto every process
+    for( blacspp::blacs_int pr = 0; pr < grid.npr(); ++pr )
+    for( blacspp::blacs_int pc = 0; pc < grid.npc(); ++pc ) {
+
+      const bool is_dest = grid.ipr() == pr and grid.ipc() == pc;
+      std::vector< blacspp::dcomplex > Z( LDA*N, blacspp::dcomplex( -1., -1. ) );
+      for( blacspp::blacs_int j = 0; j < N; ++j )
+      for( blacspp::blacs_int i = 0; i < M; ++i )
+        Z[ i + j*LDA ] = blacspp::dcomplex( mpi.rank(), i + j*M );
+
+      blacspp::gsum2d( grid, blacspp::Scope::All, M, N, Z.data(), LDA, pr, pc );
+
+      for( blacspp::blacs_int j = 0; j < N;   ++j )
+      for( blacspp::blacs_int i = 0; i < LDA; ++i ) {
+        const auto z = Z[ i + j*LDA ];
+        if( i >= M )      CHECK( z == blacspp::dcomplex( -1., -1. ) );
+        else if( is_dest ) CHECK( z == blacspp::dcomplex( rsum, nproc * ( i + j*M ) ) );
+        else              CHECK( z == blacspp::dcomplex( mpi.rank(), i + j*M ) );
+      }
+
+    }
+
+    CHECK( hier->stats().broadcasts == std::size_t( 2 * nproc ) );
+    CHECK( hier->stats().combines   == std::size_t( nproc + 1 ) );
+
+  }
+
+  SECTION( "Other Scopes" ) {
+
+    // Row broadcasts are not affected
+    grid.enable_hierarchical_collectives( 1 );
+    double x = grid.ipc() == 0 ? grid.ipr() + 0.5 : -1.;
+    if( grid.ipc() == 0 ) blacspp::gebs2d( grid, blacspp::Scope::Row, 1, 1, &x, 1 );
+    else blacspp::gebr2d( grid, blacspp::Scope::Row, 1, 1, &x, 1, grid.ipr(), 0 );
+    CHECK( x == grid.ipr() + 0.5 );
+    CHECK( grid.hierarchical()->stats().broadcasts == 0 );
+
+    grid.disable_hierarchical_collectives();
+    CHECK( not grid.hierarchical() );
+
+  }
+
+}
@@ -0,0 +1,111 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/io.hpp>
+#include <blacspp/information.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+template <typename T>
+void fill( blacspp::DistMatrix<T>& A ) {
+  A.for_each_local( [&]( auto i, auto j, T& x ) { x = T( i + j * A.m() ); } );
+}
+
+template <typename T>
+void check( const blacspp::DistMatrix<T>& B ) {
+  for( blacspp::blacs_int jl = 0; jl < B.local_n(); ++jl )
+  for( blacspp::blacs_int il = 0; il < B.local_m(); ++il ) {
+    const auto [i, j] = B.local_to_global( il, jl );
+    CHECK( B(il,jl) == T( i + j * B.m() ) );
+  }
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Matrix IO", "[io]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+  blacspp::Grid row_grid( MPI_COMM_WORLD, 1, mpi.size() );
+
+  const blacspp::blacs_int M(17), N(11);
+  const std::string fname = std::string("blacspp_io_test.") +
+    blacspp::detail::blacs_type_char_v<TestType> + ".bin";
+
+  blacspp::DistMatrix< TestType > A( grid, M, N, 2, 3, 0, grid.npc() - 1 );
+  fill( A );
+
+  SECTION( "Raw" ) {
+
+    blacspp::write_matrix( fname, A );
+    MPI_Barrier( MPI_COMM_WORLD );
+
+    if( mpi.rank() == 0 ) {
+      std::vector< TestType > G( M * N );
+      std::ifstream file( fname, std::ios::binary );
+      file.read( reinterpret_cast<char*>( G.data() ), G.size() * sizeof(TestType) );
+      CHECK( file.gcount() == std::streamsize( G.size() * sizeof(TestType) ) );
+      for( blacspp::blacs_int j = 0; j < N; ++j )
+      for( blacspp::blacs_int i = 0; i < M; ++i )
+        CHECK( G[i + j*M] == TestType( i + j * M ) );
+    }
+
+    blacspp::DistMatrix< TestType > B( row_grid, M, N, 4, 1, 0, mpi.size() - 1 );
+    blacspp::read_matrix( fname, B );
+    check( B );
+
+  }
+
+  SECTION( "Tiles" ) {
+
+    blacspp::write_tiles( fname, A );
+    MPI_Barrier( MPI_COMM_WORLD );
+
+    const auto h = blacspp::read_tile_header( fname );
+    CHECK( h.type == blacspp::detail::blacs_type_char_v<TestType> );
+    CHECK( h.M  == M );
+    CHECK( h.N  == N );
+    CHECK( h.MB == A.mb() );
+    CHECK( h.NB == A.nb() );
+
+    // Restart on another grid with other block sizes
+    blacspp::DistMatrix< TestType > B( row_grid, M, N, 5, 2, 0, mpi.size() - 1 );
+    blacspp::read_tiles( fname, B );
+    check( B );
+
+    blacspp::DistMatrix< TestType > C( grid, M, N, 2, 3, 0, grid.npc() - 1 );
+    blacspp::read_tiles( fname, C );
+    check( C );
+
+    if( mpi.rank() == 0 ) {
+      blacspp::MappedTileFile mapped( fname );
+      const std::int64_t bi = 8, bj = 1; // Partial last block row
+      CHECK( mapped.tile_rows( bi ) == 1 );
+      CHECK( mapped.tile_cols( bj ) == 3 );
+      mapped.prefetch( bi, bj );
+      const TestType* T = static_cast<const TestType*>( mapped.tile( bi, bj ) );
+      for( std::int64_t j = 0; j < 3; ++j )
+        CHECK( T[j] == TestType( 16 + (3 + j) * M ) );
+    }
+
+    using other = std::conditional_t< std::is_same_v<TestType, double>, float, double >;
+    blacspp::DistMatrix< other > D( grid, M, N, 2, 3 );
+    CHECK_THROWS( blacspp::read_tiles( fname, D ) );
+
+    blacspp::DistMatrix< TestType > E( grid, M + 1, N, 2, 3 );
+    CHECK_THROWS( blacspp::read_tiles( fname, E ) );
+
+  }
+
+  MPI_Barrier( MPI_COMM_WORLD );
+  if( mpi.rank() == 0 ) std::remove( fname.c_str() );
+
+}
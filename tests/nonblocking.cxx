@@ -0,0 +1,191 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "General 2D Non-Blocking Send-Recv", "[nonblocking]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(4), N(4);
+
+  std::vector< TestType > data_send( M*N, TestType(mpi.rank()) );
+  std::vector< TestType > data_recv( M*N, TestType(-1) );
+
+  auto check = [&]() {
+    // Check that send data is unchanged
+    for( auto x : data_send ) CHECK( x == TestType(mpi.rank()) );
+
+    // Get the rank for the first column
+    int rank_col = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+
+    // Check that recv data is correct
+    if( grid.ipc() == 0 )
+      for( auto x : data_recv ) CHECK( x == TestType(-1)       );
+    else
+      for( auto x : data_recv ) CHECK( x == TestType(rank_col) );
+  };
+
+  std::vector< blacspp::Request > reqs;
+
+  SECTION( "Pointer Interface" ) {
+
+    if( grid.ipc() == 0)
+      for( int i = 1; i < grid.npc(); ++i )
+        reqs.emplace_back( blacspp::igesd2d( grid, M, N, data_send.data(), M,
+          grid.ipr(), i ) );
+    else
+      reqs.emplace_back( blacspp::igerv2d(grid, M, N, data_recv.data(), M,
+        grid.ipr(), 0 ) );
+
+    blacspp::wait_all( reqs );
+    for( auto& r : reqs ) CHECK( not r.is_active() );
+
+    check();
+
+  }
+
+  SECTION( "Container Interface" ) {
+
+    if( grid.ipc() == 0)
+      for( int i = 1; i < grid.npc(); ++i )
+        reqs.emplace_back( blacspp::igesd2d( grid, M, N, data_send, M,
+          grid.ipr(), i ) );
+    else
+      reqs.emplace_back( blacspp::igerv2d(grid, M, N, data_recv, M,
+        grid.ipr(), 0 ) );
+
+    for( auto& r : reqs ) r.wait();
+
+    check();
+
+  }
+
+  SECTION( "Abbreviated Container Interface" ) {
+
+    if( grid.ipc() == 0)
+      for( int i = 1; i < grid.npc(); ++i )
+        reqs.emplace_back( blacspp::igesd2d( grid, data_send, grid.ipr(), i ) );
+    else
+      reqs.emplace_back( blacspp::igerv2d(grid, data_recv, grid.ipr(), 0 ) );
+
+    while( not blacspp::test_all( reqs ) ) { }
+
+    check();
+
+  }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Strided 2D Non-Blocking Send-Recv", "[nonblocking]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(3), N(4), LDA(5);
+
+  std::vector< TestType > data_send( LDA*N, TestType(mpi.rank()) );
+  std::vector< TestType > data_recv( LDA*N, TestType(-1) );
+
+  blacspp::Request req;
+  if( grid.ipc() == 0 and grid.npc() > 1 )
+    req = blacspp::igesd2d( grid, M, N, data_send.data(), LDA, grid.ipr(), 1 );
+  else if( grid.ipc() == 1 )
+    req = blacspp::igerv2d( grid, M, N, data_recv.data(), LDA, grid.ipr(), 0 );
+
+  CHECK( not std::is_copy_constructible_v< blacspp::Request > );
+  blacspp::Request moved( std::move(req) );
+  CHECK( not req.is_active() );
+  moved.wait();
+
+  int rank_col = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+  if( grid.ipc() == 1 )
+    for( auto i = 0; i < LDA; ++i )
+    for( auto j = 0; j < N;   ++j ) {
+      auto x = data_recv[ i + j*LDA ];
+      if( i < M ) CHECK( x == TestType(rank_col) );
+      else        CHECK( x == TestType(-1) ); // padding unchanged
+    }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Sub-Grid Non-Blocking Send-Recv", "[nonblocking]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  if( grid.npr() < 2 ) return;
+
+  // Process (0,0) of the sub-grid is not rank 0 of Grid::comm()
+  auto sub = grid.subgrid( 1, grid.npr(), 0, grid.npc() );
+  if( not sub.is_valid() ) return;
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(2), N(3);
+  std::vector< TestType > data( M*N, TestType(mpi.rank()) );
+
+  if( sub.ipr() == 0 and sub.ipc() == 0 ) {
+    std::vector< blacspp::Request > reqs;
+    for( auto j = 1; j < sub.npc(); ++j )
+      reqs.emplace_back( blacspp::igesd2d( sub, M, N, data, M, 0, j ) );
+    blacspp::wait_all( reqs );
+  } else if( sub.ipr() == 0 ) {
+    blacspp::igerv2d( sub, M, N, data, M, 0, 0 ).wait();
+    for( auto x : data ) CHECK( x == TestType( grid.comm_rank(1,0) ) );
+  }
+
+}
+
+
+TEST_CASE( "Non-Blocking Transfers Are Isolated From Grid::comm()", "[nonblocking]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  if( grid.npr() * grid.npc() < 2 ) return;
+
+  CHECK( grid.transfer_comm() != MPI_COMM_NULL );
+  CHECK( grid.transfer_comm() != grid.comm() );
+
+  // The peer of (0,0) is the last process of the grid
+  const blacspp::blacs_int pr = grid.npr() - 1, pc = grid.npc() - 1;
+  const int peer = grid.comm_rank( pr, pc );
+  const int TAG  = blacspp::nonblocking_tag;
+
+  const blacspp::blacs_int M(3), N(2);
+  std::vector<double> grid_data( M*N ), app_data( M*N );
+
+  if( grid.ipr() == 0 and grid.ipc() == 0 ) {
+
+    // A message of the application with the same tag, sent after the transfer
+    std::fill( grid_data.begin(), grid_data.end(), 1. );
+    std::fill( app_data.begin(),  app_data.end(),  2. );
+    auto req = blacspp::igesd2d( grid, M, N, grid_data, M, pr, pc );
+    MPI_Send( app_data.data(), M*N, MPI_DOUBLE, peer, TAG, grid.comm() );
+    req.wait();
+
+  } else if( grid.ipr() == pr and grid.ipc() == pc ) {
+
+    // Recieved in the opposite order, each must match its own message
+    MPI_Recv( app_data.data(), M*N, MPI_DOUBLE, grid.comm_rank(0,0), TAG,
+              grid.comm(), MPI_STATUS_IGNORE );
+    blacspp::igerv2d( grid, M, N, grid_data, M, 0, 0 ).wait();
+
+    for( auto x : grid_data ) CHECK( x == 1. );
+    for( auto x : app_data  ) CHECK( x == 2. );
+
+  }
+
+}
@@ -0,0 +1,116 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/util/pack.hpp>
+#include <blacspp/types.hpp>
+#include <stdexcept>
+#include <vector>
+
+
+TEST_CASE( "Pack Kernels", "[pack]" ) {
+
+  using namespace blacspp;
+  using namespace blacspp::detail;
+
+  const auto isa0      = pack_isa();
+  const auto streaming = pack_streaming_bytes();
+  REQUIRE( pack_isa_supported( isa0 ) );
+  REQUIRE( pack_isa_supported( PackISA::Generic ) );
+
+  // Odd extents exercise the unaligned heads / tails of the vector kernels,
+  // long columns the unrolled bodies
+  const std::vector< std::pair<blacs_int,blacs_int> > shapes =
+    { {1,1}, {7,3}, {3,7}, {67,5}, {300,9}, {9,300} };
+
+  for( auto isa : { PackISA::Generic, PackISA::AVX2, PackISA::AVX512, PackISA::NEON } ) {
+
+    if( not pack_isa_supported( isa ) ) {
+      CHECK_THROWS_AS( set_pack_isa( isa ), std::runtime_error );
+      continue;
+    }
+    set_pack_isa( isa );
+    CHECK( pack_isa() == isa );
+
+    // Regular and non-temporal stores
+    for( std::size_t stream_bytes : { streaming, std::size_t(0) } ) {
+
+      set_pack_streaming_bytes( stream_bytes );
+
+      for( auto [M,N] : shapes ) {
+
+        const blacs_int LDA = M + 3;
+        std::vector< double > A( LDA*N ), B( LDA*N, -1. );
+        for( blacs_int i = 0; i < LDA*N; ++i ) A[i] = i;
+
+        // General
+        std::vector< double > packed( M*N, -2. );
+        pack_2d( packed.data(), sizeof(double), M, N, A.data() + 1, LDA );
+        for( blacs_int j = 0; j < N; ++j )
+        for( blacs_int i = 0; i < M; ++i )
+          CHECK( packed[ i + j*M ] == A[ 1 + i + j*LDA ] );
+
+        unpack_2d( B.data() + 1, sizeof(double), M, N, packed.data(), LDA );
+        for( blacs_int j = 0; j < N;   ++j )
+        for( blacs_int i = 0; i < LDA; ++i )
+          CHECK( B[ i + j*LDA ] == ( i >= 1 and i <= M ? A[ i + j*LDA ] : -1. ) );
+
+        // Trapezoids
+        for( auto uplo : { Upper, Lower } )
+        for( auto diag : { Unit, NonUnit } ) {
+
+          std::vector< double > T( trapezoid_size( uplo, diag, M, N ) );
+          std::vector< double > C( LDA*N, -1. );
+          pack_trapezoid( T.data(), sizeof(double), uplo, diag, M, N, A.data(), LDA );
+          unpack_trapezoid( C.data(), sizeof(double), uplo, diag, M, N, T.data(), LDA );
+
+          for( blacs_int j = 0; j < N; ++j ) {
+            const auto [st,en] = trapezoid_rows( uplo, diag, M, N, j );
+            for( blacs_int i = 0; i < LDA; ++i )
+              CHECK( C[ i + j*LDA ] == ( i >= st and i < en ? A[ i + j*LDA ] : -1. ) );
+          }
+
+        }
+
+      }
+
+    }
+
+  }
+
+  set_pack_isa( isa0 );
+  set_pack_streaming_bytes( streaming );
+
+}
+
+
+TEST_CASE( "Packed Trapezoid Storage", "[pack]" ) {
+
+  using namespace blacspp;
+  using namespace blacspp::detail;
+
+  // Consecutive trapezoids reuse the scratch storage of the thread
+  const void* first = nullptr;
+  {
+    packed_trapezoid<double> P( Upper, NonUnit, 64, 64 );
+    CHECK( P.n == blacs_int( trapezoid_size( Upper, NonUnit, 64, 64 ) ) );
+    first = P.data();
+  }
+  {
+    packed_trapezoid<double> P( Lower, Unit, 8, 8 );
+    CHECK( static_cast<const void*>( P.data() ) == first );
+
+    // Nested trapezoids obtain their own storage
+    packed_trapezoid<float> Q( Lower, Unit, 8, 8 );
+    CHECK( static_cast<const void*>( Q.data() ) != first );
+    for( blacs_int i = 0; i < Q.n; ++i ) Q.data()[i] = i;
+  }
+  {
+    packed_trapezoid<double> P( Upper, Unit, 4, 4 );
+    CHECK( static_cast<const void*>( P.data() ) == first );
+  }
+
+}
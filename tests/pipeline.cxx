@@ -0,0 +1,79 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/pipeline.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Pipelined Broadcast", "[pipeline]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(3), N(7), LDA(4), NB(2);
+
+  std::vector< TestType > data( LDA*N, TestType(-1) );
+  auto value = [&]( int rank, blacspp::blacs_int i, blacspp::blacs_int j ) {
+    return TestType( rank * 100 + i + j*M );
+  };
+
+  const int root = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+  if( grid.ipc() == 0 )
+    for( blacspp::blacs_int j = 0; j < N; ++j )
+    for( blacspp::blacs_int i = 0; i < M; ++i )
+      data[i + j*LDA] = value( mpi.rank(), i, j );
+
+  SECTION( "Callback" ) {
+
+    if( grid.ipc() == 0 ) {
+      blacspp::gebs2d_pipelined( grid, blacspp::Scope::Row, blacspp::Topology::IRing,
+        M, N, data.data(), LDA, NB );
+    } else {
+      std::vector< blacspp::column_range > blocks;
+      blacspp::gebr2d_pipelined( grid, blacspp::Scope::Row, blacspp::Topology::IRing,
+        M, N, data.data(), LDA, grid.ipr(), 0, NB, 
+        [&]( blacspp::blacs_int first, blacspp::blacs_int last ) {
+          // Columns of the block have arrived
+          for( auto j = first; j < last; ++j )
+          for( blacspp::blacs_int i = 0; i < M; ++i )
+            CHECK( data[i + j*LDA] == value( root, i, j ) );
+          blocks.emplace_back( first, last );
+        });
+
+      REQUIRE( blocks.size() == 4 );
+      CHECK( blocks.front() == blacspp::column_range( 0, 2 ) );
+      CHECK( blocks.back()  == blacspp::column_range( 6, 7 ) );
+    }
+
+  }
+
+  SECTION( "Cursor" ) {
+
+    blacspp::BroadcastPipeline<TestType> pipe( grid, blacspp::Scope::Row, 
+      blacspp::Topology::Tree, M, N, data.data(), LDA, grid.ipr(), 0, NB );
+    CHECK( pipe.is_root() == (grid.ipc() == 0) );
+    CHECK( pipe.block_size() == NB );
+
+    auto blk = pipe.next();
+    CHECK( blk == blacspp::column_range( 0, 2 ) );
+    CHECK( pipe.columns_ready() == 2 );
+
+    pipe.run();
+    CHECK( pipe.done() );
+    CHECK( pipe.next() == blacspp::column_range( N, N ) );
+
+  }
+
+  for( blacspp::blacs_int j = 0; j < N;   ++j )
+  for( blacspp::blacs_int i = 0; i < LDA; ++i )
+    CHECK( data[i + j*LDA] == ( i < M ? value( root, i, j ) : TestType(-1) ) );
+
+}
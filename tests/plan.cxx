@@ -0,0 +1,293 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/plan.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/combine.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Point-to-Point Plans", "[plan]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  // Strided (M,N,LDA) layout
+  const blacspp::blacs_int M(3), N(4), LDA(5), niter(3);
+
+  const int rank_col = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+
+  std::vector< TestType > data( LDA*N, TestType(-1) );
+
+  auto check = [&]( int iter ) {
+    for( blacspp::blacs_int j = 0; j < N;   ++j )
+    for( blacspp::blacs_int i = 0; i < LDA; ++i )
+      if( i < M ) CHECK( data[i + j*LDA] == TestType( rank_col + iter ) );
+      else        CHECK( data[i + j*LDA] == TestType(-1) );
+  };
+
+  auto fill = [&]( int iter ) {
+    for( blacspp::blacs_int j = 0; j < N; ++j )
+    for( blacspp::blacs_int i = 0; i < M; ++i )
+      data[i + j*LDA] = TestType( mpi.rank() + iter );
+  };
+
+  SECTION( "Blocking" ) {
+
+    std::vector< blacspp::SendPlan<TestType> > sends;
+    if( grid.ipc() == 0 )
+      for( int i = 1; i < grid.npc(); ++i )
+        sends.emplace_back( blacspp::plan_send<TestType>( grid, M, N, LDA, 
+          grid.ipr(), i ) );
+
+    auto recv = blacspp::plan_recv<TestType>( grid, M, N, LDA, grid.ipr(), 0 );
+
+    for( int iter = 0; iter < niter; ++iter ) {
+      if( grid.ipc() == 0 ) {
+        fill( iter );
+        for( const auto& s : sends ) s.execute( data.data() );
+      } else {
+        recv.execute( data.data() );
+        check( iter );
+      }
+    }
+
+  }
+
+  SECTION( "Non-Blocking" ) {
+
+    std::vector< blacspp::SendPlan<TestType> > sends;
+    if( grid.ipc() == 0 )
+      for( int i = 1; i < grid.npc(); ++i )
+        sends.emplace_back( blacspp::plan_send<TestType>( grid, M, N, LDA, 
+          grid.ipr(), i ) );
+
+    auto recv = blacspp::plan_recv<TestType>( grid, M, N, LDA, grid.ipr(), 0 );
+
+    for( int iter = 0; iter < niter; ++iter ) {
+      std::vector< blacspp::Request > reqs;
+      if( grid.ipc() == 0 ) {
+        fill( iter );
+        for( const auto& s : sends ) reqs.emplace_back( s.start( data.data() ) );
+        blacspp::wait_all( reqs );
+      } else {
+        reqs.emplace_back( recv.start( data.data() ) );
+        blacspp::wait_all( reqs );
+        check( iter );
+      }
+    }
+
+  }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Broadcast Plans", "[plan]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(2), N(3), niter(3);
+
+  std::vector< TestType > data( M*N );
+
+  SECTION( "Row" ) {
+
+    auto plan = blacspp::plan_broadcast<TestType>( grid, blacspp::Scope::Row, 
+      blacspp::Topology::IRing, M, N, M );
+    CHECK( plan.is_root() == (grid.ipc() == 0) );
+
+    const auto root = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+    for( int iter = 0; iter < niter; ++iter ) {
+      std::fill( data.begin(), data.end(), TestType( mpi.rank() + iter ) );
+      plan.execute( data.data() );
+      for( auto x : data ) CHECK( x == TestType( root + iter ) );
+    }
+
+  }
+
+  SECTION( "All With Root" ) {
+
+    const auto RSRC = grid.npr() - 1, CSRC = grid.npc() - 1;
+    auto plan = blacspp::plan_broadcast<TestType>( grid, blacspp::Scope::All, 
+      blacspp::Topology::Default, M, N, M, RSRC, CSRC );
+
+    const auto root = blacspp::coordinate_rank( grid, RSRC, CSRC );
+    for( int iter = 0; iter < niter; ++iter ) {
+      std::fill( data.begin(), data.end(), TestType( mpi.rank() + iter ) );
+      plan.execute( data.data() );
+      for( auto x : data ) CHECK( x == TestType( root + iter ) );
+    }
+
+  }
+
+  SECTION( "Grid Topology" ) {
+
+    grid.set_broadcast_topology( blacspp::Topology::Tree );
+    auto plan = blacspp::plan_broadcast<TestType>( grid, blacspp::Scope::Column, 
+      M, N, M );
+
+    const auto root = blacspp::coordinate_rank( grid, 0, grid.ipc() );
+    std::fill( data.begin(), data.end(), TestType( mpi.rank() ) );
+    plan.execute( data.data() );
+    for( auto x : data ) CHECK( x == TestType( root ) );
+
+  }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Combine Plans", "[plan]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(4), N(2), niter(2);
+
+  std::vector< TestType > data( M*N );
+
+  SECTION( "Sum" ) {
+
+    auto plan = blacspp::plan_combine<TestType>( grid, blacspp::Sum, 
+      blacspp::Scope::All, blacspp::Topology::IRing, M, N, M );
+
+    const TestType all_sum = TestType( mpi.size() * (mpi.size()-1) / 2 );
+    for( int iter = 0; iter < niter; ++iter ) {
+      std::fill( data.begin(), data.end(), TestType( mpi.rank() ) );
+      plan.execute( data.data() );
+      for( auto x : data ) CHECK( x == all_sum );
+    }
+
+  }
+
+  SECTION( "Max/Min" ) {
+
+    auto mx = blacspp::plan_combine<TestType>( grid, blacspp::Max, 
+      blacspp::Scope::All, M, N, M );
+    auto mn = blacspp::plan_combine<TestType>( grid, blacspp::Min, 
+      blacspp::Scope::All, M, N, M );
+
+    std::fill( data.begin(), data.end(), TestType( mpi.rank() ) );
+    mx.execute( data.data() );
+    for( auto x : data ) CHECK( x == TestType( mpi.size()-1 ) );
+
+    std::fill( data.begin(), data.end(), TestType( mpi.rank() ) );
+    mn.execute( data.data() );
+    for( auto x : data ) CHECK( x == TestType(0) );
+
+  }
+
+}
+
+
+// Plans paired with the regular calls on the other end of each transfer
+void check_mixed_pairings( const blacspp::Grid& grid ) {
+
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  // Strided (M,N,LDA) layout, values are exact in every wire precision
+  const blacspp::blacs_int M(3), N(4), LDA(5);
+  std::vector< double > data( LDA*N );
+
+  auto fill = [&]( int src ) {
+    std::fill( data.begin(), data.end(), -1. );
+    for( blacspp::blacs_int j = 0; j < N; ++j )
+    for( blacspp::blacs_int i = 0; i < M; ++i ) data[i + j*LDA] = src * 16 + i + j*M;
+  };
+  auto check = [&]( int src ) {
+    for( blacspp::blacs_int j = 0; j < N;   ++j )
+    for( blacspp::blacs_int i = 0; i < LDA; ++i )
+      CHECK( data[i + j*LDA] == ( i < M ? src * 16 + i + j*M : -1. ) );
+  };
+
+  // Round 0: plans send / broadcast, round 1: plans recieve
+  for( int round = 0; round < 2; ++round ) {
+
+    const int rank_col = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+    if( grid.ipc() == 0 ) {
+      fill( mpi.rank() );
+      for( int i = 1; i < grid.npc(); ++i )
+        if( round == 0 )
+          blacspp::plan_send<double>( grid, M, N, LDA, grid.ipr(), i ).execute( data.data() );
+        else
+          blacspp::gesd2d( grid, M, N, data.data(), LDA, grid.ipr(), i );
+    } else {
+      fill( -1 );
+      if( round == 0 )
+        blacspp::gerv2d( grid, M, N, data.data(), LDA, grid.ipr(), 0 );
+      else
+        blacspp::plan_recv<double>( grid, M, N, LDA, grid.ipr(), 0 ).execute( data.data() );
+      check( rank_col );
+    }
+
+    for( auto scope : { blacspp::Scope::All, blacspp::Scope::Row } ) {
+
+      const auto [RSRC, CSRC] = blacspp::detail::scope_origin( grid, scope );
+      const bool is_root = grid.ipr() == RSRC and grid.ipc() == CSRC;
+      auto plan = blacspp::plan_broadcast<double>( grid, scope, M, N, LDA );
+
+      fill( is_root ? mpi.rank() : -1 );
+      if( is_root == ( round == 0 ) ) plan.execute( data.data() );
+      else if( is_root ) blacspp::gebs2d( grid, scope, M, N, data.data(), LDA );
+      else blacspp::gebr2d( grid, scope, M, N, data.data(), LDA, RSRC, CSRC );
+      check( blacspp::coordinate_rank( grid, RSRC, CSRC ) );
+
+    }
+
+    // Every other process sums through the plan
+    auto plan = blacspp::plan_combine<double>( grid, blacspp::Sum, blacspp::Scope::All,
+      M, N, LDA );
+    std::fill( data.begin(), data.end(), 1. );
+    if( ( mpi.rank() + round ) % 2 ) plan.execute( data.data() );
+    else blacspp::gsum2d( grid, blacspp::Scope::All, M, N, data.data(), LDA );
+    for( blacspp::blacs_int j = 0; j < N;   ++j )
+    for( blacspp::blacs_int i = 0; i < LDA; ++i )
+      CHECK( data[i + j*LDA] == ( i < M ? mpi.size() : 1. ) );
+
+  }
+
+}
+
+
+TEST_CASE( "Plans With Transports", "[plan]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  SECTION( "Datatype Transport" ) {
+    grid.enable_datatype_transport();
+    check_mixed_pairings( grid );
+  }
+
+  SECTION( "Device Transport" ) {
+    grid.enable_device_transport( 64 );
+    check_mixed_pairings( grid );
+  }
+
+  SECTION( "Compression" ) {
+    blacspp::compression_options opts;
+    opts.precision = blacspp::WirePrecision::BFloat16;
+    opts.min_bytes = 0;
+    grid.enable_compression( opts );
+    check_mixed_pairings( grid );
+    CHECK( grid.compression()->stats().compressed > 0 );
+  }
+
+  SECTION( "Hierarchical Collectives" ) {
+    grid.enable_hierarchical_collectives( 1 );
+    check_mixed_pairings( grid );
+    CHECK( grid.hierarchical()->stats().broadcasts == 2 );
+    CHECK( grid.hierarchical()->stats().combines   == 2 );
+  }
+
+}
@@ -0,0 +1,209 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/profile.hpp>
+#include <blacspp/batch.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/combine.hpp>
+#include <blacspp/information.hpp>
+#include <blacspp/plan.hpp>
+#include <sstream>
+#include <vector>
+
+
+TEST_CASE( "Profiler Statistics", "[profile]" ) {
+
+  auto& prof = blacspp::Profiler::instance();
+  prof.reset();
+
+  prof.record( "gebs2d", blacspp::Scope::Row, blacspp::Topology::IRing, 'd', 64, 
+               0., 1e-6 );
+  prof.record( "gebs2d", blacspp::Scope::Row, blacspp::Topology::IRing, 'd', 32, 
+               0., 1e-3 );
+  prof.record( "gebs2d", blacspp::Scope::All, blacspp::Topology::IRing, 'd', 8, 
+               0., 1e-5 );
+  prof.record( "barrier", blacspp::Scope::All, -1, 0, 0, 0., 1e-6 );
+
+  auto entries = prof.entries();
+  REQUIRE( entries.size() == 3 );
+
+  blacspp::profile_key key{ "gebs2d", blacspp::Scope::Row, blacspp::Topology::IRing, 'd' };
+  REQUIRE( entries.count( key ) );
+
+  const auto& e = entries.at( key );
+  CHECK( e.count == 2 );
+  CHECK( e.bytes == 96 );
+  CHECK( e.min   == Approx( 1e-6 ) );
+  CHECK( e.max   == Approx( 1e-3 ) );
+  CHECK( e.total == Approx( 1e-3 + 1e-6 ) );
+  CHECK( e.histogram[0] == 1 ); // 1us
+  CHECK( e.histogram[9] == 1 ); // 1000us
+
+  SECTION( "Local Report" ) {
+    std::ostringstream ss;
+    prof.report( ss );
+    CHECK( ss.str().find( "gebs2d" )  != std::string::npos );
+    CHECK( ss.str().find( "barrier" ) != std::string::npos );
+  }
+
+  SECTION( "Reduced Report" ) {
+
+    blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+    std::ostringstream ss;
+    prof.report( ss, MPI_COMM_WORLD );
+
+    if( mpi.rank() == 0 ) {
+      const auto str = ss.str();
+      CHECK( str.find( "over " + std::to_string( mpi.size() ) ) != std::string::npos );
+
+      // Counts are summed over the processes
+      std::istringstream in( str );
+      std::string line;
+      bool found = false;
+      while( std::getline( in, line ) ) {
+        std::istringstream ls( line );
+        std::string name, scope, top, type;
+        std::size_t count, bytes;
+        ls >> name >> scope >> top >> type >> count >> bytes;
+        if( name == "gebs2d" and scope == "row" ) {
+          found = true;
+          CHECK( count == std::size_t( 2 * mpi.size() ) );
+          CHECK( bytes == std::size_t( 96 * mpi.size() ) );
+        }
+      }
+      CHECK( found );
+    } else CHECK( ss.str().empty() );
+
+  }
+
+  SECTION( "Reset" ) {
+    prof.reset();
+    CHECK( prof.entries().empty() );
+  }
+
+  prof.reset();
+
+}
+
+TEST_CASE( "Profiler Chrome Trace", "[profile]" ) {
+
+  auto& prof = blacspp::Profiler::instance();
+  prof.reset();
+
+  std::ostringstream ss;
+
+  SECTION( "Disabled" ) {
+    prof.record( "gesd2d", -1, -1, 's', 4, 0., 1e-6 );
+    prof.write_chrome_trace( ss, 0 );
+    CHECK( ss.str().find( "\"ph\":\"X\"" ) == std::string::npos );
+  }
+
+  SECTION( "Enabled" ) {
+    prof.enable_tracing();
+    CHECK( prof.tracing() );
+
+    const double t = MPI_Wtime();
+    prof.record( "gesd2d", -1, -1, 's', 4, t, t + 1e-6 );
+    prof.record( "gerv2d", -1, -1, 's', 4, t, t + 2e-6 );
+    prof.write_chrome_trace( ss, 3 );
+    prof.enable_tracing( false );
+
+    const auto str = ss.str();
+    CHECK( str.find( "\"traceEvents\"" )  != std::string::npos );
+    CHECK( str.find( "\"name\":\"gesd2d\"" ) != std::string::npos );
+    CHECK( str.find( "\"name\":\"gerv2d\"" ) != std::string::npos );
+    CHECK( str.find( "\"pid\":3" )        != std::string::npos );
+    CHECK( str.find( "\"bytes\":4" )      != std::string::npos );
+  }
+
+  prof.reset();
+
+}
+
+TEST_CASE( "Instrumented Entry Points", "[profile]" ) {
+
+  if constexpr ( not blacspp::profiling_enabled() ) return;
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  auto& prof = blacspp::Profiler::instance();
+  prof.reset();
+
+  std::vector< double > data( 6, 1. );
+  blacspp::gsum2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, 2, 3, 
+                   data.data(), 2 );
+  if( grid.ipr() == 0 and grid.ipc() == 0 )
+    blacspp::gebs2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, 2, 3,
+                     data.data(), 2 );
+  else
+    blacspp::gebr2d( grid, blacspp::Scope::All, blacspp::Topology::IRing, 2, 3,
+                     data.data(), 2, 0, 0 );
+  grid.barrier( blacspp::Scope::All );
+
+  auto entries = prof.entries();
+  const auto sum = entries.find( { "gsum2d", blacspp::Scope::All, 
+    blacspp::Topology::IRing, 'd' } );
+  REQUIRE( sum != entries.end() );
+  CHECK( sum->second.count == 1 );
+  CHECK( sum->second.bytes == 6 * sizeof(double) );
+
+  const char* bcast = grid.ipr() == 0 and grid.ipc() == 0 ? "gebs2d" : "gebr2d";
+  CHECK( entries.count( { bcast, blacspp::Scope::All, blacspp::Topology::IRing, 'd' } ) );
+  CHECK( entries.count( { "barrier", blacspp::Scope::All, -1, 0 } ) );
+
+  prof.reset();
+
+}
+
+TEST_CASE( "Instrumented Plans And Batches", "[profile]" ) {
+
+  if constexpr ( not blacspp::profiling_enabled() ) return;
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  auto& prof = blacspp::Profiler::instance();
+  prof.reset();
+
+  std::vector< double > data( 6, 1. );
+  auto bcast = blacspp::plan_broadcast<double>( grid, blacspp::Scope::All,
+    blacspp::Topology::IRing, 2, 3, 2 );
+  bcast.execute( data.data() );
+
+  auto sum = blacspp::plan_combine<double>( grid, blacspp::Sum, blacspp::Scope::All,
+    blacspp::Topology::IRing, 2, 3, 2 );
+  sum.execute( data.data() );
+
+  // Every process sends a tile to itself
+  blacspp::MessageBatch batch( grid );
+  std::vector< double > recv( 6 );
+  batch.enqueue( 2, 3, data.data(), 2, grid.ipr(), grid.ipc() );
+  batch.expect ( 2, 3, recv.data(), 2, grid.ipr(), grid.ipc() );
+  batch.flush();
+
+  auto entries = prof.entries();
+  const auto plan = entries.find( { "broadcast_plan", blacspp::Scope::All,
+    blacspp::Topology::IRing, 'd' } );
+  REQUIRE( plan != entries.end() );
+  CHECK( plan->second.count == 1 );
+  CHECK( plan->second.bytes == 6 * sizeof(double) );
+
+  // Plans go through the instrumented transport dispatch
+  const char* inner = bcast.is_root() ? "gebs2d" : "gebr2d";
+  CHECK( entries.count( { inner, blacspp::Scope::All, blacspp::Topology::IRing, 'd' } ) );
+  CHECK( entries.count( { "combine_plan", blacspp::Scope::All, 
+    blacspp::Topology::IRing, 'd' } ) );
+
+  const auto flush = entries.find( { "batch_flush", -1, -1, 0 } );
+  REQUIRE( flush != entries.end() );
+  CHECK( flush->second.count == 1 );
+  CHECK( flush->second.bytes > 6 * sizeof(double) );
+
+  prof.reset();
+
+}
@@ -0,0 +1,146 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/progress.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/information.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE( "Progress Queue", "[progress]" ) {
+
+  blacspp::detail::submission_queue queue( 3 ); // Rounded up to 4
+
+  std::vector< std::shared_ptr< blacspp::detail::progress_state > > ops;
+  for( int i = 0; i < 5; ++i )
+    ops.emplace_back( std::make_shared< blacspp::detail::progress_state >() );
+
+  auto pushed = ops; // push() moves from its argument on success
+  for( int i = 0; i < 4; ++i ) CHECK( queue.push( pushed[i] ) );
+  CHECK( not queue.push( pushed[4] ) );
+  CHECK( pushed[4] );
+
+  std::shared_ptr< blacspp::detail::progress_state > op;
+  for( int i = 0; i < 4; ++i ) {
+    REQUIRE( queue.pop( op ) );
+    CHECK( op == ops[i] ); // FIFO
+  }
+  CHECK( not queue.pop( op ) );
+
+  SECTION( "Concurrent" ) {
+
+    blacspp::detail::submission_queue q( 64 );
+    const int nthreads = 4, nper = 1000;
+
+    std::vector< std::thread > producers;
+    for( int t = 0; t < nthreads; ++t )
+      producers.emplace_back( [&]() {
+        for( int i = 0; i < nper; ++i ) {
+          auto s = std::make_shared< blacspp::detail::progress_state >();
+          while( not q.push( s ) ) std::this_thread::yield();
+        }
+      });
+
+    int npopped = 0;
+    while( npopped < nthreads * nper )
+      if( q.pop( op ) ) npopped++;
+
+    for( auto& t : producers ) t.join();
+    CHECK( not q.pop( op ) );
+
+  }
+
+}
+
+TEST_CASE( "Progress Engine", "[progress]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  SECTION( "Polling" ) {
+
+    grid.enable_progress();
+    REQUIRE( grid.progress() );
+    auto& engine = *grid.progress();
+    CHECK( engine.mode() == blacspp::ProgressMode::Polling );
+
+    // Exchange along the process rows
+    const blacspp::blacs_int M(5), N(3);
+    const auto right = ( grid.ipc() + 1 ) % grid.npc();
+    const auto left  = ( grid.ipc() + grid.npc() - 1 ) % grid.npc();
+
+    std::vector< double > send( M*N ), recv( M*N, -1. );
+    for( blacspp::blacs_int i = 0; i < M*N; ++i ) send[i] = mpi.rank() * 100 + i;
+
+    auto rt = engine.submit( blacspp::igerv2d( grid, M, N, recv.data(), M,
+      grid.ipr(), left ) );
+    auto st = engine.submit( blacspp::igesd2d( grid, M, N, send.data(), M,
+      grid.ipr(), right ) );
+
+    rt.wait();
+    st.wait();
+    CHECK( rt.done() );
+    CHECK( engine.pending() == 0 );
+
+    const int src = blacspp::coordinate_rank( grid, grid.ipr(), left );
+    for( blacspp::blacs_int i = 0; i < M*N; ++i ) CHECK( recv[i] == src * 100 + i );
+
+    // General operations
+    int nsteps = 0;
+    auto t = engine.submit( [&]() { return ++nsteps == 3; } );
+    CHECK( not t.done() );
+    CHECK( engine.poll() == 0 );
+    CHECK( engine.poll() == 0 );
+    CHECK( engine.poll() == 1 );
+    CHECK( t.done() );
+    CHECK( nsteps == 3 );
+
+    auto e = engine.submit( []() -> bool { throw std::runtime_error("Step"); } );
+    CHECK_THROWS( e.wait() );
+    CHECK( engine.pending() == 0 );
+
+    // Pipelined broadcast from the first process column
+    const blacspp::blacs_int LDA(6), NB(1);
+    std::vector< double > data( LDA*N, -1. );
+    const int root = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+    if( grid.ipc() == 0 ) data = std::vector< double >( LDA*N, double( mpi.rank() ) );
+
+    blacspp::BroadcastPipeline< double > pipe( grid, blacspp::Scope::Row,
+      blacspp::Topology::IRing, M, N, data.data(), LDA, grid.ipr(), 0, NB );
+    auto pt = engine.submit( pipe );
+    pt.wait();
+    CHECK( pipe.done() );
+    for( blacspp::blacs_int j = 0; j < N; ++j )
+    for( blacspp::blacs_int i = 0; i < M; ++i ) CHECK( data[i + j*LDA] == root );
+
+    grid.disable_progress();
+    CHECK( not grid.progress() );
+
+  }
+
+  SECTION( "Thread" ) {
+
+    blacspp::progress_options opts;
+    opts.mode = blacspp::ProgressMode::Thread;
+
+    int level;
+    MPI_Query_thread( &level );
+    if( level < MPI_THREAD_MULTIPLE ) {
+      CHECK_THROWS( grid.enable_progress( opts ) );
+    } else {
+      grid.enable_progress( opts );
+      std::atomic<int> nsteps{0};
+      auto t = grid.progress()->submit( [&]() { return ++nsteps == 10; } );
+      while( not t.done() ) std::this_thread::yield();
+      CHECK( nsteps == 10 );
+    }
+
+  }
+
+}
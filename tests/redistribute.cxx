@@ -0,0 +1,97 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/redistribute.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+template <typename T>
+void fill( blacspp::DistMatrix<T>& A ) {
+  A.for_each_local( [&]( auto i, auto j, T& x ) { x = T( i + j * A.m() ); } );
+}
+
+template <typename T>
+void check( const blacspp::DistMatrix<T>& B ) {
+  for( blacspp::blacs_int jl = 0; jl < B.local_n(); ++jl )
+  for( blacspp::blacs_int il = 0; il < B.local_m(); ++il ) {
+    const auto [i, j] = B.local_to_global( il, jl );
+    CHECK( B(il,jl) == T( i + j * B.m() ) );
+  }
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Redistribution", "[redistribute]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(17), N(11);
+
+  blacspp::DistMatrix< TestType > A( grid, M, N, 2, 3 );
+  fill( A );
+
+  SECTION( "Block Size" ) {
+    blacspp::DistMatrix< TestType > B( grid, M, N, 3, 2, grid.npr() - 1, 0 );
+    blacspp::redistribute( A, B, MPI_COMM_WORLD );
+    check( B );
+  }
+
+  SECTION( "Row Grid" ) {
+    blacspp::Grid row_grid( MPI_COMM_WORLD, 1, mpi.size() );
+    blacspp::DistMatrix< TestType > B( row_grid, M, N, 4, 1 );
+    blacspp::redistribute( A, B, MPI_COMM_WORLD );
+    check( B );
+
+    // And back
+    blacspp::DistMatrix< TestType > C( grid, M, N, 5, 5, 0, grid.npc() - 1 );
+    blacspp::redistribute( B, C, MPI_COMM_WORLD );
+    check( C );
+  }
+
+  SECTION( "Identical Layout" ) {
+    blacspp::DistMatrix< TestType > B( grid, M, N, 2, 3 );
+    blacspp::RedistributionPlan< TestType > plan( A, B, MPI_COMM_WORLD );
+    plan.execute( A, B );
+    check( B );
+    CHECK( plan.stats().sends == 0 );
+    CHECK( plan.stats().recvs == 0 );
+    CHECK( plan.stats().local_bytes == 
+           std::size_t( A.local_m() * A.local_n() ) * sizeof(TestType) );
+  }
+
+  SECTION( "Reused Plan With Small Pieces" ) {
+
+    blacspp::redistribution_options opts;
+    opts.piece_bytes   = 1;   // One column per piece
+    opts.scratch_bytes = 256; // Few pieces in flight
+
+    blacspp::DistMatrix< TestType > B( grid, M, N, 1, 4 );
+    blacspp::RedistributionPlan< TestType > plan( A, B, MPI_COMM_WORLD, opts );
+    if( mpi.size() > 1 ) CHECK( plan.stats().scratch <= 
+      std::max( std::size_t(256), 2 * M * sizeof(TestType) ) );
+
+    for( int rep = 0; rep < 2; ++rep ) {
+      std::fill( B.data(), B.data() + B.lda() * B.local_n(), TestType(-1) );
+      plan.execute( A, B );
+      check( B );
+    }
+
+  }
+
+  SECTION( "Layout Mismatch" ) {
+    blacspp::DistMatrix< TestType > B( grid, M, N, 3, 3 );
+    blacspp::RedistributionPlan< TestType > plan( A, B, MPI_COMM_WORLD );
+    blacspp::DistMatrix< TestType > C( grid, M, N, 2, 2 );
+    CHECK_THROWS( plan.execute( A, C ) );
+    CHECK_THROWS( blacspp::RedistributionPlan< TestType >( A, 
+      blacspp::DistMatrix< TestType >( grid, M+1, N, 2, 3 ), MPI_COMM_WORLD ) );
+  }
+
+}
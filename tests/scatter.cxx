@@ -0,0 +1,94 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/scatter.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Scatter / Gather", "[scatter]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  const blacspp::blacs_int M(15), N(10), LDA(17);
+  const blacspp::blacs_int RROOT = grid.npr() - 1, CROOT = 0;
+  const bool is_root = grid.ipr() == RROOT and grid.ipc() == CROOT;
+
+  auto value = [&]( blacspp::blacs_int i, blacspp::blacs_int j ) {
+    return TestType( i + j * M );
+  };
+
+  std::vector< TestType > A;
+  if( is_root ) {
+    A.resize( LDA * N, TestType(-1) );
+    for( blacspp::blacs_int j = 0; j < N; ++j )
+    for( blacspp::blacs_int i = 0; i < M; ++i ) A[i + j*LDA] = value( i, j );
+  }
+
+  blacspp::DistMatrix< TestType > B( grid, M, N, 2, 3, 0, grid.npc() - 1 );
+
+  auto check_local = [&]() {
+    for( blacspp::blacs_int jl = 0; jl < B.local_n(); ++jl )
+    for( blacspp::blacs_int il = 0; il < B.local_m(); ++il ) {
+      const auto [i, j] = B.local_to_global( il, jl );
+      CHECK( B(il,jl) == value( i, j ) );
+    }
+  };
+
+  // Bounded to a single outstanding staging buffer on the root
+  blacspp::scatter_options small;
+  small.window_bytes = 1;
+
+  SECTION( "Matrix" )
+  for( const auto& opts : { blacspp::scatter_options(), small } ) {
+
+    std::fill( B.data(), B.data() + B.lda() * B.local_n(), TestType(-1) );
+    blacspp::scatter( A.data(), LDA, B, RROOT, CROOT, opts );
+    check_local();
+
+    std::vector< TestType > C( is_root ? LDA * N : 0, TestType(-2) );
+    blacspp::gather( B, C.data(), LDA, RROOT, CROOT, opts );
+    if( is_root )
+      for( blacspp::blacs_int j = 0; j < N; ++j )
+      for( blacspp::blacs_int i = 0; i < LDA; ++i )
+        CHECK( C[i + j*LDA] == (i < M ? value( i, j ) : TestType(-2)) );
+
+  }
+
+  SECTION( "Panels" )
+  for( const auto& opts : { blacspp::scatter_options(), small } ) {
+
+    std::fill( B.data(), B.data() + B.lda() * B.local_n(), TestType(-1) );
+    blacspp::blacs_int ncalls = 0;
+    blacspp::scatter( [&]( blacspp::blacs_int j0, blacspp::blacs_int ncols, 
+      TestType* P, blacspp::blacs_int LDP ) {
+      CHECK( is_root );
+      CHECK( ncols <= B.nb() );
+      for( blacspp::blacs_int j = 0; j < ncols; ++j )
+      for( blacspp::blacs_int i = 0; i < M; ++i ) P[i + j*LDP] = value( i, j0 + j );
+      ncalls++;
+    }, B, RROOT, CROOT, opts );
+    if( is_root ) CHECK( ncalls == (N + B.nb() - 1) / B.nb() );
+    check_local();
+
+    blacspp::blacs_int next = 0;
+    blacspp::gather( B, [&]( blacspp::blacs_int j0, blacspp::blacs_int ncols, 
+      const TestType* P, blacspp::blacs_int LDP ) {
+      CHECK( j0 == next );
+      next += ncols;
+      for( blacspp::blacs_int j = 0; j < ncols; ++j )
+      for( blacspp::blacs_int i = 0; i < M; ++i ) 
+        CHECK( P[i + j*LDP] == value( i, j0 + j ) );
+    }, RROOT, CROOT, opts );
+    if( is_root ) CHECK( next == N );
+
+  }
+
+}
@@ -0,0 +1,121 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/information.hpp>
+#include <vector>
+
+#define BLACSPP_TEMPLATE_TEST_CASE(NAME, CAT)\
+TEMPLATE_TEST_CASE(NAME,CAT,blacspp::blacs_int, float, double, blacspp::scomplex, blacspp::dcomplex)
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Shared Memory Send-Recv", "[shared_memory]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  grid.enable_shared_memory();
+  REQUIRE( grid.shared_memory() );
+
+  const blacspp::blacs_int M(3), N(4), LDA(5);
+
+  std::vector< TestType > data_send( LDA*N, TestType(mpi.rank()) );
+  std::vector< TestType > data_recv( LDA*N, TestType(-1) );
+
+  // Every process sends to its right neighbour before recieving from
+  // its left neighbour (sends must not wait on the reciever)
+  const auto right = (grid.ipc() + 1) % grid.npc();
+  const auto left  = (grid.ipc() + grid.npc() - 1) % grid.npc();
+
+  for( int it = 0; it < 3; ++it ) {
+    blacspp::gesd2d( grid, M, N, data_send.data(), LDA, grid.ipr(), right );
+    blacspp::gesd2d( grid, M, N, data_send.data(), LDA, grid.ipr(), right );
+    blacspp::gerv2d( grid, M, N, data_recv.data(), LDA, grid.ipr(), left );
+    blacspp::gerv2d( grid, M, N, data_recv.data(), LDA, grid.ipr(), left );
+  }
+
+  const auto left_rank = grid.comm_rank( grid.ipr(), left );
+  for( auto i = 0; i < LDA; ++i )
+  for( auto j = 0; j < N;   ++j ) {
+    auto x = data_recv[ i + j*LDA ];
+    if( i < M ) CHECK( x == TestType(left_rank) );
+    else        CHECK( x == TestType(-1) ); // padding unchanged
+  }
+
+  const auto& stats = grid.shared_memory()->stats();
+  if( grid.shared_memory()->is_local( grid.comm_rank( grid.ipr(), right ) ) )
+    CHECK( stats.shared == 6 );
+
+  grid.disable_shared_memory();
+  CHECK( not grid.shared_memory() );
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Shared Memory Fallback", "[shared_memory]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  // Segment too small for the large tile
+  grid.enable_shared_memory( 1024 );
+
+  const blacspp::blacs_int M(64), N(8), M_small(2);
+  std::vector< TestType > large( M*N, TestType(mpi.rank()) );
+  std::vector< TestType > small( M_small*N, TestType(mpi.rank()) );
+
+  if( grid.ipc() == 0 ) {
+    for( auto j = 1; j < grid.npc(); ++j ) {
+      blacspp::gesd2d( grid, M, N, large, M, grid.ipr(), j );
+      blacspp::gesd2d( grid, M_small, N, small, M_small, grid.ipr(), j );
+    }
+  } else {
+
+    const auto src = grid.comm_rank( grid.ipr(), 0 );
+    std::vector< TestType > large_recv( M*N, TestType(-1) ), small_recv( M_small*N, TestType(-1) );
+    blacspp::gerv2d( grid, M, N, large_recv, M, grid.ipr(), 0 );
+    blacspp::gerv2d( grid, M_small, N, small_recv, M_small, grid.ipr(), 0 );
+    for( auto x : large_recv ) CHECK( x == TestType(src) );
+    for( auto x : small_recv ) CHECK( x == TestType(src) );
+
+  }
+
+  if( grid.ipc() == 0 and grid.npc() > 1 and 
+      grid.shared_memory()->is_local( grid.comm_rank( grid.ipr(), 1 ) ) ) {
+    CHECK( grid.shared_memory()->stats().fallback == std::size_t(grid.npc()-1) );
+    CHECK( grid.shared_memory()->stats().shared   == std::size_t(grid.npc()-1) );
+  }
+
+}
+
+
+BLACSPP_TEMPLATE_TEST_CASE( "Shared Memory Broadcast", "[shared_memory]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+  grid.enable_shared_memory();
+
+  const blacspp::blacs_int M(4), N(4);
+  std::vector< TestType > data( M*N, TestType(mpi.rank()) );
+
+  for( auto scope : { blacspp::All, blacspp::Row, blacspp::Column } ) {
+
+    std::fill( data.begin(), data.end(), TestType(mpi.rank()) );
+    const auto [RSRC, CSRC] = blacspp::detail::scope_origin( grid, scope );
+
+    if( grid.ipr() == RSRC and grid.ipc() == CSRC )
+      blacspp::gebs2d( grid, scope, blacspp::Topology::Default, M, N, data.data(), M );
+    else
+      blacspp::gebr2d( grid, scope, blacspp::Topology::Default, M, N, data.data(), M,
+                       RSRC, CSRC );
+
+    for( auto x : data ) CHECK( x == TestType( grid.comm_rank( RSRC, CSRC ) ) );
+
+  }
+
+}
@@ -0,0 +1,131 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/send_recv.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/nonblocking.hpp>
+#include <blacspp/information.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+  // 64-bit payload transported as pairs of blacs_int
+  struct int_pair { std::int32_t lo, hi; };
+
+  // 16-bit payload transported as float (extents must be even)
+  struct half_bits { std::uint16_t bits; };
+
+}
+
+template <>
+struct blacspp::blacs_traits< int_pair > :
+  blacspp::reinterpreted_blacs_traits< int_pair, blacspp::blacs_int > { };
+
+template <>
+struct blacspp::blacs_traits< half_bits > :
+  blacspp::reinterpreted_blacs_traits< half_bits, float > { };
+
+
+TEST_CASE( "BLACS Traits", "[traits]" ) {
+
+  using namespace blacspp::detail;
+
+  CHECK( blacs_supported< double >::value );
+  CHECK( blacs_native< double >::value );
+  CHECK( blacs_supported< int_pair >::value );
+  CHECK( not blacs_native< int_pair >::value );
+  CHECK( not blacs_supported< char >::value );
+  CHECK( not blacs_native< char >::value );
+
+  CHECK( blacs_type_char_v< blacspp::dcomplex > == 'z' );
+  CHECK( blacspp::blacs_traits< float >::mpi_type() == MPI_FLOAT );
+
+  CHECK( transported_extent< double >( 5 ) == 5 );
+  CHECK( transported_extent< int_pair >( 3 ) == 6 );
+  CHECK( transported_extent< half_bits >( 4 ) == 2 );
+  CHECK_THROWS( transported_extent< half_bits >( 3 ) );
+
+}
+
+TEST_CASE( "Reinterpreted Types", "[traits]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  const auto right = ( grid.ipc() + 1 ) % grid.npc();
+  const auto left  = ( grid.ipc() + grid.npc() - 1 ) % grid.npc();
+  const int  src   = blacspp::coordinate_rank( grid, grid.ipr(), left );
+  const int  root  = blacspp::coordinate_rank( grid, grid.ipr(), 0 );
+
+  const blacspp::blacs_int M(3), N(2), LDA(5);
+
+  std::vector< int_pair > send( LDA*N ), recv( LDA*N, int_pair{ -1, -1 } );
+  for( blacspp::blacs_int i = 0; i < LDA*N; ++i )
+    send[i] = int_pair{ mpi.rank(), std::int32_t(i) };
+
+  auto check = [&]() {
+    for( blacspp::blacs_int j = 0; j < N;   ++j )
+    for( blacspp::blacs_int i = 0; i < LDA; ++i ) {
+      const auto& x = recv[ i + j*LDA ];
+      if( i < M ) {
+        CHECK( x.lo == src );
+        CHECK( x.hi == i + j*LDA );
+      } else {
+        CHECK( x.lo == -1 ); // Padding untouched
+        CHECK( x.hi == -1 );
+      }
+    }
+  };
+
+  SECTION( "Send-Recv" ) {
+
+    // Through BLACS
+    if( grid.ipc() % 2 == 0 ) {
+      blacspp::gesd2d( grid, M, N, send.data(), LDA, grid.ipr(), right );
+      blacspp::gerv2d( grid, M, N, recv.data(), LDA, grid.ipr(), left );
+    } else {
+      blacspp::gerv2d( grid, M, N, recv.data(), LDA, grid.ipr(), left );
+      blacspp::gesd2d( grid, M, N, send.data(), LDA, grid.ipr(), right );
+    }
+    check();
+
+    // Non-blocking
+    recv.assign( LDA*N, int_pair{ -1, -1 } );
+    auto rreq = blacspp::igerv2d( grid, M, N, recv.data(), LDA, grid.ipr(), left );
+    auto sreq = blacspp::igesd2d( grid, M, N, send.data(), LDA, grid.ipr(), right );
+    rreq.wait();
+    sreq.wait();
+    check();
+
+  }
+
+  SECTION( "Broadcast" ) {
+
+    const blacspp::blacs_int MH(4), LDH(6);
+    std::vector< half_bits > data( LDH*N, half_bits{ 0xffff } );
+    for( blacspp::blacs_int j = 0; j < N;  ++j )
+    for( blacspp::blacs_int i = 0; i < MH; ++i )
+      if( grid.ipc() == 0 ) data[ i + j*LDH ].bits = std::uint16_t( mpi.rank() * 100 + i + j*LDH );
+
+    if( grid.ipc() == 0 )
+      blacspp::gebs2d( grid, blacspp::Scope::Row, MH, N, data.data(), LDH );
+    else
+      blacspp::gebr2d( grid, blacspp::Scope::Row, MH, N, data.data(), LDH, grid.ipr(), 0 );
+
+    for( blacspp::blacs_int j = 0; j < N;   ++j )
+    for( blacspp::blacs_int i = 0; i < LDH; ++i )
+      CHECK( data[ i + j*LDH ].bits ==
+        ( i < MH ? std::uint16_t( root * 100 + i + j*LDH ) : 0xffff ) );
+
+    // Odd number of rows is not a whole number of floats
+    if( grid.ipc() == 0 )
+      CHECK_THROWS( blacspp::gebs2d( grid, blacspp::Scope::Row, 3, N, data.data(), LDH ) );
+
+  }
+
+}
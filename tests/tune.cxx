@@ -0,0 +1,150 @@
+/**
+ *  This file is a part of blacspp (see LICENSE)
+ *
+ *  Copyright (c) 2019-2020 David Williams-Young
+ *  All rights reserved
+ */
+#include <catch2/catch.hpp>
+#include <blacspp/tune.hpp>
+#include <blacspp/broadcast.hpp>
+#include <blacspp/combine.hpp>
+#include <blacspp/information.hpp>
+#include <sstream>
+#include <vector>
+
+
+TEST_CASE( "Topology Table", "[tune]" ) {
+
+  blacspp::TopologyTable table;
+  CHECK( table.empty() );
+  CHECK( not table.lookup( blacspp::Broadcast, blacspp::All, 8 ) );
+
+  table.insert( blacspp::Broadcast, blacspp::All, 1024,    blacspp::Hypercube );
+  table.insert( blacspp::Broadcast, blacspp::All, 64,      blacspp::IRing     );
+  table.insert( blacspp::Combine,   blacspp::Row, 1 << 20, blacspp::Default   );
+  CHECK( not table.empty() );
+
+  SECTION( "Lookup" ) {
+    CHECK( table.lookup( blacspp::Broadcast, blacspp::All, 8    ) == blacspp::IRing     );
+    CHECK( table.lookup( blacspp::Broadcast, blacspp::All, 64   ) == blacspp::IRing     );
+    CHECK( table.lookup( blacspp::Broadcast, blacspp::All, 65   ) == blacspp::Hypercube );
+    CHECK( table.lookup( blacspp::Broadcast, blacspp::All, 1<<30) == blacspp::Hypercube );
+    CHECK( table.lookup( blacspp::Combine,   blacspp::Row, 8    ) == blacspp::Default   );
+    CHECK( not table.lookup( blacspp::Combine, blacspp::Column, 8 ) );
+  }
+
+  SECTION( "Save / Load" ) {
+
+    std::stringstream ss;
+    table.save( ss );
+    auto loaded = blacspp::TopologyTable::load( ss );
+
+    for( auto op : { blacspp::Broadcast, blacspp::Combine } )
+    for( auto scope : { blacspp::All, blacspp::Row, blacspp::Column } ) {
+      const auto& ref = table.entries( op, scope );
+      const auto& chk = loaded.entries( op, scope );
+      REQUIRE( ref.size() == chk.size() );
+      for( size_t i = 0; i < ref.size(); ++i ) {
+        CHECK( ref[i].max_bytes == chk[i].max_bytes );
+        CHECK( ref[i].top       == chk[i].top       );
+      }
+    }
+
+    std::stringstream bad( "broadcast all 64 x-ring\n" );
+    CHECK_THROWS( blacspp::TopologyTable::load( bad ) );
+
+  }
+
+  SECTION( "Build From Samples" ) {
+
+    std::vector< blacspp::tune_sample > samples = {
+      { blacspp::Broadcast, blacspp::All, 'd', 1, 1, 8,  blacspp::IRing,     1.0, 8. },
+      { blacspp::Broadcast, blacspp::All, 'd', 1, 1, 8,  blacspp::Hypercube, 2.0, 4. },
+      { blacspp::Broadcast, blacspp::All, 'd', 2, 1, 16, blacspp::IRing,     1.0, 16.},
+      { blacspp::Broadcast, blacspp::All, 'd', 2, 1, 16, blacspp::Hypercube, 2.0, 8. },
+      { blacspp::Broadcast, blacspp::All, 'd', 4, 1, 32, blacspp::IRing,     3.0, 8. },
+      { blacspp::Broadcast, blacspp::All, 'd', 4, 1, 32, blacspp::Hypercube, 2.0, 16.},
+    };
+
+    auto built = blacspp::build_topology_table( samples );
+    const auto& e = built.entries( blacspp::Broadcast, blacspp::All );
+    REQUIRE( e.size() == 2 );
+    CHECK( e[0].max_bytes == 16 );
+    CHECK( e[0].top       == blacspp::IRing );
+    CHECK( e[1].max_bytes == 32 );
+    CHECK( e[1].top       == blacspp::Hypercube );
+
+  }
+
+}
+
+
+TEST_CASE( "Combine Sweep", "[tune]" ) {
+
+  CHECK(     blacspp::valid_for( blacspp::Broadcast, blacspp::SRing ) );
+  CHECK(     blacspp::valid_for( blacspp::Broadcast, blacspp::MRing ) );
+  CHECK( not blacspp::valid_for( blacspp::Combine,   blacspp::SRing ) );
+  CHECK( not blacspp::valid_for( blacspp::Combine,   blacspp::MRing ) );
+  CHECK(     blacspp::valid_for( blacspp::Combine,   blacspp::IRing ) );
+
+  blacspp::TopologyTable table;
+  CHECK_THROWS( table.insert( blacspp::Combine, blacspp::All, 64, blacspp::SRing ) );
+  CHECK( table.empty() );
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+
+  // The default topologies include the rings, which are skipped for combines
+  blacspp::tune_options opts;
+  opts.ops     = { blacspp::Combine };
+  opts.shapes  = { {1,1} };
+  opts.nwarmup = 0;
+  opts.nrepeat = 1;
+
+  auto samples = blacspp::benchmark_topologies( grid, opts );
+  CHECK( samples.size() == opts.scopes.size() * (opts.topologies.size() - 2) );
+  for( const auto& s : samples ) {
+    CHECK( s.op  == blacspp::Combine );
+    CHECK( s.top != blacspp::SRing   );
+    CHECK( s.top != blacspp::MRing   );
+  }
+
+}
+
+
+TEST_CASE( "Tuned Grid", "[tune]" ) {
+
+  blacspp::Grid grid = blacspp::Grid::square_grid( MPI_COMM_WORLD );
+  blacspp::mpi_info mpi( MPI_COMM_WORLD );
+
+  blacspp::tune_options opts;
+  opts.shapes  = { {1,1}, {16,16} };
+  opts.nwarmup = 0;
+  opts.nrepeat = 1;
+
+  auto table = std::make_shared<blacspp::TopologyTable>( blacspp::tune( grid, opts ) );
+  for( auto op : opts.ops )
+  for( auto scope : opts.scopes )
+    CHECK( table->lookup( op, scope, 8 ) );
+
+  grid.set_broadcast_topology( blacspp::Topology::Hypercube );
+  CHECK( grid.broadcast_topology( blacspp::Scope::All, 8 ) == blacspp::Topology::Hypercube );
+
+  grid.set_topology_table( table );
+  CHECK( grid.topology_table() == table );
+  CHECK( grid.broadcast_topology( blacspp::Scope::Row, 8 ) ==
+         *table->lookup( blacspp::Broadcast, blacspp::Row, 8 ) );
+  CHECK( grid.combine_topology( blacspp::Scope::All, 1 << 20 ) ==
+         *table->lookup( blacspp::Combine, blacspp::All, 1 << 20 ) );
+
+  blacspp::Grid copy( grid );
+  CHECK( copy.topology_table() == table );
+
+  // Operations without topology go through the table
+  std::vector< double > data( 16, double(mpi.rank()) );
+  blacspp::gsum2d( grid, blacspp::Scope::All, data );
+  for( auto x : data ) CHECK( x == double( mpi.size() * (mpi.size()-1) / 2 ) );
+
+  grid.set_topology_table( nullptr );
+  CHECK( grid.broadcast_topology( blacspp::Scope::All, 8 ) == blacspp::Topology::Hypercube );
+
+}